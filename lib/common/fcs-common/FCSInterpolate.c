@@ -0,0 +1,174 @@
+/*
+  Copyright (C) 2011-2013 Michael Pippig
+
+  This file is part of ScaFaCoS.
+
+  ScaFaCoS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ScaFaCoS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "FCSDefinitions.h"
+#include "FCSInterpolate.h"
+
+
+/* max. number of nodes to avoid overflows during conversion to int */
+#define FCS_INTERPOLATE_MAX_NODES  1e7
+
+
+/* max. absolute value of the derivatives of erf(x)/x on [0,1] (computed numerically via Mathematica) */
+static fcs_float get_derivative_bound_erf(fcs_int order)
+{
+  switch(order){
+    case 0: return 1.13; /* FindMaxValue[Evaluate[D[Erf[x]/x, {x, 0}]], {x, 1}] */
+    case 1: return 0.43; /* FindMaxValue[Evaluate[-D[Erf[x]/x, {x, 1}]], {x, 1}] */
+    case 2: return 0.76; /* FindMaxValue[Evaluate[-D[Erf[x]/x, {x, 2}]], {x, 1}] */
+    case 3: return 1.06; /* FindMaxValue[Evaluate[D[Erf[x]/x, {x, 3}]], {x, 1}] */
+    case 4: return 2.69; /* FindMaxValue[Evaluate[D[Erf[x]/x, {x, 4}]], {x, 1}] */
+    case 5: return 6.01; /* FindMaxValue[Evaluate[-D[Erf[x]/x, {x, 5}]], {x, 1}] */
+  }
+
+  return 0.0;
+}
+
+
+/* The interpolation error of erf(alpha*r)/r = alpha * g(alpha*r) with g(x) = erf(x)/x is bounded by c * h^(n+1) * alpha^(n+2) * max|g^(n+1)|,
+ * see 'Methods of Shape-Preserving Spline-Approximation' by B.I.Kvasov, 2000. The derivative (field) requires one more order of alpha and g. */
+fcs_int fcs_interpolation_num_nodes_erf(fcs_int interpolation_order, fcs_float eps, fcs_float alpha, fcs_float r_cut, unsigned *err)
+{
+  fcs_float N, N_force, c;
+
+
+  *err = 0;
+
+  /* define constants from Taylor expansion */
+  switch(interpolation_order){
+    case 0: c = 1.0; break;
+    case 1: c = 1.0/8.0; break;
+    case 2: c = fcs_sqrt(3)/9.0; break;
+    case 3: c = 3.0/128.0; break;
+    default: return 0; /* no interpolation */
+  }
+
+  eps = fcs_fabs(eps);
+
+  N       = alpha * r_cut * fcs_pow(c * alpha * get_derivative_bound_erf(interpolation_order + 1) / eps, 1.0 / (1.0 + interpolation_order));
+  N_force = alpha * r_cut * fcs_pow(c * alpha * alpha * get_derivative_bound_erf(interpolation_order + 2) / eps, 1.0 / (1.0 + interpolation_order));
+
+  /* use the same number of nodes for potentials and fields */
+  if (N_force > N) N = N_force;
+
+  /* at least use 16 interpolation points */
+  if (N < 16) N = 16.0;
+
+  if (N > FCS_INTERPOLATE_MAX_NODES)
+  {
+    *err = 1;
+    N = FCS_INTERPOLATE_MAX_NODES;
+  }
+
+  return (fcs_int) fcs_ceil(N);
+}
+
+
+void fcs_interpolation_table_erf_potential(fcs_int num_nodes, fcs_float r_cut, fcs_float alpha, fcs_float *table)
+{
+  fcs_float r;
+
+  for(fcs_int k=0; k<num_nodes+3; k++){
+    r = r_cut * (fcs_float) k / num_nodes;
+    if (fcs_float_is_zero(r))
+      table[k] = 2 * alpha * FCS_1_SQRTPI;
+    else
+      table[k] = fcs_erf(alpha * r)/r;
+  }
+}
+
+
+void fcs_interpolation_table_erf_field(fcs_int num_nodes, fcs_float r_cut, fcs_float alpha, fcs_float *table)
+{
+  fcs_float r;
+
+  for(fcs_int k=0; k<num_nodes+3; k++){
+    r = r_cut * (fcs_float) k / num_nodes;
+    if (fcs_float_is_zero(r))
+      table[k] = 0;
+    else
+      table[k] = (-fcs_erf(alpha * r)/r
+          + 2.0*alpha*FCS_1_SQRTPI * fcs_exp(- alpha*alpha * r*r)
+        ) / r;
+  }
+}
+
+
+void fcs_erfc_table_init(fcs_erfc_table_t *table)
+{
+  table->order = -1;
+  table->num_nodes = 0;
+  table->tolerance = table->alpha = table->r_cut = table->one_over_r_cut = 0;
+  table->potential = table->field = NULL;
+}
+
+
+fcs_int fcs_erfc_table_create(fcs_erfc_table_t *table, fcs_int order, fcs_float tolerance, fcs_float alpha, fcs_float r_cut)
+{
+  fcs_int num_nodes;
+  unsigned err;
+
+
+  if (table->num_nodes > 0 && table->order == order && table->tolerance == tolerance && table->alpha == alpha && table->r_cut == r_cut) return table->num_nodes;
+
+  fcs_erfc_table_destroy(table);
+
+  if (order < 0 || order > 3 || r_cut <= 0 || tolerance <= 0) return -1;
+
+  num_nodes = fcs_interpolation_num_nodes_erf(order, tolerance, alpha, r_cut, &err);
+
+  table->potential = malloc((num_nodes + 3) * sizeof(fcs_float));
+  table->field = malloc((num_nodes + 3) * sizeof(fcs_float));
+
+  if (table->potential == NULL || table->field == NULL)
+  {
+    fcs_erfc_table_destroy(table);
+    return -1;
+  }
+
+  fcs_interpolation_table_erf_potential(num_nodes, r_cut, alpha, table->potential);
+  fcs_interpolation_table_erf_field(num_nodes, r_cut, alpha, table->field);
+
+  table->order = order;
+  table->num_nodes = num_nodes;
+  table->tolerance = tolerance;
+  table->alpha = alpha;
+  table->r_cut = r_cut;
+  table->one_over_r_cut = 1.0 / r_cut;
+
+  return num_nodes;
+}
+
+
+void fcs_erfc_table_destroy(fcs_erfc_table_t *table)
+{
+  if (table->potential) free(table->potential);
+  if (table->field) free(table->field);
+
+  fcs_erfc_table_init(table);
+}
@@ -0,0 +1,289 @@
+/*
+  Copyright (C) 2011-2013 Michael Pippig
+
+  This file is part of ScaFaCoS.
+
+  ScaFaCoS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ScaFaCoS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef FCS_INTERPOLATE_INCLUDED
+#define FCS_INTERPOLATE_INCLUDED
+
+
+#include "fcs_config.h"
+#include "FCSCommon.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/** constant spline interpolation in near field with even kernels */
+static inline fcs_float fcs_intpol_even_const(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_I
+    )
+{
+  fcs_float c;
+  fcs_int r;
+  fcs_float f1;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_I);
+  r=(fcs_int)c;
+  f1=table[r];
+  return f1;
+}
+
+/** constant spline interpolation in far field without symmetry */
+static inline fcs_float fcs_intpol_const(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_B
+    )
+{
+  fcs_float c;
+  fcs_int r;
+  fcs_float f1;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_B);
+  r=(fcs_int)c;
+  f1=table[r+1];
+  return f1;
+}
+
+/** linear spline interpolation in near field with even kernels */
+static inline fcs_float fcs_intpol_even_lin(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_I
+    )
+{
+  fcs_float c,c1,c3;
+  fcs_int r;
+  fcs_float f1,f2;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_I);
+  r=(fcs_int)c;
+  f1=table[r];f2=table[r+1];
+  c1=c-r;
+  c3=c1-1.0;
+  return (-f1*c3+f2*c1);
+}
+
+/** linear spline interpolation in far field without symmetry */
+static inline fcs_float fcs_intpol_lin(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_B
+    )
+{
+  fcs_float c,c1,c3;
+  fcs_int r;
+  fcs_float f1,f2;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_B);
+  r=(fcs_int)c;
+  f1=table[r+1];f2=table[r+2];
+  c1=c-r;
+  c3=c1-1.0;
+  return (-f1*c3+f2*c1);
+}
+
+/** quadratic spline interpolation in near field with even kernels */
+static inline fcs_float fcs_intpol_even_quad(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_I
+    )
+{
+  fcs_float c,c1,c2,c3;
+  fcs_int r;
+  fcs_float f0,f1,f2;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_I);
+  r=(fcs_int)c;
+  if (r==0) {f0=table[r+1];f1=table[r];f2=table[r+1];}
+  else { f0=table[r-1];f1=table[r];f2=table[r+1];}
+  c1=c-r;
+  c2=c1+1.0;
+  c3=c1-1.0;
+  return (0.5*f0*c1*c3-f1*c2*c3+0.5*f2*c2*c1);
+}
+
+/** quadratic spline interpolation in far field without symmetry */
+static inline fcs_float fcs_intpol_quad(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_B
+    )
+{
+  fcs_float c,c1,c2,c3;
+  fcs_int r;
+  fcs_float f0,f1,f2;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_B);
+  r=(fcs_int)c;
+  f0=table[r];f1=table[r+1];f2=table[r+2];
+  c1=c-r;
+  c2=c1+1.0;
+  c3=c1-1.0;
+  return (0.5*f0*c1*c3-f1*c2*c3+0.5*f2*c2*c1);
+}
+
+/** cubic spline interpolation in near field with even kernels */
+static inline fcs_float fcs_intpol_even_cub(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_I
+    )
+{
+  fcs_float c,c1,c2,c3,c4;
+  fcs_int r;
+  fcs_float f0,f1,f2,f3;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_I);
+  r=(fcs_int)c;
+  if (r==0) {f0=table[r+1];f1=table[r];f2=table[r+1];f3=table[r+2];}
+  else { f0=table[r-1];f1=table[r];f2=table[r+1];f3=table[r+2];}
+  c1=c-r;
+  c2=c1+1.0;
+  c3=c1-1.0;
+  c4=c1-2.0;
+  return(-f0*c1*c3*c4+3.0*f1*c2*c3*c4-3.0*f2*c2*c1*c4+f3*c2*c1*c3)/6.0;
+}
+
+/** cubic spline interpolation in far field without symmetry */
+static inline fcs_float fcs_intpol_cub(
+    const fcs_float x, const fcs_float *table,
+    const fcs_int num_nodes, const fcs_float one_over_eps_B
+    )
+{
+  fcs_float c,c1,c2,c3,c4;
+  fcs_int r;
+  fcs_float f0,f1,f2,f3;
+
+  c=fcs_fabs(x*num_nodes*one_over_eps_B);
+  r=(fcs_int)c;
+  f0=table[r];f1=table[r+1];f2=table[r+2];f3=table[r+3];
+  c1=c-r;
+  c2=c1+1.0;
+  c3=c1-1.0;
+  c4=c1-2.0;
+  return(-f0*c1*c3*c4+3.0*f1*c2*c3*c4-3.0*f2*c2*c1*c4+f3*c2*c1*c3)/6.0;
+}
+
+/** spline interpolation of the given order (0: constant, 1: linear, 2: quadratic, 3: cubic) in near field with even kernels */
+static inline fcs_float fcs_interpolation_near(
+    fcs_float x, fcs_float one_over_epsI,
+    fcs_int order, fcs_int num_nodes,
+    const fcs_float *table
+    )
+{
+  switch(order){
+    case 0: return fcs_intpol_even_const(x, table, num_nodes, one_over_epsI);
+    case 1: return fcs_intpol_even_lin(x, table, num_nodes, one_over_epsI);
+    case 2: return fcs_intpol_even_quad(x, table, num_nodes, one_over_epsI);
+    default: return fcs_intpol_even_cub(x, table, num_nodes, one_over_epsI);
+  }
+}
+
+/** spline interpolation of the given order (0: constant, 1: linear, 2: quadratic, 3: cubic) in far field without symmetry */
+static inline fcs_float fcs_interpolation_far(
+    fcs_float x, fcs_float one_over_epsB,
+    fcs_int order, fcs_int num_nodes,
+    const fcs_float *table
+    )
+{
+  switch(order){
+    case 0: return fcs_intpol_const(x, table, num_nodes, one_over_epsB);
+    case 1: return fcs_intpol_lin(x, table, num_nodes, one_over_epsB);
+    case 2: return fcs_intpol_quad(x, table, num_nodes, one_over_epsB);
+    default: return fcs_intpol_cub(x, table, num_nodes, one_over_epsB);
+  }
+}
+
+
+/**
+ * @brief compute the minimum number of interpolation nodes that guarantee the (absolute) error eps for the interpolation
+ * of erf(alpha*r)/r and its derivative on the interval [0,r_cut]
+ * @param interpolation_order fcs_int interpolation order (0: constant, 1: linear, 2: quadratic, 3: cubic)
+ * @param eps fcs_float requested accuracy
+ * @param alpha fcs_float Ewald splitting parameter
+ * @param r_cut fcs_float cutoff range
+ * @param err unsigned* set to 1 if the number of nodes was limited to avoid overflows, otherwise 0
+ * @return fcs_int number of interpolation nodes (0 if the interpolation order is not supported)
+ */
+fcs_int fcs_interpolation_num_nodes_erf(fcs_int interpolation_order, fcs_float eps, fcs_float alpha, fcs_float r_cut, unsigned *err);
+
+/**
+ * @brief initialize the table of erf(alpha*r)/r on the interval [0,r_cut] (table requires num_nodes+3 elements)
+ */
+void fcs_interpolation_table_erf_potential(fcs_int num_nodes, fcs_float r_cut, fcs_float alpha, fcs_float *table);
+
+/**
+ * @brief initialize the table of the derivative of erf(alpha*r)/r on the interval [0,r_cut] (table requires num_nodes+3 elements)
+ */
+void fcs_interpolation_table_erf_field(fcs_int num_nodes, fcs_float r_cut, fcs_float alpha, fcs_float *table);
+
+
+/**
+ * @brief interpolation tables for the near field part of Ewald-split Coulomb interactions,
+ * erfc(alpha*r)/r and its derivative are determined from the tabulated smooth parts erf(alpha*r)/r
+ */
+typedef struct _fcs_erfc_table_t
+{
+  fcs_int order, num_nodes;
+  fcs_float tolerance, alpha, r_cut, one_over_r_cut;
+  fcs_float *potential, *field;
+
+} fcs_erfc_table_t;
+
+/**
+ * @brief initialize an empty interpolation table object
+ * @param table fcs_erfc_table_t* interpolation table object
+ */
+void fcs_erfc_table_init(fcs_erfc_table_t *table);
+
+/**
+ * @brief create the interpolation tables for the given parameters (the tables are only recomputed if the parameters have changed),
+ * the number of nodes is chosen such that the interpolation error is below the given tolerance
+ * @param table fcs_erfc_table_t* interpolation table object
+ * @param order fcs_int interpolation order (0: constant, 1: linear, 2: quadratic, 3: cubic)
+ * @param tolerance fcs_float requested accuracy of the interpolated potentials and fields
+ * @param alpha fcs_float Ewald splitting parameter
+ * @param r_cut fcs_float cutoff range
+ * @return fcs_int number of interpolation nodes if successful, otherwise less than zero
+ */
+fcs_int fcs_erfc_table_create(fcs_erfc_table_t *table, fcs_int order, fcs_float tolerance, fcs_float alpha, fcs_float r_cut);
+
+/**
+ * @brief free the interpolation tables
+ * @param table fcs_erfc_table_t* interpolation table object
+ */
+void fcs_erfc_table_destroy(fcs_erfc_table_t *table);
+
+/**
+ * @brief interpolate erfc(alpha*dist)/dist (potential) and its derivative (field) for 0 < dist <= r_cut
+ */
+static inline void fcs_erfc_table_field_potential(const fcs_erfc_table_t *table, fcs_float dist, fcs_float *f, fcs_float *p)
+{
+  fcs_float inv_dist = 1.0 / dist;
+
+  *p = inv_dist - fcs_interpolation_near(dist, table->one_over_r_cut, table->order, table->num_nodes, table->potential);
+  *f = -inv_dist * inv_dist - fcs_interpolation_near(dist, table->one_over_r_cut, table->order, table->num_nodes, table->field);
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* FCS_INTERPOLATE_INCLUDED */
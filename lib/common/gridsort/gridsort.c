@@ -192,6 +192,9 @@ void fcs_gridsort_create(fcs_gridsort_t *gs)
 
   gs->d.lower_bounds[0] = gs->d.lower_bounds[1] = gs->d.lower_bounds[2] = -1;
   gs->d.upper_bounds[0] = gs->d.upper_bounds[1] = gs->d.upper_bounds[2] = -1;
+
+  gs->d.balance = 0;
+  gs->d.balance_min_width = 0;
   
   gs->d.bounds = NULL;
 
@@ -221,7 +224,10 @@ void fcs_gridsort_create(fcs_gridsort_t *gs)
 
   gs->nresort_particles = -1;
 
+  gs->balance_weights = NULL;
+
   gs->max_particle_move = -1;
+  gs->ghost_origins = 0;
   gs->nprocs = -1;
   gs->procs = NULL;
 
@@ -271,6 +277,14 @@ void fcs_gridsort_set_bounds(fcs_gridsort_t *gs, fcs_float *lower_bounds, fcs_fl
 }
 
 
+void fcs_gridsort_set_balance(fcs_gridsort_t *gs, fcs_int balance, fcs_float *weights, fcs_float min_width)
+{
+  gs->d.balance = balance;
+  gs->d.balance_min_width = min_width;
+  gs->balance_weights = weights;
+}
+
+
 void fcs_gridsort_set_zslices(fcs_gridsort_t *gs, fcs_int local_nzslices, fcs_int ghost_nzslices)
 {
   gs->local_nzslices = local_nzslices;
@@ -305,6 +319,12 @@ void fcs_gridsort_set_max_particle_move(fcs_gridsort_t *gs, fcs_float max_partic
 }
 
 
+void fcs_gridsort_set_ghost_origins(fcs_gridsort_t *gs, fcs_int ghost_origins)
+{
+  gs->ghost_origins = ghost_origins;
+}
+
+
 void fcs_gridsort_get_sorted_particles(fcs_gridsort_t *gs, fcs_int *nparticles, fcs_int *max_nparticles, fcs_float **positions, fcs_float **charges, fcs_gridsort_index_t **indices)
 {
   if (nparticles) *nparticles = gs->nsorted_particles;
@@ -372,6 +392,7 @@ static void update_cache(fcs_gridsort_t *gs)
   if (gs->cache == NULL) return;
 
   if (*gs->cache == FCS_GRIDSORT_CACHE_NULL) create_cache(gs->cache);
+  else if ((*gs->cache)->bounds != gs->d.bounds) release_bounds(&(*gs->cache)->bounds);
 
   memcpy(*gs->cache, &gs->d, sizeof(gs->d));
 
@@ -391,7 +412,8 @@ static fcs_float *get_cache_bounds(fcs_gridsort_t *gs, int size, int rank, MPI_C
   local_invalid = (float3_is_equal((*gs->cache)->box_base, gs->d.box_base) &&
                    float3_is_equal((*gs->cache)->box_a, gs->d.box_a) && float3_is_equal((*gs->cache)->box_b, gs->d.box_b) && float3_is_equal((*gs->cache)->box_c, gs->d.box_c) &&
                    int3_is_equal((*gs->cache)->periodicity, gs->d.periodicity) &&
-                   float3_is_equal((*gs->cache)->lower_bounds, gs->d.lower_bounds) && float3_is_equal((*gs->cache)->upper_bounds, gs->d.upper_bounds))?0:1;
+                   float3_is_equal((*gs->cache)->lower_bounds, gs->d.lower_bounds) && float3_is_equal((*gs->cache)->upper_bounds, gs->d.upper_bounds) &&
+                   (*gs->cache)->balance == gs->d.balance && z_fp_is_equal((*gs->cache)->balance_min_width, gs->d.balance_min_width))?0:1;
 
   MPI_Allreduce(&local_invalid, &global_invalid, 1, FCS_MPI_INT, MPI_SUM, comm);
 
@@ -514,6 +536,165 @@ static void release_bounds(fcs_float **bounds)
 }
 
 
+/* number of histogram bins per process along each dimension used to determine balanced bounds */
+#define BALANCE_NBINS      32
+
+/* balanced bounds are recomputed if the max. load of a process row exceeds the average load by more than this fraction */
+#define BALANCE_TOLERANCE  0.1
+
+static fcs_float balance_cumulative(fcs_float *hist, fcs_int nbins, fcs_float v)
+{
+  fcs_int i, k;
+  fcs_float s;
+
+
+  /* weight within [0,v), weights are assumed to be uniformly distributed within each bin */
+  if (v <= 0.0) return 0.0;
+  if (v > 1.0) v = 1.0;
+
+  k = (fcs_int) (v * nbins);
+
+  s = 0.0;
+  for (i = 0; i < z_min(k, nbins); ++i) s += hist[i];
+  if (k < nbins) s += hist[k] * (v * nbins - k);
+
+  return s;
+}
+
+
+static fcs_float *setup_balanced_bounds(fcs_float *cached_bounds, fcs_int nparticles, fcs_float *positions, fcs_float *weights, fcs_float *min_f, int *cart_dims, fcs_int *periodicity, fcs_float *grid_data, int size, int rank, MPI_Comm comm)
+{
+  const fcs_int grid_data_invert[3] = { GRID_DATA_INVERT_0, GRID_DATA_INVERT_1, GRID_DATA_INVERT_2 };
+  fcs_int i, j, k, dim, nbins[3], hist_offsets[3], bounds_offset, total_nbins, rebalance;
+  fcs_float *hist, *h, *bounds, *b, *cb, v, w, total, target, s, max_load, f;
+
+
+  total_nbins = 0;
+  for (dim = 0; dim < 3; ++dim)
+  {
+    nbins[dim] = BALANCE_NBINS * cart_dims[dim];
+    hist_offsets[dim] = total_nbins;
+    total_nbins += nbins[dim];
+  }
+
+  hist = malloc(total_nbins * sizeof(fcs_float));
+
+  for (i = 0; i < total_nbins; ++i) hist[i] = 0.0;
+
+  /* local histograms of the (weighted) particles along each dimension of the box */
+  for (i = 0; i < nparticles; ++i)
+  {
+    w = (weights)?weights[i]:1.0;
+
+    for (dim = 0; dim < 3; ++dim)
+    {
+      v = (positions[3 * i + 0] - grid_data[GRID_DATA_BASE + 0]) * grid_data[grid_data_invert[dim] + 0]
+        + (positions[3 * i + 1] - grid_data[GRID_DATA_BASE + 1]) * grid_data[grid_data_invert[dim] + 1]
+        + (positions[3 * i + 2] - grid_data[GRID_DATA_BASE + 2]) * grid_data[grid_data_invert[dim] + 2];
+
+      if (periodicity[dim]) v -= fcs_floor(v);
+
+      k = z_minmax(0, (fcs_int) (v * nbins[dim]), nbins[dim] - 1);
+
+      hist[hist_offsets[dim] + k] += w;
+    }
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, hist, total_nbins, FCS_MPI_FLOAT, MPI_SUM, comm);
+
+  /* all processes determine the same bounds from the global histograms */
+  bounds = malloc((cart_dims[0] + cart_dims[1] + cart_dims[2] + 3) * sizeof(fcs_float));
+
+  bounds_offset = 0;
+  for (dim = 0; dim < 3; ++dim)
+  {
+    h = hist + hist_offsets[dim];
+    b = bounds + bounds_offset;
+    cb = (cached_bounds)?cached_bounds + bounds_offset:NULL;
+
+    total = 0.0;
+    for (k = 0; k < nbins[dim]; ++k) total += h[k];
+
+    /* keep the previous bounds as long as the load of the process rows is balanced well enough */
+    rebalance = 1;
+    if (cb)
+    {
+      max_load = 0.0;
+      for (j = 0; j < cart_dims[dim]; ++j) max_load = z_max(max_load, balance_cumulative(h, nbins[dim], cb[j + 1]) - balance_cumulative(h, nbins[dim], cb[j]));
+
+      rebalance = (max_load > (1.0 + BALANCE_TOLERANCE) * total / cart_dims[dim]);
+
+      INFO_CMD(
+        if (rank == 0)
+          printf(INFO_PRINT_PREFIX "balance: dim: %" FCS_LMOD_INT "d, load imbalance of previous bounds: %" FCS_LMOD_FLOAT "f%s\n",
+            dim, (total > 0)?(max_load * cart_dims[dim] / total):1.0, rebalance?", recompute bounds":"");
+      );
+    }
+
+    if (!rebalance)
+    {
+      for (j = 0; j <= cart_dims[dim]; ++j) b[j] = cb[j];
+
+    } else
+    {
+      b[0] = 0.0;
+      
+      if (total > 0)
+      {
+        /* place the bounds at the positions where the cumulative weights reach equal parts of the total weight */
+        j = 1;
+        s = 0.0;
+        for (k = 0; k < nbins[dim] && j < cart_dims[dim]; ++k)
+        {
+          target = total * j / cart_dims[dim];
+
+          while (j < cart_dims[dim] && s + h[k] >= target)
+          {
+            b[j] = (k + ((h[k] > 0)?(target - s) / h[k]:0.0)) / nbins[dim];
+            ++j;
+            target = total * j / cart_dims[dim];
+          }
+
+          s += h[k];
+        }
+        for (; j < cart_dims[dim]; ++j) b[j] = 1.0;
+
+      } else for (j = 1; j < cart_dims[dim]; ++j) b[j] = (fcs_float) j / cart_dims[dim];
+
+      b[cart_dims[dim]] = 1.0;
+
+      /* enforce the min. width of the process domains (at least one histogram bin) */
+      f = z_minmax(1.0 / nbins[dim], min_f[dim], 1.0 / cart_dims[dim]);
+
+      for (j = 1; j < cart_dims[dim]; ++j) b[j] = z_max(b[j], b[j - 1] + f);
+      for (j = cart_dims[dim] - 1; j > 0; --j) b[j] = z_min(b[j], b[j + 1] - f);
+    }
+
+    bounds_offset += cart_dims[dim] + 1;
+  }
+
+  free(hist);
+
+  DEBUG_CMD(
+    if (rank == 0)
+    {
+      printf(DEBUG_PRINT_PREFIX " balanced 0-bounds:");
+      for (i = 0; i <= cart_dims[0]; ++i) printf("  %" FCS_LMOD_FLOAT "f", bounds[i]);
+      printf("\n");
+      printf(DEBUG_PRINT_PREFIX " balanced 1-bounds:");
+      for (i = 0; i <= cart_dims[1]; ++i) printf("  %" FCS_LMOD_FLOAT "f", bounds[i + cart_dims[0] + 1]);
+      printf("\n");
+      printf(DEBUG_PRINT_PREFIX " balanced 2-bounds:");
+      for (i = 0; i <= cart_dims[2]; ++i) printf("  %" FCS_LMOD_FLOAT "f", bounds[i + cart_dims[0] + 1 + cart_dims[1] + 1]);
+      printf("\n");
+    }
+  );
+
+  return bounds;
+}
+
+
+
 #define BOUNDS_XYZ2COORDS(_c_, _xyz_, _base_, _b_, _cd_, _p_, _gd_) Z_MOP( \
   if (_p_) bounds_xyz2coords_ghost_periodic_tricl((_c_), (_xyz_), (_base_), (_b_), (_cd_), (_p_), (_gd_)); \
   else bounds_xyz2coords_ghost_tricl((_c_), (_xyz_), (_base_), (_b_), (_cd_), (_gd_)); \
@@ -867,8 +1048,8 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
   fcs_forw_tproc_f *tproc_func = NULL;
   fcs_forw_tprocs_mod_f *tprocs_mod_func = NULL;
 
-  fcs_int with_ghost, with_periodic, with_triclinic, with_bounds, with_zslices;
-  fcs_float ghost_f[3], zslices_ghost_range, zslices_ghost_f;
+  fcs_int with_ghost, with_periodic, with_triclinic, with_bounds, with_zslices, with_balance;
+  fcs_float ghost_f[3], zslices_ghost_range, zslices_ghost_f, balance_f[3], *cached_bounds;
 
 #if defined(GRIDSORT_FRONT_TPROC_RANK_CACHE) || defined(GRIDSORT_PROCLIST)
   fcs_float max_particle_move, move_f[3];
@@ -925,6 +1106,7 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
   with_triclinic = z_is_triclinic(gs->d.box_a, gs->d.box_b, gs->d.box_c);
   with_bounds = (gs->d.lower_bounds[0] >= 0 && gs->d.lower_bounds[1] >= 0 && gs->d.lower_bounds[2] >= 0 && gs->d.upper_bounds[0] >= 0 && gs->d.upper_bounds[1] >= 0 && gs->d.upper_bounds[2] >= 0);
   with_zslices = (gs->local_nzslices > 0);
+  with_balance = (gs->d.balance && !with_bounds && !with_zslices);
 
   INFO_CMD(
     if (comm_rank == 0)
@@ -935,6 +1117,7 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
       printf(INFO_PRINT_PREFIX " triclinic: %s\n", with_triclinic?"yes":"no");
       printf(INFO_PRINT_PREFIX " bounds: %s\n", with_bounds?"yes":"no");
       printf(INFO_PRINT_PREFIX " zslices: %s\n", with_zslices?"yes":"no");
+      printf(INFO_PRINT_PREFIX " balance: %s\n", with_balance?"yes":"no");
       printf(INFO_PRINT_PREFIX " cartesian grid:\n");
       printf(INFO_PRINT_PREFIX "  dims: %dx%dx%d\n", cart_dims[0], cart_dims[1], cart_dims[2]);
       printf(INFO_PRINT_PREFIX "  periods: %dx%dx%d\n", cart_periods[0], cart_periods[1], cart_periods[2]);
@@ -1037,7 +1220,7 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
   grid_data[GRID_DATA_INVERT_2 + 1] = iv[5];
   grid_data[GRID_DATA_INVERT_2 + 2] = iv[8];
 
-  if (with_bounds)
+  if (with_bounds || with_balance)
   {
     DEBUG_CMD(
       printf(DEBUG_PRINT_PREFIX "%d: my bounds: %" FCS_LMOD_FLOAT "f,%" FCS_LMOD_FLOAT "f,%" FCS_LMOD_FLOAT "f - %" FCS_LMOD_FLOAT "f,%" FCS_LMOD_FLOAT "f,%" FCS_LMOD_FLOAT "f\n",
@@ -1050,7 +1233,20 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
       printf(DEBUG_PRINT_PREFIX "%d: cached bounds: %p\n", comm_rank, gs->d.bounds);
     );
 
-    if (gs->d.bounds == NULL) gs->d.bounds = setup_bounds(gs->d.upper_bounds, cart_dims, cart_coords, comm_size, comm_rank, comm);
+    if (with_balance)
+    {
+      /* balanced bounds are determined from the current particle distribution, cached bounds are kept if they are still balanced */
+      balance_f[0] = get_ghost_factor(gs->d.box_a, gs->d.box_b, gs->d.box_c, gs->d.balance_min_width);
+      balance_f[1] = get_ghost_factor(gs->d.box_b, gs->d.box_c, gs->d.box_a, gs->d.balance_min_width);
+      balance_f[2] = get_ghost_factor(gs->d.box_c, gs->d.box_a, gs->d.box_b, gs->d.balance_min_width);
+
+      cached_bounds = gs->d.bounds;
+
+      gs->d.bounds = setup_balanced_bounds(cached_bounds, gs->noriginal_particles, gs->original_positions, gs->balance_weights, balance_f, cart_dims, periodicity, grid_data, comm_size, comm_rank, comm);
+
+      if (cached_bounds) release_bounds(&(*gs->cache)->bounds);
+
+    } else if (gs->d.bounds == NULL) gs->d.bounds = setup_bounds(gs->d.upper_bounds, cart_dims, cart_coords, comm_size, comm_rank, comm);
 
     grid_tproc_data[GRID_TPROC_DATA_BOUNDS] = gs->d.bounds;
 
@@ -1124,7 +1320,7 @@ fcs_int fcs_gridsort_sort_forward(fcs_gridsort_t *gs, fcs_float ghost_range, MPI
   grid_tproc_data[GRID_TPROC_DATA_RANK_CACHE_SIZES] = rank_cache_sizes;
 #endif
 
-  if (with_bounds)
+  if (with_bounds || with_balance)
   {
     if (with_triclinic)
     {
@@ -1404,6 +1600,49 @@ static void set_periodics(fcs_forw_elements_t *s, int count, int displ, int d)
 }
 
 
+static void set_ghost_origins(fcs_forw_elements_t *s, int count, int displ, fcs_float *shift)
+{
+  fcs_int i;
+
+  for (i = displ; i < displ + count; ++i)
+  {
+    if (s->keys[i] >= 0) s->keys[i] |= GRIDSORT_GHOST_BASE;
+
+    if (shift)
+    {
+      s->data0[3 * i + 0] += shift[0];
+      s->data0[3 * i + 1] += shift[1];
+      s->data0[3 * i + 2] += shift[2];
+    }
+  }
+}
+
+
+static void wrap_positions(fcs_int nparticles, fcs_float *positions, fcs_float *box_base, fcs_float *box_a, fcs_float *box_b, fcs_float *box_c, int *periods)
+{
+  fcs_int i, d;
+  fcs_float box_size[3];
+
+
+  box_size[0] = box_a[0];
+  box_size[1] = box_b[1];
+  box_size[2] = box_c[2];
+
+  for (d = 0; d < 3; ++d)
+  {
+    if (!periods[d]) continue;
+
+    for (i = 0; i < nparticles; ++i)
+    {
+      positions[3 * i + d] -= fcs_floor((positions[3 * i + d] - box_base[d]) / box_size[d]) * box_size[d];
+
+      /* rounding of values slightly below the base */
+      if (positions[3 * i + d] >= box_base[d] + box_size[d]) positions[3 * i + d] = box_base[d];
+    }
+  }
+}
+
+
 static int gridsort_split_0b(fcs_forw_elements_t *s, fcs_forw_slint_t x, void *data)
 {
   double *bounds = data;
@@ -1452,7 +1691,7 @@ fcs_int fcs_gridsort_create_ghosts(fcs_gridsort_t *gs, fcs_float ghost_range, MP
 
   int counts[4], displs[4], neighbors[6], periodic[6], scounts[2], rcounts[2], received;
   
-  fcs_float bounds[6];
+  fcs_float bounds[6], shifts[6 * 3];
 
   fcs_forw_split_generic_t sg_gridsort_split[] = { fcs_forw_SPLIT_GENERIC_INIT_TPROC(gridsort_split_0b), fcs_forw_SPLIT_GENERIC_INIT_TPROC(gridsort_split_1b), fcs_forw_SPLIT_GENERIC_INIT_TPROC(gridsort_split_2b) };
   
@@ -1503,6 +1742,20 @@ fcs_int fcs_gridsort_create_ghosts(fcs_gridsort_t *gs, fcs_float ghost_range, MP
 
   get_neighbors(neighbors, periodic, comm_size, comm_rank, comm);
 
+  /* shifts of ghost particles received across periodic boundaries (from the higher and the lower neighbor) */
+  for (d = 0; d < 3; ++d)
+  {
+    shifts[3 * 0 + d] =  gs->d.box_a[d];
+    shifts[3 * 1 + d] = -gs->d.box_a[d];
+    shifts[3 * 2 + d] =  gs->d.box_b[d];
+    shifts[3 * 3 + d] = -gs->d.box_b[d];
+    shifts[3 * 4 + d] =  gs->d.box_c[d];
+    shifts[3 * 5 + d] = -gs->d.box_c[d];
+  }
+
+  /* ghost particles with original indices are shifted only once across the periodic boundaries, thus the particles have to be located within the system */
+  if (gs->ghost_origins) wrap_positions(gs->nsorted_particles, gs->sorted_positions, gs->d.box_base, gs->d.box_a, gs->d.box_b, gs->d.box_c, cart_periods);
+
   fcs_forw_elem_set_size(&s, gs->nsorted_particles);
   fcs_forw_elem_set_max_size(&s, gs->max_nsorted_particles);
   fcs_forw_elem_set_keys(&s, gs->sorted_indices);
@@ -1519,6 +1772,19 @@ fcs_int fcs_gridsort_create_ghosts(fcs_gridsort_t *gs, fcs_float ghost_range, MP
     bounds[4] = gs->d.lower_bounds[2] + ghost_range;
     bounds[5] = gs->d.upper_bounds[2] - ghost_range;
 
+  } else if (gs->d.balance)
+  {
+    /* balanced bounds of the local process were determined in fcs_gridsort_sort_forward */
+    if (comm_rank == 0 && ghost_range > gs->d.balance_min_width)
+      fprintf(stderr, "WARNING: ghost_range (%" FCS_LMOD_FLOAT "f) is larger than the min. width of the balanced process domains (%" FCS_LMOD_FLOAT "f), ghost particles may be missing\n", ghost_range, gs->d.balance_min_width);
+
+    bounds[0] = gs->sub_box_base[0] + ghost_range;
+    bounds[1] = gs->sub_box_base[0] + gs->sub_box_a[0] - ghost_range;
+    bounds[2] = gs->sub_box_base[1] + ghost_range;
+    bounds[3] = gs->sub_box_base[1] + gs->sub_box_b[1] - ghost_range;
+    bounds[4] = gs->sub_box_base[2] + ghost_range;
+    bounds[5] = gs->sub_box_base[2] + gs->sub_box_c[2] - ghost_range;
+
   } else
   {
     bounds[0] = gs->d.box_base[0] + (gs->d.box_a[0] *  cart_coords[0]      / cart_dims[0]) + ghost_range;
@@ -1554,11 +1820,13 @@ fcs_int fcs_gridsort_create_ghosts(fcs_gridsort_t *gs, fcs_float ghost_range, MP
     fcs_forw_elements_realloc(&s, fcs_forw_elem_get_size(&s) + rcounts[0] + rcounts[1], SLCM_ALL);
 
     forw_sendrecv(&s, scounts[0], displs[1], neighbors[2 * d + 0], &s, rcounts[0], s.size, neighbors[2 * d + 1], comm, &received);
-    if (periodic[2 * d + 1]) set_periodics(&s, rcounts[0], s.size, 2 * d + 0); else set_ghosts(&s, rcounts[0], s.size);
+    if (gs->ghost_origins) set_ghost_origins(&s, rcounts[0], s.size, (periodic[2 * d + 1])?&shifts[3 * (2 * d + 0)]:NULL);
+    else if (periodic[2 * d + 1]) set_periodics(&s, rcounts[0], s.size, 2 * d + 0); else set_ghosts(&s, rcounts[0], s.size);
     s.size += rcounts[0];
 
     forw_sendrecv(&s, scounts[1], displs[2], neighbors[2 * d + 1], &s, rcounts[1], s.size, neighbors[2 * d + 0], comm, &received);
-    if (periodic[2 * d + 0]) set_periodics(&s, rcounts[1], s.size, 2 * d + 1); else set_ghosts(&s, rcounts[1], s.size);
+    if (gs->ghost_origins) set_ghost_origins(&s, rcounts[1], s.size, (periodic[2 * d + 0])?&shifts[3 * (2 * d + 1)]:NULL);
+    else if (periodic[2 * d + 0]) set_periodics(&s, rcounts[1], s.size, 2 * d + 1); else set_ghosts(&s, rcounts[1], s.size);
     s.size += rcounts[1];
   }
 
@@ -1571,6 +1839,7 @@ fcs_int fcs_gridsort_create_ghosts(fcs_gridsort_t *gs, fcs_float ghost_range, MP
   gs->sorted_charges = s.data1;
 
   gs->nsorted_real_particles = s.size;
+  gs->nsorted_ghost_particles = 0;
 
   return 0;
 }
@@ -1921,7 +2190,7 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 {
   int comm_size, comm_rank;
 
-  fcs_int i, j, type;
+  fcs_int i, j, type, nresults, with_ghosts;
 
   fcs_back_fp_elements_t sin0, sout0;
   fcs_back_f__elements_t sin1, sout1;
@@ -1952,6 +2221,21 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
   else if (!gs->original_field && gs->original_potentials) type = 2;
   else type = 3;
 
+  /* results of ghost particles are added to the results of their original particles */
+  with_ghosts = (gs->ghost_origins && gs->nsorted_ghost_particles > 0 && gs->max_nsorted_results >= gs->nsorted_real_particles + gs->nsorted_ghost_particles);
+
+  nresults = gs->nsorted_real_particles;
+
+  if (with_ghosts)
+  {
+    nresults += gs->nsorted_ghost_particles;
+
+    for (i = gs->nsorted_real_particles; i < nresults; ++i) gs->sorted_indices[i] = GRIDSORT_GHOST_ORIGIN(gs->sorted_indices[i]);
+  }
+
+  if (gs->original_field) for (i = 0; i < 3 * gs->noriginal_particles; ++i) gs->original_field[i] = 0;
+  if (gs->original_potentials) for (i = 0; i < gs->noriginal_particles; ++i) gs->original_potentials[i] = 0;
+
   switch (type)
   {
     case 0:
@@ -1959,8 +2243,8 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back_fp_mpi_datatypes_init();
 
-      fcs_back_fp_elem_set_size(&sin0, gs->nsorted_real_particles);
-      fcs_back_fp_elem_set_max_size(&sin0, gs->nsorted_real_particles);
+      fcs_back_fp_elem_set_size(&sin0, nresults);
+      fcs_back_fp_elem_set_max_size(&sin0, nresults);
       fcs_back_fp_elem_set_keys(&sin0, gs->sorted_indices);
       fcs_back_fp_elem_set_data(&sin0, gs->sorted_field, gs->sorted_potentials);
 
@@ -1969,7 +2253,8 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
       fcs_back_fp_tproc_create_tproc(&tproc0, gridsort_back_fp_tproc, fcs_back_fp_TPROC_RESET_NULL, fcs_back_fp_TPROC_EXDEF_NULL);
 
 #ifdef GRIDSORT_BACK_PROCLIST
-      if (gs->procs) fcs_back_fp_tproc_set_proclists(tproc0, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
+      /* ghost particles can originate from processes outside the process lists */
+      if (gs->procs && !with_ghosts) fcs_back_fp_tproc_set_proclists(tproc0, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
 #endif
 
 #ifdef ALLTOALLV_PACKED
@@ -1988,18 +2273,18 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back_fp_tproc_free(&tproc0);
 
-      if (gs->noriginal_particles != sout0.size)
+      if ((!with_ghosts && gs->noriginal_particles != sout0.size) || gs->noriginal_particles > sout0.size)
         fprintf(stderr, "%d: error: wanted %" FCS_LMOD_INT "d particles, but got %" fcs_back_fp_slint_fmt "!\n", comm_rank, gs->noriginal_particles, sout0.size);
 
       for (i = 0; i < sout0.size; ++i)
       {
         j = sout0.keys[i] & index_mask;
 
-        gs->original_field[3 * j + 0] = sout0.data0[3 * i + 0];
-        gs->original_field[3 * j + 1] = sout0.data0[3 * i + 1];
-        gs->original_field[3 * j + 2] = sout0.data0[3 * i + 2];
+        gs->original_field[3 * j + 0] += sout0.data0[3 * i + 0];
+        gs->original_field[3 * j + 1] += sout0.data0[3 * i + 1];
+        gs->original_field[3 * j + 2] += sout0.data0[3 * i + 2];
 
-        gs->original_potentials[j] = sout0.data1[i];
+        gs->original_potentials[j] += sout0.data1[i];
       }
 
       fcs_back_fp_elements_free(&sout0);
@@ -2013,8 +2298,8 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back_f__mpi_datatypes_init();
 
-      fcs_back_f__elem_set_size(&sin1, gs->nsorted_real_particles);
-      fcs_back_f__elem_set_max_size(&sin1, gs->nsorted_real_particles);
+      fcs_back_f__elem_set_size(&sin1, nresults);
+      fcs_back_f__elem_set_max_size(&sin1, nresults);
       fcs_back_f__elem_set_keys(&sin1, gs->sorted_indices);
       fcs_back_f__elem_set_data(&sin1, gs->sorted_field);
 
@@ -2023,7 +2308,7 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
       fcs_back_f__tproc_create_tproc(&tproc1, gridsort_back_f__tproc, fcs_back_f__TPROC_RESET_NULL, fcs_back_f__TPROC_EXDEF_NULL);
 
 #ifdef GRIDSORT_BACK_PROCLIST
-      if (gs->procs) fcs_back_f__tproc_set_proclists(tproc1, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
+      if (gs->procs && !with_ghosts) fcs_back_f__tproc_set_proclists(tproc1, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
 #endif
 
 #ifdef ALLTOALLV_PACKED
@@ -2042,16 +2327,16 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back_f__tproc_free(&tproc1);
 
-      if (gs->noriginal_particles != sout1.size)
+      if ((!with_ghosts && gs->noriginal_particles != sout1.size) || gs->noriginal_particles > sout1.size)
         fprintf(stderr, "%d: error: wanted %" FCS_LMOD_INT "d particles, but got %" fcs_back_f__slint_fmt "!\n", comm_rank, gs->noriginal_particles, sout1.size);
 
       for (i = 0; i < sout1.size; ++i)
       {
         j = sout1.keys[i] & index_mask;
      
-        gs->original_field[3 * j + 0] = sout1.data0[3 * i + 0];
-        gs->original_field[3 * j + 1] = sout1.data0[3 * i + 1];
-        gs->original_field[3 * j + 2] = sout1.data0[3 * i + 2];
+        gs->original_field[3 * j + 0] += sout1.data0[3 * i + 0];
+        gs->original_field[3 * j + 1] += sout1.data0[3 * i + 1];
+        gs->original_field[3 * j + 2] += sout1.data0[3 * i + 2];
       }
 
       fcs_back_f__elements_free(&sout1);
@@ -2065,8 +2350,8 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back__p_mpi_datatypes_init();
 
-      fcs_back__p_elem_set_size(&sin2, gs->nsorted_real_particles);
-      fcs_back__p_elem_set_max_size(&sin2, gs->nsorted_real_particles);
+      fcs_back__p_elem_set_size(&sin2, nresults);
+      fcs_back__p_elem_set_max_size(&sin2, nresults);
       fcs_back__p_elem_set_keys(&sin2, gs->sorted_indices);
       fcs_back__p_elem_set_data(&sin2, gs->sorted_potentials);
 
@@ -2075,7 +2360,7 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
       fcs_back__p_tproc_create_tproc(&tproc2, gridsort_back__p_tproc, fcs_back__p_TPROC_RESET_NULL, fcs_back__p_TPROC_EXDEF_NULL);
 
 #ifdef GRIDSORT_BACK_PROCLIST
-      if (gs->procs) fcs_back__p_tproc_set_proclists(tproc2, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
+      if (gs->procs && !with_ghosts) fcs_back__p_tproc_set_proclists(tproc2, gs->nprocs, gs->procs, gs->nprocs, gs->procs, comm_size, comm_rank, comm);
 #endif
 
 #ifdef ALLTOALLV_PACKED
@@ -2094,14 +2379,14 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
 
       fcs_back__p_tproc_free(&tproc2);
 
-      if (gs->noriginal_particles != sout2.size)
+      if ((!with_ghosts && gs->noriginal_particles != sout2.size) || gs->noriginal_particles > sout2.size)
         fprintf(stderr, "%d: error: wanted %" FCS_LMOD_INT "d particles, but got only %" fcs_back__p_slint_fmt "!\n", comm_rank, gs->noriginal_particles, sout2.size);
 
       for (i = 0; i < sout2.size; ++i)
       {
         j = sout2.keys[i] & index_mask;
 
-        gs->original_potentials[j] = sout2.data1[i];
+        gs->original_potentials[j] += sout2.data1[i];
       }
 
       fcs_back__p_elements_free(&sout2);
@@ -2111,6 +2396,9 @@ fcs_int fcs_gridsort_sort_backward(fcs_gridsort_t *gs, MPI_Comm comm)
       break;
   }
 
+  if (with_ghosts)
+    for (i = gs->nsorted_real_particles; i < nresults; ++i) gs->sorted_indices[i] |= GRIDSORT_GHOST_BASE;
+
   TIMING_SYNC(comm); TIMING_STOP(t[0]);
 
   TIMING_CMD(
@@ -46,6 +46,9 @@ typedef struct _fcs_gridsort_data_t
 
   fcs_float lower_bounds[3], upper_bounds[3];
 
+  fcs_int balance;
+  fcs_float balance_min_width;
+
   fcs_float *bounds;
 
 } *fcs_gridsort_cache_t;
@@ -82,7 +85,10 @@ typedef struct _fcs_gridsort_t
 
   fcs_int nresort_particles;
 
+  fcs_float *balance_weights;
+
   fcs_float max_particle_move;
+  fcs_int ghost_origins;
   fcs_int nprocs;
   int *procs;
 
@@ -96,6 +102,7 @@ typedef struct _fcs_gridsort_t
 #define GRIDSORT_GHOST_BASE              0x8000000000000000LL
 
 #define GRIDSORT_IS_GHOST(_x_)           ((_x_) < 0)
+#define GRIDSORT_GHOST_ORIGIN(_x_)       ((_x_) & ~GRIDSORT_GHOST_BASE)
 
 #define GRIDSORT_PERIODIC_BITS           10
 #define GRIDSORT_PERIODIC_CONST(_v_)     (_v_##LL)
@@ -138,6 +145,17 @@ void fcs_gridsort_set_system(fcs_gridsort_t *gs, const fcs_float *box_base, cons
  */
 void fcs_gridsort_set_bounds(fcs_gridsort_t *gs, fcs_float *lower_bounds, fcs_float *upper_bounds);
 
+/**
+ * @brief set load balancing of the process domains, i.e., the bounds of the processes along each dimension are chosen such that the (weighted) particles
+ * are distributed equally across the process rows, balanced bounds are kept in the gridsort cache and reused as long as the load imbalance stays low
+ * (lower and upper bounds as well as zslices take precedence over the load balancing)
+ * @param gs fcs_gridsort_t* gridsort object
+ * @param balance fcs_int whether to balance the bounds of the processes (default: 0, i.e., regular subdivision of the system box)
+ * @param weights fcs_float* array of weights (e.g., measured work) of the local particles (NULL for equal weights)
+ * @param min_width fcs_float min. width of the process domains (e.g., the ghost range used with fcs_gridsort_create_ghosts)
+ */
+void fcs_gridsort_set_balance(fcs_gridsort_t *gs, fcs_int balance, fcs_float *weights, fcs_float min_width);
+
 /**
  * @brief set number of zslices per process and the number of ghost zslices
  * @param gs fcs_gridsort_t* gridsort object
@@ -181,6 +199,15 @@ void fcs_gridsort_set_particles(fcs_gridsort_t *gs, fcs_int nparticles, fcs_int
  */
 void fcs_gridsort_set_max_particle_move(fcs_gridsort_t *gs, fcs_float max_particle_move);
 
+/**
+ * @brief set whether ghost particles created with fcs_gridsort_create_ghosts keep the indices of their original particles (see GRIDSORT_GHOST_ORIGIN),
+ * the positions of ghost particles created at periodic boundaries are then already unfolded (i.e., fcs_gridsort_unfold_periodic_particles must not be used)
+ * and results of ghost particles are added to the results of their original particles in fcs_gridsort_sort_backward
+ * @param gs fcs_gridsort_t* gridsort object
+ * @param ghost_origins fcs_int whether ghost particles keep the indices of their original particles
+ */
+void fcs_gridsort_set_ghost_origins(fcs_gridsort_t *gs, fcs_int ghost_origins);
+
 /**
  * @brief get information of sorted particles
  * @param gs fcs_gridsort_t* gridsort object
@@ -275,7 +302,8 @@ fcs_int fcs_gridsort_sort_random(fcs_gridsort_t *gs, MPI_Comm comm);
 void fcs_gridsort_unfold_periodic_particles(fcs_int nparticles, fcs_gridsort_index_t *indices, fcs_float *positions, fcs_float *box_a, fcs_float *box_b, fcs_float *box_c);
 
 /**
- * @brief set information of results to sort back
+ * @brief set information of results to sort back (if ghost particles keep the indices of their original particles and max_nresults covers all sorted particles,
+ * then the arrays contain the results of the real particles followed by the results of the ghost particles)
  * @param gs fcs_gridsort_t* gridsort object
  * @param max_nparticles fcs_int max number of results that can be stored in local result data arrays
  * @param field fcs_float* array of field values (can be NULL)
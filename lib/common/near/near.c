@@ -28,6 +28,10 @@
 
 #include <mpi.h>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
 #include "common/fcs-common/FCSCommon.h"
 
 #include "common/gridsort/gridsort.h"
@@ -90,6 +94,11 @@
 #define TIMING_START(_t_)          TIMING_CMD(((_t_) = MPI_Wtime());)
 #define TIMING_STOP(_t_)           TIMING_CMD(((_t_) = MPI_Wtime() - (_t_));)
 #define TIMING_STOP_ADD(_t_, _r_)  TIMING_CMD(((_r_) += MPI_Wtime() - (_t_));)
+#ifdef DO_TIMING
+# define TIMING_ARG(_t_)           (_t_)
+#else
+# define TIMING_ARG(_t_)           NULL
+#endif
 
 
 typedef long long box_t;
@@ -232,6 +241,8 @@ void fcs_near_create(fcs_near_t *near)
   near->compute_potential_3diff = NULL;
   near->compute_field_potential_3diff = NULL;
 
+  near->compute_field_potential_batch = NULL;
+
   near->compute_loop = NULL;
 
   near->box_base[0] = near->box_base[1] = near->box_base[2] = 0;
@@ -251,16 +262,40 @@ void fcs_near_create(fcs_near_t *near)
   near->ghost_positions = NULL;
   near->ghost_charges = NULL;
   near->ghost_indices = NULL;
+  near->ghost_field = NULL;
+  near->ghost_potentials = NULL;
 
   near->max_particle_move = -1;
 
   near->resort = 0;
   near->gridsort_resort = FCS_GRIDSORT_RESORT_NULL;
+
+  near->balance = 0;
+  near->gridsort_cache = NULL;
+
+  near->verlet = FCS_NEAR_VERLET_NULL;
+
+  near->step_active = 0;
+  near->step_next = near->step_end = 0;
+  near->step_cutoff = 0;
+  near->step_param = NULL;
+  near->step_comm = MPI_COMM_NULL;
+  near->step_verlet = FCS_NEAR_VERLET_NULL;
+  near->step_real_boxes = near->step_ghost_boxes = NULL;
+  near->step_ghost_field = near->step_ghost_potentials = NULL;
 }
 
 
 void fcs_near_destroy(fcs_near_t *near)
 {
+  if (near->step_active)
+  {
+    if (near->step_real_boxes) free(near->step_real_boxes);
+    if (near->step_ghost_boxes) free(near->step_ghost_boxes);
+    near->step_real_boxes = near->step_ghost_boxes = NULL;
+    near->step_active = 0;
+  }
+
   near->compute_field = NULL;
   near->compute_potential = NULL;
   near->compute_field_potential = NULL;
@@ -269,6 +304,8 @@ void fcs_near_destroy(fcs_near_t *near)
   near->compute_potential_3diff = NULL;
   near->compute_field_potential_3diff = NULL;
 
+  near->compute_field_potential_batch = NULL;
+
   near->compute_loop = NULL;
 
   near->box_base[0] = near->box_base[1] = near->box_base[2] = 0;
@@ -288,8 +325,12 @@ void fcs_near_destroy(fcs_near_t *near)
   near->ghost_positions = NULL;
   near->ghost_charges = NULL;
   near->ghost_indices = NULL;
+  near->ghost_field = NULL;
+  near->ghost_potentials = NULL;
 
   fcs_gridsort_resort_destroy(&near->gridsort_resort);
+
+  near->verlet = FCS_NEAR_VERLET_NULL;
 }
 
 
@@ -329,6 +370,12 @@ void fcs_near_set_field_potential_3diff(fcs_near_t *near, fcs_near_field_potenti
 }
 
 
+void fcs_near_set_field_potential_batch(fcs_near_t *near, fcs_near_field_potential_batch_f compute_field_potential_batch)
+{
+  near->compute_field_potential_batch = compute_field_potential_batch;
+}
+
+
 void fcs_near_set_loop(fcs_near_t *near, fcs_near_loop_f compute_loop)
 {
   near->compute_loop = compute_loop;
@@ -373,6 +420,13 @@ void fcs_near_set_ghosts(fcs_near_t *near, fcs_int nghosts, fcs_float *positions
 }
 
 
+void fcs_near_set_ghost_results(fcs_near_t *near, fcs_float *field, fcs_float *potentials)
+{
+  near->ghost_field = field;
+  near->ghost_potentials = potentials;
+}
+
+
 void fcs_near_set_max_particle_move(fcs_near_t *near, fcs_float max_particle_move)
 {
   near->max_particle_move = max_particle_move;
@@ -385,6 +439,19 @@ void fcs_near_set_resort(fcs_near_t *near, fcs_int resort)
 }
 
 
+void fcs_near_set_balance(fcs_near_t *near, fcs_int balance, fcs_gridsort_cache_t *gridsort_cache)
+{
+  near->balance = balance;
+  near->gridsort_cache = gridsort_cache;
+}
+
+
+void fcs_near_set_verlet(fcs_near_t *near, fcs_near_verlet_t verlet)
+{
+  near->verlet = verlet;
+}
+
+
 #ifdef PRINT_PARTICLES
 static void print_particles(fcs_int n, fcs_float *xyz, int size, int rank, MPI_Comm comm)
 {
@@ -612,8 +679,155 @@ static void find_neighbours(fcs_int nneighbours, fcs_int *neighbours, box_t *box
 }
 
 
+/* number of particles staged in a structure-of-arrays tile for batch computations */
+#define BATCH_SIZE  64
+
+/* select the process that computes the interaction between a real particle and a ghost particle (dx, dy, dz is the distance vector from the real to the ghost particle),
+   the interaction is computed either by the process of the real particle or by the process of the original particle of the ghost particle */
+static int ghost_pair_selected(fcs_gridsort_index_t real_index, fcs_gridsort_index_t ghost_origin, fcs_float dx, fcs_float dy, fcs_float dz)
+{
+  /* periodic image of the particle itself, only one of the two opposite images is computed */
+  if (real_index == ghost_origin) return (dz > 0 || (dz == 0 && (dy > 0 || (dy == 0 && dx > 0))));
+
+  /* alternate between the lower and the higher index to balance the interactions between the processes */
+  return ((real_index ^ ghost_origin) & 1)?(real_index < ghost_origin):(real_index > ghost_origin);
+}
+
+static void compute_near_batch(fcs_float *positions0, fcs_float *charges0, fcs_float *field0, fcs_float *potentials0, fcs_int start0, fcs_int size0,
+                               fcs_float *positions1, fcs_float *charges1, fcs_float *field1, fcs_float *potentials1, fcs_int start1, fcs_int size1, fcs_float cutoff, fcs_near_t *near, const void *near_param)
+{
+  fcs_int i, j, k, k0, l, n, first1, n1, real, once;
+  fcs_float x1[BATCH_SIZE], y1[BATCH_SIZE], z1[BATCH_SIZE], q1[BATCH_SIZE];
+  fcs_gridsort_index_t o1[BATCH_SIZE], oi;
+  fcs_float dx[BATCH_SIZE], dy[BATCH_SIZE], dz[BATCH_SIZE], r2[BATCH_SIZE];
+  fcs_float dist[BATCH_SIZE], f[BATCH_SIZE], p[BATCH_SIZE];
+  fcs_int idx[BATCH_SIZE];
+  fcs_float xi, yi, zi, qi, fx, fi[3], pi, cutoff2;
+
+
+  real = (positions1 == NULL || charges1 == NULL);
+
+  /* interactions with ghost particles are computed only once if the results of the ghost particles are required */
+  once = (!real && (field1 || potentials1));
+
+  cutoff2 = cutoff * cutoff;
+
+  if (real)
+  {
+    positions1 = positions0;
+    charges1 = charges0;
+    field1 = field0;
+    potentials1 = potentials0;
+  }
+
+  for (first1 = start1; first1 < start1 + size1; first1 += BATCH_SIZE)
+  {
+    n1 = z_min(BATCH_SIZE, start1 + size1 - first1);
+
+    /* stage the tile of particles (unused entries are set to zero so that the distances can be computed for the whole tile) */
+    for (k = 0; k < n1; ++k)
+    {
+      x1[k] = positions1[3 * (first1 + k) + 0];
+      y1[k] = positions1[3 * (first1 + k) + 1];
+      z1[k] = positions1[3 * (first1 + k) + 2];
+      q1[k] = charges1[first1 + k];
+    }
+    for (; k < BATCH_SIZE; ++k) x1[k] = y1[k] = z1[k] = q1[k] = 0;
+
+    if (once)
+      for (k = 0; k < n1; ++k) o1[k] = GRIDSORT_GHOST_ORIGIN(near->ghost_indices[first1 + k]);
+
+    for (i = start0; i < start0 + size0; ++i)
+    {
+      /* pairs of real particles within the same box are computed only once */
+      k0 = (real && start0 == start1)?z_max(0, i + 1 - first1):0;
+
+      if (k0 >= n1) continue;
+
+      xi = positions0[3 * i + 0];
+      yi = positions0[3 * i + 1];
+      zi = positions0[3 * i + 2];
+      qi = charges0[i];
+
+      /* fixed trip count for vectorization */
+      for (k = 0; k < BATCH_SIZE; ++k)
+      {
+        dx[k] = x1[k] - xi;
+        dy[k] = y1[k] - yi;
+        dz[k] = z1[k] - zi;
+        r2[k] = dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k];
+      }
+
+      n = 0;
+      if (once)
+      {
+        oi = near->indices[i];
+        for (k = k0; k < n1; ++k)
+        if (r2[k] <= cutoff2 && ghost_pair_selected(oi, o1[k], dx[k], dy[k], dz[k]))
+        {
+          idx[n] = k;
+          dist[n] = fcs_sqrt(r2[k]);
+          ++n;
+        }
+
+      } else
+      {
+        for (k = k0; k < n1; ++k)
+        if (r2[k] <= cutoff2)
+        {
+          idx[n] = k;
+          dist[n] = fcs_sqrt(r2[k]);
+          ++n;
+        }
+      }
+
+      if (n == 0) continue;
+
+      near->compute_field_potential_batch(near_param, n, dist, f, p);
+
+      if (field0)
+      {
+        fi[0] = fi[1] = fi[2] = 0;
+        for (l = 0; l < n; ++l)
+        {
+          k = idx[l];
+          fx = f[l] / dist[l];
+          fi[0] += fx * q1[k] * dx[k];
+          fi[1] += fx * q1[k] * dy[k];
+          fi[2] += fx * q1[k] * dz[k];
+
+          if (field1)
+          {
+            j = first1 + k;
+            field1[3 * j + 0] -= fx * qi * dx[k];
+            field1[3 * j + 1] -= fx * qi * dy[k];
+            field1[3 * j + 2] -= fx * qi * dz[k];
+          }
+        }
+        field0[3 * i + 0] += fi[0];
+        field0[3 * i + 1] += fi[1];
+        field0[3 * i + 2] += fi[2];
+      }
+
+      if (potentials0)
+      {
+        pi = 0;
+        for (l = 0; l < n; ++l)
+        {
+          k = idx[l];
+          pi += p[l] * q1[k];
+
+          if (potentials1) potentials1[first1 + k] += p[l] * qi;
+        }
+        potentials0[i] += pi;
+      }
+    }
+  }
+}
+
+
 static void compute_near(fcs_float *positions0, fcs_float *charges0, fcs_float *field0, fcs_float *potentials0, fcs_int start0, fcs_int size0,
-                         fcs_float *positions1, fcs_float *charges1, fcs_int start1, fcs_int size1, fcs_float cutoff, fcs_near_t *near, const void *near_param)
+                         fcs_float *positions1, fcs_float *charges1, fcs_float *field1, fcs_float *potentials1, fcs_int start1, fcs_int size1, fcs_float cutoff, fcs_near_t *near, const void *near_param)
 {
   FCS_NEAR_LOOP_HEAD();
 
@@ -624,6 +838,12 @@ static void compute_near(fcs_float *positions0, fcs_float *charges0, fcs_float *
     return;
   }
 
+  if (near->compute_field_potential_batch)
+  {
+    compute_near_batch(positions0, charges0, field0, potentials0, start0, size0, positions1, charges1, field1, potentials1, start1, size1, cutoff, near, near_param);
+    return;
+  }
+
 /*  printf("compute: %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d vs. %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d\n", start0, size0, start1, size1);*/
 
   if (near->compute_field_potential)
@@ -671,25 +891,740 @@ static void compute_near(fcs_float *positions0, fcs_float *charges0, fcs_float *
 }
 
 
-fcs_int fcs_near_compute(fcs_near_t *near,
-                         fcs_float cutoff,
-                         const void *compute_param,
-                         MPI_Comm comm)
+static void compute_boxes(fcs_near_t *near, box_t *real_boxes, box_t *ghost_boxes, fcs_int first, fcs_int last, fcs_float *field, fcs_float *potentials, fcs_float *ghost_field, fcs_float *ghost_potentials,
+                          fcs_float cutoff, const void *compute_param, double *t)
 {
-  int comm_size, comm_rank;
+  fcs_int i;
+
+  box_t current_box;
+  const fcs_int max_nboxes = 27;
+  fcs_int current_last, current_start, current_size;
+  fcs_int real_lasts[max_nboxes], real_starts[max_nboxes], real_sizes[max_nboxes];
+  fcs_int ghost_lasts[max_nboxes], ghost_starts[max_nboxes], ghost_sizes[max_nboxes];
+  fcs_int ghost_first;
+
+  TIMING_DECL(double _t;)
+
+
+  if (first >= last) return;
+
+  /* start the neighbour searches close to the first box (the searches can go backward and forward) */
+  ghost_first = 0;
+  if (ghost_boxes) find_box(ghost_boxes, near->nghosts, real_boxes[first], 0, &ghost_first, &current_size);
+
+  current_last = first;
+  for (i = 0; i < max_nboxes; ++i)
+  {
+    real_lasts[i] = first;
+    ghost_lasts[i] = ghost_first;
+  }
+
+  do
+  {
+    current_box = real_boxes[current_last];
+
+    TIMING_START(_t);
+    find_box(real_boxes, near->nparticles, current_box, current_last, &current_start, &current_size);
+    TIMING_STOP_ADD(_t, t[4]);
+
+/*    printf("box: " box_fmt ", start: %" FCS_LMOD_INT "d, size: %" FCS_LMOD_INT "d\n",
+      box_val(current_box), current_start, current_size);*/
+
+    TIMING_START(_t);
+    find_neighbours(nreal_neighbours, real_neighbours, real_boxes, near->nparticles, current_box, real_lasts, real_starts, real_sizes);
+    if (ghost_boxes) find_neighbours(nghost_neighbours, ghost_neighbours, ghost_boxes, near->nghosts, current_box, ghost_lasts, ghost_starts, ghost_sizes);
+    TIMING_STOP_ADD(_t, t[5]);
+
+    TIMING_START(_t);
+    compute_near(near->positions, near->charges, field, potentials, current_start, current_size, NULL, NULL, NULL, NULL, current_start, current_size, cutoff, near, compute_param);
+    for (i = 0; i < nreal_neighbours; ++i)
+    {
+/*      printf("  real-neighbour %" FCS_LMOD_INT "d: %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d\n", i, current_starts[i], current_sizes[i]);*/
+
+      compute_near(near->positions, near->charges, field, potentials, current_start, current_size, NULL, NULL, NULL, NULL, real_starts[i], real_sizes[i], cutoff, near, compute_param);
+
+      real_lasts[i] = real_starts[i] + real_sizes[i];
+    }
+
+    if (ghost_boxes)
+    for (i = 0; i < nghost_neighbours; ++i)
+    {
+/*      printf("  ghost-neighbour %" FCS_LMOD_INT "d: %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d\n", i, ghost_starts[i], ghost_sizes[i]);*/
+
+      compute_near(near->positions, near->charges, field, potentials, current_start, current_size, near->ghost_positions, near->ghost_charges, ghost_field, ghost_potentials, ghost_starts[i], ghost_sizes[i], cutoff, near, compute_param);
 
+      ghost_lasts[i] = ghost_starts[i] + ghost_sizes[i];
+    }
+    current_last = current_start + current_size;
+    TIMING_STOP_ADD(_t, t[6]);
+
+  } while (current_last < last);
+}
+
+
+static fcs_int verlet_check_particles(fcs_near_verlet_t verlet, fcs_near_t *near, fcs_float cutoff, fcs_int ghost_once)
+{
   fcs_int i;
 
+
+  if (verlet->nlists < 0 || verlet->nparticles != near->nparticles || verlet->cutoff != cutoff || verlet->ghost_once != ghost_once) return 0;
+
+  for (i = 0; i < 3; ++i)
+  if (verlet->box_a[i] != near->box_a[i] || verlet->box_b[i] != near->box_b[i] || verlet->box_c[i] != near->box_c[i]) return 0;
+
+  /* the ghost particles may change between the rebuilds (see verlet_map_ghosts) */
+  for (i = 0; i < near->nparticles; ++i)
+  if (verlet->indices[i] != near->indices[i]) return 0;
+
+  return 1;
+}
+
+
+static void verlet_set_particles(fcs_near_verlet_t verlet, fcs_near_t *near, fcs_float cutoff, fcs_int ghost_once)
+{
+  fcs_int i;
+
+
+  verlet->nparticles = near->nparticles;
+  verlet->ghost_once = ghost_once;
+  verlet->cutoff = cutoff;
+
+  for (i = 0; i < 3; ++i)
+  {
+    verlet->box_a[i] = near->box_a[i];
+    verlet->box_b[i] = near->box_b[i];
+    verlet->box_c[i] = near->box_c[i];
+  }
+
+  verlet->indices = realloc(verlet->indices, near->nparticles * sizeof(fcs_gridsort_index_t));
+
+  for (i = 0; i < near->nparticles; ++i) verlet->indices[i] = near->indices[i];
+
+  verlet->list_particles = realloc(verlet->list_particles, near->nparticles * sizeof(fcs_int));
+  verlet->list_starts = realloc(verlet->list_starts, (near->nparticles + 1) * sizeof(fcs_int));
+
+  /* force a rebuild */
+  verlet->nlists = -1;
+}
+
+
+static fcs_float verlet_max_displacement(fcs_near_verlet_t verlet, fcs_near_t *near)
+{
+  fcs_int i;
+  fcs_float *p0, d[3], d2, max_d2;
+
+
+  max_d2 = 0;
+
+  /* the ghost particles are real particles of other processes, their displacements are determined there */
+  p0 = verlet->positions;
+  for (i = 0; i < near->nparticles; ++i)
+  {
+    d[0] = near->positions[3 * i + 0] - p0[3 * i + 0];
+    d[1] = near->positions[3 * i + 1] - p0[3 * i + 1];
+    d[2] = near->positions[3 * i + 2] - p0[3 * i + 2];
+    d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    if (d2 > max_d2) max_d2 = d2;
+  }
+
+  return fcs_sqrt(max_d2);
+}
+
+
+typedef struct
+{
+  fcs_gridsort_index_t index;
+  fcs_int i;
+
+} verlet_key_t;
+
+
+static int verlet_key_cmp(const void *a, const void *b)
+{
+  const verlet_key_t *ka = a, *kb = b;
+
+  if (ka->index != kb->index) return (ka->index < kb->index)?-1:1;
+
+  return (ka->i < kb->i)?-1:((ka->i > kb->i)?1:0);
+}
+
+
+static verlet_key_t *verlet_sort_keys(fcs_int n, fcs_gridsort_index_t *indices)
+{
+  fcs_int i;
+  verlet_key_t *keys;
+
+
+  keys = malloc((n + 1) * sizeof(verlet_key_t));
+
+  for (i = 0; i < n; ++i)
+  {
+    keys[i].index = indices[i];
+    keys[i].i = i;
+  }
+
+  qsort(keys, n, sizeof(verlet_key_t), verlet_key_cmp);
+
+  return keys;
+}
+
+
+/* find the ghost particles of the last rebuild among the current ghost particles, the ghost particles are identified by the indices of their original particles,
+   the periodic images of the same particle are distinguished by their positions (the ghost particles of the last rebuild that are missing now are out of range) */
+static void verlet_map_ghosts(fcs_near_verlet_t verlet, fcs_near_t *near)
+{
+  fcs_int i, j, k, l, jl, jh, kl, kh, best;
+  fcs_float *p0, *p1, d[3], d2, best_d2, max_d2;
+  verlet_key_t *keys0, *keys1;
+
+
+  for (j = 0; j < verlet->nghosts; ++j) verlet->ghost_map[j] = -1;
+
+  if (verlet->nghosts == 0 || near->nghosts == 0) return;
+
+  keys0 = malloc(verlet->nghosts * sizeof(verlet_key_t));
+  for (j = 0; j < verlet->nghosts; ++j)
+  {
+    keys0[j].i = verlet->ghost_order[j];
+    keys0[j].index = verlet->indices[verlet->nparticles + keys0[j].i];
+  }
+
+  keys1 = verlet_sort_keys(near->nghosts, near->ghost_indices);
+
+  p0 = verlet->positions + 3 * verlet->nparticles;
+  p1 = near->ghost_positions;
+
+  /* matching images moved at most the skin (otherwise the lists are rebuilt anyway) */
+  max_d2 = verlet->skin * verlet->skin;
+
+  jl = kl = 0;
+  while (jl < verlet->nghosts && kl < near->nghosts)
+  {
+    if (keys0[jl].index < keys1[kl].index) { ++jl; continue; }
+    if (keys0[jl].index > keys1[kl].index) { ++kl; continue; }
+
+    for (jh = jl + 1; jh < verlet->nghosts && keys0[jh].index == keys0[jl].index; ++jh);
+    for (kh = kl + 1; kh < near->nghosts && keys1[kh].index == keys1[kl].index; ++kh);
+
+    for (j = jl; j < jh; ++j)
+    {
+      i = keys0[j].i;
+      best = -1;
+      best_d2 = max_d2;
+      for (k = kl; k < kh; ++k)
+      {
+        l = keys1[k].i;
+        d[0] = p1[3 * l + 0] - p0[3 * i + 0];
+        d[1] = p1[3 * l + 1] - p0[3 * i + 1];
+        d[2] = p1[3 * l + 2] - p0[3 * i + 2];
+        d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        if (d2 <= best_d2)
+        {
+          best = l;
+          best_d2 = d2;
+        }
+      }
+      verlet->ghost_map[i] = best;
+    }
+
+    jl = jh;
+    kl = kh;
+  }
+
+  free(keys0);
+  free(keys1);
+}
+
+
+static void verlet_add_neighbour(fcs_near_verlet_t verlet, fcs_int *nneighbours, fcs_int j)
+{
+  if (*nneighbours >= verlet->max_nneighbours)
+  {
+    verlet->max_nneighbours = z_max(2 * verlet->max_nneighbours, 1024);
+    verlet->neighbours = realloc(verlet->neighbours, verlet->max_nneighbours * sizeof(fcs_int));
+  }
+
+  verlet->neighbours[*nneighbours] = j;
+  ++(*nneighbours);
+}
+
+
+static void verlet_build(fcs_near_verlet_t verlet, fcs_near_t *near)
+{
+  fcs_int i, j, k, n, nghosts, nneighbours;
+  fcs_float range, range2, d[3];
+  const fcs_int no_periodicity[3] = { 0, 0, 0 };
+
   box_t *real_boxes, *ghost_boxes, current_box;
+  fcs_float *real_positions, *ghost_positions, *charges;
+  fcs_gridsort_index_t *real_order, *ghost_order;
+
   const fcs_int max_nboxes = 27;
   fcs_int current_last, current_start, current_size;
   fcs_int real_lasts[max_nboxes], real_starts[max_nboxes], real_sizes[max_nboxes];
   fcs_int ghost_lasts[max_nboxes], ghost_starts[max_nboxes], ghost_sizes[max_nboxes];
-  fcs_int periodicity[3];
+
+
+  n = near->nparticles;
+  nghosts = near->nghosts;
+
+  range = verlet->cutoff + verlet->skin;
+  range2 = range * range;
+
+  /* reference positions for the displacements (particles are already unfolded) and the ghost particles to find them again (see verlet_map_ghosts) */
+  verlet->nghosts = nghosts;
+
+  verlet->indices = realloc(verlet->indices, (n + nghosts) * sizeof(fcs_gridsort_index_t));
+  verlet->positions = realloc(verlet->positions, (n + nghosts) * 3 * sizeof(fcs_float));
+  verlet->ghost_order = realloc(verlet->ghost_order, (nghosts + 1) * sizeof(fcs_int));
+  verlet->ghost_map = realloc(verlet->ghost_map, (nghosts + 1) * sizeof(fcs_int));
+
+  for (i = 0; i < 3 * n; ++i) verlet->positions[i] = near->positions[i];
+  for (i = 0; i < 3 * nghosts; ++i) verlet->positions[3 * n + i] = near->ghost_positions[i];
+
+  for (i = 0; i < nghosts; ++i) verlet->indices[n + i] = near->ghost_indices[i];
+  for (i = 0; i < nghosts; ++i) verlet->ghost_map[i] = i;
+
+  if (nghosts > 0)
+  {
+    verlet_key_t *keys = verlet_sort_keys(nghosts, near->ghost_indices);
+    for (i = 0; i < nghosts; ++i) verlet->ghost_order[i] = keys[i].i;
+    free(keys);
+  }
+
+  verlet->displacement = 0;
+
+  /* the given particles are not rearranged, the boxes are determined for copies of the particles that keep their original order */
+  real_boxes = malloc((n + 1) * sizeof(box_t));
+  real_positions = malloc(n * 3 * sizeof(fcs_float));
+  real_order = malloc(n * sizeof(fcs_gridsort_index_t));
+  charges = malloc(z_max(n, nghosts) * sizeof(fcs_float));
+
+  for (i = 0; i < 3 * n; ++i) real_positions[i] = near->positions[i];
+  for (i = 0; i < n; ++i) real_order[i] = i;
+
+  create_boxes(n, real_boxes, real_positions, NULL, near->box_base, near->box_a, near->box_b, near->box_c, (fcs_int *) no_periodicity, range);
+  sort_into_boxes(n, real_boxes, real_positions, charges, real_order, NULL, NULL);
+
+  if (nghosts > 0)
+  {
+    ghost_boxes = malloc((nghosts + 1) * sizeof(box_t));
+    ghost_positions = malloc(nghosts * 3 * sizeof(fcs_float));
+    ghost_order = malloc(nghosts * sizeof(fcs_gridsort_index_t));
+
+    for (i = 0; i < 3 * nghosts; ++i) ghost_positions[i] = near->ghost_positions[i];
+    for (i = 0; i < nghosts; ++i) ghost_order[i] = i;
+
+    create_boxes(nghosts, ghost_boxes, ghost_positions, NULL, near->box_base, near->box_a, near->box_b, near->box_c, (fcs_int *) no_periodicity, range);
+    sort_into_boxes(nghosts, ghost_boxes, ghost_positions, charges, ghost_order, NULL, NULL);
+
+  } else
+  {
+    ghost_boxes = NULL;
+    ghost_positions = NULL;
+    ghost_order = NULL;
+  }
+
+#ifdef BOX_SKIP_FORMAT
+  make_boxes_skip_format(n, real_boxes);
+  if (ghost_boxes) make_boxes_skip_format(nghosts, ghost_boxes);
+#endif
+
+  /* one list per real particle (in the order of the boxes) with the real neighbours of the half shell and all ghost neighbours (indices >= n) */
+  verlet->nlists = 0;
+  nneighbours = 0;
+
+  current_last = 0;
+  for (i = 0; i < max_nboxes; ++i) real_lasts[i] = ghost_lasts[i] = 0;
+
+  while (current_last < n)
+  {
+    current_box = real_boxes[current_last];
+
+    find_box(real_boxes, n, current_box, current_last, &current_start, &current_size);
+
+    find_neighbours(nreal_neighbours, real_neighbours, real_boxes, n, current_box, real_lasts, real_starts, real_sizes);
+    if (ghost_boxes) find_neighbours(nghost_neighbours, ghost_neighbours, ghost_boxes, nghosts, current_box, ghost_lasts, ghost_starts, ghost_sizes);
+
+    for (i = current_start; i < current_start + current_size; ++i)
+    {
+      verlet->list_particles[verlet->nlists] = real_order[i];
+      verlet->list_starts[verlet->nlists] = nneighbours;
+      ++verlet->nlists;
+
+#define VERLET_DIST2(_p_, _j_)  (d[0] = (_p_)[3 * (_j_) + 0] - real_positions[3 * i + 0], \
+                                 d[1] = (_p_)[3 * (_j_) + 1] - real_positions[3 * i + 1], \
+                                 d[2] = (_p_)[3 * (_j_) + 2] - real_positions[3 * i + 2], \
+                                 d[0] * d[0] + d[1] * d[1] + d[2] * d[2])
+
+      for (j = i + 1; j < current_start + current_size; ++j)
+      if (VERLET_DIST2(real_positions, j) <= range2) verlet_add_neighbour(verlet, &nneighbours, real_order[j]);
+
+      for (k = 0; k < nreal_neighbours; ++k)
+      for (j = real_starts[k]; j < real_starts[k] + real_sizes[k]; ++j)
+      if (VERLET_DIST2(real_positions, j) <= range2) verlet_add_neighbour(verlet, &nneighbours, real_order[j]);
+
+      if (ghost_boxes)
+      for (k = 0; k < nghost_neighbours; ++k)
+      for (j = ghost_starts[k]; j < ghost_starts[k] + ghost_sizes[k]; ++j)
+      if (VERLET_DIST2(ghost_positions, j) <= range2
+        && (!verlet->ghost_once || ghost_pair_selected(near->indices[real_order[i]], GRIDSORT_GHOST_ORIGIN(near->ghost_indices[ghost_order[j]]), d[0], d[1], d[2])))
+        verlet_add_neighbour(verlet, &nneighbours, n + ghost_order[j]);
+
+#undef VERLET_DIST2
+    }
+
+    for (k = 0; k < nreal_neighbours; ++k) real_lasts[k] = real_starts[k] + real_sizes[k];
+    if (ghost_boxes)
+    for (k = 0; k < nghost_neighbours; ++k) ghost_lasts[k] = ghost_starts[k] + ghost_sizes[k];
+
+    current_last = current_start + current_size;
+  }
+
+  verlet->list_starts[verlet->nlists] = nneighbours;
+
+  free(real_boxes);
+  free(real_positions);
+  free(real_order);
+  free(charges);
+
+  if (ghost_boxes)
+  {
+    free(ghost_boxes);
+    free(ghost_positions);
+    free(ghost_order);
+  }
+}
+
+
+static void compute_verlet(fcs_near_t *near, fcs_near_verlet_t verlet, fcs_int first, fcs_int last, fcs_float *field, fcs_float *potentials, fcs_float *ghost_field, fcs_float *ghost_potentials,
+                           fcs_float cutoff, const void *near_param)
+{
+  fcs_int i, j, k, l, m, n, nreal, first1, n1;
+  fcs_float x1[BATCH_SIZE], y1[BATCH_SIZE], z1[BATCH_SIZE], q1[BATCH_SIZE];
+  fcs_float dx[BATCH_SIZE], dy[BATCH_SIZE], dz[BATCH_SIZE], r2[BATCH_SIZE];
+  fcs_float dist[BATCH_SIZE], f[BATCH_SIZE], p[BATCH_SIZE];
+  fcs_int idx[BATCH_SIZE], jx[BATCH_SIZE];
+  fcs_float xi, yi, zi, qi, fx, fi[3], pi, cutoff2;
+
+
+  nreal = near->nparticles;
+
+  cutoff2 = cutoff * cutoff;
+
+  for (m = first; m < last; ++m)
+  {
+    i = verlet->list_particles[m];
+
+    xi = near->positions[3 * i + 0];
+    yi = near->positions[3 * i + 1];
+    zi = near->positions[3 * i + 2];
+    qi = near->charges[i];
+
+    fi[0] = fi[1] = fi[2] = pi = 0;
+
+    for (first1 = verlet->list_starts[m]; first1 < verlet->list_starts[m + 1]; first1 += BATCH_SIZE)
+    {
+      n1 = z_min(BATCH_SIZE, verlet->list_starts[m + 1] - first1);
+
+      /* gather the tile of neighbours (unused entries are set to zero so that the distances can be computed for the whole tile),
+         ghost particles are addressed by their current positions (jx >= 0), missing ghost particles are placed out of range */
+      for (k = 0; k < n1; ++k)
+      {
+        j = verlet->neighbours[first1 + k];
+        if (j < nreal)
+        {
+          jx[k] = -1;
+          x1[k] = near->positions[3 * j + 0];
+          y1[k] = near->positions[3 * j + 1];
+          z1[k] = near->positions[3 * j + 2];
+          q1[k] = near->charges[j];
+
+        } else if ((j = verlet->ghost_map[j - nreal]) >= 0)
+        {
+          jx[k] = j;
+          x1[k] = near->ghost_positions[3 * j + 0];
+          y1[k] = near->ghost_positions[3 * j + 1];
+          z1[k] = near->ghost_positions[3 * j + 2];
+          q1[k] = near->ghost_charges[j];
+
+        } else
+        {
+          jx[k] = -1;
+          x1[k] = xi + 2 * cutoff;
+          y1[k] = yi;
+          z1[k] = zi;
+          q1[k] = 0;
+        }
+      }
+      for (; k < BATCH_SIZE; ++k) x1[k] = y1[k] = z1[k] = q1[k] = 0;
+
+      /* fixed trip count for vectorization */
+      for (k = 0; k < BATCH_SIZE; ++k)
+      {
+        dx[k] = x1[k] - xi;
+        dy[k] = y1[k] - yi;
+        dz[k] = z1[k] - zi;
+        r2[k] = dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k];
+      }
+
+      n = 0;
+      for (k = 0; k < n1; ++k)
+      if (r2[k] <= cutoff2)
+      {
+        idx[n] = k;
+        dist[n] = fcs_sqrt(r2[k]);
+        ++n;
+      }
+
+      if (n == 0) continue;
+
+      near->compute_field_potential_batch(near_param, n, dist, f, p);
+
+      if (field)
+      for (l = 0; l < n; ++l)
+      {
+        k = idx[l];
+        fx = f[l] / dist[l];
+        fi[0] += fx * q1[k] * dx[k];
+        fi[1] += fx * q1[k] * dy[k];
+        fi[2] += fx * q1[k] * dz[k];
+
+        j = verlet->neighbours[first1 + k];
+        if (j < nreal)
+        {
+          field[3 * j + 0] -= fx * qi * dx[k];
+          field[3 * j + 1] -= fx * qi * dy[k];
+          field[3 * j + 2] -= fx * qi * dz[k];
+
+        } else if (ghost_field)
+        {
+          j = jx[k];
+          ghost_field[3 * j + 0] -= fx * qi * dx[k];
+          ghost_field[3 * j + 1] -= fx * qi * dy[k];
+          ghost_field[3 * j + 2] -= fx * qi * dz[k];
+        }
+      }
+
+      if (potentials)
+      for (l = 0; l < n; ++l)
+      {
+        k = idx[l];
+        pi += p[l] * q1[k];
+
+        j = verlet->neighbours[first1 + k];
+        if (j < nreal) potentials[j] += p[l] * qi;
+        else if (ghost_potentials) ghost_potentials[jx[k]] += p[l] * qi;
+      }
+    }
+
+    if (field)
+    {
+      field[3 * i + 0] += fi[0];
+      field[3 * i + 1] += fi[1];
+      field[3 * i + 2] += fi[2];
+    }
+    if (potentials) potentials[i] += pi;
+  }
+}
+
+
+static fcs_int box_bound(box_t *boxes, fcs_int n, fcs_int i)
+{
+  /* move forward to the first particle of the next box */
+  while (i > 0 && i < n && boxes[i - 1] == boxes[i]) ++i;
+
+  return i;
+}
+
+
+#ifdef _OPENMP
+
+static fcs_int verlet_bound(fcs_near_verlet_t verlet, fcs_int first, fcs_int last, fcs_int i, fcs_int n)
+{
+  fcs_int low, high, mid;
+  long long nneighbours;
+
+
+  /* first list (of the given range) whose neighbours start at or after the given fraction of the neighbours of the range */
+  nneighbours = verlet->list_starts[first] + ((long long) (verlet->list_starts[last] - verlet->list_starts[first]) * i) / n;
+
+  low = first;
+  high = last;
+  while (low < high)
+  {
+    mid = (low + high) / 2;
+    if (verlet->list_starts[mid] < nneighbours) low = mid + 1;
+    else high = mid;
+  }
+
+  return low;
+}
+
+
+static void compute_threaded(fcs_near_t *near, fcs_near_verlet_t verlet, box_t *real_boxes, box_t *ghost_boxes, fcs_int range_first, fcs_int range_last, fcs_float *ghost_field, fcs_float *ghost_potentials,
+                             fcs_float cutoff, const void *compute_param, double *t)
+{
+  fcs_int i, j, nthreads;
+  fcs_float *field_buffers, *potentials_buffers, *ghost_field_buffers, *ghost_potentials_buffers;
+
+
+  nthreads = omp_get_max_threads();
+
+  if (nthreads <= 1 || range_last - range_first < 2 * nthreads)
+  {
+    if (verlet) compute_verlet(near, verlet, range_first, range_last, near->field, near->potentials, ghost_field, ghost_potentials, cutoff, compute_param);
+    else compute_boxes(near, real_boxes, ghost_boxes, range_first, range_last, near->field, near->potentials, ghost_field, ghost_potentials, cutoff, compute_param, t);
+    return;
+  }
+
+  /* pairs of real particles are computed only once (half shell), i.e., a thread writes also to particles of boxes
+     owned by other threads, thus all threads except the first accumulate into private buffers that are summed up afterwards */
+  field_buffers = (near->field)?malloc((nthreads - 1) * 3 * near->nparticles * sizeof(fcs_float)):NULL;
+  potentials_buffers = (near->potentials)?malloc((nthreads - 1) * near->nparticles * sizeof(fcs_float)):NULL;
+
+  /* the same applies to the results of ghost particles */
+  ghost_field_buffers = (ghost_field)?malloc((nthreads - 1) * 3 * near->nghosts * sizeof(fcs_float)):NULL;
+  ghost_potentials_buffers = (ghost_potentials)?malloc((nthreads - 1) * near->nghosts * sizeof(fcs_float)):NULL;
+
+#pragma omp parallel num_threads(nthreads) private(i)
+  {
+    fcs_int tid = omp_get_thread_num();
+    fcs_int first, last;
+    fcs_float *field = near->field, *potentials = near->potentials;
+    fcs_float *thread_ghost_field = ghost_field, *thread_ghost_potentials = ghost_potentials;
+#ifdef DO_TIMING
+    double thread_t[7] = { 0, 0, 0, 0, 0, 0, 0 };
+#endif
+
+    if (verlet)
+    {
+      /* contiguous ranges of neighbour lists with (roughly) equal numbers of neighbours */
+      first = verlet_bound(verlet, range_first, range_last, tid, nthreads);
+      last = verlet_bound(verlet, range_first, range_last, tid + 1, nthreads);
+
+    } else
+    {
+      /* contiguous ranges of whole boxes with (roughly) equal numbers of particles */
+      first = box_bound(real_boxes, range_last, range_first + (fcs_int) (((long long) (range_last - range_first) * tid) / nthreads));
+      last = box_bound(real_boxes, range_last, range_first + (fcs_int) (((long long) (range_last - range_first) * (tid + 1)) / nthreads));
+    }
+
+    if (tid > 0)
+    {
+      if (field_buffers)
+      {
+        field = field_buffers + (tid - 1) * 3 * near->nparticles;
+        for (i = 0; i < 3 * near->nparticles; ++i) field[i] = 0;
+      }
+      if (potentials_buffers)
+      {
+        potentials = potentials_buffers + (tid - 1) * near->nparticles;
+        for (i = 0; i < near->nparticles; ++i) potentials[i] = 0;
+      }
+      if (ghost_field_buffers)
+      {
+        thread_ghost_field = ghost_field_buffers + (tid - 1) * 3 * near->nghosts;
+        for (i = 0; i < 3 * near->nghosts; ++i) thread_ghost_field[i] = 0;
+      }
+      if (ghost_potentials_buffers)
+      {
+        thread_ghost_potentials = ghost_potentials_buffers + (tid - 1) * near->nghosts;
+        for (i = 0; i < near->nghosts; ++i) thread_ghost_potentials[i] = 0;
+      }
+    }
+
+    if (verlet) compute_verlet(near, verlet, first, last, field, potentials, thread_ghost_field, thread_ghost_potentials, cutoff, compute_param);
+    else compute_boxes(near, real_boxes, ghost_boxes, first, last, field, potentials, thread_ghost_field, thread_ghost_potentials, cutoff, compute_param, (tid == 0)?t:TIMING_ARG(thread_t));
+
+#pragma omp barrier
+
+    if (field_buffers)
+    {
+#pragma omp for private(j)
+      for (i = 0; i < 3 * near->nparticles; ++i)
+        for (j = 0; j < nthreads - 1; ++j) near->field[i] += field_buffers[j * 3 * near->nparticles + i];
+    }
+
+    if (potentials_buffers)
+    {
+#pragma omp for private(j)
+      for (i = 0; i < near->nparticles; ++i)
+        for (j = 0; j < nthreads - 1; ++j) near->potentials[i] += potentials_buffers[j * near->nparticles + i];
+    }
+
+    if (ghost_field_buffers)
+    {
+#pragma omp for private(j)
+      for (i = 0; i < 3 * near->nghosts; ++i)
+        for (j = 0; j < nthreads - 1; ++j) ghost_field[i] += ghost_field_buffers[j * 3 * near->nghosts + i];
+    }
+
+    if (ghost_potentials_buffers)
+    {
+#pragma omp for private(j)
+      for (i = 0; i < near->nghosts; ++i)
+        for (j = 0; j < nthreads - 1; ++j) ghost_potentials[i] += ghost_potentials_buffers[j * near->nghosts + i];
+    }
+  }
+
+  if (field_buffers) free(field_buffers);
+  if (potentials_buffers) free(potentials_buffers);
+  if (ghost_field_buffers) free(ghost_field_buffers);
+  if (ghost_potentials_buffers) free(ghost_potentials_buffers);
+}
+
+#endif /* _OPENMP */
+
+
+fcs_int fcs_near_compute(fcs_near_t *near,
+                         fcs_float cutoff,
+                         const void *compute_param,
+                         MPI_Comm comm)
+{
+  fcs_int ret;
+
+#ifdef DO_TIMING
+  int comm_rank;
+  double t[1] = { 0 };
+#endif
+
+
+  TIMING_SYNC(comm); TIMING_START(t[0]);
+
+  ret = fcs_near_compute_begin(near, cutoff, compute_param, comm);
+
+  if (ret == 0) ret = fcs_near_compute_end(near);
+
+  TIMING_SYNC(comm); TIMING_STOP(t[0]);
+
+  TIMING_CMD(
+    MPI_Comm_rank(comm, &comm_rank);
+    if (comm_rank == 0)
+      printf(TIMING_PRINT_PREFIX "fcs_near_compute: %f\n", t[0]);
+  );
+
+  return ret;
+}
+
+
+fcs_int fcs_near_compute_begin(fcs_near_t *near,
+                               fcs_float cutoff,
+                               const void *compute_param,
+                               MPI_Comm comm)
+{
+  int comm_size, comm_rank;
+
+  box_t *real_boxes, *ghost_boxes;
+  fcs_int periodicity[3], ghost_periodicity[3];
   int cart_dims[3], cart_periods[3], cart_coords[3], topo_status;
+  fcs_float *ghost_field, *ghost_potentials;
+  fcs_near_verlet_t verlet;
+  fcs_int rebuild, local_rebuild;
+  fcs_float displacement;
 
 #ifdef DO_TIMING
-  double _t, t[7] = { 0, 0, 0, 0, 0, 0, 0 };
+  double t[3] = { 0, 0, 0 };
 #endif
 
 
@@ -698,6 +1633,15 @@ fcs_int fcs_near_compute(fcs_near_t *near,
   MPI_Comm_size(comm, &comm_size);
   MPI_Comm_rank(comm, &comm_rank);
 
+  near->step_active = 1;
+  near->step_next = near->step_end = 0;
+  near->step_cutoff = cutoff;
+  near->step_param = compute_param;
+  near->step_comm = comm;
+  near->step_verlet = FCS_NEAR_VERLET_NULL;
+  near->step_real_boxes = near->step_ghost_boxes = NULL;
+  near->step_ghost_field = near->step_ghost_potentials = NULL;
+
   if (cutoff <= 0) goto exit;
 
   MPI_Topo_test(comm, &topo_status);
@@ -711,7 +1655,11 @@ fcs_int fcs_near_compute(fcs_near_t *near,
       periodicity[1] = cart_periods[1];
       periodicity[2] = cart_periods[2];
 
-    } else return -1;
+    } else
+    {
+      near->step_active = 0;
+      return -1;
+    }
 
   } else
   {
@@ -721,7 +1669,10 @@ fcs_int fcs_near_compute(fcs_near_t *near,
   }
 
   if ((near->compute_field_potential && near->compute_field_potential_3diff) || ((near->compute_field || near->compute_potential) && (near->compute_field_3diff || near->compute_potential_3diff)))
+  {
+    near->step_active = 0;
     return -2;
+  }
 
   INFO_CMD(
     if (comm_rank == 0)
@@ -737,13 +1688,89 @@ fcs_int fcs_near_compute(fcs_near_t *near,
     }
   );
 
+  /* ghost particles that keep the indices of their original particles are already unfolded */
+  if (near->ghost_field || near->ghost_potentials) ghost_periodicity[0] = ghost_periodicity[1] = ghost_periodicity[2] = 0;
+  else
+  {
+    ghost_periodicity[0] = periodicity[0];
+    ghost_periodicity[1] = periodicity[1];
+    ghost_periodicity[2] = periodicity[2];
+  }
+
+  /* interactions with ghost particles are computed only once if all required results of the ghost particles are available */
+  if (near->nghosts > 0 && near->indices && near->compute_loop == NULL && near->compute_field_potential_batch
+    && (near->field == NULL || near->ghost_field) && (near->potentials == NULL || near->ghost_potentials))
+  {
+    ghost_field = (near->field)?near->ghost_field:NULL;
+    ghost_potentials = (near->potentials)?near->ghost_potentials:NULL;
+
+  } else ghost_field = ghost_potentials = NULL;
+
+  /* persistent neighbour lists require the batch computations and the gridsort-indices to recognize the local particles */
+  if (near->verlet && near->indices && (near->nghosts == 0 || near->ghost_indices) && near->compute_loop == NULL && near->compute_field_potential_batch) verlet = near->verlet;
+  else verlet = FCS_NEAR_VERLET_NULL;
+
+  if (verlet)
+  {
+    TIMING_SYNC(comm); TIMING_START(t[1]);
+    rebuild = !verlet_check_particles(verlet, near, cutoff, (ghost_field || ghost_potentials));
+    if (rebuild) verlet_set_particles(verlet, near, cutoff, (ghost_field || ghost_potentials));
+
+    if (periodicity[0] || periodicity[1] || periodicity[2])
+      fcs_gridsort_unfold_periodic_particles(near->nparticles, near->indices, near->positions, near->box_a, near->box_b, near->box_c);
+    if (near->nghosts > 0 && (ghost_periodicity[0] || ghost_periodicity[1] || ghost_periodicity[2]))
+      fcs_gridsort_unfold_periodic_particles(near->nghosts, near->ghost_indices, near->ghost_positions, near->box_a, near->box_b, near->box_c);
+
+    /* the lists contain all pairs within the cutoff range as long as no particle has moved more than half of the skin,
+       the decision is global, because the ghost particles are moved by other processes (and the selection of the pairs with ghost particles has to remain consistent) */
+    if (rebuild) displacement = -1;
+    else if (near->max_particle_move >= 0)
+    {
+      displacement = verlet->displacement + near->max_particle_move;
+      /* particles wrapped into the periodic box keep their indices, but move farther than the given maximum */
+      if (verlet_max_displacement(verlet, near) > displacement) displacement = -1;
+
+    } else displacement = verlet_max_displacement(verlet, near);
+
+    local_rebuild = (displacement < 0 || displacement > 0.5 * verlet->skin);
+
+    MPI_Allreduce(&local_rebuild, &rebuild, 1, FCS_MPI_INT, MPI_MAX, comm);
+
+    if (!rebuild)
+    {
+      verlet->displacement = displacement;
+      verlet_map_ghosts(verlet, near);
+    }
+    TIMING_SYNC(comm); TIMING_STOP(t[1]);
+
+    TIMING_SYNC(comm); TIMING_START(t[2]);
+    if (rebuild)
+    {
+      verlet_build(verlet, near);
+      ++verlet->nbuilds;
+
+    } else ++verlet->nreuses;
+    TIMING_SYNC(comm); TIMING_STOP(t[2]);
+
+    INFO_CMD(
+      if (comm_rank == 0) printf(INFO_PRINT_PREFIX "neighbour lists: %s (builds: %" FCS_LMOD_INT "d, reuses: %" FCS_LMOD_INT "d)\n", (rebuild)?"rebuilt":"reused", verlet->nbuilds, verlet->nreuses);
+    );
+
+    near->step_verlet = verlet;
+    near->step_end = verlet->nlists;
+    near->step_ghost_field = ghost_field;
+    near->step_ghost_potentials = ghost_potentials;
+
+    goto exit;
+  }
+
   real_boxes = malloc((near->nparticles + 1) * sizeof(box_t)); /* + 1 for a sentinel */
   if (near->nghosts > 0) ghost_boxes = malloc((near->nghosts + 1) * sizeof(box_t)); /* + 1 for a sentinel */
   else ghost_boxes = NULL;
 
   TIMING_SYNC(comm); TIMING_START(t[1]);
   create_boxes(near->nparticles, real_boxes, near->positions, near->indices, near->box_base, near->box_a, near->box_b, near->box_c, periodicity, cutoff);
-  if (ghost_boxes) create_boxes(near->nghosts, ghost_boxes, near->ghost_positions, near->ghost_indices, near->box_base, near->box_a, near->box_b, near->box_c, periodicity, cutoff);
+  if (ghost_boxes) create_boxes(near->nghosts, ghost_boxes, near->ghost_positions, near->ghost_indices, near->box_base, near->box_a, near->box_b, near->box_c, ghost_periodicity, cutoff);
   TIMING_SYNC(comm); TIMING_STOP(t[1]);
 
 #ifdef PRINT_PARTICLES
@@ -758,7 +1785,7 @@ fcs_int fcs_near_compute(fcs_near_t *near,
 
   TIMING_SYNC(comm); TIMING_START(t[2]);
   sort_into_boxes(near->nparticles, real_boxes, near->positions, near->charges, near->indices, near->field, near->potentials);
-  if (ghost_boxes) sort_into_boxes(near->nghosts, ghost_boxes, near->ghost_positions, near->ghost_charges, near->ghost_indices, NULL, NULL);
+  if (ghost_boxes) sort_into_boxes(near->nghosts, ghost_boxes, near->ghost_positions, near->ghost_charges, near->ghost_indices, near->ghost_field, near->ghost_potentials);
   TIMING_SYNC(comm); TIMING_STOP(t[2]);
 
 #ifdef BOX_SKIP_FORMAT
@@ -773,73 +1800,99 @@ fcs_int fcs_near_compute(fcs_near_t *near,
 /*  for (i = 0; i < nlocal_particles; ++i)
     printf("%" FCS_LMOD_INT "d: %f,%f,%f  " box_fmt "  %lld\n", i, positions[3 * i + 0], positions[3 * i + 1], positions[3 * i + 2], box_val(&boxes[3 * i]), indices[i]);*/
 
-  current_last = 0;
-  for (i = 0; i < max_nboxes; ++i) real_lasts[i] = ghost_lasts[i] = 0;
+  near->step_real_boxes = real_boxes;
+  near->step_ghost_boxes = ghost_boxes;
+  near->step_end = near->nparticles;
+  near->step_ghost_field = ghost_field;
+  near->step_ghost_potentials = ghost_potentials;
 
-  TIMING_SYNC(comm); TIMING_START(t[3]);
-  do
-  {
-    current_box = real_boxes[current_last];
+exit:
+  TIMING_SYNC(comm); TIMING_STOP(t[0]);
 
-    TIMING_START(_t);
-    find_box(real_boxes, near->nparticles, current_box, current_last, &current_start, &current_size);
-    TIMING_STOP_ADD(_t, t[4]);
+  TIMING_CMD(
+    if (comm_rank == 0)
+      printf(TIMING_PRINT_PREFIX "fcs_near_compute_begin: %f  %f  %f\n", t[0], t[1], t[2]);
+  );
 
-/*    printf("box: " box_fmt ", start: %" FCS_LMOD_INT "d, size: %" FCS_LMOD_INT "d\n",
-      box_val(current_box), current_start, current_size);*/
+  return 0;
+}
 
-    TIMING_START(_t);
-    find_neighbours(nreal_neighbours, real_neighbours, real_boxes, near->nparticles, current_box, real_lasts, real_starts, real_sizes);
-    if (ghost_boxes) find_neighbours(nghost_neighbours, ghost_neighbours, ghost_boxes, near->nghosts, current_box, ghost_lasts, ghost_starts, ghost_sizes);
-    TIMING_STOP_ADD(_t, t[5]);
 
-    TIMING_START(_t);
-    compute_near(near->positions, near->charges, near->field, near->potentials, current_start, current_size, NULL, NULL, current_start, current_size, cutoff, near, compute_param);
-    for (i = 0; i < nreal_neighbours; ++i)
-    {
-/*      printf("  real-neighbour %" FCS_LMOD_INT "d: %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d\n", i, current_starts[i], current_sizes[i]);*/
+fcs_int fcs_near_compute_step(fcs_near_t *near,
+                              fcs_int nparticles)
+{
+  fcs_int first, last;
 
-      compute_near(near->positions, near->charges, near->field, near->potentials, current_start, current_size, NULL, NULL, real_starts[i], real_sizes[i], cutoff, near, compute_param);
+#ifdef DO_TIMING
+  double t[7] = { 0, 0, 0, 0, 0, 0, 0 };
+#endif
 
-      real_lasts[i] = real_starts[i] + real_sizes[i];
-    }
 
-    if (ghost_boxes)
-    for (i = 0; i < nghost_neighbours; ++i)
-    {
-/*      printf("  ghost-neighbour %" FCS_LMOD_INT "d: %" FCS_LMOD_INT "d / %" FCS_LMOD_INT "d\n", i, ghost_starts[i], ghost_sizes[i]);*/
+  if (!near->step_active) return 0;
 
-      compute_near(near->positions, near->charges, near->field, near->potentials, current_start, current_size, near->ghost_positions, near->ghost_charges, ghost_starts[i], ghost_sizes[i], cutoff, near, compute_param);
+  first = near->step_next;
+  last = (nparticles < near->step_end - first) ? first + nparticles : near->step_end;
 
-      ghost_lasts[i] = ghost_starts[i] + ghost_sizes[i];
-    }
-    current_last = current_start + current_size;
-    TIMING_STOP_ADD(_t, t[6]);
+  if (first >= last) return near->step_end - first;
 
-  } while (current_last < near->nparticles);
-  TIMING_SYNC(comm); TIMING_STOP(t[3]);
+  if (near->step_verlet) compute_verlet(near, near->step_verlet, first, last, near->field, near->potentials, near->step_ghost_field, near->step_ghost_potentials, near->step_cutoff, near->step_param);
+  else
+  {
+    /* complete the last box */
+    last = box_bound(near->step_real_boxes, near->step_end, last);
+    compute_boxes(near, near->step_real_boxes, near->step_ghost_boxes, first, last, near->field, near->potentials, near->step_ghost_field, near->step_ghost_potentials, near->step_cutoff, near->step_param, TIMING_ARG(t));
+  }
 
-  free(real_boxes);
-  if (ghost_boxes) free(ghost_boxes);
+  near->step_next = last;
 
-exit:
-  TIMING_SYNC(comm); TIMING_STOP(t[0]);
+  return near->step_end - last;
+}
+
+
+fcs_int fcs_near_compute_end(fcs_near_t *near)
+{
+#ifdef DO_TIMING
+  int comm_rank;
+  double t[7] = { 0, 0, 0, 0, 0, 0, 0 };
+#endif
+
+
+  if (!near->step_active) return -1;
+
+  TIMING_START(t[3]);
+  if (near->step_next < near->step_end)
+  {
+#ifdef _OPENMP
+    compute_threaded(near, near->step_verlet, near->step_real_boxes, near->step_ghost_boxes, near->step_next, near->step_end, near->step_ghost_field, near->step_ghost_potentials,
+      near->step_cutoff, near->step_param, TIMING_ARG(t));
+#else
+    if (near->step_verlet) compute_verlet(near, near->step_verlet, near->step_next, near->step_end, near->field, near->potentials, near->step_ghost_field, near->step_ghost_potentials, near->step_cutoff, near->step_param);
+    else compute_boxes(near, near->step_real_boxes, near->step_ghost_boxes, near->step_next, near->step_end, near->field, near->potentials, near->step_ghost_field, near->step_ghost_potentials,
+      near->step_cutoff, near->step_param, TIMING_ARG(t));
+#endif
+  }
+  TIMING_STOP(t[3]);
+
+  if (near->step_real_boxes) free(near->step_real_boxes);
+  if (near->step_ghost_boxes) free(near->step_ghost_boxes);
+
+  near->step_active = 0;
+  near->step_next = near->step_end = 0;
+  near->step_param = NULL;
+  near->step_verlet = FCS_NEAR_VERLET_NULL;
+  near->step_real_boxes = near->step_ghost_boxes = NULL;
+  near->step_ghost_field = near->step_ghost_potentials = NULL;
 
   TIMING_CMD(
+    MPI_Comm_rank(near->step_comm, &comm_rank);
     if (comm_rank == 0)
-      printf(TIMING_PRINT_PREFIX "fcs_near_compute: %f  %f  %f  %f  %f  %f  %f\n", t[0], t[1], t[2], t[3], t[4], t[5], t[6]);
+      printf(TIMING_PRINT_PREFIX "fcs_near_compute_end: %f  %f  %f  %f\n", t[3], t[4], t[5], t[6]);
   );
 
   return 0;
 }
 
 
-/*#define SORT_FORWARD_BOUNDS*/
-/*#define CREATE_GHOSTS_SEPARATE*/
-/*#define SEPARATE_GHOSTS*/
-/*#define SEPARATE_ZSLICES  7*/
-
-
 fcs_int fcs_near_field_solver(fcs_near_t *near,
                               fcs_float cutoff,
                               const void *compute_param,
@@ -861,13 +1914,12 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
   fcs_float *positions_s_real, *charges_s_real;
   fcs_gridsort_index_t *indices_s_real;
   
-  fcs_int resort;
+  fcs_int resort, ghost_results, use_verlet, nlocal_s_results;
+  fcs_float ghost_range;
 
-#ifdef SEPARATE_GHOSTS
   fcs_int nlocal_s_ghost;
   fcs_float *positions_s_ghost, *charges_s_ghost;
   fcs_gridsort_index_t *indices_s_ghost;
-#endif
 
   fcs_gridsort_t gridsort;
 
@@ -963,20 +2015,55 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
 
   fcs_gridsort_set_max_particle_move(&gridsort, near->max_particle_move);
 
+  /* interactions between real and ghost particles are computed only once and the results of ghost particles are sent back to their original particles,
+     this requires the batch computations, ghost particles from direct neighbors only (see fcs_gridsort_create_ghosts), and no resorting */
+  MPI_Cart_get(cart_comm, 3, cart_dims, cart_periods, cart_coords);
+
+  ghost_results = (near->compute_loop == NULL && near->compute_field_potential_batch && !near->resort && !z_is_triclinic(near->box_a, near->box_b, near->box_c)
+    && near->box_a[0] >= cutoff * cart_dims[0] && near->box_b[1] >= cutoff * cart_dims[1] && near->box_c[2] >= cutoff * cart_dims[2]);
+
+  /* persistent neighbour lists require the ghost particles within cutoff + skin to remain valid until the next rebuild */
+  ghost_range = cutoff;
+  if (ghost_results && near->verlet) ghost_range += near->verlet->skin;
+
+  use_verlet = (ghost_results && near->verlet
+    && near->box_a[0] >= ghost_range * cart_dims[0] && near->box_b[1] >= ghost_range * cart_dims[1] && near->box_c[2] >= ghost_range * cart_dims[2]);
+
+  if (!use_verlet) ghost_range = cutoff;
+
+  /* balanced process domains are at least as wide as the ghost range, thus ghost particles are still created from direct neighbors only */
+  fcs_gridsort_set_balance(&gridsort, near->balance, NULL, ghost_range);
+  fcs_gridsort_set_cache(&gridsort, near->gridsort_cache);
+
   TIMING_SYNC(comm); TIMING_START(t[1]);
+  if (ghost_results)
+  {
+    fcs_gridsort_set_ghost_origins(&gridsort, 1);
+    fcs_gridsort_sort_forward(&gridsort, 0, cart_comm);
+    fcs_gridsort_create_ghosts(&gridsort, ghost_range, cart_comm);
+
+  } else
+  {
 #ifdef CREATE_GHOSTS_SEPARATE
-  fcs_gridsort_sort_forward(&gridsort, 0, cart_comm);
-  fcs_gridsort_create_ghosts(&gridsort, cutoff, cart_comm);
+    fcs_gridsort_sort_forward(&gridsort, 0, cart_comm);
+    fcs_gridsort_create_ghosts(&gridsort, cutoff, cart_comm);
 #else
-  fcs_gridsort_sort_forward(&gridsort, cutoff, cart_comm);
+    fcs_gridsort_sort_forward(&gridsort, cutoff, cart_comm);
 #endif
+  }
   TIMING_SYNC(comm); TIMING_STOP(t[1]);
 
   fcs_gridsort_get_sorted_particles(&gridsort, &nlocal_s, NULL, &positions_s, &charges_s, &indices_s);
 
-#ifdef SEPARATE_GHOSTS
-  fcs_gridsort_separate_ghosts(&gridsort, &nlocal_s_real, &nlocal_s_ghost);
-  fcs_gridsort_get_ghost_particles(&gridsort, &nlocal_s_ghost, &positions_s_ghost, &charges_s_ghost, &indices_s_ghost);
+#ifndef SEPARATE_GHOSTS
+  if (ghost_results)
+#endif
+  {
+    fcs_gridsort_separate_ghosts(&gridsort);
+    fcs_gridsort_get_ghost_particles(&gridsort, &nlocal_s_ghost, &positions_s_ghost, &charges_s_ghost, &indices_s_ghost);
+  }
+#ifndef SEPARATE_GHOSTS
+  else nlocal_s_ghost = 0;
 #endif
 
 #ifdef SEPARATE_ZSLICES
@@ -1000,19 +2087,22 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
   }*/
 #endif
 
-  if (near->field) field_s = malloc(nlocal_s_real * 3 * sizeof(fcs_float));
+  /* with ghost results, the results of the ghost particles follow the results of the real particles */
+  nlocal_s_results = nlocal_s_real + ((ghost_results) ? nlocal_s_ghost : 0);
+
+  if (near->field) field_s = malloc(nlocal_s_results * 3 * sizeof(fcs_float));
   else field_s = NULL;
-  if (near->potentials) potentials_s = malloc(nlocal_s_real * sizeof(fcs_float));
+  if (near->potentials) potentials_s = malloc(nlocal_s_results * sizeof(fcs_float));
   else potentials_s = NULL;
 
   if (field_s && potentials_s)
   {
-    for (i = 0; i < nlocal_s_real; ++i) field_s[3 * i + 0] = field_s[3 * i + 1] = field_s[3 * i + 2] = potentials_s[i] = 0;
+    for (i = 0; i < nlocal_s_results; ++i) field_s[3 * i + 0] = field_s[3 * i + 1] = field_s[3 * i + 2] = potentials_s[i] = 0;
 
   } else
   {
-    if (field_s) for (i = 0; i < nlocal_s_real; ++i) field_s[3 * i + 0] = field_s[3 * i + 1] = field_s[3 * i + 2] = 0;
-    if (potentials_s) for (i = 0; i < nlocal_s_real; ++i) potentials_s[i] = 0;
+    if (field_s) for (i = 0; i < nlocal_s_results; ++i) field_s[3 * i + 0] = field_s[3 * i + 1] = field_s[3 * i + 2] = 0;
+    if (potentials_s) for (i = 0; i < nlocal_s_results; ++i) potentials_s[i] = 0;
   }
 
   fcs_near_create(&near_s);
@@ -1025,8 +2115,15 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
   fcs_near_set_potential_3diff(&near_s, near->compute_potential_3diff);
   fcs_near_set_field_potential_3diff(&near_s, near->compute_field_potential_3diff);
 
+  fcs_near_set_field_potential_batch(&near_s, near->compute_field_potential_batch);
+
   fcs_near_set_loop(&near_s, near->compute_loop);
 
+  fcs_near_set_max_particle_move(&near_s, near->max_particle_move);
+
+  /* persistent neighbour lists require ghost particles that can be identified by their original indices */
+  if (use_verlet) fcs_near_set_verlet(&near_s, near->verlet);
+
   if (near->periodicity[0] < 0 || near->periodicity[1] < 0 || near->periodicity[2] < 0)
     fcs_near_set_system(&near_s, near->box_base, near->box_a, near->box_b, near->box_c, NULL);
   else
@@ -1034,9 +2131,9 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
 
   fcs_near_set_particles(&near_s, nlocal_s_real, nlocal_s_real, positions_s_real, charges_s_real, indices_s_real, field_s, potentials_s);
 
-#ifdef SEPARATE_GHOSTS
-  fcs_near_set_ghosts(&near_s, nlocal_s_ghost, positions_s_ghost, charges_s_ghost, indices_s_ghost);
-#endif
+  if (nlocal_s_ghost > 0) fcs_near_set_ghosts(&near_s, nlocal_s_ghost, positions_s_ghost, charges_s_ghost, indices_s_ghost);
+
+  if (ghost_results) fcs_near_set_ghost_results(&near_s, (field_s) ? field_s + 3 * nlocal_s_real : NULL, (potentials_s) ? potentials_s + nlocal_s_real : NULL);
 
   TIMING_SYNC(comm); TIMING_START(t[2]);
   fcs_near_compute(&near_s, cutoff, compute_param, cart_comm);
@@ -1050,7 +2147,7 @@ fcs_int fcs_near_field_solver(fcs_near_t *near,
     printf("%d: %f,%f,%f  %f\n", i, field_s[3 * i + 0], field_s[3 * i + 1], field_s[3 * i + 2], potentials_s[i]);
   }*/
 
-  fcs_gridsort_set_sorted_results(&gridsort, nlocal_s_real, field_s, potentials_s);
+  fcs_gridsort_set_sorted_results(&gridsort, nlocal_s_results, field_s, potentials_s);
   fcs_gridsort_set_results(&gridsort, near->max_nparticles, near->field, near->potentials);
 
   TIMING_SYNC(comm); TIMING_START(t[3]);
@@ -1085,6 +2182,48 @@ exit:
 }
 
 
+void fcs_near_verlet_create(fcs_near_verlet_t *verlet, fcs_float skin)
+{
+  *verlet = malloc(sizeof(**verlet));
+
+  (*verlet)->skin = skin;
+  (*verlet)->cutoff = 0;
+  (*verlet)->displacement = 0;
+
+  (*verlet)->nparticles = (*verlet)->nghosts = -1;
+  (*verlet)->ghost_once = 0;
+  (*verlet)->indices = NULL;
+  (*verlet)->positions = NULL;
+  (*verlet)->ghost_order = (*verlet)->ghost_map = NULL;
+
+  (*verlet)->nlists = -1;
+  (*verlet)->list_particles = NULL;
+  (*verlet)->list_starts = NULL;
+  (*verlet)->max_nneighbours = 0;
+  (*verlet)->neighbours = NULL;
+
+  (*verlet)->nbuilds = (*verlet)->nreuses = 0;
+}
+
+
+void fcs_near_verlet_destroy(fcs_near_verlet_t *verlet)
+{
+  if (*verlet == FCS_NEAR_VERLET_NULL) return;
+
+  if ((*verlet)->indices) free((*verlet)->indices);
+  if ((*verlet)->positions) free((*verlet)->positions);
+  if ((*verlet)->ghost_order) free((*verlet)->ghost_order);
+  if ((*verlet)->ghost_map) free((*verlet)->ghost_map);
+  if ((*verlet)->list_particles) free((*verlet)->list_particles);
+  if ((*verlet)->list_starts) free((*verlet)->list_starts);
+  if ((*verlet)->neighbours) free((*verlet)->neighbours);
+
+  free(*verlet);
+
+  *verlet = FCS_NEAR_VERLET_NULL;
+}
+
+
 void fcs_near_resort_create(fcs_near_resort_t *near_resort, fcs_near_t *near)
 {
   *near_resort = near->gridsort_resort;
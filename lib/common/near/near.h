@@ -39,6 +39,8 @@ typedef fcs_float (*fcs_near_field_3diff_f)(const void *param, fcs_float dist, f
 typedef fcs_float (*fcs_near_potential_3diff_f)(const void *param, fcs_float dist, fcs_float dx, fcs_float dy, fcs_float dz);
 typedef void (*fcs_near_field_potential_3diff_f)(const void *param, fcs_float dist, fcs_float dx, fcs_float dy, fcs_float dz, fcs_float *f, fcs_float *p);
 
+typedef void (*fcs_near_field_potential_batch_f)(const void *param, fcs_int n, const fcs_float *dist, fcs_float *f, fcs_float *p);
+
 typedef void (*fcs_near_loop_f)(fcs_float *positions0, fcs_float *charges0, fcs_float *field0, fcs_float *potentials0, fcs_int start0, fcs_int size0,
                                 fcs_float *positions1, fcs_float *charges1, fcs_int start1, fcs_int size1, fcs_float cutoff, const void *near_param);
 
@@ -48,6 +50,29 @@ typedef fcs_gridsort_resort_t fcs_near_resort_t;
 #define FCS_NEAR_RESORT_NULL  FCS_GRIDSORT_RESORT_NULL
 
 
+/**
+ * @brief persistent neighbour list (Verlet list) object structure
+ */
+typedef struct _fcs_near_verlet_t
+{
+  fcs_float skin, cutoff, displacement;
+  fcs_float box_a[3], box_b[3], box_c[3];
+
+  fcs_int nparticles, nghosts, ghost_once;
+  fcs_gridsort_index_t *indices;
+  fcs_float *positions;
+  fcs_int *ghost_order, *ghost_map;
+
+  fcs_int nlists, *list_particles, *list_starts;
+  fcs_int max_nneighbours, *neighbours;
+
+  fcs_int nbuilds, nreuses;
+
+} *fcs_near_verlet_t;
+
+#define FCS_NEAR_VERLET_NULL  NULL
+
+
 /**
  * @brief near field solver object structure
  */
@@ -61,6 +86,8 @@ typedef struct _fcs_near_t
   fcs_near_potential_3diff_f compute_potential_3diff;
   fcs_near_field_potential_3diff_f compute_field_potential_3diff;
 
+  fcs_near_field_potential_batch_f compute_field_potential_batch;
+
   fcs_near_loop_f compute_loop;
 
   fcs_float box_base[3], box_a[3], box_b[3], box_c[3];
@@ -74,12 +101,27 @@ typedef struct _fcs_near_t
   fcs_int nghosts;
   fcs_float *ghost_positions, *ghost_charges;
   fcs_gridsort_index_t *ghost_indices;
+  fcs_float *ghost_field, *ghost_potentials;
 
   fcs_float max_particle_move;
 
   fcs_int resort;
   fcs_gridsort_resort_t gridsort_resort;
 
+  fcs_int balance;
+  fcs_gridsort_cache_t *gridsort_cache;
+
+  fcs_near_verlet_t verlet;
+
+  /* state of a stepwise computation (see fcs_near_compute_begin) */
+  fcs_int step_active, step_next, step_end;
+  fcs_float step_cutoff;
+  const void *step_param;
+  MPI_Comm step_comm;
+  fcs_near_verlet_t step_verlet;
+  void *step_real_boxes, *step_ghost_boxes;
+  fcs_float *step_ghost_field, *step_ghost_potentials;
+
 } fcs_near_t;
 
 
@@ -137,6 +179,14 @@ void fcs_near_set_potential_3diff(fcs_near_t *near, fcs_near_potential_3diff_f c
  */
 void fcs_near_set_field_potential_3diff(fcs_near_t *near, fcs_near_field_potential_3diff_f compute_field_potential_3diff);
 
+/**
+ * @brief set callback function for combined field and potential computations of a batch of distances (created with FCS_NEAR_BATCH_FP macro),
+ * particle positions and charges are staged in structure-of-arrays tiles and only the distances within the cutoff range are passed to the callback function
+ * @param near fcs_near_t near field solver object
+ * @param compute_field_potential_batch fcs_near_field_potential_batch_f callback function for combined field and potential computations of a batch of distances
+ */
+void fcs_near_set_field_potential_batch(fcs_near_t *near, fcs_near_field_potential_batch_f compute_field_potential_batch);
+
 /**
  * @brief set callback function for whole loop of computations (created with FCS_NEAR_LOOP* macros)
  * @param near fcs_near_t near field solver object
@@ -178,6 +228,17 @@ void fcs_near_set_particles(fcs_near_t *near, fcs_int nparticles, fcs_int max_np
  */
 void fcs_near_set_ghosts(fcs_near_t *near, fcs_int nghosts, fcs_float *positions, fcs_float *charges, fcs_gridsort_index_t *indices);
 
+/**
+ * @brief set arrays for results of ghost particles, interactions between real and ghost particles are then computed only once (i.e., either by the process of the real particle
+ * or by the process of the original particle of the ghost particle) and the results of ghost particles have to be added to the results of their original particles,
+ * the ghost particles have to keep the indices of their original particles (see fcs_gridsort_set_ghost_origins), only supported with fcs_near_set_field_potential_batch
+ * (otherwise all interactions between real and ghost particles are computed and the results of ghost particles remain unchanged)
+ * @param near fcs_near_t near field solver object
+ * @param field fcs_float* array of ghost particle field values (results are added)
+ * @param potentials fcs_float* array of ghost particle potential values (results are added)
+ */
+void fcs_near_set_ghost_results(fcs_near_t *near, fcs_float *field, fcs_float *potentials);
+
 /**
  * @brief set max. distance particles are away from the domain of the local process, e.g. because they have moved since the last call to fcs_near_field_solver
  * @param near fcs_near_t near field solver object
@@ -196,9 +257,32 @@ void fcs_near_set_max_particle_move(fcs_near_t *near, fcs_float max_particle_mov
  */
 void fcs_near_set_resort(fcs_near_t *near, fcs_int resort);
 
+/**
+ * @brief set load balancing of the process domains used by fcs_near_field_solver (see fcs_gridsort_set_balance)
+ * @param near fcs_near_t near field solver object
+ * @param balance fcs_int whether the process domains are balanced according to the particle distribution (default: 0)
+ * @param gridsort_cache fcs_gridsort_cache_t* gridsort cache to keep the balanced process domains between the runs (NULL if not required)
+ */
+void fcs_near_set_balance(fcs_near_t *near, fcs_int balance, fcs_gridsort_cache_t *gridsort_cache);
+
+/**
+ * @brief set persistent neighbour list object to use and update, the neighbour lists are only rebuilt if the local particles change
+ * or if particles have moved more than half of the skin since the last rebuild (the accumulated max. particle move is used if available,
+ * otherwise the displacements are determined), only supported with fcs_near_set_field_potential_batch and gridsort-indices,
+ * the ghost particles have to include all particles within cutoff + skin and are found again by their indices and positions,
+ * the rebuilds are decided collectively by all processes of the communicator
+ * (fcs_near_field_solver uses the neighbour lists only if ghost particles keep their original indices, i.e., not with resorting,
+ * and if the process domains are at least as wide as cutoff + skin)
+ * @param near fcs_near_t near field solver object
+ * @param verlet fcs_near_verlet_t persistent neighbour list object (see fcs_near_verlet_create) or FCS_NEAR_VERLET_NULL to disable
+ */
+void fcs_near_set_verlet(fcs_near_t *near, fcs_near_verlet_t verlet);
+
 /**
  * @brief compute near field interactions with the given "gridsorted" particles,
- * particle values (positions, charges, field, potentials and gridsort-indices) get rearranged!
+ * particle values (positions, charges, field, potentials and gridsort-indices) get rearranged (except if persistent neighbour lists are used, see fcs_near_set_verlet)!
+ * If OpenMP is enabled (configure option --enable-fcs-openmp), the boxes are computed by multiple threads,
+ * thus the field and/or potential functions have to be thread-safe.
  * @param near fcs_near_t* near field solver object
  * @param cutoff fcs_float cutoff range
  * @param compute_param void* parameter for field and/or potential functions
@@ -210,6 +294,50 @@ fcs_int fcs_near_compute(fcs_near_t *near,
                          const void *compute_param,
                          MPI_Comm comm);
 
+/**
+ * @brief prepare a stepwise computation of near field interactions (same as fcs_near_compute, but the interactions are computed with subsequent calls to
+ * fcs_near_compute_step and fcs_near_compute_end), particle values get rearranged already here, thus the particle data must not be reordered until fcs_near_compute_end,
+ * the stepwise computation can be used to overlap the near field computations with the communication of other (e.g., far field) computations
+ * @param near fcs_near_t* near field solver object
+ * @param cutoff fcs_float cutoff range
+ * @param compute_param void* parameter for field and/or potential functions (has to remain valid until fcs_near_compute_end)
+ * @param comm MPI_Comm MPI communicator to use, has to be Cartesian if periodicity was not set with fcs_near_set_system
+ * @return fcs_int zero if successful, otherwise less than zero
+ */
+fcs_int fcs_near_compute_begin(fcs_near_t *near,
+                               fcs_float cutoff,
+                               const void *compute_param,
+                               MPI_Comm comm);
+
+/**
+ * @brief compute the interactions of the next (whole) boxes of at least the given number of particles (single-threaded, no communication)
+ * @param near fcs_near_t* near field solver object
+ * @param nparticles fcs_int number of particles to compute
+ * @return fcs_int number of particles that remain to be computed
+ */
+fcs_int fcs_near_compute_step(fcs_near_t *near,
+                              fcs_int nparticles);
+
+/**
+ * @brief compute the remaining interactions of a stepwise computation and finish it
+ * @param near fcs_near_t* near field solver object
+ * @return fcs_int zero if successful, otherwise less than zero
+ */
+fcs_int fcs_near_compute_end(fcs_near_t *near);
+
+/**
+ * @brief create persistent neighbour list object
+ * @param verlet fcs_near_verlet_t* persistent neighbour list object
+ * @param skin fcs_float additional range of the neighbour lists beyond the cutoff range
+ */
+void fcs_near_verlet_create(fcs_near_verlet_t *verlet, fcs_float skin);
+
+/**
+ * @brief destroy persistent neighbour list object
+ * @param verlet fcs_near_verlet_t* persistent neighbour list object
+ */
+void fcs_near_verlet_destroy(fcs_near_verlet_t *verlet);
+
 /**
  * @brief create near_resort object from given near field solver object
  * @param gsr fcs_near_resort_t* near_resort object
@@ -803,6 +931,20 @@ void _id_(fcs_float *positions0, fcs_float *charges0, fcs_float *field0, fcs_flo
 #define FCS_NEAR_LOOP2_3DIFF_FP(_id_)  FCS_NEAR_LOOP_3DIFF_FP(_id_, FCS_NEAR_LOOP2_FIELD_POTENTIAL_3DIFF)
 
 
+/**
+ * @brief create batch callback function for combined field and potential computations
+ * @param _id_ name name of the batch callback function
+ * @param _nfp_ name name of the function for combined field and potential computations (type fcs_near_field_potential_f)
+ */
+#define FCS_NEAR_BATCH_FP(_id_, _nfp_) \
+void _id_(const void *near_param, fcs_int n, const fcs_float *dist, fcs_float *f, fcs_float *p) \
+{ \
+  fcs_int i; \
+\
+  for (i = 0; i < n; ++i) _nfp_(near_param, dist[i], &f[i], &p[i]); \
+}
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,8 @@ void fcs_directc_create(fcs_directc_t *directc)
   directc->cutoff = 0.0;
   directc->cutoff_with_near = 0;
 
+  directc->half_ring = 0;
+
   directc->max_particle_move = -1;
 
   directc->resort = 0;
@@ -211,6 +213,18 @@ void fcs_directc_get_cutoff_with_near(fcs_directc_t *directc, fcs_int *cutoff_wi
 }
 
 
+void fcs_directc_set_half_ring(fcs_directc_t *directc, fcs_int half_ring)
+{
+  directc->half_ring = half_ring;
+}
+
+
+void fcs_directc_get_half_ring(fcs_directc_t *directc, fcs_int *half_ring)
+{
+  *half_ring = directc->half_ring;
+}
+
+
 void fcs_directc_set_max_particle_move(fcs_directc_t *directc, fcs_float max_particle_move)
 {
   directc->max_particle_move = max_particle_move;
@@ -344,7 +358,7 @@ static void directc_local_two(fcs_int n0, fcs_float *xyz0, fcs_float *q0, fcs_in
 static void directc_local_periodic(fcs_int n0, fcs_float *xyz0, fcs_float *q0, fcs_int n1, fcs_float *xyz1, fcs_float *q1, fcs_float *f, fcs_float *p, fcs_int *periodic, fcs_float *box_a, fcs_float *box_b, fcs_float *box_c, fcs_float cutoff)
 {
   fcs_int i, j, pd[3];
-  fcs_float dx, dy, dz, ir;
+  fcs_float sx, sy, sz, dx, dy, dz, ir;
 
 
   if (fcs_fabs(cutoff) > 0) cutoff = 1.0 / cutoff;
@@ -355,12 +369,16 @@ static void directc_local_periodic(fcs_int n0, fcs_float *xyz0, fcs_float *q0, f
   {
     if (pd[0] == 0 && pd[1] == 0 && pd[2] == 0) continue;
 
+    sx = (pd[0] * box_a[0]) + (pd[1] * box_b[0]) + (pd[2] * box_c[0]);
+    sy = (pd[0] * box_a[1]) + (pd[1] * box_b[1]) + (pd[2] * box_c[1]);
+    sz = (pd[0] * box_a[2]) + (pd[1] * box_b[2]) + (pd[2] * box_c[2]);
+
     for (i = 0; i < n0; ++i)
     for (j = 0; j < n1; ++j)
     {
-      dx = xyz0[i*3+0] - (xyz1[j*3+0] + (pd[0] * box_a[0]) + (pd[1] * box_b[0]) + (pd[2] * box_c[0]));
-      dy = xyz0[i*3+1] - (xyz1[j*3+1] + (pd[0] * box_a[1]) + (pd[1] * box_b[1]) + (pd[2] * box_c[1]));
-      dz = xyz0[i*3+2] - (xyz1[j*3+2] + (pd[0] * box_a[2]) + (pd[1] * box_b[2]) + (pd[2] * box_c[2]));
+      dx = xyz0[i*3+0] - (xyz1[j*3+0] + sx);
+      dy = xyz0[i*3+1] - (xyz1[j*3+1] + sy);
+      dz = xyz0[i*3+2] - (xyz1[j*3+2] + sz);
 
       ir = 1.0 / fcs_sqrt(z_sqr(dx) + z_sqr(dy) + z_sqr(dz));
 
@@ -376,56 +394,226 @@ static void directc_local_periodic(fcs_int n0, fcs_float *xyz0, fcs_float *q0, f
 }
 
 
-static void directc_global(fcs_directc_t *directc, fcs_int *periodic, int size, int rank, MPI_Comm comm)
+/* interactions between two different blocks (including all periodic images) computed only once and added to both sides */
+static void directc_local_two_sym(fcs_int n0, fcs_float *xyz0, fcs_float *q0, fcs_float *f0, fcs_float *p0, fcs_int n1, fcs_float *xyz1, fcs_float *q1, fcs_float *f1, fcs_float *p1, fcs_int *periodic, fcs_float *box_a, fcs_float *box_b, fcs_float *box_c, fcs_float cutoff)
+{
+  fcs_int i, j, pd[3];
+  fcs_float sx, sy, sz, dx, dy, dz, ir, ir3;
+
+
+  if (fcs_fabs(cutoff) > 0) cutoff = 1.0 / cutoff;
+
+  for (pd[0] = -periodic[0]; pd[0] <= periodic[0]; ++pd[0])
+  for (pd[1] = -periodic[1]; pd[1] <= periodic[1]; ++pd[1])
+  for (pd[2] = -periodic[2]; pd[2] <= periodic[2]; ++pd[2])
+  {
+    sx = (pd[0] * box_a[0]) + (pd[1] * box_b[0]) + (pd[2] * box_c[0]);
+    sy = (pd[0] * box_a[1]) + (pd[1] * box_b[1]) + (pd[2] * box_c[1]);
+    sz = (pd[0] * box_a[2]) + (pd[1] * box_b[2]) + (pd[2] * box_c[2]);
+
+    for (i = 0; i < n0; ++i)
+    for (j = 0; j < n1; ++j)
+    {
+      dx = xyz0[i*3+0] - (xyz1[j*3+0] + sx);
+      dy = xyz0[i*3+1] - (xyz1[j*3+1] + sy);
+      dz = xyz0[i*3+2] - (xyz1[j*3+2] + sz);
+
+      ir = 1.0 / fcs_sqrt(z_sqr(dx) + z_sqr(dy) + z_sqr(dz));
+
+      if ((cutoff > 0 && cutoff > ir) || (cutoff < 0 && -cutoff < ir)) continue;
+
+      ir3 = ir * ir * ir;
+
+      p0[i] += q1[j] * ir;
+      p1[j] += q0[i] * ir;
+
+      f0[i*3+0] += q1[j] * dx * ir3;
+      f0[i*3+1] += q1[j] * dy * ir3;
+      f0[i*3+2] += q1[j] * dz * ir3;
+
+      f1[j*3+0] -= q0[i] * dx * ir3;
+      f1[j*3+1] -= q0[i] * dy * ir3;
+      f1[j*3+2] -= q0[i] * dz * ir3;
+    }
+  }
+}
+
+
+static fcs_int directc_local_block(fcs_directc_t *directc, fcs_float *xyzq)
+{
+  fcs_int n = directc->nparticles + directc->in_nparticles;
+
+
+  memcpy(xyzq, directc->positions, directc->nparticles * 3 * sizeof(fcs_float));
+  memcpy(xyzq + 3 * n, directc->charges, directc->nparticles * sizeof(fcs_float));
+
+  if (directc->in_nparticles > 0 && directc->in_positions && directc->in_charges)
+  {
+    memcpy(xyzq + directc->nparticles * 3, directc->in_positions, directc->in_nparticles * 3 * sizeof(fcs_float));
+    memcpy(xyzq + 3 * n + directc->nparticles, directc->in_charges, directc->in_nparticles * sizeof(fcs_float));
+  }
+
+  return n;
+}
+
+
+/* the blocks of particles (positions followed by charges) are passed around in a ring, the transfer of the next block is overlapped with the computations of the current one */
+static void directc_global_ring(fcs_directc_t *directc, fcs_int *periodic, int size, int rank, MPI_Comm comm)
 {
   fcs_int l;
 
-  fcs_int my_n, max_n, all_n[size], other_n, other_n_next;
+  fcs_int my_n, max_n, all_n[size], other_n, next_n;
+
+  fcs_float *xyzq[2], *other_xyz, *other_q;
+  int cur;
 
-  fcs_float *other_xyzq, *other_xyz, *other_q;
+  MPI_Request requests[2];
 
-  MPI_Status status;
+
+  my_n = directc->nparticles + directc->in_nparticles;
+  MPI_Allreduce(&my_n, &max_n, 1, FCS_MPI_INT, MPI_MAX, comm);
+  MPI_Allgather(&my_n, 1, FCS_MPI_INT, all_n, 1, FCS_MPI_INT, comm);
+
+  xyzq[0] = calloc(2 * max_n, 4*sizeof(fcs_float));
+  xyzq[1] = xyzq[0] + 4 * max_n;
+
+  cur = 0;
+  other_n = directc_local_block(directc, xyzq[cur]);
+  next_n = 0;
+
+  for (l = 0; l < size; ++l)
+  {
+    other_xyz = xyzq[cur];
+    other_q = xyzq[cur] + 3 * other_n;
+
+    if (l + 1 < size)
+    {
+      next_n = all_n[(rank - l - 1 + size) % size];
+
+      MPI_Irecv(xyzq[1 - cur], next_n * 4, FCS_MPI_FLOAT, (rank - 1 + size) % size, 0, comm, &requests[0]);
+      MPI_Isend(xyzq[cur], other_n * 4, FCS_MPI_FLOAT, (rank + 1) % size, 0, comm, &requests[1]);
+    }
+
+    if (l == 0) directc_local_one(directc->nparticles, other_n, other_xyz, other_q, directc->field, directc->potentials, directc->cutoff);
+    else directc_local_two(directc->nparticles, directc->positions, directc->charges, other_n, other_xyz, other_q, directc->field, directc->potentials, directc->cutoff);
+
+    directc_local_periodic(directc->nparticles, directc->positions, directc->charges, other_n, other_xyz, other_q, directc->field, directc->potentials, periodic, directc->box_a, directc->box_b, directc->box_c, directc->cutoff);
+
+    if (l + 1 < size)
+    {
+      MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+
+      cur = 1 - cur;
+      other_n = next_n;
+    }
+  }
+
+  free(xyzq[0]);
+}
+
+
+/* the blocks of particles are passed around only half the ring and each pair of blocks is computed only once,
+   the results for a block (fields followed by potentials) follow it one step behind and are finally sent back to its owner */
+static void directc_global_half_ring(fcs_directc_t *directc, fcs_int *periodic, int size, int rank, MPI_Comm comm)
+{
+  fcs_int i, s, nsteps;
+
+  fcs_int my_n, max_n, all_n[size], other_n, next_n, prev_n;
+
+  fcs_float *my_xyzq, *my_fp, *xyzq[2], *fp[2], *fp_in;
+  int cur, left, right, nrequests;
+
+  MPI_Request requests[4];
 
 
   my_n = directc->nparticles + directc->in_nparticles;
   MPI_Allreduce(&my_n, &max_n, 1, FCS_MPI_INT, MPI_MAX, comm);
   MPI_Allgather(&my_n, 1, FCS_MPI_INT, all_n, 1, FCS_MPI_INT, comm);
 
-  other_xyzq = calloc(max_n, 4*sizeof(fcs_float));
+  my_xyzq = calloc(2 * my_n + 5 * max_n, 4*sizeof(fcs_float));
+  my_fp = my_xyzq + 4 * my_n;
+  xyzq[0] = my_fp + 4 * my_n;
+  xyzq[1] = xyzq[0] + 4 * max_n;
+  fp[0] = xyzq[1] + 4 * max_n;
+  fp[1] = fp[0] + 4 * max_n;
+  fp_in = fp[1] + 4 * max_n;
 
-  other_n_next = all_n[rank];
+  directc_local_block(directc, my_xyzq);
 
-  other_n = other_n_next;
-  other_xyz = other_xyzq;
-  other_q = other_xyzq + 3 * other_n;
+  left = (rank - 1 + size) % size;
+  right = (rank + 1) % size;
 
-  memcpy(other_xyz, directc->positions, directc->nparticles * 3 * sizeof(fcs_float));
-  memcpy(other_q, directc->charges, directc->nparticles * sizeof(fcs_float));
+  nsteps = size / 2;
 
-  if (directc->in_nparticles > 0 && directc->in_positions && directc->in_charges)
+  cur = 0;
+  other_n = all_n[left];
+
+  /* the local interactions overlap the first transfer */
+  nrequests = 0;
+  if (nsteps > 0)
   {
-    memcpy(other_xyz + directc->nparticles * 3, directc->in_positions, directc->in_nparticles * 3 * sizeof(fcs_float));
-    memcpy(other_q + directc->nparticles, directc->in_charges, directc->in_nparticles * sizeof(fcs_float));
+    MPI_Irecv(xyzq[cur], other_n * 4, FCS_MPI_FLOAT, left, 0, comm, &requests[nrequests++]);
+    MPI_Isend(my_xyzq, my_n * 4, FCS_MPI_FLOAT, right, 0, comm, &requests[nrequests++]);
   }
 
-  directc_local_one(directc->nparticles, other_n, other_xyz, other_q, directc->field, directc->potentials, directc->cutoff);
-  directc_local_periodic(directc->nparticles, directc->positions, directc->charges, other_n, other_xyz, other_q, directc->field, directc->potentials, periodic, directc->box_a, directc->box_b, directc->box_c, directc->cutoff);
+  directc_local_one(directc->nparticles, my_n, my_xyzq, my_xyzq + 3 * my_n, directc->field, directc->potentials, directc->cutoff);
+  directc_local_periodic(directc->nparticles, directc->positions, directc->charges, my_n, my_xyzq, my_xyzq + 3 * my_n, directc->field, directc->potentials, periodic, directc->box_a, directc->box_b, directc->box_c, directc->cutoff);
+
+  MPI_Waitall(nrequests, requests, MPI_STATUSES_IGNORE);
+
+  prev_n = 0;
 
-  for (l = 1; l < size; ++l)
+  for (s = 1; s <= nsteps; ++s)
   {
-    other_n_next = all_n[(rank - l + size) % size];
-    
-    MPI_Sendrecv_replace(other_xyzq, max_n * (3 + 1), FCS_MPI_FLOAT, (rank + 1) % size, 0, (rank - 1 + size) % size, 0, comm, &status);
+    nrequests = 0;
 
-    other_n = other_n_next;
-    other_xyz = other_xyzq;
-    other_q = other_xyzq + 3 * other_n;
+    if (s < nsteps)
+    {
+      next_n = all_n[(rank - s - 1 + size) % size];
 
-    directc_local_two(directc->nparticles, directc->positions, directc->charges, other_n, other_xyz, other_q, directc->field, directc->potentials, directc->cutoff);
-    directc_local_periodic(directc->nparticles, directc->positions, directc->charges, other_n, other_xyz, other_q, directc->field, directc->potentials, periodic, directc->box_a, directc->box_b, directc->box_c, directc->cutoff);
+      MPI_Irecv(xyzq[1 - cur], next_n * 4, FCS_MPI_FLOAT, left, 0, comm, &requests[nrequests++]);
+      MPI_Isend(xyzq[cur], other_n * 4, FCS_MPI_FLOAT, right, 0, comm, &requests[nrequests++]);
+
+    } else next_n = 0;
+
+    if (s > 1)
+    {
+      MPI_Irecv(fp_in, other_n * 4, FCS_MPI_FLOAT, left, 1, comm, &requests[nrequests++]);
+      MPI_Isend(fp[1 - cur], prev_n * 4, FCS_MPI_FLOAT, right, 1, comm, &requests[nrequests++]);
+    }
+
+    memset(fp[cur], 0, other_n * 4 * sizeof(fcs_float));
+
+    /* with an even number of processes, the pairs of opposite blocks are met twice in the last step */
+    if (2 * s != size || rank < s)
+      directc_local_two_sym(my_n, my_xyzq, my_xyzq + 3 * my_n, my_fp, my_fp + 3 * my_n,
+        other_n, xyzq[cur], xyzq[cur] + 3 * other_n, fp[cur], fp[cur] + 3 * other_n,
+        periodic, directc->box_a, directc->box_b, directc->box_c, directc->cutoff);
+
+    MPI_Waitall(nrequests, requests, MPI_STATUSES_IGNORE);
+
+    if (s > 1) for (i = 0; i < other_n * 4; ++i) fp[cur][i] += fp_in[i];
+
+    prev_n = other_n;
+    other_n = next_n;
+    cur = 1 - cur;
+  }
+
+  if (nsteps > 0)
+  {
+    MPI_Sendrecv(fp[1 - cur], prev_n * 4, FCS_MPI_FLOAT, (rank - nsteps + size) % size, 2,
+      fp_in, my_n * 4, FCS_MPI_FLOAT, (rank + nsteps) % size, 2, comm, MPI_STATUS_IGNORE);
+
+    for (i = 0; i < directc->nparticles; ++i)
+    {
+      directc->field[i * 3 + 0] += my_fp[i * 3 + 0] + fp_in[i * 3 + 0];
+      directc->field[i * 3 + 1] += my_fp[i * 3 + 1] + fp_in[i * 3 + 1];
+      directc->field[i * 3 + 2] += my_fp[i * 3 + 2] + fp_in[i * 3 + 2];
+      directc->potentials[i] += my_fp[3 * my_n + i] + fp_in[3 * my_n + i];
+    }
   }
 
-  free(other_xyzq);
+  free(my_xyzq);
 }
 
 
@@ -564,7 +752,8 @@ void fcs_directc_run(fcs_directc_t *directc, MPI_Comm comm)
 
   } else
   {
-    directc_global(directc, periodic, comm_size, comm_rank, comm);
+    if (directc->half_ring) directc_global_half_ring(directc, periodic, comm_size, comm_rank, comm);
+    else directc_global_ring(directc, periodic, comm_size, comm_rank, comm);
   }
 
   TIMING_SYNC(comm); TIMING_STOP(t);
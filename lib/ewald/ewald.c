@@ -115,6 +115,30 @@ void ewald_tune_alpha(fcs_int N, fcs_float sum_q2, fcs_float box_l[3],
 /***************************************************
  **** K-SPACE CONTRIBUTION
  ***************************************************/
+/** Computes the table of exp(i*n*k1*x) for n=-kmax..kmax by complex
+   recurrence (only a single cos and sin call per table).
+   \param kmax the maximal k vector
+   \param k1 the length of the unit reciprocal vector in this direction
+   \param x the particle coordinate in this direction
+   \param t (out) the real and imaginary parts of the values, indexed
+   from -kmax to kmax (i.e. t[2*n] and t[2*n+1])
+*/
+static inline void
+ewald_compute_eik(fcs_int kmax, fcs_float k1, fcs_float x, fcs_float *t) {
+  const fcs_float c1 = cos(k1*x);
+  const fcs_float s1 = sin(k1*x);
+
+  t[0] = 1.0;
+  t[1] = 0.0;
+  for (fcs_int n=1; n <= kmax; n++) {
+    t[2*n] = t[2*(n-1)]*c1 - t[2*(n-1)+1]*s1;
+    t[2*n+1] = t[2*(n-1)]*s1 + t[2*(n-1)+1]*c1;
+    /* exp(-i*n*k1*x) is the complex conjugate */
+    t[-2*n] = t[2*n];
+    t[-2*n+1] = -t[2*n+1];
+  }
+}
+
 void ewald_compute_kspace(ewald_data_struct* d, 
     fcs_int num_particles,
     fcs_float *positions,
@@ -124,176 +148,126 @@ void ewald_compute_kspace(ewald_data_struct* d,
 
   FCS_INFO(fprintf(stderr, "ewald_compute_kspace started...\n"));
 
-  /* DISTRIBUTE ALL PARTICLE DATA TO ALL NODES */
-  /* Gather all particle numbers */
-  int node_num_particles = num_particles;
-  int node_particles[d->comm_size]; 
-  int node_particles3[d->comm_size]; 
-  int displs[d->comm_size];
-  int displs3[d->comm_size];
-  fcs_int total_particles;
-
-  /* printf("%d: num_particles=%d\n", d->comm_rank, num_particles); */
-  MPI_Allgather(&node_num_particles, 1, MPI_INT, node_particles, 1, MPI_INT, d->comm);
-
-  /* compute displacements for MPI_Gatherv */
-  total_particles = node_particles[0];
-  node_particles3[0] = node_particles[0]*3;
-  displs[0] = 0;
-  displs3[0] = 0;
-  for (fcs_int i=1; i < d->comm_size; i++) {
-    total_particles += node_particles[i];
-    node_particles3[i] = node_particles[i]*3;
-    displs[i] = displs[i-1] + node_particles[i-1];
-    displs3[i] = displs3[i-1] + node_particles3[i-1];
+  const fcs_int kmax = d->kmax;
+  const fcs_int num_k_per_dir = 2*kmax+1;
+
+  /* system length vector L_vec */
+  const fcs_float Lx = d->box_l[0];
+  const fcs_float Ly = d->box_l[1];
+  const fcs_float Lz = d->box_l[2];
+  /* unit reciprocal vectors */
+  const fcs_float k1x = 2.0*M_PI / Lx;
+  const fcs_float k1y = 2.0*M_PI / Ly;
+  const fcs_float k1z = 2.0*M_PI / Lz;
+
+  /* COLLECT THE K-VECTORS */
+  /* Only one k_vec of each pair k_vec, -k_vec is used. rhohat(-k_vec)
+     is the complex conjugate of rhohat(k_vec), so that both contribute
+     the same to the fields and potentials. */
+  fcs_int num_k = 0;
+  fcs_int *k_n = malloc(sizeof(fcs_int) * 3 * (num_k_per_dir*num_k_per_dir*(kmax+1)));
+  fcs_float *k_g = malloc(sizeof(fcs_float) * (num_k_per_dir*num_k_per_dir*(kmax+1)));
+
+  for (fcs_int nz=0; nz <= kmax; nz++)
+  for (fcs_int ny=-kmax; ny <= kmax; ny++)
+  for (fcs_int nx=-kmax; nx <= kmax; nx++) {
+    if (nz == 0 && (ny < 0 || (ny == 0 && nx <= 0))) continue;
+    if (nx*nx + ny*ny + nz*nz > kmax*kmax) continue;
+    k_n[3*num_k] = nx;
+    k_n[3*num_k+1] = ny;
+    k_n[3*num_k+2] = nz;
+    /* fetch influence function (twice for the omitted -k_vec) */
+    k_g[num_k] = 2.0 * d->G[linindex(abs(nx), abs(ny), abs(nz), kmax)];
+    num_k++;
   }
 
-  fcs_float *all_positions, *all_charges, *node_fields, *node_potentials;
-
-  all_positions = malloc(sizeof(fcs_float) * 3 * total_particles);
-  all_charges = malloc(sizeof(fcs_float) * total_particles);
-  node_fields = malloc(sizeof(fcs_float) * 3 * total_particles);
-  node_potentials = malloc(sizeof(fcs_float) * total_particles);
-
-  /* gather all particle data at all nodes */
-  MPI_Allgatherv(positions, num_particles*3, FCS_MPI_FLOAT, all_positions, node_particles3, displs3, FCS_MPI_FLOAT, d->comm);
-  MPI_Allgatherv(charges, num_particles, FCS_MPI_FLOAT, all_charges, node_particles, displs, FCS_MPI_FLOAT, d->comm);
-
-  /* for (fcs_int i=0; i < total_particles; i++) { */
-  /*   printf("%d: all_positions[%d]={%lf, %lf, %lf}\n", d->comm_rank, i, all_positions[i*3], all_positions[3*i+1], all_positions[3*i+2]); */
-  /*   printf("%d: all_charges[%d]=%lf\n", d->comm_rank, i, all_charges[i]); */
-  /* } */
-
-  /* INIT ALGORITHM */
-
-  /* init fields and potentials */
-  if (fields != NULL) {
-    for (fcs_int i=0; i < total_particles; i++) {
-      node_fields[3*i] = 0.0;
-      node_fields[3*i+1] = 0.0;
-      node_fields[3*i+2] = 0.0;
+  /* tables of exp(i*k*x), exp(i*k*y) and exp(i*k*z) of a particle */
+  fcs_float *eik = malloc(sizeof(fcs_float) * 2 * 3 * num_k_per_dir);
+  fcs_float *eikx = eik + 2*kmax;
+  fcs_float *eiky = eikx + 2*num_k_per_dir;
+  fcs_float *eikz = eiky + 2*num_k_per_dir;
+
+  /* reciprocal charge density rhohat (real and imaginary parts) */
+  fcs_float *rhohat = malloc(sizeof(fcs_float) * 2 * num_k);
+  for (fcs_int k=0; k < 2*num_k; k++)
+    rhohat[k] = 0.0;
+
+  /* compute Deserno, Holm (1998) eq. (8) for the local particles */
+  for (fcs_int i=0; i < num_particles; i++) {
+    /* charge q */
+    const fcs_float q = charges[i];
+    if (fcs_float_is_zero(q)) continue;
+
+    ewald_compute_eik(kmax, k1x, positions[3*i], eikx);
+    ewald_compute_eik(kmax, k1y, positions[3*i+1], eiky);
+    ewald_compute_eik(kmax, k1z, positions[3*i+2], eikz);
+
+    for (fcs_int k=0; k < num_k; k++) {
+      const fcs_float *ex = eikx + 2*k_n[3*k];
+      const fcs_float *ey = eiky + 2*k_n[3*k+1];
+      const fcs_float *ez = eikz + 2*k_n[3*k+2];
+      /* exp(i*k_vec*r_vec) = cos(kr) + i*sin(kr) */
+      const fcs_float eyz_re = ey[0]*ez[0] - ey[1]*ez[1];
+      const fcs_float eyz_im = ey[0]*ez[1] + ey[1]*ez[0];
+      const fcs_float coskr = ex[0]*eyz_re - ex[1]*eyz_im;
+      const fcs_float sinkr = ex[0]*eyz_im + ex[1]*eyz_re;
+      /* rhohat = qi * exp(-i*k_vec*r_vec) */
+      rhohat[2*k] += q * coskr;
+      rhohat[2*k+1] -= q * sinkr;
     }
   }
-  if (potentials != NULL)
-    for (fcs_int i=0; i < total_particles; i++)
-      node_potentials[i] = 0.0;
-  
-  /* COMPUTE FAR FIELDS */
 
-  /* evenly distribute the k-vectors onto all tasks */
-  fcs_int num_k_per_dir = 2*d->kmax+1;
-  fcs_int num_k = num_k_per_dir * num_k_per_dir * num_k_per_dir;
-  for (int k_ind = d->comm_rank; k_ind < num_k; k_ind += d->comm_size) {
-    /* compute fields and potentials */
-    fcs_int nx = 
-      k_ind % num_k_per_dir - d->kmax;
-    fcs_int ny = 
-      k_ind % (num_k_per_dir*num_k_per_dir) / num_k_per_dir - d->kmax;
-    fcs_int nz = 
-      k_ind / (num_k_per_dir*num_k_per_dir) - d->kmax;
-    if (nx*nx + ny*ny + nz*nz <= d->kmax*d->kmax) {
-      /* system length vector L_vec */
-      const fcs_float Lx = d->box_l[0];
-      const fcs_float Ly = d->box_l[1];
-      const fcs_float Lz = d->box_l[2];
-      /* reciprocal vector k_vec */
-      const fcs_float kx = 2.0*M_PI*nx / Lx;
-      const fcs_float ky = 2.0*M_PI*ny / Ly;
-      const fcs_float kz = 2.0*M_PI*nz / Lz;
-      /* reciprocal charge density rhohat */
-      fcs_float rhohat_re = 0.0;
-      fcs_float rhohat_im = 0.0;
-      
-      /* compute Deserno, Holm (1998) eq. (8) */
-      for (fcs_int i=0; i < total_particles; i++) {
-        /* charge q */
-        const fcs_float q = all_charges[i];
-        if (!fcs_float_is_zero(q)) {
-          /* particle position r_vec */
-          const fcs_float rx = all_positions[3*i];
-          const fcs_float ry = all_positions[3*i+1];
-          const fcs_float rz = all_positions[3*i+2];
-          /* compute k_vec*r_vec */
-          fcs_float kr = kx*rx + ky*ry + kz*rz;
-          /* rhohat = qi * exp(-i*k_vec*r_vec) */
-          rhohat_re += q * cos(kr);
-          rhohat_im += q * -sin(kr);
-        }
+  /* sum up the contributions of all tasks */
+  MPI_Allreduce(MPI_IN_PLACE, rhohat, 2*num_k, FCS_MPI_FLOAT, MPI_SUM, d->comm);
+
+  /* COMPUTE FAR FIELDS */
+  for (fcs_int i=0; i < num_particles; i++) {
+    fcs_float fx = 0.0, fy = 0.0, fz = 0.0, phi = 0.0;
+
+    ewald_compute_eik(kmax, k1x, positions[3*i], eikx);
+    ewald_compute_eik(kmax, k1y, positions[3*i+1], eiky);
+    ewald_compute_eik(kmax, k1z, positions[3*i+2], eikz);
+
+    for (fcs_int k=0; k < num_k; k++) {
+      const fcs_float *ex = eikx + 2*k_n[3*k];
+      const fcs_float *ey = eiky + 2*k_n[3*k+1];
+      const fcs_float *ez = eikz + 2*k_n[3*k+2];
+      const fcs_float eyz_re = ey[0]*ez[0] - ey[1]*ez[1];
+      const fcs_float eyz_im = ey[0]*ez[1] + ey[1]*ez[0];
+      const fcs_float coskr = ex[0]*eyz_re - ex[1]*eyz_im;
+      const fcs_float sinkr = ex[0]*eyz_im + ex[1]*eyz_re;
+      const fcs_float g = k_g[k];
+
+      if (fields != NULL) {
+        /* compute field at position of particle i
+           compare to Deserno, Holm (1998) eq. (15) */
+        fcs_float fak1 = g * (rhohat[2*k]*sinkr + rhohat[2*k+1]*coskr);
+        fx += k_n[3*k] * fak1;
+        fy += k_n[3*k+1] * fak1;
+        fz += k_n[3*k+2] * fak1;
       }
-      
-/*      FCS_DEBUG(fprintf(stderr, "  n_vec= (%d, %d, %d) rhohat_re=%e rhohat_im=%e\n",
-        nx, ny, nz, rhohat_re, rhohat_im));*/
-      
-      /* fetch influence function */
-      fcs_float g = d->G[linindex(abs(nx), abs(ny), abs(nz), d->kmax)];
-      for (fcs_int i=0; i < total_particles; i++) {
-        /* particle position r_vec */
-        const fcs_float rx = all_positions[3*i];
-        const fcs_float ry = all_positions[3*i+1];
-        const fcs_float rz = all_positions[3*i+2];
-        /* compute k_vec*r_vec */
-        fcs_float kr = kx*rx + ky*ry + kz*rz;
-
-        if (fields != NULL) {
-          /* compute field at position of particle i
-             compare to Deserno, Holm (1998) eq. (15) */
-          fcs_float fak1 = g * (rhohat_re*sin(kr) + rhohat_im*cos(kr));
-          node_fields[3*i] += kx * fak1;
-          node_fields[3*i+1] += ky * fak1;
-          node_fields[3*i+2] += kz * fak1;
-        }
-        if (potentials != NULL) {
-          /* compute potential at position of particle i
-             compare to Deserno, Holm (1998) eq. (9) */
-          node_potentials[i] += g * (rhohat_re*cos(kr) - rhohat_im*sin(kr));
-        }
+      if (potentials != NULL) {
+        /* compute potential at position of particle i
+           compare to Deserno, Holm (1998) eq. (9) */
+        phi += g * (rhohat[2*k]*coskr - rhohat[2*k+1]*sinkr);
       }
     }
-  }
-  
-  /* printf("%d: node_fields[0]=%lf\n", d->comm_rank, node_fields[0]); */
 
-  /* REDISTRIBUTE COMPUTED FAR FIELDS AND POTENTIALS  */
-  if (fields != NULL) {
-    fcs_float all_fields[total_particles*3];
-    for (fcs_int pid=0; pid < total_particles; pid++) {
-      all_fields[3*pid] = 0.0;
-      all_fields[3*pid+1] = 0.0;
-      all_fields[3*pid+2] = 0.0;
+    if (fields != NULL) {
+      fields[3*i] = k1x * fx;
+      fields[3*i+1] = k1y * fy;
+      fields[3*i+2] = k1z * fz;
     }
-
-    /* Combine all fields on master */
-    MPI_Reduce(node_fields, all_fields, total_particles*3, 
-      FCS_MPI_FLOAT, MPI_SUM, 0, d->comm);
-    /* if (d->comm_rank == 0) */
-    /*   printf("%d: all_fields[0]=%lf\n", d->comm_rank, all_fields[0]); */
-    /* Scatter the fields to the task that holds the particle */
-    MPI_Scatterv(all_fields, node_particles3, displs3, FCS_MPI_FLOAT,
-      fields, num_particles*3, FCS_MPI_FLOAT, 0, d->comm);
-  }
-
-  if (potentials != NULL) {
-    fcs_float all_potentials[total_particles];
-    for (fcs_int pid=0; pid < total_particles; pid++)
-      all_potentials[pid] = 0.0;
-    /* Combine all potentials on master */
-    MPI_Reduce(node_potentials, all_potentials, total_particles, 
-      FCS_MPI_FLOAT, MPI_SUM, 0, d->comm);
-    /* Scatter the potentials to the task that holds the particle */
-    MPI_Scatterv(all_potentials, node_particles, displs, FCS_MPI_FLOAT,
-      potentials, num_particles, FCS_MPI_FLOAT, 0, d->comm);
-
-    /* subtract self potential */
-    FCS_INFO(fprintf(stderr, "  subtracting self potential...\n"));
-    for (fcs_int i=0; i < num_particles; i++) {
-      potentials[i] -= charges[i] * M_2_SQRTPI * d->alpha;
+    if (potentials != NULL) {
+      /* subtract self potential */
+      potentials[i] = phi - charges[i] * M_2_SQRTPI * d->alpha;
     }
   }
 
-  free(all_positions);
-  free(all_charges);
-  free(node_fields);
-  free(node_potentials);
+  free(eik);
+  free(rhohat);
+  free(k_n);
+  free(k_g);
 
   /* now each task should have its far field components */
   FCS_INFO(fprintf(stderr, "ewald_compute_kspace finished.\n"));
@@ -340,6 +314,19 @@ ewald_compute_near(const void *param, fcs_float dist, fcs_float *f, fcs_float *p
 /* callback function for performing a whole loop of near field computations (using ewald_compute_near) */
 FCS_NEAR_LOOP_FP(ewald_compute_near_loop, ewald_compute_near)
 
+/* callback function for computing a batch of near field interactions (using ewald_compute_near) */
+FCS_NEAR_BATCH_FP(ewald_compute_near_batch, ewald_compute_near)
+
+/* callback function for near field computations with interpolation tables */
+static inline void
+ewald_compute_near_table(const void *param, fcs_float dist, fcs_float *f, fcs_float *p)
+{
+  fcs_erfc_table_field_potential((const fcs_erfc_table_t *) param, dist, f, p);
+}
+
+/* callback function for computing a batch of near field interactions (using ewald_compute_near_table) */
+FCS_NEAR_BATCH_FP(ewald_compute_near_table_batch, ewald_compute_near_table)
+
 void ewald_compute_rspace(ewald_data_struct* d, 
     fcs_int num_particles,
     fcs_int max_num_particles,
@@ -367,6 +354,8 @@ void ewald_compute_rspace(ewald_data_struct* d,
   fcs_gridsort_set_system(&gridsort, box_base, box_a, box_b, box_c, NULL);
   fcs_gridsort_set_particles(&gridsort, num_particles, max_num_particles,
     positions, charges);
+  fcs_gridsort_set_balance(&gridsort, d->balance, NULL, 0);
+  fcs_gridsort_set_cache(&gridsort, &d->gridsort_cache);
 
   FCS_INFO(fprintf(stderr, "  calling fcs_gridsort_sort_forward()...\n"));
   fcs_gridsort_sort_forward(&gridsort, d->r_cut, d->comm_cart);
@@ -410,7 +399,10 @@ void ewald_compute_rspace(ewald_data_struct* d,
   /* COMPUTE NEAR FIELD */
   fcs_near_t near;
   fcs_near_create(&near);
-  fcs_near_set_loop(&near, ewald_compute_near_loop);
+  if (d->erfc_table.num_nodes > 0)
+    fcs_near_set_field_potential_batch(&near, ewald_compute_near_table_batch);
+  else
+    fcs_near_set_field_potential_batch(&near, ewald_compute_near_batch);
   fcs_near_set_system(&near, box_base, box_a, box_b, box_c, NULL);
 
   fcs_near_set_particles(&near, local_num_real_particles, local_num_real_particles,
@@ -424,7 +416,7 @@ void ewald_compute_rspace(ewald_data_struct* d,
     local_ghost_indices);
 
   FCS_INFO(fprintf(stderr, "  calling fcs_near_compute()...\n"));
-  fcs_near_compute(&near, d->r_cut, &d->alpha, d->comm_cart);
+  fcs_near_compute(&near, d->r_cut, (d->erfc_table.num_nodes > 0) ? (const void *) &d->erfc_table : (const void *) &d->alpha, d->comm_cart);
   FCS_INFO(fprintf(stderr, "  returning from fcs_near_compute().\n"));
   fcs_near_destroy(&near);
 
@@ -22,6 +22,10 @@
 #define __EWALD_H__
 
 
+#include "FCSInterpolate.h"
+#include "common/gridsort/gridsort.h"
+
+
 #define FCS_EWALD_USE_ERFC_APPROXIMATION 0
 
 /* Mathematical constants, from gcc's math.h */
@@ -113,6 +117,18 @@ typedef struct {
   /** Kspace cutoff */
   fcs_int kmax;
 
+  /** Order of the near field interpolation tables (-1: no interpolation) */
+  fcs_int interpolation_order;
+
+  /** Near field interpolation tables */
+  fcs_erfc_table_t erfc_table;
+
+  /** Whether or not the process domains of the near field are load balanced */
+  fcs_int balance;
+
+  /** Gridsort cache to reuse the balanced process domains */
+  fcs_gridsort_cache_t gridsort_cache;
+
   /** maximal Kspace cutoff used by tuning */
   fcs_int maxkmax;
 
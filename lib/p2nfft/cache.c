@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2011-2013 Michael Pippig
+ *
+ * This file is part of ScaFaCoS.
+ *
+ * ScaFaCoS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ScaFaCoS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* On-disk cache of the tuned P2NFFT parameters and the Fourier coefficients of the regularized kernel.
+ * Every entry is stored in its own file that is named by a hash of the key. The key consists of all
+ * quantities the tuning depends on (box, periodicity, number of particles, charge sums, tolerance,
+ * regularization, PNFFT and PFFT options and user defined parameters) and of the process grid, since the Fourier coefficients
+ * are stored in the distribution of the PNFFT plan. All file I/O is done by the master process. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi.h>
+
+#include "cache.h"
+#include "types.h"
+
+#define FCS_P2NFFT_TUNE_CACHE_MAGIC      "P2NFFTC2"
+#define FCS_P2NFFT_TUNE_CACHE_NUM_VALUES 14
+
+
+static void init_key(
+    ifcs_p2nfft_data_struct *d, fcs_int reg_near, fcs_int reg_far, fcs_float sum_q_abs)
+{
+  fcs_float *key = d->tune_cache_key;
+  int k = 0, num_procs;
+
+  MPI_Comm_size(d->cart_comm_pnfft, &num_procs);
+
+  for(int i=0; i<FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH; ++i)
+    key[i] = 0.0;
+
+  key[k++] = sizeof(fcs_float);
+  key[k++] = num_procs;
+  for(int t=0; t<3; ++t) key[k++] = d->np[t];
+  for(int t=0; t<3; ++t) key[k++] = d->box_a[t];
+  for(int t=0; t<3; ++t) key[k++] = d->box_b[t];
+  for(int t=0; t<3; ++t) key[k++] = d->box_c[t];
+  for(int t=0; t<3; ++t) key[k++] = (d->periodicity[t] != 0);
+
+  key[k++] = d->num_nodes;
+  key[k++] = d->sum_q2;
+  key[k++] = sum_q_abs;
+  key[k++] = d->tolerance_type;
+  key[k++] = d->tolerance;
+  key[k++] = reg_near;
+  key[k++] = reg_far;
+  key[k++] = d->reg_kernel;
+  key[k++] = d->interpolation_order;
+  key[k++] = (d->pnfft_flags & PNFFT_INTERLACED) ? 1 : 0;
+  key[k++] = d->pnfft_direct;
+  key[k++] = (d->flags & FCS_P2NFFT_IGNORE_TOLERANCE) ? 1 : 0;
+  key[k++] = d->k_cut;
+
+  /* PNFFT and PFFT options (window, interpolation and all flags) */
+  key[k++] = d->pnfft_window;
+  key[k++] = d->pnfft_interpolation_order;
+  key[k++] = d->pnfft_flags;
+  key[k++] = d->pfft_flags;
+  key[k++] = d->pfft_patience;
+
+  /* user defined parameters, the values of tuned parameters are left out */
+  key[k++] = d->tune_alpha; key[k++] = d->tune_alpha ? 0.0 : d->alpha;
+  key[k++] = d->tune_r_cut; key[k++] = d->tune_r_cut ? 0.0 : d->r_cut;
+  key[k++] = d->tune_epsI;  key[k++] = d->tune_epsI  ? 0.0 : d->epsI;
+  key[k++] = d->tune_epsB;  key[k++] = d->tune_epsB  ? 0.0 : d->epsB;
+  key[k++] = d->tune_c;     key[k++] = d->tune_c     ? 0.0 : d->c;
+  key[k++] = d->tune_p;     key[k++] = d->tune_p     ? 0   : d->p;
+  key[k++] = d->tune_m;     key[k++] = d->tune_m     ? 0   : d->m;
+  key[k++] = d->tune_N;
+  for(int t=0; t<3; ++t) key[k++] = d->tune_N ? 0 : d->N[t];
+  key[k++] = d->tune_n;
+  for(int t=0; t<3; ++t) key[k++] = d->tune_n ? 0 : d->n[t];
+}
+
+static void get_values(
+    const ifcs_p2nfft_data_struct *d, fcs_float *values)
+{
+  int k = 0;
+
+  values[k++] = d->alpha;
+  values[k++] = d->r_cut;
+  values[k++] = d->epsI;
+  values[k++] = d->epsB;
+  values[k++] = d->log2epsI;
+  values[k++] = d->c;
+  values[k++] = d->p;
+  values[k++] = d->m;
+  for(int t=0; t<3; ++t) values[k++] = d->N[t];
+  for(int t=0; t<3; ++t) values[k++] = d->n[t];
+}
+
+static void set_values(
+    ifcs_p2nfft_data_struct *d, const fcs_float *values)
+{
+  int k = 0;
+
+  d->alpha    = values[k++];
+  d->r_cut    = values[k++];
+  d->epsI     = values[k++];
+  d->epsB     = values[k++];
+  d->log2epsI = (fcs_int) values[k++];
+  d->c        = values[k++];
+  d->p        = (fcs_int) values[k++];
+  d->m        = (fcs_int) values[k++];
+  for(int t=0; t<3; ++t) d->N[t] = (ptrdiff_t) values[k++];
+  for(int t=0; t<3; ++t) d->n[t] = (ptrdiff_t) values[k++];
+}
+
+static void get_filename(
+    const fcs_float *key, char *filename, size_t length)
+{
+  /* FNV-1a hash of the key */
+  const unsigned char *c = (const unsigned char *) key;
+  unsigned long long hash = 14695981039346656037ULL;
+
+  for(size_t i=0; i<sizeof(fcs_float) * FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH; ++i){
+    hash ^= c[i];
+    hash *= 1099511628211ULL;
+  }
+
+  snprintf(filename, length, "p2nfft-tune-%016llx.dat", hash);
+}
+
+static ptrdiff_t get_local_count(
+    const ifcs_p2nfft_data_struct *d)
+{
+  return d->local_N[0] * d->local_N[1] * d->local_N[2];
+}
+
+/* open the cache file that belongs to the key and read the tuned parameters,
+ * returns NULL if there is no valid entry for the key */
+static FILE* open_entry(
+    const fcs_float *key, fcs_float *values)
+{
+  char filename[64], magic[8];
+  fcs_float file_key[FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH];
+  FILE *f;
+
+  get_filename(key, filename, sizeof(filename));
+
+  f = fopen(filename, "rb");
+  if(f == NULL)
+    return NULL;
+
+  if(   fread(magic, 1, sizeof(magic), f) != sizeof(magic)
+     || memcmp(magic, FCS_P2NFFT_TUNE_CACHE_MAGIC, sizeof(magic)) != 0
+     || fread(file_key, sizeof(fcs_float), FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH, f) != FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH
+     || memcmp(file_key, key, sizeof(file_key)) != 0
+     || fread(values, sizeof(fcs_float), FCS_P2NFFT_TUNE_CACHE_NUM_VALUES, f) != FCS_P2NFFT_TUNE_CACHE_NUM_VALUES)
+  {
+    fclose(f);
+    return NULL;
+  }
+
+  return f;
+}
+
+
+/* Look up the current tuning in the cache. On success, the tuned parameters are set
+ * and the tuning flags are switched off (saving the previous values), so that the
+ * tuning only derives the dependent values without any accuracy estimates. */
+fcs_int ifcs_p2nfft_tune_cache_load_parameters(
+    ifcs_p2nfft_data_struct *d, fcs_int reg_near, fcs_int reg_far, fcs_float sum_q_abs,
+    ifcs_p2nfft_tune_cache_saved_t *saved)
+{
+  int myrank;
+  fcs_int hit = 0;
+  fcs_float values[FCS_P2NFFT_TUNE_CACHE_NUM_VALUES];
+
+  MPI_Comm_rank(d->cart_comm_pnfft, &myrank);
+
+  init_key(d, reg_near, reg_far, sum_q_abs);
+
+  if(myrank == 0){
+    FILE *f = open_entry(d->tune_cache_key, values);
+    if(f != NULL){
+      hit = 1;
+      fclose(f);
+    }
+  }
+
+  MPI_Bcast(&hit, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+  if(!hit)
+    return 0;
+
+  MPI_Bcast(values, FCS_P2NFFT_TUNE_CACHE_NUM_VALUES, FCS_MPI_FLOAT, 0, d->cart_comm_pnfft);
+
+  saved->tune_alpha = d->tune_alpha;
+  saved->tune_r_cut = d->tune_r_cut;
+  saved->tune_epsI  = d->tune_epsI;
+  saved->tune_epsB  = d->tune_epsB;
+  saved->tune_N     = d->tune_N;
+  saved->tune_n     = d->tune_n;
+  saved->tune_m     = d->tune_m;
+  saved->tune_p     = d->tune_p;
+  saved->tune_c     = d->tune_c;
+  saved->flags      = d->flags;
+
+  d->tune_alpha = d->tune_r_cut = d->tune_epsI = d->tune_epsB = 0;
+  d->tune_N = d->tune_n = d->tune_m = d->tune_p = d->tune_c = 0;
+
+  /* the accuracy has already been checked when the entry was stored */
+  d->flags |= FCS_P2NFFT_IGNORE_TOLERANCE;
+
+  set_values(d, values);
+
+#if FCS_ENABLE_INFO
+  if(myrank == 0){
+    char filename[64];
+    get_filename(d->tune_cache_key, filename, sizeof(filename));
+    printf("P2NFFT_INFO: Restored tuned parameters from tuning cache '%s'.\n", filename);
+  }
+#endif
+
+  return 1;
+}
+
+void ifcs_p2nfft_tune_cache_restore_flags(
+    ifcs_p2nfft_data_struct *d, const ifcs_p2nfft_tune_cache_saved_t *saved)
+{
+  d->tune_alpha = saved->tune_alpha;
+  d->tune_r_cut = saved->tune_r_cut;
+  d->tune_epsI  = saved->tune_epsI;
+  d->tune_epsB  = saved->tune_epsB;
+  d->tune_N     = saved->tune_N;
+  d->tune_n     = saved->tune_n;
+  d->tune_m     = saved->tune_m;
+  d->tune_p     = saved->tune_p;
+  d->tune_c     = saved->tune_c;
+  d->flags      = saved->flags;
+}
+
+/* Read the Fourier coefficients of the regularized kernel for the current key.
+ * Returns 1 on all processes if the coefficients have been loaded, 0 otherwise. */
+fcs_int ifcs_p2nfft_tune_cache_load_regkern_hat(
+    ifcs_p2nfft_data_struct *d, fcs_pnfft_complex **regkern_hat)
+{
+  int myrank, num_procs;
+  fcs_int ok = 1, local_count = get_local_count(d), count = 0;
+  fcs_int *counts = NULL;
+  fcs_float values[FCS_P2NFFT_TUNE_CACHE_NUM_VALUES];
+  fcs_pnfft_complex *data;
+  FILE *f = NULL;
+
+  MPI_Comm_rank(d->cart_comm_pnfft, &myrank);
+  MPI_Comm_size(d->cart_comm_pnfft, &num_procs);
+
+  if(myrank == 0){
+    fcs_int file_num_procs = 0;
+    counts = malloc(sizeof(fcs_int) * num_procs);
+
+    f = open_entry(d->tune_cache_key, values);
+    ok = (f != NULL)
+      && (fread(&file_num_procs, sizeof(fcs_int), 1, f) == 1)
+      && (file_num_procs == num_procs)
+      && (fread(counts, sizeof(fcs_int), num_procs, f) == (size_t) num_procs);
+  }
+
+  /* check that the stored distribution matches the current one */
+  MPI_Bcast(&ok, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+  if(ok){
+    MPI_Scatter(counts, 1, FCS_MPI_INT, &count, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+    ok = (count == local_count);
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, FCS_MPI_INT, MPI_MIN, d->cart_comm_pnfft);
+  }
+
+  if(!ok){
+    if(f != NULL) fclose(f);
+    free(counts);
+    return 0;
+  }
+
+  data = FCS_PFFT(alloc_complex)(local_count > 0 ? local_count : 1);
+
+  if(myrank == 0){
+    fcs_int max_count = 0;
+    fcs_pnfft_complex *buffer;
+
+    ok = (fread(data, sizeof(fcs_pnfft_complex), local_count, f) == (size_t) local_count);
+
+    for(int r=1; r<num_procs; ++r)
+      if(counts[r] > max_count) max_count = counts[r];
+    buffer = malloc(sizeof(fcs_pnfft_complex) * (max_count > 0 ? max_count : 1));
+
+    /* send the data of the other processes one after another, unreadable data is rejected below */
+    for(int r=1; r<num_procs; ++r){
+      ok = ok && (fread(buffer, sizeof(fcs_pnfft_complex), counts[r], f) == (size_t) counts[r]);
+      MPI_Send(buffer, 2 * counts[r], FCS_MPI_FLOAT, r, 0, d->cart_comm_pnfft);
+    }
+
+    free(buffer);
+    fclose(f);
+  } else
+    MPI_Recv(data, 2 * local_count, FCS_MPI_FLOAT, 0, 0, d->cart_comm_pnfft, MPI_STATUS_IGNORE);
+
+  free(counts);
+
+  MPI_Bcast(&ok, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+  if(!ok){
+    FCS_PFFT(free)(data);
+    return 0;
+  }
+
+  *regkern_hat = data;
+  return 1;
+}
+
+/* Write the tuned parameters and the Fourier coefficients of the regularized kernel for the current key.
+ * The entry is written to a temporary file first, so that other jobs never read incomplete entries. */
+void ifcs_p2nfft_tune_cache_store(
+    ifcs_p2nfft_data_struct *d)
+{
+  int myrank, num_procs;
+  fcs_int ok = 1, local_count = get_local_count(d), nprocs;
+  fcs_int *counts = NULL;
+  fcs_float values[FCS_P2NFFT_TUNE_CACHE_NUM_VALUES];
+  char filename[64], tmp_filename[80];
+  FILE *f = NULL;
+
+  MPI_Comm_rank(d->cart_comm_pnfft, &myrank);
+  MPI_Comm_size(d->cart_comm_pnfft, &num_procs);
+
+  if(myrank == 0)
+    counts = malloc(sizeof(fcs_int) * num_procs);
+  MPI_Gather(&local_count, 1, FCS_MPI_INT, counts, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+
+  if(myrank == 0){
+    get_filename(d->tune_cache_key, filename, sizeof(filename));
+    snprintf(tmp_filename, sizeof(tmp_filename), "%s.tmp", filename);
+    get_values(d, values);
+    nprocs = num_procs;
+
+    f = fopen(tmp_filename, "wb");
+    ok = (f != NULL)
+      && (fwrite(FCS_P2NFFT_TUNE_CACHE_MAGIC, 1, 8, f) == 8)
+      && (fwrite(d->tune_cache_key, sizeof(fcs_float), FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH, f) == FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH)
+      && (fwrite(values, sizeof(fcs_float), FCS_P2NFFT_TUNE_CACHE_NUM_VALUES, f) == FCS_P2NFFT_TUNE_CACHE_NUM_VALUES)
+      && (fwrite(&nprocs, sizeof(fcs_int), 1, f) == 1)
+      && (fwrite(counts, sizeof(fcs_int), num_procs, f) == (size_t) num_procs);
+  }
+
+  MPI_Bcast(&ok, 1, FCS_MPI_INT, 0, d->cart_comm_pnfft);
+  if(!ok){
+    if(f != NULL){
+      fclose(f);
+      remove(tmp_filename);
+    }
+    free(counts);
+    return;
+  }
+
+  if(myrank == 0){
+    fcs_int max_count = 0;
+    fcs_pnfft_complex *buffer;
+
+    ok = (fwrite(d->regkern_hat, sizeof(fcs_pnfft_complex), local_count, f) == (size_t) local_count);
+
+    for(int r=1; r<num_procs; ++r)
+      if(counts[r] > max_count) max_count = counts[r];
+    buffer = malloc(sizeof(fcs_pnfft_complex) * (max_count > 0 ? max_count : 1));
+
+    /* receive the data of the other processes one after another */
+    for(int r=1; r<num_procs; ++r){
+      MPI_Recv(buffer, 2 * counts[r], FCS_MPI_FLOAT, r, 0, d->cart_comm_pnfft, MPI_STATUS_IGNORE);
+      ok = ok && (fwrite(buffer, sizeof(fcs_pnfft_complex), counts[r], f) == (size_t) counts[r]);
+    }
+
+    free(buffer);
+
+    if(fclose(f) != 0) ok = 0;
+    if(ok) ok = (rename(tmp_filename, filename) == 0);
+    if(!ok) remove(tmp_filename);
+
+#if FCS_ENABLE_INFO
+    if(ok) printf("P2NFFT_INFO: Stored tuned parameters in tuning cache '%s'.\n", filename);
+#endif
+  } else
+    MPI_Send(d->regkern_hat, 2 * local_count, FCS_MPI_FLOAT, 0, 0, d->cart_comm_pnfft);
+
+  free(counts);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2011-2013 Michael Pippig
+ *
+ * This file is part of ScaFaCoS.
+ *
+ * ScaFaCoS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ScaFaCoS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _P2NFFT_CACHE_H
+#define _P2NFFT_CACHE_H
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "types.h"
+
+/* tuning flags and P2NFFT flags that are overwritten while a cached tuning is restored */
+typedef struct {
+  fcs_int tune_alpha, tune_r_cut, tune_epsI, tune_epsB;
+  fcs_int tune_N, tune_n, tune_m, tune_p, tune_c;
+  unsigned flags;
+} ifcs_p2nfft_tune_cache_saved_t;
+
+fcs_int ifcs_p2nfft_tune_cache_load_parameters(
+    ifcs_p2nfft_data_struct *d, fcs_int reg_near, fcs_int reg_far, fcs_float sum_q_abs,
+    ifcs_p2nfft_tune_cache_saved_t *saved);
+void ifcs_p2nfft_tune_cache_restore_flags(
+    ifcs_p2nfft_data_struct *d, const ifcs_p2nfft_tune_cache_saved_t *saved);
+fcs_int ifcs_p2nfft_tune_cache_load_regkern_hat(
+    ifcs_p2nfft_data_struct *d, fcs_pnfft_complex **regkern_hat);
+void ifcs_p2nfft_tune_cache_store(
+    ifcs_p2nfft_data_struct *d);
+
+#endif
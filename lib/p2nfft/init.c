@@ -179,6 +179,10 @@ FCSResult ifcs_p2nfft_init(
   d->gridsort_resort = FCS_GRIDSORT_RESORT_NULL;
   d->gridsort_cache = FCS_GRIDSORT_CACHE_NULL;
 
+  /* init persistent PNFFT nodes */
+  d->pnfft_nodes_capacity = -1;
+  d->pnfft_nodes_malloc_flags = 0;
+
   *rd = d;
 
   return NULL;
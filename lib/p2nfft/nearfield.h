@@ -28,7 +28,7 @@
 #include "FCSCommon.h"
 #include "constants.h"
 #include "regularization.h"
-#include "interpolation.h"
+#include "FCSInterpolate.h"
 
 
 typedef struct {
@@ -151,7 +151,7 @@ ifcs_p2nfft_compute_near_potential_interpolation(
 {
   ifcs_p2nfft_near_params *d = (ifcs_p2nfft_near_params*) param;
 
-  return 1.0/dist - ifcs_p2nfft_interpolation_near(
+  return 1.0/dist - fcs_interpolation_near(
       dist, d->one_over_r_cut,
       d->interpolation_order, d->interpolation_num_nodes,
       d->near_interpolation_table_potential);
@@ -165,7 +165,7 @@ ifcs_p2nfft_compute_near_field_interpolation(
   ifcs_p2nfft_near_params *d = (ifcs_p2nfft_near_params*) param;
   fcs_float inv_dist = 1.0/dist;
 
-  return -inv_dist*inv_dist - ifcs_p2nfft_interpolation_near(
+  return -inv_dist*inv_dist - fcs_interpolation_near(
         dist, d->one_over_r_cut,
         d->interpolation_order, d->interpolation_num_nodes,
         d->near_interpolation_table_force);
@@ -180,11 +180,11 @@ ifcs_p2nfft_compute_near_interpolation(
   ifcs_p2nfft_near_params *d = (ifcs_p2nfft_near_params*) param;
   fcs_float inv_dist = 1.0/dist;
 
-  *p = inv_dist - ifcs_p2nfft_interpolation_near(
+  *p = inv_dist - fcs_interpolation_near(
       dist, d->one_over_r_cut,
       d->interpolation_order, d->interpolation_num_nodes,
       d->near_interpolation_table_potential);
-  *f = -inv_dist*inv_dist - ifcs_p2nfft_interpolation_near(
+  *f = -inv_dist*inv_dist - fcs_interpolation_near(
         dist, d->one_over_r_cut,
         d->interpolation_order, d->interpolation_num_nodes,
         d->near_interpolation_table_force);
@@ -200,10 +200,10 @@ ifcs_p2nfft_compute_near_interpolation(
   { \
     ifcs_p2nfft_near_params *d = (ifcs_p2nfft_near_params*) param; \
     fcs_float inv_dist = 1.0/dist; \
-    *p = inv_dist - ifcs_p2nfft_intpol_even_ ## _suffix_( \
+    *p = inv_dist - fcs_intpol_even_ ## _suffix_( \
         dist, d->near_interpolation_table_potential, \
         d->interpolation_num_nodes, d->one_over_r_cut); \
-    *f = -inv_dist*inv_dist - ifcs_p2nfft_intpol_even_ ## _suffix_( \
+    *f = -inv_dist*inv_dist - fcs_intpol_even_ ## _suffix_( \
         dist, d->near_interpolation_table_force, \
         d->interpolation_num_nodes, d->one_over_r_cut); \
   }
@@ -29,7 +29,7 @@
 #include "types.h"
 #include "utils.h"
 #include "nearfield.h"
-#include "interpolation.h"
+#include "FCSInterpolate.h"
 #include <common/near/near.h>
 //#include "constants.h"
 
@@ -269,14 +269,22 @@ FCSResult ifcs_p2nfft_run(
     if (myrank == 0) fprintf(stderr, "E_NEAR(0) = %" FCS_LMOD_FLOAT "e\n", sorted_field[0]);
 #endif
       
-  /* Reinit PNFFT corresponding to number of sorted nodes */
+  /* Reinit PNFFT nodes only if the number of sorted nodes exceeds the allocated nodes, if the padding exceeds
+   * the headroom of 10% or if different arrays are needed, otherwise keep the nodes of the last run */
   unsigned pnfft_malloc_flags = PNFFT_MALLOC_X | PNFFT_MALLOC_F;
   if(compute_field)
     pnfft_malloc_flags |= PNFFT_MALLOC_GRAD_F;
 
-  FCS_PNFFT(init_nodes)(d->pnfft, sorted_num_particles,
-      pnfft_malloc_flags,
-      PNFFT_FREE_X|   PNFFT_FREE_F|   PNFFT_FREE_GRAD_F);
+  if(d->pnfft_nodes_capacity < sorted_num_particles || d->pnfft_nodes_capacity > sorted_num_particles + sorted_num_particles / 10
+      || d->pnfft_nodes_malloc_flags != pnfft_malloc_flags)
+  {
+    d->pnfft_nodes_capacity = sorted_num_particles + sorted_num_particles / 10;
+    d->pnfft_nodes_malloc_flags = pnfft_malloc_flags;
+
+    FCS_PNFFT(init_nodes)(d->pnfft, d->pnfft_nodes_capacity,
+        pnfft_malloc_flags,
+        PNFFT_FREE_X|   PNFFT_FREE_F|   PNFFT_FREE_GRAD_F);
+  }
 
   fcs_pnfft_complex *f_hat, *f, *grad_f;
   fcs_float *x;
@@ -311,7 +319,7 @@ FCSResult ifcs_p2nfft_run(
 //   fprintf(stderr, "myrank = %d, sorted_num_particles = %d\n", myrank, sorted_num_particles);
 // #endif
   
-  /* Set NFFT nodes within [-0.5,0.5]^3 */
+  /* Set NFFT nodes within [-0.5,0.5]^3 and NFFT values */
   for (fcs_int j = 0; j < sorted_num_particles; ++j)
   {
     fcs_float pos[3];
@@ -323,10 +331,18 @@ FCSResult ifcs_p2nfft_run(
     x[3 * j + 0] = ( XYZ2TRI(0, pos, d->box_inv) - 0.5 ) / d->box_expand[0];
     x[3 * j + 1] = ( XYZ2TRI(1, pos, d->box_inv) - 0.5 ) / d->box_expand[1];
     x[3 * j + 2] = ( XYZ2TRI(2, pos, d->box_inv) - 0.5 ) / d->box_expand[2];
+
+    f[j] = sorted_charges[j];
+  }
+
+  /* Pad the unused nodes with a valid node and zero charge (their results are ignored) */
+  for (fcs_int j = sorted_num_particles; j < d->pnfft_nodes_capacity; ++j)
+  {
+    x[3 * j + 0] = (sorted_num_particles > 0) ? x[0] : 0.0;
+    x[3 * j + 1] = (sorted_num_particles > 0) ? x[1] : 0.0;
+    x[3 * j + 2] = (sorted_num_particles > 0) ? x[2] : 0.0;
+    f[j] = 0;
   }
-    
-  /* Set NFFT values */
-  for (fcs_int j = 0; j < sorted_num_particles; ++j) f[j] = sorted_charges[j];
 
 // #if FCS_ENABLE_INFO
 //   fcs_float min[3], max[3], gmin[3], gmax[3];
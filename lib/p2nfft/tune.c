@@ -28,13 +28,14 @@
 
 #include "tune.h"
 #include "types.h"
+#include "cache.h"
 #include "utils.h"
 #include "constants.h"
 #include "FCSCommon.h"
 
 #include "kernels.h"
 #include "regularization.h"
-#include "interpolation.h"
+#include "FCSInterpolate.h"
 #include "taylor2p.h"
 #include "cg_cos_coeff.h"
 #include "cg_cos_err.h"
@@ -62,15 +63,6 @@
 /* FORWARD DECLARATIONS OF STATIC FUNCTIONS */
 static void print_command_line_arguments(
     ifcs_p2nfft_data_struct *d, fcs_int verbose);
-static void init_near_interpolation_table_potential_3dp(
-    fcs_int num_nodes,
-    fcs_float r_cut, fcs_float alpha,
-    fcs_float *table);
-static void init_near_interpolation_table_force_3dp(
-    fcs_int num_nodes,
-    fcs_float r_cut, fcs_float alpha,
-    fcs_float *table);
-
 static void init_near_interpolation_table_potential_0dp(
     fcs_int num_nodes,
     fcs_float r_cut, fcs_float epsI, fcs_int p,
@@ -111,7 +103,7 @@ static fcs_float evaluate_sin_polynomial_1d(
 static int get_dim_of_smallest_periodic_box_l(
     fcs_int periodicity[3], fcs_float box_l[3]);
 
-static void init_pnfft(
+static int init_pnfft(
     FCS_PNFFT(plan) *ths, int dim, const ptrdiff_t *N, const ptrdiff_t *n,
     const fcs_float *x_max, int m,
     unsigned pnfft_flags, fcs_int pnfft_intpol_order, fcs_int pnfft_window,
@@ -376,6 +368,8 @@ FCSResult ifcs_p2nfft_tune(
   fcs_int i, num_particles;
   fcs_float sum_q, sum_q2, sum_q4, sum_q_abs, avg_dist, error=0;
   fcs_float box_l[3]; /* TODO: deprecated parameter  */
+  fcs_int tune_cache_hit = 0;
+  ifcs_p2nfft_tune_cache_saved_t tune_cache_saved;
   FCSResult result;
 
 #if FCS_P2NFFT_DEBUG_RETUNE
@@ -581,6 +575,11 @@ FCSResult ifcs_p2nfft_tune(
         if(d->epsI + d->epsB >= 0.5)
           return fcs_result_create(FCS_ERROR_WRONG_ARGUMENT, fnc_name, "Sum of epsI and epsB must be less than 0.5.");
 
+    /* restore the tuned parameters from the on-disk tuning cache,
+     * the following tuning then only derives the dependent values */
+    if(d->flags & FCS_P2NFFT_TUNE_CACHE)
+      tune_cache_hit = ifcs_p2nfft_tune_cache_load_parameters(d, reg_near, reg_far, sum_q_abs, &tune_cache_saved);
+
     /* At this point we choose default value 7. */
     if(d->tune_p)
       d->p = 8;
@@ -706,7 +705,7 @@ FCSResult ifcs_p2nfft_tune(
 
       if(!comm_rank)
         printf("P2NFFT_INFO: P2NFFT: k space error via new error estimate: %e, m = %d\n", 
-            p2nfft_k_space_error_general_window(d->sum_qpart, d->sum_q2, d->box_l, d->N, d->alpha, (cao+1)/2, d->pnfft_window_flag, d->cart_comm_3d), (cao+1)/2);
+            p2nfft_k_space_error_general_window(d->sum_qpart, d->sum_q2, d->box_l, d->N, d->alpha, (cao+1)/2, d->pnfft_window, d->cart_comm_3d), (cao+1)/2);
 #endif
 
       /* P3M tuning works with cao==2*m */
@@ -786,13 +785,13 @@ FCSResult ifcs_p2nfft_tune(
 
       if(d->near_interpolation_num_nodes){
         d->near_interpolation_table_potential = (fcs_float*) malloc(sizeof(fcs_float) * (d->near_interpolation_num_nodes+3));
-        init_near_interpolation_table_potential_3dp(
+        fcs_interpolation_table_erf_potential(
             d->near_interpolation_num_nodes,
             d->r_cut, d->alpha, 
             d->near_interpolation_table_potential);
 
         d->near_interpolation_table_force = (fcs_float*) malloc(sizeof(fcs_float) * (d->near_interpolation_num_nodes+3));
-        init_near_interpolation_table_force_3dp(
+        fcs_interpolation_table_erf_field(
             d->near_interpolation_num_nodes,
             d->r_cut, d->alpha,
             d->near_interpolation_table_force);
@@ -1175,6 +1174,9 @@ FCSResult ifcs_p2nfft_tune(
       d->lower_border[t] += 0.5 / d->box_expand[t];
       d->upper_border[t] += 0.5 / d->box_expand[t];
     }
+
+    if(tune_cache_hit)
+      ifcs_p2nfft_tune_cache_restore_flags(d, &tune_cache_saved);
   }
   /* Finish timing of parameter tuning */
   FCS_P2NFFT_FINISH_TIMING(d->cart_comm_3d, "Parameter tuning");
@@ -1182,43 +1184,63 @@ FCSResult ifcs_p2nfft_tune(
   /* Start timing of precomputation */
   FCS_P2NFFT_START_TIMING(d->cart_comm_3d);
   if (d->needs_retune) {
-    /* precompute Fourier coefficients for convolution */
-    if (d->num_periodic_dims == 3)
-      d->regkern_hat = malloc_and_precompute_regkern_hat_3dp(
-          d->local_N, d->local_N_start, d->box_inv, d->alpha, d->k_cut);
-    if (d->num_periodic_dims == 2)
-      d->regkern_hat = malloc_and_precompute_regkern_hat_2dp_and_1dp(
-          d->N, d->epsB, d->box_a, d->box_b, d->box_c, d->box_inv, d->box_scales, d->alpha, d->k_cut, d->periodicity, d->p, d->c, reg_far,
-          d->interpolation_order, d->far_interpolation_num_nodes, d->far_interpolation_table_potential,
-          d->cart_comm_pnfft);
-    if (d->num_periodic_dims == 1)
-      d->regkern_hat = malloc_and_precompute_regkern_hat_2dp_and_1dp(
-          d->N, d->epsB, d->box_a, d->box_b, d->box_c, d->box_inv, d->box_scales, d->alpha, d->k_cut, d->periodicity, d->p, d->c, reg_far,
-          d->interpolation_order, d->far_interpolation_num_nodes, d->far_interpolation_table_potential,
-          d->cart_comm_pnfft);
-      /* malloc_and_precompute_regkern_hat_1dp */
-    if (d->num_periodic_dims == 0) {
-      if (d->reg_kernel == FCS_P2NFFT_REG_KERNEL_EWALD) {
-        d->regkern_hat = malloc_and_precompute_regkern_hat_0dp_ewald(
-            d->N, d->epsB, d->box_scales, d->alpha, d->p, d->c, reg_far,
+    /* free the Fourier coefficients of the last tuning */
+    if(d->regkern_hat != NULL){
+      FCS_PFFT(free)(d->regkern_hat);
+      d->regkern_hat = NULL;
+    }
+
+    /* load the Fourier coefficients from the tuning cache */
+    fcs_int regkern_hat_cached = 0;
+    if(tune_cache_hit)
+      regkern_hat_cached = ifcs_p2nfft_tune_cache_load_regkern_hat(d, &d->regkern_hat);
+
+    if(!regkern_hat_cached){
+      /* precompute Fourier coefficients for convolution */
+      if (d->num_periodic_dims == 3)
+        d->regkern_hat = malloc_and_precompute_regkern_hat_3dp(
+            d->local_N, d->local_N_start, d->box_inv, d->alpha, d->k_cut);
+      if (d->num_periodic_dims == 2)
+        d->regkern_hat = malloc_and_precompute_regkern_hat_2dp_and_1dp(
+            d->N, d->epsB, d->box_a, d->box_b, d->box_c, d->box_inv, d->box_scales, d->alpha, d->k_cut, d->periodicity, d->p, d->c, reg_far,
+            d->interpolation_order, d->far_interpolation_num_nodes, d->far_interpolation_table_potential,
+            d->cart_comm_pnfft);
+      if (d->num_periodic_dims == 1)
+        d->regkern_hat = malloc_and_precompute_regkern_hat_2dp_and_1dp(
+            d->N, d->epsB, d->box_a, d->box_b, d->box_c, d->box_inv, d->box_scales, d->alpha, d->k_cut, d->periodicity, d->p, d->c, reg_far,
             d->interpolation_order, d->far_interpolation_num_nodes, d->far_interpolation_table_potential,
-            d->cart_comm_pnfft, is_cubic(d->box_l));
-      } else if (d->reg_kernel == FCS_P2NFFT_REG_KERNEL_OTHER) {
-        d->regkern_hat = malloc_and_precompute_regkern_hat_0dp(
-            d->N, d->r_cut, d->epsI, d->epsB, d->p, d->c, d->box_scales, reg_near, reg_far,
-            d->taylor2p_coeff, d->N_cg_cos, d->cg_cos_coeff,
-            d->interpolation_order, d->near_interpolation_num_nodes, d->far_interpolation_num_nodes,
-            d->near_interpolation_table_potential, d->far_interpolation_table_potential,
-            d->cart_comm_pnfft, is_cubic(d->box_l));
+            d->cart_comm_pnfft);
+        /* malloc_and_precompute_regkern_hat_1dp */
+      if (d->num_periodic_dims == 0) {
+        if (d->reg_kernel == FCS_P2NFFT_REG_KERNEL_EWALD) {
+          d->regkern_hat = malloc_and_precompute_regkern_hat_0dp_ewald(
+              d->N, d->epsB, d->box_scales, d->alpha, d->p, d->c, reg_far,
+              d->interpolation_order, d->far_interpolation_num_nodes, d->far_interpolation_table_potential,
+              d->cart_comm_pnfft, is_cubic(d->box_l));
+        } else if (d->reg_kernel == FCS_P2NFFT_REG_KERNEL_OTHER) {
+          d->regkern_hat = malloc_and_precompute_regkern_hat_0dp(
+              d->N, d->r_cut, d->epsI, d->epsB, d->p, d->c, d->box_scales, reg_near, reg_far,
+              d->taylor2p_coeff, d->N_cg_cos, d->cg_cos_coeff,
+              d->interpolation_order, d->near_interpolation_num_nodes, d->far_interpolation_num_nodes,
+              d->near_interpolation_table_potential, d->far_interpolation_table_potential,
+              d->cart_comm_pnfft, is_cubic(d->box_l));
+        }
       }
+
+      /* store the tuned parameters and Fourier coefficients in the tuning cache */
+      if(d->flags & FCS_P2NFFT_TUNE_CACHE)
+        ifcs_p2nfft_tune_cache_store(d);
     }
   }
   /* Finish timing of of precomputation */
   FCS_P2NFFT_FINISH_TIMING(d->cart_comm_3d, "Precomputation of regularization");
 
-  /* Initialize the plan for the PNFFT */
-  init_pnfft(&d->pnfft, 3, d->N, d->n, d->x_max, d->m, d->pnfft_flags, d->pnfft_interpolation_order, d->pnfft_window,
-      d->pfft_flags, d->pfft_patience, d->cart_comm_pnfft);
+  /* Initialize the plan for the PNFFT, a new plan has no nodes */
+  if(init_pnfft(&d->pnfft, 3, d->N, d->n, d->x_max, d->m, d->pnfft_flags, d->pnfft_interpolation_order, d->pnfft_window,
+      d->pfft_flags, d->pfft_patience, d->cart_comm_pnfft))
+  {
+    d->pnfft_nodes_capacity = -1;
+  }
 
   if(d->tune_b)
     FCS_PNFFT(get_b)(d->pnfft, &d->b[0], &d->b[1], &d->b[2]);
@@ -1352,6 +1374,8 @@ static void print_command_line_arguments(
       printf("p2nfft_p,%" FCS_LMOD_INT "d,", d->p);
     if(verbose || (d->flags & FCS_P2NFFT_IGNORE_TOLERANCE) )
       printf("p2nfft_ignore_tolerance,%d,", (d->flags & FCS_P2NFFT_IGNORE_TOLERANCE) ? 1 : 0);
+    if(verbose || (d->flags & FCS_P2NFFT_TUNE_CACHE) )
+      printf("p2nfft_tune_cache,%d,", (d->flags & FCS_P2NFFT_TUNE_CACHE) ? 1 : 0);
     if(verbose || (d->virial != NULL) )
       printf("p2nfft_require_virial,%d,", (d->virial != NULL) ? 1 : 0);
 
@@ -1417,23 +1441,6 @@ static void print_command_line_arguments(
   }
 }
 
-static void init_near_interpolation_table_potential_3dp(
-    fcs_int num_nodes,
-    fcs_float r_cut, fcs_float alpha,
-    fcs_float *table
-    )
-{
-  fcs_float r;
-
-  for(fcs_int k=0; k<num_nodes+3; k++){
-    r = r_cut * (fcs_float) k / num_nodes;
-    if (fcs_float_is_zero(r))
-      table[k] = 2 * alpha * FCS_P2NFFT_1_SQRTPI;
-    else
-      table[k] = erf(alpha * r)/r;
-  }
-}
-
 static void init_near_interpolation_table_potential_0dp(
     fcs_int num_nodes,
     fcs_float r_cut, fcs_float epsI, fcs_int p,
@@ -1587,25 +1594,6 @@ static void init_far_interpolation_table_potential_1dp(
   }
 }
 
-static void init_near_interpolation_table_force_3dp(
-    fcs_int num_nodes,
-    fcs_float r_cut, fcs_float alpha,
-    fcs_float *table
-    )
-{
-  fcs_float r;
-
-  for(fcs_int k=0; k<num_nodes+3; k++){
-    r = r_cut * (fcs_float) k / num_nodes;
-    if (fcs_float_is_zero(r))
-      table[k] = 0;
-    else
-      table[k] = (-erf(alpha * r)/r
-          + 2.0*alpha*FCS_P2NFFT_1_SQRTPI * fcs_exp(- alpha*alpha * r*r)
-        ) / r;
-  }
-}
-
 static void init_near_interpolation_table_force_0dp(
     fcs_int num_nodes,
     fcs_float r_cut, fcs_float epsI, fcs_int p,
@@ -1731,7 +1719,8 @@ static fcs_int calc_interpolation_num_nodes_erf(
   return (fcs_int) fcs_ceil(N);
 }
 
-static void init_pnfft(
+/* returns 1 if the plan has been (re)created, 0 if it was already up to date */
+static int init_pnfft(
     FCS_PNFFT(plan) *ths, int dim, const ptrdiff_t *N, const ptrdiff_t *n,
     const fcs_float *x_max, int m,
     unsigned pnfft_flags, fcs_int pnfft_intpol_order, fcs_int pnfft_window,
@@ -1772,7 +1761,7 @@ static void init_pnfft(
 
   /* return if nothing to do */
   if( pnfft_is_up_to_date(*ths, dim, N, n, x_max, m, pnfft_flags, pfft_flags) )
-    return;
+    return 0;
 #if FCS_P2NFFT_DEBUG_RETUNE
   else
     fprintf(stderr, "\n!!! pnfft_is_up_to_date fails !!!\n\n");
@@ -1829,6 +1818,8 @@ static void init_pnfft(
   
   /* Finish timing of PNFFT tuning */
   FCS_P2NFFT_FINISH_TIMING(cart_comm_pnfft, "PNFFT tuning");
+
+  return 1;
 }
   
 
@@ -1893,7 +1884,7 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_0dp(
         /* calculate near and farfield regularization via interpolation */
         if(x2norm < r_cut){
           if(near_interpolation_num_nodes > 0)
-            regkern_hat[m] = ifcs_p2nfft_interpolation_near(
+            regkern_hat[m] = fcs_interpolation_near(
                 x2norm, 1.0/r_cut, interpolation_order, near_interpolation_num_nodes, near_interpolation_table_potential);
           else if (reg_near == FCS_P2NFFT_REG_NEAR_CG)
             regkern_hat[m] = epsI/r_cut * evaluate_cos_polynomial_1d(x2norm * epsI/r_cut, N_cg_cos, cg_cos_coeff);
@@ -1913,9 +1904,9 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_0dp(
                * Therefore, use xsnorm, scale the continuation value 'c', and rescale after evaluation.
                * Note that box_scales are the same in every direction for cubic boxes. */
               if(far_interpolation_num_nodes){
-                regkern_hat[m] = ifcs_p2nfft_interpolation_far(
+                regkern_hat[m] = fcs_interpolation_far(
                     xsnorm - 0.5 + epsB, 1.0/epsB, interpolation_order, far_interpolation_num_nodes, far_interpolation_table_potential) / box_scales[0];
-                FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "ifcs_p2nfft_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
+                FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "fcs_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
               } else if (reg_far == FCS_P2NFFT_REG_FAR_RAD_CG){
                 regkern_hat[m] = evaluate_cos_polynomial_1d(xsnorm, N_cg_cos, cg_cos_coeff) / box_scales[0];
                 FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "evaluate_cos_polynomial_1d: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
@@ -2080,7 +2071,7 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_0dp_ewald(
 //               * Therefore, use xsnorm, scale the continuation value 'c', and rescale after evaluation.
 //               * Note that box_scales are the same in every direction for cubic boxes. */
 //              if(far_interpolation_num_nodes){
-//                regkern_hat[m] = ifcs_p2nfft_interpolation_far(
+//                regkern_hat[m] = fcs_interpolation_far(
 //                    xsnorm - 0.5 + epsB, 1.0/epsB, interpolation_order, far_interpolation_num_nodes, far_interpolation_table_potential) / box_scales[0];
 //              } else if (reg_far == FCS_P2NFFT_REG_FAR_RAD_CG){
 //                regkern_hat[m] = evaluate_cos_polynomial_1d(xsnorm, N_cg_cos, cg_cos_coeff) / box_scales[0];
@@ -2123,7 +2114,7 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_0dp_ewald(
             fcs_float xs = (x2norm > h*0.5) ? 0.5   : xsnorm;
             param[1] = x2;
 
-            regkern_hat[m] = ifcs_p2nfft_interpolation_far(
+            regkern_hat[m] = fcs_interpolation_far(
                 xs - 0.5 + epsB, 1.0/epsB, interpolation_order, far_interpolation_num_nodes, far_interpolation_table_potential);
           } else if (reg_far == FCS_P2NFFT_REG_FAR_RAD_T2P_IC){
             regkern_hat[m] = ifcs_p2nfft_reg_far_rad_ic_no_singularity(ifcs_p2nfft_erfx_over_x, param,
@@ -2357,9 +2348,9 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_2dp_and_1dp(
               fcs_int ind = k[pdim] - local_Ni_start[pdim];
               fcs_int offset = far_interpolation_num_nodes + 3;
 
-              regkern_hat[m] = ifcs_p2nfft_interpolation_far(
+              regkern_hat[m] = fcs_interpolation_far(
                   xs - 0.5 + epsB, 1.0/epsB, interpolation_order, far_interpolation_num_nodes, far_interpolation_table_potential + ind * offset);
-              FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "k==0, ifcs_p2nfft_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
+              FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "k==0, fcs_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
             } else if (reg_far == FCS_P2NFFT_REG_FAR_RAD_T2P_SYM){
               regkern_hat[m] = -ifcs_p2nfft_reg_far_rad_sym_no_singularity(ifcs_p2nfft_ewald_1dp_keq0, param, x2norm, p, epsB);
               FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "k==0, ifcs_p2nfft_reg_far_rad_sym_no_singularity: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
@@ -2454,11 +2445,11 @@ static fcs_pnfft_complex* malloc_and_precompute_regkern_hat_2dp_and_1dp(
                   fcs_int ind = k[pdim] + local_Ni_start[pdim];
                   fcs_int offset = far_interpolation_num_nodes + 3;
 
-                  regkern_hat[m] = ifcs_p2nfft_interpolation_far(
+                  regkern_hat[m] = fcs_interpolation_far(
                       xs - 0.5 + epsB, 1.0/epsB, interpolation_order, far_interpolation_num_nodes, far_interpolation_table_potential + ind * offset);
                   FCS_P2NFFT_IFDBG(++count_far_interpolate);
                   FCS_P2NFFT_IFDBG(++count_interpolate);
-                  FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "k!=0, ifcs_p2nfft_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
+                  FCS_P2NFFT_IFDBG_REGKERN(if(myrank==0) fprintf(stderr, "k!=0, fcs_interpolation_far: regkern[%td] = %e + I * %e\n", m, creal(regkern_hat[m]), cimag(regkern_hat[m])));
             } else {
               /* The function evaluations 'in the middle' of the far field are much more expensive than the rest.
                * Here, we use symmetry to reduce the number of expensive function evaluations. 
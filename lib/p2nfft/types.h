@@ -100,6 +100,10 @@ typedef ptrdiff_t INT;
 #define FCS_P2NFFT_IGNORE_POTENTIAL          (1U << 1)
 #define FCS_P2NFFT_IGNORE_FIELD              (1U << 2)
 #define FCS_P2NFFT_VERBOSE_TUNING            (1U << 3)
+#define FCS_P2NFFT_TUNE_CACHE                (1U << 4)
+
+/* number of values that identify an entry of the tuning cache */
+#define FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH     64
 
 /* p2nfft_reg_kernels */
 #define FCS_P2NFFT_REG_KERNEL_DEFAULT (-1)
@@ -268,6 +272,15 @@ typedef struct {
   /* gridsort cache */
   fcs_gridsort_cache_t gridsort_cache;
 
+  /* persistent PNFFT nodes */
+  fcs_int pnfft_nodes_capacity;       /**< @brief Number of nodes allocated in the PNFFT plan
+                                        (-1 if the nodes have to be (re)initialized). */
+  unsigned pnfft_nodes_malloc_flags;  /**< @brief Malloc flags used for the allocated nodes. */
+
+  /* tuning cache */
+  fcs_float tune_cache_key[FCS_P2NFFT_TUNE_CACHE_KEY_LENGTH]; /**< @brief Key of the current tuning
+                                                                (valid only during retuning). */
+
 } ifcs_p2nfft_data_struct;
 
 #endif
@@ -37,12 +37,72 @@ extern "C" {
     Solver *d = reinterpret_cast<Solver*>(rd);
     
     try {
-      d->run(num_particles, positions, charges, fields, potentials);
+      d->run(num_particles, _max_num_particles,
+             positions, charges, fields, potentials);
     } catch (std::exception &e) {
       return fcs_result_create(FCS_ERROR_LOGICAL_ERROR, "ifcs_p3m_run", e.what());
     }
     
     return FCS_RESULT_SUCCESS;
   }
+
+  void
+  ifcs_p3m_set_max_particle_move(void *rd, fcs_float max_particle_move) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    d->max_particle_move = max_particle_move;
+  }
+
+  void
+  ifcs_p3m_set_resort(void *rd, fcs_int resort) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    d->resort = (resort != 0);
+  }
+
+  void
+  ifcs_p3m_get_resort(void *rd, fcs_int *resort) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    *resort = d->resort ? 1 : 0;
+  }
+
+  void
+  ifcs_p3m_get_resort_availability(void *rd, fcs_int *availability) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    *availability = fcs_gridsort_resort_is_available(d->gridsort_resort);
+  }
+
+  void
+  ifcs_p3m_get_resort_particles(void *rd, fcs_int *resort_particles) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    if (d->gridsort_resort == FCS_GRIDSORT_RESORT_NULL) {
+      *resort_particles = d->num_local_particles;
+      return;
+    }
+    *resort_particles =
+      fcs_gridsort_resort_get_sorted_particles(d->gridsort_resort);
+  }
+
+  void
+  ifcs_p3m_resort_ints(void *rd, fcs_int *src, fcs_int *dst,
+                       fcs_int n, MPI_Comm comm) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    if (d->gridsort_resort == FCS_GRIDSORT_RESORT_NULL) return;
+    fcs_gridsort_resort_ints(d->gridsort_resort, src, dst, n, comm);
+  }
+
+  void
+  ifcs_p3m_resort_floats(void *rd, fcs_float *src, fcs_float *dst,
+                         fcs_int n, MPI_Comm comm) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    if (d->gridsort_resort == FCS_GRIDSORT_RESORT_NULL) return;
+    fcs_gridsort_resort_floats(d->gridsort_resort, src, dst, n, comm);
+  }
+
+  void
+  ifcs_p3m_resort_bytes(void *rd, void *src, void *dst,
+                        fcs_int n, MPI_Comm comm) {
+    Solver *d = reinterpret_cast<Solver*>(rd);
+    if (d->gridsort_resort == FCS_GRIDSORT_RESORT_NULL) return;
+    fcs_gridsort_resort_bytes(d->gridsort_resort, src, dst, n, comm);
+  }
   
 }
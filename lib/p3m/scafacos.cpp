@@ -64,15 +64,19 @@ void ifcs_p3m_set_near_field_flag(void *rd, fcs_int flag) {
 
 FCSResult ifcs_p3m_set_triclinic_flag(void *rd) {
         P3M_DEBUG_LOCAL(printf("P3M triclinic: triclinic box detected.\n"));
-#if defined(P3M_INTERLACE) && defined(P3M_AD)
         Solver *d = static_cast<Solver *> (rd);
+        if (!d->tune_variant && d->variant != P3M_VARIANT_ADI) {
+          if (d->variant_set) {
+            const char* fnc_name = "ifcs_p3m_set_triclinic_flag";
+            return fcs_result_create(FCS_ERROR_NOT_IMPLEMENTED, fnc_name,
+                    "p3m triclinic is only implemented with ADI so far.");
+          }
+          /* the default variant ik is not implemented for triclinic boxes */
+          d->variant = P3M_VARIANT_ADI;
+          d->needs_retune = 1;
+        }
         d->isTriclinic = true;
         return FCS_RESULT_SUCCESS;
-#else
-        const char* fnc_name = "ifcs_p3m_set_triclinic_flag";
-        return fcs_result_create(FCS_ERROR_NOT_IMPLEMENTED, fnc_name,
-                "p3m triclinic is only implemented with ADI so far.");
-#endif
 }
 
 void ifcs_p3m_set_box_a(void* rd, fcs_float a) {
@@ -194,6 +198,56 @@ void ifcs_p3m_get_cao(void *rd, fcs_int *cao) {
 	*cao = d->cao;
 }
 
+void ifcs_p3m_set_variant(void *rd, fcs_int variant) {
+	Solver *d = static_cast<Solver *>(rd);
+	if (variant != d->variant)
+		d->needs_retune = 1;
+	d->variant = variant;
+	d->variant_set = 1;
+	d->tune_variant = 0;
+}
+
+void ifcs_p3m_set_variant_tune(void *rd) {
+	Solver *d = static_cast<Solver *>(rd);
+	d->needs_retune = 1;
+	d->tune_variant = 1;
+}
+
+void ifcs_p3m_get_variant(void *rd, fcs_int *variant) {
+	Solver *d = static_cast<Solver *>(rd);
+	*variant = d->variant;
+}
+
+void ifcs_p3m_set_interpolation_order(void *rd, fcs_int interpolation_order) {
+	Solver *d = static_cast<Solver *>(rd);
+	d->interpolation_order = interpolation_order;
+}
+
+void ifcs_p3m_get_interpolation_order(void *rd, fcs_int *interpolation_order) {
+	Solver *d = static_cast<Solver *>(rd);
+	*interpolation_order = d->interpolation_order;
+}
+
+void ifcs_p3m_set_overlap_near(void *rd, fcs_int overlap_near) {
+	Solver *d = static_cast<Solver *>(rd);
+	d->overlap_near = (overlap_near != 0);
+}
+
+void ifcs_p3m_get_overlap_near(void *rd, fcs_int *overlap_near) {
+	Solver *d = static_cast<Solver *>(rd);
+	*overlap_near = d->overlap_near;
+}
+
+void ifcs_p3m_set_fftw_rigor(void *rd, fcs_int fftw_rigor) {
+	Solver *d = static_cast<Solver *>(rd);
+	d->fftw_rigor = fftw_rigor;
+}
+
+void ifcs_p3m_get_fftw_rigor(void *rd, fcs_int *fftw_rigor) {
+	Solver *d = static_cast<Solver *>(rd);
+	*fftw_rigor = d->fftw_rigor;
+}
+
 void ifcs_p3m_set_tolerance_field(void *rd, fcs_float tolerance_field) {
 	Solver *d = static_cast<Solver *>(rd);
 	if (!float_is_equal(tolerance_field, d->tolerance_field))
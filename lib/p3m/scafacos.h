@@ -63,6 +63,18 @@ extern "C" {
   void ifcs_p3m_set_cao(void *rd, fcs_int cao);
   void ifcs_p3m_set_cao_tune(void *rd);
   void ifcs_p3m_get_cao(void *rd, fcs_int *cao);
+  void ifcs_p3m_set_variant(void *rd, fcs_int variant);
+  void ifcs_p3m_set_variant_tune(void *rd);
+  void ifcs_p3m_get_variant(void *rd, fcs_int *variant);
+
+  void ifcs_p3m_set_interpolation_order(void *rd, fcs_int interpolation_order);
+  void ifcs_p3m_get_interpolation_order(void *rd, fcs_int *interpolation_order);
+
+  void ifcs_p3m_set_overlap_near(void *rd, fcs_int overlap_near);
+  void ifcs_p3m_get_overlap_near(void *rd, fcs_int *overlap_near);
+
+  void ifcs_p3m_set_fftw_rigor(void *rd, fcs_int fftw_rigor);
+  void ifcs_p3m_get_fftw_rigor(void *rd, fcs_int *fftw_rigor);
 
   void ifcs_p3m_set_tolerance_field(void *rd, fcs_float tolerance_field);
   void ifcs_p3m_set_tolerance_field_tune(void *rd);
@@ -89,6 +101,15 @@ extern "C" {
   ifcs_p3m_run(void* rd, fcs_int num_particles, fcs_int max_particles,
                fcs_float *positions, fcs_float *charges,
                fcs_float *fields, fcs_float *potentials);
+
+  void ifcs_p3m_set_max_particle_move(void *rd, fcs_float max_particle_move);
+  void ifcs_p3m_set_resort(void *rd, fcs_int resort);
+  void ifcs_p3m_get_resort(void *rd, fcs_int *resort);
+  void ifcs_p3m_get_resort_availability(void *rd, fcs_int *availability);
+  void ifcs_p3m_get_resort_particles(void *rd, fcs_int *resort_particles);
+  void ifcs_p3m_resort_ints(void *rd, fcs_int *src, fcs_int *dst, fcs_int n, MPI_Comm comm);
+  void ifcs_p3m_resort_floats(void *rd, fcs_float *src, fcs_float *dst, fcs_int n, MPI_Comm comm);
+  void ifcs_p3m_resort_bytes(void *rd, void *src, void *dst, fcs_int n, MPI_Comm comm);
   
 #ifdef __cplusplus
 }
@@ -39,6 +39,9 @@ void ErrorEstimate::computeKSError(TuneParameters& p, p3m_int num_charges,
 			{ 1.0 / p.grid[0], 1.0 / p.grid[1], 1.0 / p.grid[2] };
 	
 	p3m_float alpha_L_i = 1. / (p.alpha * box_l[0]);
+	/* wave vectors in units of 2 pi/box_l[0] */
+	p3m_float box_scale[3] =
+			{ 1.0, box_l[0] / box_l[1], box_l[0] / box_l[2] };
 
 	// Distribute indices onto parallel tasks
 	p3m_int num_ix = p.grid[0] * p.grid[1] * p.grid[2];
@@ -71,7 +74,7 @@ void ErrorEstimate::computeKSError(TuneParameters& p, p3m_int num_charges,
 			p3m_float alias1, alias2, alias3, alias4, alias5, alias6;
 			p3m_float D;
 
-			KSErrorSum2(nx,ny,nz, p.grid,grid_i, p.cao,alpha_L_i,
+			KSErrorSum2(nx,ny,nz, p.grid,grid_i,box_scale, p.cao,alpha_L_i,
 					&alias1,&alias2,&alias3,&alias4,&alias5,&alias6);
 
 			D = alias1 - SQR(alias2) / (0.5*(alias3*alias4 + alias5*alias6));
@@ -84,33 +87,42 @@ void ErrorEstimate::computeKSError(TuneParameters& p, p3m_int num_charges,
 	MPI_Reduce(&local_he_q, &he_q, 1, P3M_MPI_FLOAT, MPI_SUM, 0,
 			comm.mpicomm);
 
+	/* the wave vectors are in units of 2 pi/box_l[0] */
 	p.ks_error = 2.0 * sum_q2 *
-			sqrt(he_q / num_charges) / (box_l[0] * box_l[1]);
+			sqrt(he_q / num_charges) / (box_l[1] * box_l[2]);
 }
 
 /** aliasing sum used by \ref k_space_error. */
 void ErrorEstimate::KSErrorSum2(p3m_int nx, p3m_int ny, p3m_int nz,
-		p3m_int grid[3], p3m_float grid_i[3], p3m_int cao, p3m_float alpha_L_i,
+		p3m_int grid[3], p3m_float grid_i[3], p3m_float box_scale[3],
+		p3m_int cao, p3m_float alpha_L_i,
 		p3m_float *alias1, p3m_float *alias2, p3m_float *alias3,
 		p3m_float *alias4, p3m_float *alias5, p3m_float *alias6) {
 	p3m_float prefactor = SQR(M_PI * alpha_L_i);
 
+	/* the factors of the aliasing terms separate into the dimensions */
+	const p3m_int num_m = 2 * P3M_BRILLOUIN_INTERLACE_ERROR + 1;
+	const p3m_int n[3] = { nx, ny, nz };
+	p3m_float U2_m[3][num_m], k2_m[3][num_m], ex_m[3][num_m];
+	for (p3m_int dim = 0; dim < 3; dim++) {
+		for (p3m_int i = 0; i < num_m; i++) {
+			p3m_float nm = n[dim] + (i - P3M_BRILLOUIN_INTERLACE_ERROR) * grid[dim];
+			U2_m[dim][i] = pow(sinc(grid_i[dim] * nm), 2.0 * cao);
+			k2_m[dim][i] = SQR(box_scale[dim] * nm);
+			ex_m[dim][i] = exp(-prefactor * k2_m[dim][i]);
+		}
+	}
+
 	*alias1 = *alias2 = *alias3 = *alias4 = *alias5 = *alias6 = 0.0;
-	for (p3m_int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
-		p3m_float nmx = nx + mx * grid[0];
-		p3m_float fnmx = grid_i[0] * nmx;
-		for (p3m_int my = -P3M_BRILLOUIN; my <= P3M_BRILLOUIN; my++) {
-			p3m_float nmy = ny + my * grid[1];
-			p3m_float fnmy = grid_i[1] * nmy;
-			for (p3m_int mz = -P3M_BRILLOUIN; mz <= P3M_BRILLOUIN; mz++) {
-				p3m_float nmz = nz + mz * grid[2];
-				p3m_float fnmz = grid_i[2] * nmz;
-
-				p3m_float nm2 = SQR(nmx) + SQR(nmy) + SQR(nmz);
-				p3m_float ex = exp(-prefactor * nm2);
-
-				p3m_float U2 = pow(sinc(fnmx) * sinc(fnmy) * sinc(fnmz),
-						2.0 * cao);
+	for (p3m_int mx = 0; mx < num_m; mx++) {
+		for (p3m_int my = 0; my < num_m; my++) {
+			p3m_float U2_xy = U2_m[0][mx] * U2_m[1][my];
+			p3m_float k2_xy = k2_m[0][mx] + k2_m[1][my];
+			p3m_float ex_xy = ex_m[0][mx] * ex_m[1][my];
+			for (p3m_int mz = 0; mz < num_m; mz++) {
+				p3m_float nm2 = k2_xy + k2_m[2][mz];
+				p3m_float ex = ex_xy * ex_m[2][mz];
+				p3m_float U2 = U2_xy * U2_m[2][mz];
 
 				*alias1 += ex * ex / nm2;
 				*alias2 += U2 * ex;
@@ -199,45 +211,52 @@ void ErrorEstimate::KSErrorSum2(p3m_int nx, p3m_int ny, p3m_int nz,
                 p3m_float *sum_U2, p3m_float *alias5, p3m_float *alias6, p3m_float box_vectors[3][3], bool isTriclinic) {
             p3m_float pi2_alpha2 = SQR(M_PI / alpha);
 
-            *sum_Fref2 = *sqrt_nominator = *sum_U2k2 = *sum_U2 = *alias5 = *alias6 = 0.0;
-            for (p3m_int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
-                p3m_int nmx = nx + mx * grid[0];
-                p3m_float fnmx = grid_i[0] * nmx;
-                for (p3m_int my = -P3M_BRILLOUIN; my <= P3M_BRILLOUIN; my++) {
-                    p3m_int nmy = ny + my * grid[1];
-                    p3m_float fnmy = grid_i[1] * nmy;
-                    for (p3m_int mz = -P3M_BRILLOUIN; mz <= P3M_BRILLOUIN; mz++) {
-                        p3m_int nmz = nz + mz * grid[2];
-                        p3m_float fnmz = grid_i[2] * nmz;
-                        p3m_float k2_4pi2 = 0.0;
-                        if (!isTriclinic) {
-                            k2_4pi2 =
-                                    SQR(nmx / box_vectors[RX][RX]) +
-                                    SQR(nmy / box_vectors[RY][RY]) +
-                                    SQR(nmz / box_vectors[RZ][RZ]);
-                        } else {
-                            p3m_int i;
-                            const p3m_int nNm[3] = {nmx, nmy, nmz};
-
-                            for (i = 0; i < 3; i++) {
-                                p3m_int j = (i + 1) % 3;
-                                p3m_int k = (i + 2) % 3;
-
-                                k2_4pi2 += SQR((nNm[i]*(box_vectors[j][j] * box_vectors[k][k]\
-                                 - box_vectors[j][k] * box_vectors[k][j]) + nNm[j]\
-                                 *(box_vectors[k][j] * box_vectors[i][k] - box_vectors[k][k]\
-                                 * box_vectors[i][j]) + nNm[k]*(box_vectors[i][j]\
-                                 * box_vectors[j][k] - box_vectors[i][k] * box_vectors[j][j])));
-                            }
-
-                            k2_4pi2 *= 1 / SQR(box_vectors[0][0] * box_vectors[1][1] * box_vectors[2][2]);
+            /* k/2pi = R (n + N m) with the rows of R being the reciprocal box vectors */
+            p3m_float R[3][3];
+            for (p3m_int i = 0; i < 3; i++) {
+                p3m_int j = (i + 1) % 3;
+                p3m_int k = (i + 2) % 3;
+                for (p3m_int d = 0; d < 3; d++)
+                    R[i][d] = 0.0;
+                if (!isTriclinic) {
+                    R[i][i] = 1.0 / box_vectors[i][i];
+                } else {
+                    p3m_float volume_i = 1.0 / (box_vectors[0][0] * box_vectors[1][1] * box_vectors[2][2]);
+                    R[i][i] = (box_vectors[j][j] * box_vectors[k][k] - box_vectors[j][k] * box_vectors[k][j]) * volume_i;
+                    R[i][j] = (box_vectors[k][j] * box_vectors[i][k] - box_vectors[k][k] * box_vectors[i][j]) * volume_i;
+                    R[i][k] = (box_vectors[i][j] * box_vectors[j][k] - box_vectors[i][k] * box_vectors[j][j]) * volume_i;
+                }
+            }
 
-                        }
+            /* U2 separates into the dimensions, k into the columns of R */
+            const p3m_int num_m = 2 * P3M_BRILLOUIN_INTERLACE_ERROR + 1;
+            const p3m_int n[3] = { nx, ny, nz };
+            p3m_float U2_m[3][num_m], k_m[3][num_m][3];
+            for (p3m_int d = 0; d < 3; d++) {
+                for (p3m_int i = 0; i < num_m; i++) {
+                    p3m_int nm = n[d] + (i - P3M_BRILLOUIN_INTERLACE_ERROR) * grid[d];
+                    U2_m[d][i] = pow(sinc(grid_i[d] * nm), 2.0 * cao);
+                    for (p3m_int c = 0; c < 3; c++)
+                        k_m[d][i][c] = R[c][d] * nm;
+                }
+            }
+
+            *sum_Fref2 = *sqrt_nominator = *sum_U2k2 = *sum_U2 = *alias5 = *alias6 = 0.0;
+            for (p3m_int mx = 0; mx < num_m; mx++) {
+                for (p3m_int my = 0; my < num_m; my++) {
+                    p3m_float U2_xy = U2_m[0][mx] * U2_m[1][my];
+                    p3m_float k_xy[3];
+                    for (p3m_int c = 0; c < 3; c++)
+                        k_xy[c] = k_m[0][mx][c] + k_m[1][my][c];
+                    for (p3m_int mz = 0; mz < num_m; mz++) {
+                        p3m_float k2_4pi2 =
+                                SQR(k_xy[0] + k_m[2][mz][0]) +
+                                SQR(k_xy[1] + k_m[2][mz][1]) +
+                                SQR(k_xy[2] + k_m[2][mz][2]);
 
                         p3m_float ex = exp(-pi2_alpha2 * k2_4pi2);              // exp(-k_{n+Nm}^2 / (4*alpha^2))
 
-                        p3m_float U2 = pow(sinc(fnmx) * sinc(fnmy) * sinc(fnmz),
-                                2.0 * cao);                                     // U(k_{n+Nm})^2
+                        p3m_float U2 = U2_xy * U2_m[2][mz];                     // U(k_{n+Nm})^2
 
                         *sum_Fref2 += ex * ex / k2_4pi2;                        // 1/4 * Sum_m [ |R(k_{n+Nm})|^2 ]
                         *sqrt_nominator += U2 * ex;                             // Sum_m [ U(k_{n+Nm})^2 * exp(-k_{n+Nm}^2 / (4*alpha^2)) ]
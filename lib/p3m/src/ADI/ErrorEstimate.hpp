@@ -36,7 +36,8 @@ public:
 protected:
     void
 	KSErrorSum2(p3m_int nx, p3m_int ny, p3m_int nz, p3m_int grid[3],
-			p3m_float grid_i[3], p3m_int cao, p3m_float alpha_L_i,
+			p3m_float grid_i[3], p3m_float box_scale[3],
+			p3m_int cao, p3m_float alpha_L_i,
 			p3m_float *alias1, p3m_float *alias2, p3m_float *alias3,
 			p3m_float *alias4, p3m_float *alias5, p3m_float *alias6);
     void KSErrorSum2Triclinic(p3m_int nx, p3m_int ny, p3m_int nz, p3m_int grid[3],
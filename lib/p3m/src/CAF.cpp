@@ -229,7 +229,8 @@ void CAF::DerivativeCache::update(p3m_float r0) {
 		pbegin[i] = computeDerivative(i, r0, caf.cao);
 }
 
-CAF::CAF(p3m_int _cao, bool _derivative) : cao(_cao), derivative(_derivative) {
+CAF::CAF(p3m_int _cao, bool _derivative)
+: cao(_cao), derivative(_derivative), data(NULL), n_interpol(0) {
 	if (cao > MAX_CAO || cao < 1) {
 		std::ostringstream s;
 		s << "Charge assignment order " << cao << " unknown.";
@@ -77,12 +77,37 @@ public:
     /* Factory method to create a matching cache. */
     virtual Cache *createCache();
 
+    /** Computes the values of the CAF at all points around \a r0 into
+        \a w. The charge assignment order is a template parameter, so
+        that the loops of the assignment kernels can be unrolled. */
+    template<p3m_int CAO>
+    void computeAll(p3m_float r0, p3m_float *w) const;
+
     protected:
     friend class InterpolatedCAF;
     p3m_int cao;
     bool derivative;
+    /** interpolated values of the CAF (NULL if they are computed) */
+    p3m_float* data;
+    p3m_int n_interpol;
 };
 
+template<p3m_int CAO>
+inline void CAF::computeAll(p3m_float r0, p3m_float *w) const {
+    if (data != NULL) {
+        const p3m_float *base = &data[
+                static_cast<p3m_int>((2*n_interpol+1) * (r0 + 0.5)) * CAO];
+        for (p3m_int i = 0; i < CAO; i++)
+            w[i] = base[i];
+    } else if (derivative) {
+        for (p3m_int i = 0; i < CAO; i++)
+            w[i] = computeDerivative(i, r0, CAO);
+    } else {
+        for (p3m_int i = 0; i < CAO; i++)
+            w[i] = compute(i, r0, CAO);
+    }
+}
+
 class InterpolatedCAF: public CAF {
 public:
     class Cache: public CAF::Cache {
@@ -102,8 +127,6 @@ public:
 
     protected:
     p3m_float* getBase(p3m_float r0);
-    p3m_float* data;
-    p3m_int n_interpol;
 };
 }
 #endif
@@ -35,6 +35,9 @@ namespace P3M {
 	  MPI_Comm_dup(mpicomm, &mpicomm_orig);
 	  MPI_Comm_size(mpicomm, &size);
 	  MPI_Comm_rank(mpicomm, &rank);
+
+	  overlap = NULL;
+	  overlap_param = NULL;
   }
 
   Communication::~Communication() {
@@ -44,6 +47,25 @@ namespace P3M {
       MPI_Comm_free(&mpicomm_orig);
   }
 
+  void Communication::waitall(int count, MPI_Request *requests) {
+    int done = 0;
+
+    /* do the overlapping work while the messages are in flight */
+    if (overlap != NULL) {
+      MPI_Testall(count, requests, &done, MPI_STATUSES_IGNORE);
+      while (!done) {
+        if (!overlap(overlap_param)) {
+          overlap = NULL;
+          break;
+        }
+        MPI_Testall(count, requests, &done, MPI_STATUSES_IGNORE);
+      }
+    }
+
+    if (!done)
+      MPI_Waitall(count, requests, MPI_STATUSES_IGNORE);
+  }
+
   void Communication::prepare(p3m_float box_l[3]) {
     P3M_DEBUG(printf( "  P3M::Communication::prepare() started...\n"));
 
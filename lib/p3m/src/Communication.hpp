@@ -36,6 +36,21 @@ struct Communication {
 
 	void prepare(p3m_float box_l[3]);
 
+	/** Work that is done while waiting for messages, returns false
+	    when there is no more work to do. */
+	typedef bool (*OverlapFunction)(void *param);
+
+	/** Set the work that is done while waiting for messages (NULL
+	    to disable). */
+	void setOverlap(OverlapFunction func, void *param) {
+	    overlap = func;
+	    overlap_param = param;
+	}
+
+	/** Complete the given requests. If overlapping work is set, it
+	    is done step by step until all messages have arrived. */
+	void waitall(int count, MPI_Request *requests);
+
 	/* The MPI communicator to use (Cartesian) */
 	MPI_Comm mpicomm;
 	/* The original MPI communicator to use (possibly not Cartesian) */
@@ -58,6 +73,10 @@ struct Communication {
 	p3m_float my_left[3];
 	/** Right (top, back) corner of this nodes local box. */
 	p3m_float my_right[3];
+
+	/** Work that is done while waiting for messages. */
+	OverlapFunction overlap;
+	void *overlap_param;
 };
 
 }
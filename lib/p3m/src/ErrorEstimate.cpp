@@ -29,12 +29,11 @@ namespace P3M {
 
 /** Factory method to create ErrorEstimates */
 ErrorEstimate*
-ErrorEstimate::create(Communication &comm) {
-#if defined(P3M_AD) && defined(P3M_INTERLACE)
-	return new ADI::ErrorEstimate(comm);
-#elif defined(P3M_IK) && !defined(P3M_INTERLACE)
-	return new IK::ErrorEstimate(comm);
-#endif
+ErrorEstimate::create(Communication &comm, p3m_int variant) {
+	if (variant == P3M_VARIANT_ADI)
+		return new ADI::ErrorEstimate(comm);
+	else
+		return new IK::ErrorEstimate(comm);
 }
 
 ErrorEstimate::CantGetRequiredAccuracy::CantGetRequiredAccuracy() :
@@ -31,7 +31,7 @@ namespace P3M {
 /* Base class of the P3M error estimates. */
 class ErrorEstimate {
 public:
-    static ErrorEstimate *create(Communication &comm);
+    static ErrorEstimate *create(Communication &comm, p3m_int variant);
 
     class CantGetRequiredAccuracy: public std::logic_error {
     public:
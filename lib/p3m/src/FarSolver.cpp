@@ -20,14 +20,19 @@
  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "FarSolver.hpp"
+#include <algorithm>
 #include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
-        p3m_float r_cut, p3m_float alpha, p3m_int grid[3], p3m_int cao, p3m_float box_vectors[3][3], p3m_float volume, bool isTriclinic)
+        p3m_float r_cut, p3m_float alpha, p3m_int grid[3], p3m_int cao, p3m_float box_vectors[3][3], p3m_float volume, bool isTriclinic,
+        p3m_int variant, p3m_int fft_rigor)
 : comm(comm), fft(comm), errorEstimate(NULL) {
     P3M_DEBUG(printf( "P3M::FarSolver() started...\n"));
 
-    errorEstimate = ErrorEstimate::create(comm);
+    errorEstimate = ErrorEstimate::create(comm, variant);
 
     this->g_force = NULL;
     this->g_energy = NULL;
@@ -61,12 +66,14 @@ P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
     this->grid[1] = grid[1];
     this->grid[2] = grid[2];
     this->cao = cao;
+    this->variant = variant;
 
     P3M_INFO(printf(                                              \
             "    p3m params: "                                    \
             "r_cut=" FFLOAT ", grid=" F3INT ", cao=" FINT ", "    \
-            "alpha=" FFLOAT "\n",                                 \
-            r_cut, grid[0], grid[1], grid[2], cao, alpha));
+            "alpha=" FFLOAT ", variant=%s\n",                     \
+            r_cut, grid[0], grid[1], grid[2], cao, alpha,         \
+            P3M_VARIANT_NAME(variant)));
 
     /* Which components to compute? */
     require_total_energy = false;
@@ -86,6 +93,9 @@ P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
         ai[i]      = grid[i]/box_l[i];
         a[i]       = 1.0/ai[i];
         cao_cut[i] = 0.5*a[i]*cao;
+        /* the interlaced grid is shifted by half a grid constant */
+        if (variant == P3M_VARIANT_ADI)
+            additional_grid[i] = 0.5*a[i];
     }
     this->prepareLocalCAGrid();
     P3M_DEBUG(this->printLocalGrid());
@@ -96,18 +106,11 @@ P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
 
     P3M_DEBUG(printf("    Interpolating charge assignment function...\n"));
     caf = P3M::CAF::create(cao, n_interpol);
-    cafx = caf->createCache();
-    cafy = caf->createCache();
-    cafz = caf->createCache();
-#ifdef P3M_AD
-    caf_d = P3M::CAF::create(cao, n_interpol, true);
-    cafx_d = caf_d->createCache();
-    cafy_d = caf_d->createCache();
-    cafz_d = caf_d->createCache();
-#else
-    caf_d = NULL;
-    cafx_d = cafy_d = cafz_d = NULL;
-#endif
+    if (variant == P3M_VARIANT_ADI)
+        caf_d = P3M::CAF::create(cao, n_interpol, true);
+    else
+        caf_d = NULL;
+    this->selectKernels();
 
     /* position offset for calc. of first gridpoint */
     pos_shift = (p3m_float)((cao-1)/2) - (cao%2)/2.0;
@@ -115,7 +118,8 @@ P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
 
     /* FFT */
     P3M_INFO(printf("    Preparing FFTs...\n"));
-    fft.prepare(local_grid.dim, local_grid.margin, grid, grid_off, &ks_pnum);
+    fft.prepare(local_grid.dim, local_grid.margin, grid, grid_off, &ks_pnum,
+            variant == P3M_VARIANT_ADI, fft_rigor);
     rs_grid = fft.malloc_data();
     ks_grid = fft.malloc_data();
     buffer = fft.malloc_data();
@@ -136,13 +140,10 @@ P3M::FarSolver::FarSolver(Communication &comm, p3m_float box_l[3],
     }
 
     P3M_INFO(printf("    Calculating influence function...\n"));
-#if !defined(P3M_INTERLACE) && defined(P3M_IK)
-    computeInfluenceFunctionIK();
-#elif defined(P3M_INTERLACE) && defined(P3M_IK)
-    computeInfluenceFunctionIKI();
-#else
-    computeInfluenceFunctionADI();
-#endif
+    if (variant == P3M_VARIANT_ADI)
+        computeInfluenceFunctionADI();
+    else
+        computeInfluenceFunctionIK();
 
     P3M_DEBUG(printf( "P3M::FarSolver() finished.\n"));
 }
@@ -155,13 +156,7 @@ P3M::FarSolver::~FarSolver() {
     delete[] send_grid;
     delete[] recv_grid;
     delete caf;
-    delete cafx;
-    delete cafy;
-    delete cafz;
     delete caf_d;
-    delete cafx_d;
-    delete cafy_d;
-    delete cafz_d;
     delete[] g_force;
     delete[] g_energy;
     delete[] d_op[0];
@@ -755,9 +750,9 @@ void P3M::FarSolver::computeInfluenceFunctionADI() {
         for (n[2]=start[2]; n[2]<end[2]; n[2]++) {
           p3m_int ind = (n[2]-start[2]) + extent[2] *
             ((n[1]-start[1]) + extent[1]*(n[0]-start[0]));
-          if ((n[KX]%(grid[RX]/2)==0) &&
-              (n[KY]%(grid[RY]/2)==0) &&
-              (n[KZ]%(grid[RZ]/2)==0) ) {
+          /* the analytical differentiation also needs the Nyquist modes,
+             only the k=0 mode is dropped */
+          if (n[KX]==0 && n[KY]==0 && n[KZ]==0) {
             g_force[ind] = 0.0;
             g_energy[ind] = 0.0;
           } else {
@@ -922,13 +917,13 @@ void P3M::FarSolver::performAliasingSumsADI(
 
    p3m_float prefactor = SQR(M_PI/alpha);
 
-   for (p3m_int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
+   for (p3m_int mx = -P3M_BRILLOUIN_INTERLACE; mx <= P3M_BRILLOUIN_INTERLACE; mx++) {
      const p3m_int nmx = nmx0 + grid[RX]*mx;
      const p3m_float sx = pow(sinc(nmx/(p3m_float)grid[RX]), 2.0*cao);
-     for (p3m_int my = -P3M_BRILLOUIN; my <= P3M_BRILLOUIN; my++) {
+     for (p3m_int my = -P3M_BRILLOUIN_INTERLACE; my <= P3M_BRILLOUIN_INTERLACE; my++) {
        const p3m_int nmy = nmy0 + grid[RY]*my;
        const p3m_float sy = sx*pow(sinc(nmy/(p3m_float)grid[RY]), 2.0*cao);
-       for (p3m_int mz = -P3M_BRILLOUIN; mz <= P3M_BRILLOUIN; mz++) {
+       for (p3m_int mz = -P3M_BRILLOUIN_INTERLACE; mz <= P3M_BRILLOUIN_INTERLACE; mz++) {
          const p3m_int nmz = nmz0 + grid[RZ]*mz;
          const p3m_float U2 = sy*pow(sinc(nmz/(p3m_float)grid[RZ]), 2.0*cao);
          
@@ -987,13 +982,13 @@ void P3M::FarSolver::performAliasingSumsIKI(p3m_int nmx0, p3m_int nmy0,
 
     const p3m_float prefactor = SQR(M_PI/alpha);
 
-    for (p3m_int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
+    for (p3m_int mx = -P3M_BRILLOUIN_INTERLACE; mx <= P3M_BRILLOUIN_INTERLACE; mx++) {
         const p3m_int nmx = nmx0 + grid[RX]*mx;
         const p3m_float sx  = pow(sinc(nmx/(p3m_float)grid[RX]),2.0*cao);
-        for (p3m_int my = -P3M_BRILLOUIN; my <= P3M_BRILLOUIN; my++) {
+        for (p3m_int my = -P3M_BRILLOUIN_INTERLACE; my <= P3M_BRILLOUIN_INTERLACE; my++) {
             const p3m_int nmy = nmy0 + grid[RY]*my;
             const p3m_float sy  = sx*pow(sinc(nmy/(p3m_float)grid[RY]),2.0*cao);
-            for (p3m_int mz = -P3M_BRILLOUIN; mz <= P3M_BRILLOUIN; mz++) {
+            for (p3m_int mz = -P3M_BRILLOUIN_INTERLACE; mz <= P3M_BRILLOUIN_INTERLACE; mz++) {
                 const p3m_int nmz = nmz0 + grid[RZ]*mz;
                 const p3m_float sz  = sy*pow(sinc(nmz/(p3m_float)grid[RZ]),2.0*cao);
                 const p3m_float nm2 =
@@ -1053,25 +1048,37 @@ P3M::FarSolver::computeGridShift(int dir, p3m_int size) {
     return gridshift;
 }
 
+/** Position of real_pos in dimension dim in the charge assignment grid,
+    relative to the corner of the charge assignment area. The floor of
+    it is the first grid point that the charge is assigned to. */
+inline p3m_float P3M::FarSolver::getCAPosition(p3m_float real_pos,
+        p3m_int dim, p3m_int shifted) {
+    /* position in normalized coordinates in [0,1] */
+    p3m_float pos = (real_pos - local_grid.ld_pos[dim]) * ai[dim];
+    /* shift position to the corner of the charge assignment area */
+    pos -= pos_shift;
+    /* if using the interlaced grid, shift it more */
+    if (shifted) pos -= 0.5;
+    return pos;
+}
+
 /** Compute the data of the charge assignment grid points.
 
       The function returns the linear index of the top left grid point
       in the charge assignment grid that corresponds to real_pos. When
       "shifted" is set, it uses the shifted position for interlacing.
-      After the call, caf_cache contains a cache of the values of the
-      charge assignment fraction (caf) for x,y,z.
+      After the call, caf_v contains the values of the charge
+      assignment fraction (caf) for x,y,z. If caf_dv is not NULL, it
+      contains the values of the derived caf.
  */
-p3m_int P3M::FarSolver::getCAPoints(p3m_float real_pos[3], p3m_int shifted) {
+template<p3m_int CAO>
+inline p3m_int P3M::FarSolver::getCAPoints(p3m_float real_pos[3],
+        p3m_int shifted, p3m_float caf_v[3][CAO], p3m_float caf_dv[3][CAO]) {
     /* linear index of the grid point */
     p3m_int linind = 0;
 
     for (p3m_int dim=0; dim<3; dim++) {
-        /* position in normalized coordinates in [0,1] */
-        p3m_float pos = (real_pos[dim] - local_grid.ld_pos[dim]) * ai[dim];
-        /* shift position to the corner of the charge assignment area */
-        pos -= pos_shift;
-        /* if using the interlaced grid, shift it more */
-        if (shifted) pos -= 0.5;
+        p3m_float pos = getCAPosition(real_pos[dim], dim, shifted);
         /* nearest grid point in the ca grid */
         p3m_int grid_ind  = (p3m_int)floor(pos);
 #ifdef ADDITIONAL_CHECKS
@@ -1092,19 +1099,9 @@ p3m_int P3M::FarSolver::getCAPoints(p3m_float real_pos[3], p3m_int shifted) {
         /* normalized distance to grid point */
         p3m_float dist = (pos-grid_ind)-0.5;
 
-        switch (dim) {
-        case 0: cafx->update(dist); break;
-        case 1: cafy->update(dist); break;
-        case 2: cafz->update(dist); break;
-        }
-
-#ifdef P3M_AD
-        switch (dim) {
-        case 0: cafx_d->update(dist); break;
-        case 1: cafy_d->update(dist); break;
-        case 2: cafz_d->update(dist); break;
-        }
-#endif
+        caf->computeAll<CAO>(dist, caf_v[dim]);
+        if (caf_dv != NULL)
+            caf_d->computeAll<CAO>(dist, caf_dv[dim]);
 
 #ifdef ADDITIONAL_CHECKS
         if (real_pos[dim] < comm.my_left[dim]
@@ -1129,33 +1126,98 @@ p3m_int P3M::FarSolver::getCAPoints(p3m_float real_pos[3], p3m_int shifted) {
 /** Assign the charges to the grid */
 void P3M::FarSolver::assignCharges(p3m_float* data, p3m_int num_charges,
         p3m_float* positions, p3m_float* charges, p3m_int shifted) {
-    P3M_DEBUG(printf( "  P3M::FarSolver::assignCharges() started...\n"));
+    (this->*assign_charges)(data, num_charges, positions, charges, shifted);
+}
 
+/** Assign a single charge q at position to the grid. */
+template<p3m_int CAO>
+inline void P3M::FarSolver::assignChargeCAO(p3m_float* data,
+        p3m_float* position, p3m_float q, p3m_int shifted) {
     const p3m_int q2off = local_grid.q_2_off;
     const p3m_int q21off = local_grid.q_21_off;
 
+    p3m_float caf_v[3][CAO];
+    p3m_int linind_grid =
+            this->getCAPoints<CAO>(position, shifted, caf_v, NULL);
+
+    /* Loop over all ca grid points nearby and compute charge assignment fraction */
+    for (p3m_int i0 = 0; i0 < CAO; i0++) {
+        for (p3m_int i1 = 0; i1 < CAO; i1++) {
+            const p3m_float q_caf_xy = q * (caf_v[0][i0] * caf_v[1][i1]);
+            p3m_float *grid_z = &data[linind_grid];
+            for (p3m_int i2 = 0; i2 < CAO; i2++)
+                /* add it to the grid */
+                grid_z[i2] += q_caf_xy * caf_v[2][i2];
+            linind_grid += CAO + q2off;
+        }
+        linind_grid += q21off;
+    }
+}
+
+template<p3m_int CAO>
+void P3M::FarSolver::assignChargesCAO(p3m_float* data, p3m_int num_charges,
+        p3m_float* positions, p3m_float* charges, p3m_int shifted) {
+    P3M_DEBUG(printf( "  P3M::FarSolver::assignCharges() started...\n"));
+
     /* init local charge grid */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for (p3m_int i=0; i<local_grid.size; i++) data[i] = 0.0;
 
-    /* now assign the charges */
-    for (p3m_int pid = 0; pid < num_charges; pid++) {
-        const p3m_float q = charges[pid];
-        p3m_int linind_grid = this->getCAPoints(&positions[pid*3], shifted);
-
-        /* Loop over all ca grid points nearby and compute charge assignment fraction */
-        for (p3m_float *caf_x = cafx->begin(); caf_x < cafx->end(); caf_x++) {
-            for (p3m_float *caf_y = cafy->begin(); caf_y < cafy->end(); caf_y++) {
-                p3m_float caf_xy = *caf_x * *caf_y;
-                for (p3m_float *caf_z = cafz->begin(); caf_z < cafz->end(); caf_z++) {
-                    /* add it to the grid */
-                    data[linind_grid] += q * caf_xy * *caf_z;
-                    linind_grid++;
+#ifdef _OPENMP
+    /* Split the possible first grid points in x direction into slabs
+       that are at least cao-1 grid points thick. The charges of a
+       slab then only touch the grid of the next slab, so that all
+       even and then all odd slabs can be assigned concurrently. */
+    const p3m_int num_first = local_grid.dim[0] - CAO + 1;
+    p3m_int num_slabs = 2*omp_get_max_threads();
+    if (CAO > 1)
+        num_slabs = std::min(num_slabs, num_first / (CAO-1));
+    if (num_slabs > 1 && num_charges > num_slabs) {
+        const p3m_int slab_width = (num_first + num_slabs - 1) / num_slabs;
+        p3m_int *slab_start = new p3m_int[num_slabs+1];
+        p3m_int *slab_of = new p3m_int[num_charges];
+        p3m_int *order = new p3m_int[num_charges];
+
+        /* sort the charges into the slabs (by the same first grid point
+           as in getCAPoints, the slabs would overlap otherwise) */
+        for (p3m_int s = 0; s <= num_slabs; s++) slab_start[s] = 0;
+        for (p3m_int pid = 0; pid < num_charges; pid++) {
+            p3m_int first = static_cast<p3m_int>(floor(
+                    getCAPosition(positions[3*pid], 0, shifted)));
+            first = std::max<p3m_int>(0, std::min(first, num_first-1));
+            slab_of[pid] = first / slab_width;
+            slab_start[slab_of[pid]+1]++;
+        }
+        for (p3m_int s = 0; s < num_slabs; s++)
+            slab_start[s+1] += slab_start[s];
+        for (p3m_int pid = 0; pid < num_charges; pid++)
+            order[slab_start[slab_of[pid]]++] = pid;
+        for (p3m_int s = num_slabs; s > 0; s--)
+            slab_start[s] = slab_start[s-1];
+        slab_start[0] = 0;
+
+#pragma omp parallel
+        for (p3m_int color = 0; color < 2; color++) {
+#pragma omp for schedule(dynamic)
+            for (p3m_int s = color; s < num_slabs; s += 2)
+                for (p3m_int i = slab_start[s]; i < slab_start[s+1]; i++) {
+                    const p3m_int pid = order[i];
+                    this->assignChargeCAO<CAO>(data, &positions[3*pid],
+                            charges[pid], shifted);
                 }
-                linind_grid += q2off;
-            }
-            linind_grid += q21off;
         }
-    }
+
+        delete[] slab_start;
+        delete[] slab_of;
+        delete[] order;
+    } else
+#endif
+    /* now assign the charges */
+    for (p3m_int pid = 0; pid < num_charges; pid++)
+        this->assignChargeCAO<CAO>(data, &positions[pid*3], charges[pid],
+                shifted);
 
     P3M_DEBUG(printf( "  P3M::FarSolver::assignCharges() finished...\n"));
 
@@ -1176,13 +1238,16 @@ void P3M::FarSolver::gatherGrid(p3m_float* rs_grid) {
                     sm.s_dim[s_dir], local_grid.dim, 1);
 
         /* communication */
-        if (comm.node_neighbors[s_dir] != comm.rank)
-            MPI_Sendrecv(send_grid, sm.s_size[s_dir], P3M_MPI_FLOAT,
-                    comm.node_neighbors[s_dir], REQ_P3M_GATHER,
-                    recv_grid, sm.r_size[r_dir], P3M_MPI_FLOAT,
+        if (comm.node_neighbors[s_dir] != comm.rank) {
+            MPI_Request requests[2];
+            MPI_Irecv(recv_grid, sm.r_size[r_dir], P3M_MPI_FLOAT,
                     comm.node_neighbors[r_dir], REQ_P3M_GATHER,
-                    comm.mpicomm, MPI_STATUS_IGNORE);
-        else std::swap(recv_grid, send_grid);
+                    comm.mpicomm, &requests[0]);
+            MPI_Isend(send_grid, sm.s_size[s_dir], P3M_MPI_FLOAT,
+                    comm.node_neighbors[s_dir], REQ_P3M_GATHER,
+                    comm.mpicomm, &requests[1]);
+            comm.waitall(2, requests);
+        } else std::swap(recv_grid, send_grid);
 
         /* add recv block */
         if(sm.r_size[r_dir]>0) {
@@ -1207,13 +1272,16 @@ void P3M::FarSolver::spreadGrid(p3m_float* rs_grid) {
             Parallel3DFFT::pack_block(rs_grid, send_grid, sm.r_ld[r_dir],
                     sm.r_dim[r_dir], local_grid.dim, 1);
         /* communication */
-        if (comm.node_neighbors[r_dir] != comm.rank)
-            MPI_Sendrecv(send_grid, sm.r_size[r_dir], P3M_MPI_FLOAT,
-                    comm.node_neighbors[r_dir], REQ_P3M_SPREAD,
-                    recv_grid, sm.s_size[s_dir], P3M_MPI_FLOAT,
+        if (comm.node_neighbors[r_dir] != comm.rank) {
+            MPI_Request requests[2];
+            MPI_Irecv(recv_grid, sm.s_size[s_dir], P3M_MPI_FLOAT,
                     comm.node_neighbors[s_dir], REQ_P3M_SPREAD,
-                    comm.mpicomm, MPI_STATUS_IGNORE);
-        else std::swap(recv_grid, send_grid);
+                    comm.mpicomm, &requests[0]);
+            MPI_Isend(send_grid, sm.r_size[r_dir], P3M_MPI_FLOAT,
+                    comm.node_neighbors[r_dir], REQ_P3M_SPREAD,
+                    comm.mpicomm, &requests[1]);
+            comm.waitall(2, requests);
+        } else std::swap(recv_grid, send_grid);
 
         /* unpack recv block */
         if (sm.s_size[s_dir]>0)
@@ -1290,22 +1358,41 @@ p3m_float P3M::FarSolver::computeTotalEnergy() {
 
     P3M_DEBUG(printf( "  P3M::FarSolver::computeTotalEnergy() started...\n"));
 
-    p3m_int size = fft.getKSSize();
-    for (p3m_int i=0; i < size; i++)
-        /* Use the energy optimized influence function */
-        k_space_energy += g_energy[i] * ( SQR(rs_grid[2*i]) +
-                SQR(rs_grid[2*i+1]) );
+    p3m_int half_dim, half_grid;
+    if (fft.getKSHalfDim(half_dim, half_grid)) {
+        /* Only the non-negative frequencies of direction half_dim are
+           stored, all other points also stand for their conjugate. */
+        const p3m_int *start, *extent;
+        fft.getKSExtent(start, extent);
+        p3m_int j[3];
+        p3m_int i = 0;
+        for (j[0]=0; j[0] < extent[0]; j[0]++)
+            for (j[1]=0; j[1] < extent[1]; j[1]++)
+                for (j[2]=0; j[2] < extent[2]; j[2]++, i++) {
+                    const p3m_int k = j[half_dim] + start[half_dim];
+                    const p3m_float weight =
+                            (k == 0 || 2*k == half_grid) ? 1.0 : 2.0;
+                    /* Use the energy optimized influence function */
+                    k_space_energy += weight * g_energy[i] *
+                            ( SQR(rs_grid[2*i]) + SQR(rs_grid[2*i+1]) );
+                }
+    } else {
+        p3m_int size = fft.getKSSize();
+        for (p3m_int i=0; i < size; i++)
+            /* Use the energy optimized influence function */
+            k_space_energy += g_energy[i] * ( SQR(rs_grid[2*i]) +
+                    SQR(rs_grid[2*i+1]) );
+    }
 
     MPI_Reduce(MPI_IN_PLACE, &k_space_energy, 1, P3M_MPI_FLOAT,
             MPI_SUM, 0, comm.mpicomm);
     p3m_float prefactor = 1.0 / (2.0 * box_l[0] * box_l[1] * box_l[2]);
     k_space_energy *= prefactor;
 
-#ifdef P3M_INTERLACE
-    /* In the case of interlacing we have calculated the sum of the
-       shifted and unshifted charges, we have to take the average. */
-    k_space_energy *= 0.5;
-#endif
+    if (variant == P3M_VARIANT_ADI)
+        /* In the case of interlacing we have calculated the sum of the
+           shifted and unshifted charges, we have to take the average. */
+        k_space_energy *= 0.5;
 
     /* self energy correction */
     k_space_energy -= sum_q2 * alpha * 0.5*M_2_SQRTPI;
@@ -1320,26 +1407,37 @@ p3m_float P3M::FarSolver::computeTotalEnergy() {
 void P3M::FarSolver::assignPotentials(p3m_float* data, p3m_int num_particles,
         p3m_float* positions, p3m_float* charges, p3m_int shifted,
         p3m_float* potentials) {
+    (this->*assign_potentials)(data, num_particles, positions, charges,
+            shifted, potentials);
+}
+
+template<p3m_int CAO>
+void P3M::FarSolver::assignPotentialsCAO(p3m_float* data,
+        p3m_int num_particles, p3m_float* positions, p3m_float* charges,
+        p3m_int shifted, p3m_float* potentials) {
     const p3m_int q2off = local_grid.q_2_off;
     const p3m_int q21off = local_grid.q_21_off;
     const p3m_float prefactor = 1.0 / (box_l[0] * box_l[1] * box_l[2]);
 
     P3M_DEBUG(printf( "  P3M::FarSolver::assignPotentials() started...\n"));
     /* Loop over all particles */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for (p3m_int pid=0; pid < num_particles; pid++) {
         p3m_float potential = 0.0;
+        p3m_float caf_v[3][CAO];
         p3m_int linind_grid =
-                this->getCAPoints(&positions[pid*3], shifted);
+                this->getCAPoints<CAO>(&positions[pid*3], shifted, caf_v, NULL);
 
         /* Loop over all ca grid points nearby and compute charge assignment fraction */
-        for (p3m_float *caf_x = cafx->begin(); caf_x < cafx->end(); caf_x++) {
-            for (p3m_float *caf_y = cafy->begin(); caf_y < cafy->end(); caf_y++) {
-                p3m_float caf_xy = *caf_x * *caf_y;
-                for (p3m_float *caf_z = cafz->begin(); caf_z < cafz->end(); caf_z++) {
-                    potential += *caf_z * caf_xy * data[linind_grid];
-                    linind_grid++;
-                }
-                linind_grid += q2off;
+        for (p3m_int i0 = 0; i0 < CAO; i0++) {
+            for (p3m_int i1 = 0; i1 < CAO; i1++) {
+                const p3m_float caf_xy = caf_v[0][i0] * caf_v[1][i1];
+                const p3m_float *grid_z = &data[linind_grid];
+                for (p3m_int i2 = 0; i2 < CAO; i2++)
+                    potential += caf_v[2][i2] * caf_xy * grid_z[i2];
+                linind_grid += CAO + q2off;
             }
             linind_grid += q21off;
         }
@@ -1366,6 +1464,14 @@ void P3M::FarSolver::assignPotentials(p3m_float* data, p3m_int num_particles,
 void P3M::FarSolver::assignFieldsIK(p3m_float* data, p3m_int dim,
         p3m_int num_particles, p3m_float* positions, p3m_int shifted,
         p3m_float* fields){
+    (this->*assign_fields_ik)(data, dim, num_particles, positions, shifted,
+            fields);
+}
+
+template<p3m_int CAO>
+void P3M::FarSolver::assignFieldsIKCAO(p3m_float* data, p3m_int dim,
+        p3m_int num_particles, p3m_float* positions, p3m_int shifted,
+        p3m_float* fields){
     const p3m_int q2off = local_grid.q_2_off;
     const p3m_int q21off = local_grid.q_21_off;
     const p3m_float prefactor = 1.0 / (2.0 * box_l[0] * box_l[1] * box_l[2]);
@@ -1373,20 +1479,23 @@ void P3M::FarSolver::assignFieldsIK(p3m_float* data, p3m_int dim,
 
     P3M_DEBUG(printf( "  P3M::FarSolver::assignFieldsIK() started...\n"));
     /* Loop over all particles */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for (p3m_int pid=0; pid < num_particles; pid++) {
         p3m_float field = 0.0;
+        p3m_float caf_v[3][CAO];
         p3m_int linind_grid =
-                this->getCAPoints(&positions[3*pid], shifted);
+                this->getCAPoints<CAO>(&positions[3*pid], shifted, caf_v, NULL);
 
         /* loop over the local grid, compute the field */
-        for (p3m_float *caf_x = cafx->begin(); caf_x < cafx->end(); caf_x++) {
-            for (p3m_float *caf_y = cafy->begin(); caf_y < cafy->end(); caf_y++) {
-                p3m_float caf_xy = *caf_x * *caf_y;
-                for (p3m_float *caf_z = cafz->begin(); caf_z < cafz->end(); caf_z++) {
-                    field -= *caf_z * caf_xy * data[linind_grid];
-                    linind_grid++;
-                }
-                linind_grid += q2off;
+        for (p3m_int i0 = 0; i0 < CAO; i0++) {
+            for (p3m_int i1 = 0; i1 < CAO; i1++) {
+                const p3m_float caf_xy = caf_v[0][i0] * caf_v[1][i1];
+                const p3m_float *grid_z = &data[linind_grid];
+                for (p3m_int i2 = 0; i2 < CAO; i2++)
+                    field -= caf_v[2][i2] * caf_xy * grid_z[i2];
+                linind_grid += CAO + q2off;
             }
             linind_grid += q21off;
         }
@@ -1406,6 +1515,13 @@ void P3M::FarSolver::assignFieldsIK(p3m_float* data, p3m_int dim,
 /* Backinterpolate the forces obtained from k-space to the positions */
 void P3M::FarSolver::assignFieldsAD(p3m_float* data, p3m_int num_particles,
         p3m_float* positions, p3m_int shifted, p3m_float* fields) {
+    (this->*assign_fields_ad)(data, num_particles, positions, shifted, fields);
+}
+
+template<p3m_int CAO>
+void P3M::FarSolver::assignFieldsADCAO(p3m_float* data,
+        p3m_int num_particles, p3m_float* positions, p3m_int shifted,
+        p3m_float* fields) {
     const p3m_int q2off = local_grid.q_2_off;
     const p3m_int q21off = local_grid.q_21_off;
     const p3m_float prefactor = 1.0 / (box_l[0] * box_l[1] * box_l[2]);
@@ -1415,31 +1531,29 @@ void P3M::FarSolver::assignFieldsAD(p3m_float* data, p3m_int num_particles,
 
     P3M_DEBUG(printf( "  P3M::Solver::assign_fields_ad() started...\n"));
     /* Loop over all particles */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for (p3m_int pid = 0; pid < num_particles; pid++) {
         p3m_float field[3] = { 0.0, 0.0, 0.0 };
+        p3m_float caf_v[3][CAO], caf_dv[3][CAO];
         p3m_int linind_grid =
-                this->getCAPoints(&positions[pid*3], shifted);
-
-        p3m_float *caf_x_d = cafx_d->begin();
-        for (p3m_float *caf_x = cafx->begin(); caf_x < cafx->end(); caf_x++) {
-            p3m_float *caf_y_d = cafy_d->begin();
-            for (p3m_float *caf_y = cafy->begin(); caf_y < cafy->end(); caf_y++) {
-                p3m_float *caf_z_d = cafz_d->begin();
-                for (p3m_float *caf_z = cafz->begin(); caf_z < cafz->end(); caf_z++) {
-                    field[0] -= *caf_x_d * *caf_y * *caf_z * l_x_inv
-                            * data[linind_grid] * grid[0];
-                    field[1] -= *caf_x * *caf_y_d * *caf_z * l_y_inv
-                            * data[linind_grid] * grid[1];
-                    field[2] -= *caf_x * *caf_y * *caf_z_d * l_z_inv
-                            * data[linind_grid] * grid[2];
-                    linind_grid++;
-                    caf_z_d++;
+                this->getCAPoints<CAO>(&positions[pid*3], shifted, caf_v, caf_dv);
+
+        for (p3m_int i0 = 0; i0 < CAO; i0++) {
+            for (p3m_int i1 = 0; i1 < CAO; i1++) {
+                const p3m_float *grid_z = &data[linind_grid];
+                for (p3m_int i2 = 0; i2 < CAO; i2++) {
+                    field[0] -= caf_dv[0][i0] * caf_v[1][i1] * caf_v[2][i2]
+                            * l_x_inv * grid_z[i2] * grid[0];
+                    field[1] -= caf_v[0][i0] * caf_dv[1][i1] * caf_v[2][i2]
+                            * l_y_inv * grid_z[i2] * grid[1];
+                    field[2] -= caf_v[0][i0] * caf_v[1][i1] * caf_dv[2][i2]
+                            * l_z_inv * grid_z[i2] * grid[2];
                 }
-                linind_grid += q2off;
-                caf_y_d++;
+                linind_grid += CAO + q2off;
             }
             linind_grid += q21off;
-            caf_x_d++;
         }
         field[0] *= prefactor;
         field[1] *= prefactor;
@@ -1458,6 +1572,31 @@ void P3M::FarSolver::assignFieldsAD(p3m_float* data, p3m_int num_particles,
     P3M_DEBUG(printf( "  assign_fields_ad() finished.\n"));
 }
 
+/** Use the charge assignment and back interpolation kernels of the
+    charge assignment order cao. */
+template<p3m_int CAO>
+void P3M::FarSolver::setKernels() {
+    assign_charges = &FarSolver::assignChargesCAO<CAO>;
+    assign_potentials = &FarSolver::assignPotentialsCAO<CAO>;
+    assign_fields_ik = &FarSolver::assignFieldsIKCAO<CAO>;
+    assign_fields_ad = &FarSolver::assignFieldsADCAO<CAO>;
+}
+
+void P3M::FarSolver::selectKernels() {
+    switch (cao) {
+    case 1: setKernels<1>(); break;
+    case 2: setKernels<2>(); break;
+    case 3: setKernels<3>(); break;
+    case 4: setKernels<4>(); break;
+    case 5: setKernels<5>(); break;
+    case 6: setKernels<6>(); break;
+    case 7: setKernels<7>(); break;
+    default:
+        throw std::logic_error("Internal error: "
+                "Charge assignment order should not occur!");
+    }
+}
+
 /** Calculate number of charged particles, the sum of the squared
       charges and the squared sum of the charges. Called in parallel at
       the beginning of tuning. */
@@ -1512,12 +1651,11 @@ const double* P3M::FarSolver::measureTimings(p3m_int num_particles,
     TimingType require_timings_before = require_timings;
     if (require_timings == NONE || require_timings == FULL)
         require_timings = ESTIMATE_ALL;
-#if defined(P3M_INTERLACE) && defined(P3M_AD)
-    //todo here we need the triclinic conversion!
-    this->runADI(num_particles, positions, charges, fields, potentials);
-#else
-    this->runIK(num_particles, positions, charges, fields, potentials);
-#endif
+    if (variant == P3M_VARIANT_ADI)
+        //todo here we need the triclinic conversion!
+        this->runADI(num_particles, positions, charges, fields, potentials);
+    else
+        this->runIK(num_particles, positions, charges, fields, potentials);
 
     /* restore require_timings */
     require_timings = require_timings_before;
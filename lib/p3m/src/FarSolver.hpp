@@ -48,7 +48,8 @@ public:
     };
 
     FarSolver(Communication &comm, p3m_float box_l[3],
-            p3m_float r_cut, p3m_float alpha, p3m_int grid[3], p3m_int cao, p3m_float box_vectors[3][3], p3m_float volume, bool isTriclinic);
+            p3m_float r_cut, p3m_float alpha, p3m_int grid[3], p3m_int cao, p3m_float box_vectors[3][3], p3m_float volume, bool isTriclinic,
+            p3m_int variant, p3m_int fft_rigor);
     virtual ~FarSolver();
 
     void runADI(p3m_int num_charges, p3m_float *positions, p3m_float *charges,
@@ -100,6 +101,8 @@ protected:
     p3m_int grid[3];
     /** charge assignment order ([0,P3M_MAX_CAO]). */
     p3m_int cao;
+    /** variant of the algorithm (P3M_VARIANT_IK or P3M_VARIANT_ADI). */
+    p3m_int variant;
 
     /****************************************************
      * FLAGS TO TURN ON/OFF COMPUTATION OF DIFFERENT COMPONENTS
@@ -162,14 +165,22 @@ protected:
 
     /** charge assignment function. */
     CAF *caf;
-    CAF::Cache *cafx;
-    CAF::Cache *cafy;
-    CAF::Cache *cafz;
     /** gradient of charge assignment function */
     CAF *caf_d;
-    CAF::Cache *cafx_d;
-    CAF::Cache *cafy_d;
-    CAF::Cache *cafz_d;
+
+    /** charge assignment and back interpolation kernels for the
+        charge assignment order (see selectKernels()) */
+    void (FarSolver::*assign_charges)(p3m_float *data, p3m_int num_charges,
+            p3m_float *positions, p3m_float *charges, p3m_int shifted);
+    void (FarSolver::*assign_potentials)(p3m_float *data,
+            p3m_int num_particles, p3m_float* positions, p3m_float* charges,
+            p3m_int shifted, p3m_float* potentials);
+    void (FarSolver::*assign_fields_ik)(p3m_float *data, p3m_int dim,
+            p3m_int num_particles, p3m_float* positions, p3m_int shifted,
+            p3m_float* fields);
+    void (FarSolver::*assign_fields_ad)(p3m_float *data,
+            p3m_int num_particles, p3m_float* positions, p3m_int shifted,
+            p3m_float* fields);
 
     /** position shift for calc. of first assignment grid point. */
     p3m_float pos_shift;
@@ -217,10 +228,23 @@ protected:
     void cartesianizeFields(p3m_float *fields, p3m_int num_particles);
     p3m_int *computeGridShift(int dir, p3m_int size);
 
+    /* select the kernels for cao */
+    void selectKernels();
+    template<p3m_int CAO> void setKernels();
+
     /* charge assignment */
-    p3m_int getCAPoints(p3m_float real_pos[3], p3m_int shifted);
+    p3m_float getCAPosition(p3m_float real_pos, p3m_int dim, p3m_int shifted);
+    template<p3m_int CAO>
+    p3m_int getCAPoints(p3m_float real_pos[3], p3m_int shifted,
+            p3m_float caf_v[3][CAO], p3m_float caf_dv[3][CAO]);
     void assignCharges(p3m_float *data,
             p3m_int num_charges, p3m_float *positions, p3m_float *charges, p3m_int shifted);
+    template<p3m_int CAO>
+    void assignChargeCAO(p3m_float *data,
+            p3m_float *position, p3m_float q, p3m_int shifted);
+    template<p3m_int CAO>
+    void assignChargesCAO(p3m_float *data,
+            p3m_int num_charges, p3m_float *positions, p3m_float *charges, p3m_int shifted);
 
     /* collect grid from neighbor processes */
     void gatherGrid(p3m_float* rs_grid);
@@ -240,18 +264,30 @@ protected:
     assignPotentials(p3m_float *data,
             p3m_int num_particles, p3m_float* positions, p3m_float* charges,
             p3m_int shifted, p3m_float* potentials);
+    template<p3m_int CAO> void
+    assignPotentialsCAO(p3m_float *data,
+            p3m_int num_particles, p3m_float* positions, p3m_float* charges,
+            p3m_int shifted, p3m_float* potentials);
 
     /* Assign the fields to the positions in dimension dim [IK] */
     void
     assignFieldsIK(p3m_float *data,
             p3m_int dim, p3m_int num_particles, p3m_float* positions,
             p3m_int shifted, p3m_float* fields);
+    template<p3m_int CAO> void
+    assignFieldsIKCAO(p3m_float *data,
+            p3m_int dim, p3m_int num_particles, p3m_float* positions,
+            p3m_int shifted, p3m_float* fields);
 
     /* Backinterpolate the forces obtained from k-space to the positions [AD]*/
     void
     assignFieldsAD(p3m_float *data,
             p3m_int num_particles, p3m_float* positions,
             p3m_int shifted, p3m_float* fields);
+    template<p3m_int CAO> void
+    assignFieldsADCAO(p3m_float *data,
+            p3m_int num_particles, p3m_float* positions,
+            p3m_int shifted, p3m_float* fields);
 
     void countCharges(p3m_int num_particles, p3m_float *charges);
 
@@ -42,6 +42,11 @@ void ErrorEstimate::computeKSError(TuneParameters& p, p3m_int num_charges,
 	    }
 	}
 
+	// the approximation assumes the same grid constant in all dimensions
+	p3m_float h0 = box_l[0] / p.grid[0];
+	for (int i = 1; i < 3 && !full_estimate; i++)
+	    full_estimate = fabs(box_l[i] / p.grid[i] - h0) > ROUND_ERROR_PREC * h0;
+
 #ifdef P3M_ENABLE_DEBUG
 	if (comm.onMaster() && !full_estimate)
 	    printf("        alpha*h < " FFLOAT " => approximation\n",
@@ -132,9 +137,9 @@ void ErrorEstimate::computeKSErrorApprox(TuneParameters& p,
 	};
 
 	p.ks_error =
-	        sum_q2 / (box_l[0] * box_l[0])
-	        * pow(h * p.alpha, p.cao)
-	        * sqrt(p.alpha * box_l[0] / num_charges * sqrt(2.0 * M_PI) * sum);
+	        sum_q2 * pow(h * p.alpha, p.cao)
+	        * sqrt(p.alpha / (num_charges * box_l[0] * box_l[1] * box_l[2])
+	                * sqrt(2.0 * M_PI) * sum);
 }
 
 /** Calculates the reciprocal space contribution to the rms error in the
@@ -154,8 +159,10 @@ void ErrorEstimate::computeKSErrorFull(TuneParameters& p, p3m_int num_charges,
 	p3m_float local_he_q = 0.0;
 	p3m_float grid_i[3] =
 			{ 1.0 / p.grid[0], 1.0 / p.grid[1], 1.0 / p.grid[2] };
-	/* @todo Handle non-cubic case? */
 	p3m_float alpha_L_i = 1. / (p.alpha * box_l[0]);
+	/* wave vectors in units of 2 pi/box_l[0] */
+	p3m_float box_scale[3] =
+			{ 1.0, box_l[0] / box_l[1], box_l[0] / box_l[2] };
 
 	// Distribute indices onto parallel tasks
 	p3m_int num_ix = p.grid[0] * p.grid[1] * p.grid[2];
@@ -197,13 +204,14 @@ void ErrorEstimate::computeKSErrorFull(TuneParameters& p, p3m_int num_charges,
 		}
 
 		if (nx != 0 || ny != 0 || nz != 0) {
-			p3m_float n2 = nx * nx + ny * ny + nz * nz;
+			p3m_float n2 = SQR(nx * box_scale[0]) + SQR(ny * box_scale[1])
+					+ SQR(nz * box_scale[2]);
 			p3m_float cs = ctan_x * ctan_y
 					* KSErrorSum1(nz, grid_i[2], p.cao);
 			p3m_float alias1, alias2;
 			// TODO: sum2_ad for IKI?
-			KSErrorSum2(nx, ny, nz, p.grid, grid_i, p.cao, alpha_L_i,
-					&alias1, &alias2);
+			KSErrorSum2(nx, ny, nz, p.grid, grid_i, box_scale, p.cao,
+					alpha_L_i, &alias1, &alias2);
 			p3m_float d = alias1 - SQR(alias2 / cs) / n2;
 			/* at high precisions, d can become negative due to extinction;
 			 also, don't take values that have no significant digits left*/
@@ -295,29 +303,35 @@ p3m_float ErrorEstimate::KSErrorSum1(p3m_int n, p3m_float grid_i, p3m_int cao) {
 /** aliasing sum used by \ref k_space_error. */
 void
 ErrorEstimate::KSErrorSum2(p3m_int nx, p3m_int ny, p3m_int nz, p3m_int grid[3],
-		p3m_float grid_i[3], p3m_int cao, p3m_float alpha_L_i,
-		p3m_float *alias1, p3m_float *alias2) {
+		p3m_float grid_i[3], p3m_float box_scale[3], p3m_int cao,
+		p3m_float alpha_L_i, p3m_float *alias1, p3m_float *alias2) {
 	p3m_float prefactor = SQR(M_PI * alpha_L_i);
+	p3m_float kx = box_scale[0] * nx;
+	p3m_float ky = box_scale[1] * ny;
+	p3m_float kz = box_scale[2] * nz;
 
 	*alias1 = *alias2 = 0.0;
 	for (p3m_int mx = -P3M_BRILLOUIN; mx <= P3M_BRILLOUIN; mx++) {
 		p3m_float nmx = nx + mx * grid[0];
 		p3m_float fnmx = grid_i[0] * nmx;
+		p3m_float kmx = box_scale[0] * nmx;
 		for (p3m_int my = -P3M_BRILLOUIN; my <= P3M_BRILLOUIN; my++) {
 			p3m_float nmy = ny + my * grid[1];
 			p3m_float fnmy = grid_i[1] * nmy;
+			p3m_float kmy = box_scale[1] * nmy;
 			for (p3m_int mz = -P3M_BRILLOUIN; mz <= P3M_BRILLOUIN; mz++) {
 				p3m_float nmz = nz + mz * grid[2];
 				p3m_float fnmz = grid_i[2] * nmz;
+				p3m_float kmz = box_scale[2] * nmz;
 
-				p3m_float nm2 = SQR(nmx) + SQR(nmy) + SQR(nmz);
+				p3m_float nm2 = SQR(kmx) + SQR(kmy) + SQR(kmz);
 				p3m_float ex = exp(-prefactor * nm2);
 
 				p3m_float U2 = pow(sinc(fnmx) * sinc(fnmy) * sinc(fnmz),
 						2.0 * cao);
 
 				*alias1 += ex * ex / nm2;
-				*alias2 += U2 * ex * (nx * nmx + ny * nmy + nz * nmz) / nm2;
+				*alias2 += U2 * ex * (kx * kmx + ky * kmy + kz * kmz) / nm2;
 			}
 		}
 	}
@@ -32,17 +32,29 @@
 #include <algorithm>
 #include <cassert>
 #include <stdexcept>
+#include <map>
+#if defined(_OPENMP) && defined(FCS_USE_FFTW3_THREADS)
+#include <omp.h>
+#endif
 
 #define fftw_complex  FFTW_MANGLE(complex)
 #define fftw_free  FFTW_MANGLE(free)
 #define fftw_malloc  FFTW_MANGLE(malloc)
 #define fftw_plan_many_dft  FFTW_MANGLE(plan_many_dft)
+#define fftw_plan_many_dft_r2c  FFTW_MANGLE(plan_many_dft_r2c)
+#define fftw_plan_many_dft_c2r  FFTW_MANGLE(plan_many_dft_c2r)
 #define fftw_destroy_plan  FFTW_MANGLE(destroy_plan)
 #define fftw_execute  FFTW_MANGLE(execute)
 #define fftw_execute_dft  FFTW_MANGLE(execute_dft)
+#define fftw_execute_dft_r2c  FFTW_MANGLE(execute_dft_r2c)
+#define fftw_execute_dft_c2r  FFTW_MANGLE(execute_dft_c2r)
 #define fftw_import_system_wisdom  FFTW_MANGLE(import_system_wisdom)
 #define fftw_import_wisdom_from_filename  FFTW_MANGLE(import_wisdom_from_filename)
 #define fftw_export_wisdom_to_filename  FFTW_MANGLE(export_wisdom_to_filename)
+#define fftw_import_wisdom_from_string  FFTW_MANGLE(import_wisdom_from_string)
+#define fftw_export_wisdom_to_string  FFTW_MANGLE(export_wisdom_to_string)
+#define fftw_init_threads  FFTW_MANGLE(init_threads)
+#define fftw_plan_with_nthreads  FFTW_MANGLE(plan_with_nthreads)
 
 namespace P3M {
 /***************************************************/
@@ -68,6 +80,93 @@ static void
 pack_block_permute2(p3m_float *in, p3m_float *out, int start[3], int size[3],
 		int dim[3], int element);
 
+static void import_wisdom(Communication &comm);
+static void export_wisdom(Communication &comm);
+
+/***************************************************/
+/* PLAN CACHE */
+/***************************************************/
+/** Cache of the 1D FFTW plans of all Parallel3DFFT objects of the
+ *  process.
+ *
+ *  A plan only depends on the kind of transform, its length and the
+ *  number of transforms, i.e. on the row layout of the node grid, so
+ *  that the parameter sets timed during tuning and the final parameters
+ *  share their plans. The plans are kept until the end of the program.
+ */
+class PlanCache {
+public:
+	enum Kind { FORWARD, BACKWARD, R2C, C2R };
+
+	~PlanCache() {
+		for (iterator it = plans.begin(); it != plans.end(); ++it)
+			fftw_destroy_plan(it->second);
+	}
+
+	/** Get a plan with at least the given rigor. If it has to be
+	 *  created, the buffers are overwritten and created is set. */
+	fftw_plan get(Kind kind, int n, int howmany, p3m_int rigor,
+			p3m_float *real_buf, fftw_complex *c_buf, bool &created) {
+		for (p3m_int r = P3M_FFTW_EXHAUSTIVE; r >= rigor; r--) {
+			iterator it = plans.find(Key(kind, n, howmany, r));
+			if (it != plans.end())
+				return it->second;
+		}
+
+		static const unsigned flags[] = { FFTW_ESTIMATE, FFTW_MEASURE,
+				FFTW_PATIENT, FFTW_EXHAUSTIVE };
+		const int n_half = n / 2 + 1;
+		fftw_plan plan;
+#if defined(_OPENMP) && defined(FCS_USE_FFTW3_THREADS)
+		// let the 1D FFTs use all threads of the process, the number of
+		// threads is a global FFTW setting, so it is reset to FFTW's
+		// default afterwards to leave the plans of others unaffected
+		fftw_plan_with_nthreads(omp_get_max_threads());
+#endif
+		switch (kind) {
+		case R2C:
+			plan = fftw_plan_many_dft_r2c(1, &n, howmany, real_buf, NULL, 1, n,
+					c_buf, NULL, 1, n_half, flags[rigor]);
+			break;
+		case C2R:
+			plan = fftw_plan_many_dft_c2r(1, &n, howmany, c_buf, NULL, 1, n_half,
+					real_buf, NULL, 1, n, flags[rigor]);
+			break;
+		default:
+			plan = fftw_plan_many_dft(1, &n, howmany, c_buf, NULL, 1, n,
+					c_buf, NULL, 1, n,
+					kind == FORWARD ? FFTW_FORWARD : FFTW_BACKWARD,
+					flags[rigor]);
+		}
+#if defined(_OPENMP) && defined(FCS_USE_FFTW3_THREADS)
+		fftw_plan_with_nthreads(1);
+#endif
+		plans[Key(kind, n, howmany, rigor)] = plan;
+		created = true;
+		return plan;
+	}
+
+private:
+	struct Key {
+		int kind, n, howmany, rigor;
+		Key(int kind, int n, int howmany, int rigor)
+		: kind(kind), n(n), howmany(howmany), rigor(rigor) {}
+		bool operator<(const Key &k) const {
+			if (kind != k.kind) return kind < k.kind;
+			if (n != k.n) return n < k.n;
+			if (howmany != k.howmany) return howmany < k.howmany;
+			return rigor < k.rigor;
+		}
+	};
+	typedef std::map<Key, fftw_plan>::iterator iterator;
+	std::map<Key, fftw_plan> plans;
+};
+
+static PlanCache plan_cache;
+
+/** Whether the wisdom of the wisdom file has been imported. */
+static bool wisdom_imported = false;
+
 /***************************************************/
 /* IMPLEMENTATION */
 /***************************************************/
@@ -114,36 +213,45 @@ Parallel3DFFT::Parallel3DFFT(Communication &comm) : comm(comm) {
     plan[i].recv_block = NULL;
     plan[i].recv_size = NULL;
     plan[i].plan = NULL;
+    plan[i].group_comm = MPI_COMM_NULL;
+    plan[i].group_rank = new int[comm.size];
+    plan[i].send_counts = new int[comm.size];
+    plan[i].send_displs = new int[comm.size];
+    plan[i].recv_counts = new int[comm.size];
+    plan[i].recv_displs = new int[comm.size];
 
     back[i].plan = NULL;
   }
   
   is_prepared = false;
+  interlace = false;
+  ks_half_dim = -1;
+  ks_half_grid = 0;
   max_comm_size = 0;
   max_grid_size = 0;
   send_buf = NULL;
   recv_buf = NULL;
   
-  // import fftw wisdom
-  fftw_import_system_wisdom();
-  fftw_import_wisdom_from_filename(P3M_FFTW_WISDOM_FILENAME);
+#if defined(_OPENMP) && defined(FCS_USE_FFTW3_THREADS)
+  // the 1D FFT plans use threads (see PlanCache::get)
+  fftw_init_threads();
+#endif
 }
   
 Parallel3DFFT::~Parallel3DFFT() {
-  // store wisdom
-  fftw_export_wisdom_to_filename(P3M_FFTW_WISDOM_FILENAME);
-
   for (int i = 0; i < 4; i++) {
     sdelete(plan[i].group);
     sfree(plan[i].send_block);
     sfree(plan[i].send_size);
     sfree(plan[i].recv_block);
     sfree(plan[i].recv_size);
-
-    if(NULL != plan[i].plan)
-      fftw_destroy_plan(plan[i].plan);
-    if(NULL != back[i].plan)
-      fftw_destroy_plan(back[i].plan);
+    sdelete(plan[i].group_rank);
+    sdelete(plan[i].send_counts);
+    sdelete(plan[i].send_displs);
+    sdelete(plan[i].recv_counts);
+    sdelete(plan[i].recv_displs);
+    if (MPI_COMM_NULL != plan[i].group_comm)
+      MPI_Comm_free(&plan[i].group_comm);
   }
   sfree(send_buf);
   sfree(recv_buf);
@@ -168,11 +276,13 @@ void Parallel3DFFT::free_data(p3m_float* data) {
 
 void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 		p3m_int* global_grid_dim, p3m_float *global_grid_off,
-		p3m_int *ks_pnum) {
+		p3m_int *ks_pnum, bool interlace, p3m_int rigor) {
 	/* helpers */
 
 	P3M_DEBUG(printf("    prepare() started...\n"));
 
+	this->interlace = interlace;
+
 	max_comm_size = 0;
 	max_grid_size = 0;
 
@@ -261,11 +371,22 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 	plan[2].row_dir = (plan[1].row_dir - 1) % 3;
 	plan[3].row_dir = (plan[1].row_dir - 2) % 3;
 
+	/* Without interlacing, the first direction is a real-to-complex
+	   transform that keeps only the non-negative frequencies, so the
+	   following directions work on the reduced grid. */
+	p3m_int ks_grid_dim[3];
+	for (int i = 0; i < 3; i++)
+		ks_grid_dim[i] = global_grid_dim[i];
+	if (!interlace)
+		ks_grid_dim[plan[1].row_dir] = global_grid_dim[plan[1].row_dir] / 2 + 1;
+
 	/* === communication groups === */
 	/* copy local grid off real space charge assignment grid */
 	for (int i = 0; i < 3; i++)
 		plan[0].new_grid[i] = local_grid_dim[i];
 	for (int i = 1; i < 4; i++) {
+		p3m_int *grid_dim = (i == 1) ? global_grid_dim : ks_grid_dim;
+
 		plan[i].g_size = find_comm_groups(comm, n_grid[i - 1], n_grid[i],
 				n_id[i - 1], n_id[i], plan[i].group, n_pos[i], my_pos[i]);
 		if (plan[i].g_size == -1) {
@@ -287,7 +408,7 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 				1 * plan[i].g_size * sizeof(p3m_int)));
 
 		plan[i].new_size = calc_local_grid(my_pos[i], n_grid[i],
-				global_grid_dim, global_grid_off, plan[i].new_grid,
+				grid_dim, global_grid_off, plan[i].new_grid,
 				plan[i].start);
 		permute_ifield(plan[i].new_grid, 3, -(plan[i].n_permute));
 		permute_ifield(plan[i].start, 3, -(plan[i].n_permute));
@@ -298,14 +419,12 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 			/* send block: this_node to comm-group-node i (identity: node) */
 			p3m_int node = plan[i].group[j];
 			plan[i].send_size[j] = calc_send_block(my_pos[i - 1], n_grid[i - 1],
-					&(n_pos[i][3 * node]), n_grid[i], global_grid_dim,
+					&(n_pos[i][3 * node]), n_grid[i], grid_dim,
 					global_grid_off, &(plan[i].send_block[6 * j]));
 			permute_ifield(&(plan[i].send_block[6 * j]), 3,
 					-(plan[i - 1].n_permute));
 			permute_ifield(&(plan[i].send_block[6 * j + 3]), 3,
 					-(plan[i - 1].n_permute));
-			if (plan[i].send_size[j] > max_comm_size)
-				max_comm_size = plan[i].send_size[j];
 			/* First plan send blocks have to be adjusted, since the CA grid
 			 may have an additional margin outside the actual domain of the
 			 node */
@@ -314,28 +433,20 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 					plan[1].send_block[6 * j + k] += local_grid_margin[2 * k];
 			/* recv block: this_node from comm-group-node i (identity: node) */
 			plan[i].recv_size[j] = calc_send_block(my_pos[i], n_grid[i],
-					&(n_pos[i - 1][3 * node]), n_grid[i - 1], global_grid_dim,
+					&(n_pos[i - 1][3 * node]), n_grid[i - 1], grid_dim,
 					global_grid_off, &(plan[i].recv_block[6 * j]));
 			permute_ifield(&(plan[i].recv_block[6 * j]), 3,
 					-(plan[i].n_permute));
 			permute_ifield(&(plan[i].recv_block[6 * j + 3]), 3,
 					-(plan[i].n_permute));
-			if (plan[i].recv_size[j] > max_comm_size)
-				max_comm_size = plan[i].recv_size[j];
 		}
 
 		for (int j = 0; j < 3; j++)
 			plan[i].old_grid[j] = plan[i - 1].new_grid[j];
-		if (i == 1) {
-#ifdef P3M_INTERLACE
-			plan[i].element = 2;
-			for(int j=0; j<plan[i].g_size; j++) {
-				plan[i].send_size[j] *= 2;
-				plan[i].recv_size[j] *= 2;
-			}
-#else
+		if (i == 2 && !interlace)
+			plan[i].old_grid[2] = plan[1].new_grid[2] / 2 + 1;
+		if (i == 1 && !interlace) {
 			plan[i].element = 1;
-#endif
 		} else {
 			plan[i].element = 2;
 			for (int j = 0; j < plan[i].g_size; j++) {
@@ -343,21 +454,64 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 				plan[i].recv_size[j] *= 2;
 			}
 		}
+
+		/* === all-to-all communication within the group === */
+		/* all nodes of a group have the same (minimal) color */
+		int color = comm.size;
+		for (int j = 0; j < plan[i].g_size; j++)
+			color = imin(color, plan[i].group[j]);
+		if (MPI_COMM_NULL != plan[i].group_comm)
+			MPI_Comm_free(&plan[i].group_comm);
+		MPI_Comm_split(comm.mpicomm, color, comm.rank, &plan[i].group_comm);
+
+		MPI_Group cart_group, sub_group;
+		MPI_Comm_group(comm.mpicomm, &cart_group);
+		MPI_Comm_group(plan[i].group_comm, &sub_group);
+		MPI_Group_translate_ranks(cart_group, plan[i].g_size, plan[i].group,
+				sub_group, plan[i].group_rank);
+		MPI_Group_free(&cart_group);
+		MPI_Group_free(&sub_group);
+
+		for (int j = 0; j < plan[i].g_size; j++) {
+			plan[i].send_counts[plan[i].group_rank[j]] = plan[i].send_size[j];
+			plan[i].recv_counts[plan[i].group_rank[j]] = plan[i].recv_size[j];
+		}
+		p3m_int send_total = 0, recv_total = 0;
+		for (int j = 0; j < plan[i].g_size; j++) {
+			plan[i].send_displs[j] = send_total;
+			plan[i].recv_displs[j] = recv_total;
+			send_total += plan[i].send_counts[j];
+			recv_total += plan[i].recv_counts[j];
+		}
+		max_comm_size = imax(max_comm_size, imax(send_total, recv_total));
 		/* DEBUG */
 		P3M_DEBUG(plan[i].print());
 	}
 
-	/* Factor 2 for complex fields */
-	max_comm_size *= 2;
-#ifdef P3M_INTERLACE
-	/* When using interlacing we need a complex charge grid which has double size */
-	max_grid_size = 2*(local_grid_dim[0]*local_grid_dim[1]*local_grid_dim[2]);
-#else
-	max_grid_size = (local_grid_dim[0] * local_grid_dim[1] * local_grid_dim[2]);
-#endif
+	if (interlace)
+		/* When using interlacing we need a complex charge grid which has double size */
+		max_grid_size = 2*(local_grid_dim[0]*local_grid_dim[1]*local_grid_dim[2]);
+	else
+		max_grid_size = (local_grid_dim[0] * local_grid_dim[1] * local_grid_dim[2]);
 	for (int i = 1; i < 4; i++)
 		if (2 * plan[i].new_size > max_grid_size)
 			max_grid_size = 2 * plan[i].new_size;
+	if (!interlace
+	        && 2 * plan[1].n_ffts * (plan[1].new_grid[2] / 2 + 1) > max_grid_size)
+		max_grid_size = 2 * plan[1].n_ffts * (plan[1].new_grid[2] / 2 + 1);
+
+	/* position of the reduced direction in the k-space grid */
+	ks_half_dim = -1;
+	ks_half_grid = 0;
+	if (!interlace) {
+		p3m_int half[3] = { 0, 0, 0 };
+		half[plan[1].row_dir] = 1;
+		permute_ifield(half, 3, -(plan[3].n_permute));
+		for (int i = 0; i < 3; i++)
+			if (half[i])
+				ks_half_dim = i;
+		ks_half_grid = global_grid_dim[plan[1].row_dir];
+	}
 
 	P3M_DEBUG(
 			printf("      max_comm_size = %d, max_grid_size = %d\n",
@@ -379,7 +533,6 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 		(*ks_pnum) = 5;
 	}
 
-	/* Factor 2 for complex numbers */
 	send_buf = (p3m_float *) realloc(send_buf,
 			max_comm_size * sizeof(p3m_float));
 	recv_buf = (p3m_float *) realloc(recv_buf,
@@ -390,31 +543,30 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 
 	p3m_float* data_buf = _malloc_data();
 	fftw_complex *c_data_buf = reinterpret_cast<fftw_complex*>(data_buf);
+	/* the real-to-complex transforms are performed out-of-place */
+	p3m_float* real_buf = _malloc_data();
 
 	/* FFTW WISDOM stuff. */
-	/* @todo: Planning shouldn't write to file. */
+	import_wisdom(comm);
+
 	/* === FFT Routines (Using FFTW / RFFTW package)=== */
+	bool created = false;
 	for (int i = 1; i < 4; i++) {
-          plan[i].dir = FFTW_FORWARD;
-          if (is_prepared)
-            fftw_destroy_plan(plan[i].plan);
-          //printf("plan[%d].n_ffts=%d\n",i,plan[i].n_ffts);
-          plan[i].plan =
-            fftw_plan_many_dft(1, &plan[i].new_grid[2], plan[i].n_ffts, c_data_buf,
-                               NULL, 1, plan[i].new_grid[2], c_data_buf, NULL, 1,
-                               plan[i].new_grid[2], plan[i].dir, FFTW_PATIENT);
+		plan[i].dir = FFTW_FORWARD;
+		plan[i].plan = plan_cache.get(
+				i == 1 && !interlace ? PlanCache::R2C : PlanCache::FORWARD,
+				plan[i].new_grid[2], plan[i].n_ffts, rigor,
+				real_buf, c_data_buf, created);
 	}
 
 	/* === The BACK Direction === */
 	/* this is needed because slightly different functions are used */
 	for (int i = 1; i < 4; i++) {
 		back[i].dir = FFTW_BACKWARD;
-		if (is_prepared)
-			fftw_destroy_plan(back[i].plan);
-		back[i].plan =
-		fftw_plan_many_dft(1, &plan[i].new_grid[2], plan[i].n_ffts, c_data_buf,
-				NULL, 1, plan[i].new_grid[2], c_data_buf, NULL, 1,
-				plan[i].new_grid[2], back[i].dir, FFTW_PATIENT);
+		back[i].plan = plan_cache.get(
+				i == 1 && !interlace ? PlanCache::C2R : PlanCache::BACKWARD,
+				plan[i].new_grid[2], plan[i].n_ffts, rigor,
+				real_buf, c_data_buf, created);
 		back[i].pack_function = pack_block_permute1;
 		P3M_DEBUG(printf("      back plan[%d] permute 1 \n", i));
 	}
@@ -426,17 +578,23 @@ void Parallel3DFFT::prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
 		P3M_DEBUG(printf("      back plan[%d] permute 2 \n", 1));
 	}
 	free_data(data_buf);
+	free_data(real_buf);
 	for (int i = 0; i < 4; i++) {
 		delete[] n_id[i];
 		delete[] n_pos[i];
 	}
 
+	/* store the wisdom of newly measured plans */
+	int new_wisdom = created && rigor != P3M_FFTW_ESTIMATE;
+	MPI_Allreduce(MPI_IN_PLACE, &new_wisdom, 1, MPI_INT, MPI_LOR, comm.mpicomm);
+	if (new_wisdom)
+		export_wisdom(comm);
+
     is_prepared = true;
 	P3M_DEBUG(printf("    prepare() finished.\n"));
 } /* end of PREPARE */
 
 void Parallel3DFFT::forward(p3m_float *data, p3m_float* buffer) {
-	p3m_int i;
 
 	/* int m,n,o; */
 	/* ===== first direction  ===== */
@@ -462,18 +620,15 @@ void Parallel3DFFT::forward(p3m_float *data, p3m_float* buffer) {
 	 }
 	 */
 
-	/* complexify the real data array (in is buffer) */
-#ifndef P3M_INTERLACE
-	for (i = 0; i < plan[1].new_size; i++) {
-		data[2 * i] = buffer[i]; /* real value */
-		data[(2 * i) + 1] = 0; /* complex value */
+	if (!interlace) {
+		/* perform real-to-complex FFT (in is buffer, out is data) */
+		fftw_execute_dft_r2c(plan[1].plan, buffer, c_data);
+	} else {
+		for (p3m_int i = 0; i < (2*plan[1].new_size); i++)
+			data[i] = buffer[i];
+		/* perform FFT (in/out is data)*/
+		fftw_execute_dft(plan[1].plan, c_data, c_data);
 	}
-#else
-	for(i=0;i<(2*plan[1].new_size);i++)
-	data[i] = buffer[i]; /* real value */
-#endif
-	/* perform FFT (in/out is data)*/
-	fftw_execute_dft(plan[1].plan, c_data, c_data);
 
 	/* ===== second direction ===== */
 	P3M_DEBUG_LOCAL(printf("    %d: fft_perform_forward: dir 2\n", comm.rank));
@@ -493,7 +648,6 @@ void Parallel3DFFT::forward(p3m_float *data, p3m_float* buffer) {
 }
 
 void Parallel3DFFT::backward(p3m_float *data, p3m_float* buffer) {
-	p3m_int i;
 
 	fftw_complex *c_data = (fftw_complex *) data;
 	fftw_complex *c_buffer = (fftw_complex *) buffer;
@@ -515,26 +669,16 @@ void Parallel3DFFT::backward(p3m_float *data, p3m_float* buffer) {
 
 	/* ===== first direction  ===== */
 	P3M_DEBUG_LOCAL(printf("    %d: backward: dir 1\n", comm.rank));
-	/* perform FFT (in is data) */
-	fftw_execute_dft(back[1].plan, c_data, c_data);
-#ifndef P3M_INTERLACE
-	/* throw away the (hopefully) empty complex component (in is data)*/
-	for (i = 0; i < plan[1].new_size; i++)
-		buffer[i] = data[2 * i]; /* real value */
-#ifdef ADDITIONAL_CHECKS
-	for (i = 0; i < plan[1].new_size; i++)
-		if (data[2 * i + 1] > 1e-5) {
-			printf("    %d: Imaginary value is not zero (i=%d,data=%g)!!!\n",
-					comm.rank, i, data[2 * i + 1]);
-			if (i > 100)
-				exit(-1);
-		}
-#endif
-#else
-	/* keep imaginary part */
-	for (i=0; i<(2*plan[1].new_size); i++)
-	buffer[i] = data[i];
-#endif
+	if (!interlace) {
+		/* perform complex-to-real FFT (in is data, out is buffer) */
+		fftw_execute_dft_c2r(back[1].plan, c_data, buffer);
+	} else {
+		/* perform FFT (in is data) */
+		fftw_execute_dft(back[1].plan, c_data, c_data);
+		/* keep imaginary part */
+		for (p3m_int i = 0; i < (2*plan[1].new_size); i++)
+			buffer[i] = data[i];
+	}
 	/* communicate (in is buffer) */
 	backward_grid_comm(plan[1], back[1], buffer, data);
 
@@ -542,12 +686,34 @@ void Parallel3DFFT::backward(p3m_float *data, p3m_float* buffer) {
 }
 
 /** communicate the grid data according to the given forward_plan.
+ *
+ *  All blocks for the nodes of the communication group are packed
+ *  into send_buf and exchanged with one all-to-all operation in the
+ *  communicator of the group.
+ *
  * \param plan communication plan (see \ref forward_plan).
  * \param in   input grid.
  * \param out  output grid.
  */
 void Parallel3DFFT::forward_grid_comm(forward_plan plan,
         p3m_float *in, p3m_float *out) {
+#if MPI_VERSION >= 3
+	for (int i = 0; i < plan.g_size; i++)
+		plan.pack_function(in, send_buf + plan.send_displs[plan.group_rank[i]],
+				&(plan.send_block[6 * i]), &(plan.send_block[6 * i + 3]),
+				plan.old_grid, plan.element);
+
+	MPI_Request request;
+	MPI_Ialltoallv(send_buf, plan.send_counts, plan.send_displs, P3M_MPI_FLOAT,
+			recv_buf, plan.recv_counts, plan.recv_displs, P3M_MPI_FLOAT,
+			plan.group_comm, &request);
+	comm.waitall(1, &request);
+
+	for (int i = 0; i < plan.g_size; i++)
+		unpack_block(recv_buf + plan.recv_displs[plan.group_rank[i]], out,
+				&(plan.recv_block[6 * i]), &(plan.recv_block[6 * i + 3]),
+				plan.new_grid, plan.element);
+#else
 	for (int i = 0; i < plan.g_size; i++) {
 		plan.pack_function(in, send_buf, &(plan.send_block[6 * i]),
 				&(plan.send_block[6 * i + 3]), plan.old_grid, plan.element);
@@ -556,14 +722,18 @@ void Parallel3DFFT::forward_grid_comm(forward_plan plan,
 		    /* Self communication... */
 		    std::swap(send_buf, recv_buf);
 		else {
-		    MPI_Sendrecv(send_buf, plan.send_size[i], P3M_MPI_FLOAT, plan.group[i],
-		            REQ_FFT_FORW, recv_buf, plan.recv_size[i], P3M_MPI_FLOAT, plan.group[i],
-		            REQ_FFT_FORW, comm.mpicomm, MPI_STATUS_IGNORE);
+		    MPI_Request requests[2];
+		    MPI_Irecv(recv_buf, plan.recv_size[i], P3M_MPI_FLOAT, plan.group[i],
+		            REQ_FFT_FORW, comm.mpicomm, &requests[0]);
+		    MPI_Isend(send_buf, plan.send_size[i], P3M_MPI_FLOAT, plan.group[i],
+		            REQ_FFT_FORW, comm.mpicomm, &requests[1]);
+		    comm.waitall(2, requests);
 		}
 
 		unpack_block(recv_buf, out, &(plan.recv_block[6 * i]),
 		        &(plan.recv_block[6 * i + 3]), plan.new_grid, plan.element);
 	}
+#endif
 }
 
 /** communicate the grid data according to the given forward_plan/fft_bakc_plan.
@@ -579,6 +749,23 @@ void Parallel3DFFT::backward_grid_comm(forward_plan plan_f,
 	 replace the recieve blocks by the send blocks and vice
 	 versa. Attention then also new_grid and old_grid are exchanged */
 
+#if MPI_VERSION >= 3
+	for (int i = 0; i < plan_f.g_size; i++)
+		plan_b.pack_function(in, send_buf + plan_f.recv_displs[plan_f.group_rank[i]],
+				&(plan_f.recv_block[6 * i]), &(plan_f.recv_block[6 * i + 3]),
+				plan_f.new_grid, plan_f.element);
+
+	MPI_Request request;
+	MPI_Ialltoallv(send_buf, plan_f.recv_counts, plan_f.recv_displs, P3M_MPI_FLOAT,
+			recv_buf, plan_f.send_counts, plan_f.send_displs, P3M_MPI_FLOAT,
+			plan_f.group_comm, &request);
+	comm.waitall(1, &request);
+
+	for (int i = 0; i < plan_f.g_size; i++)
+		unpack_block(recv_buf + plan_f.send_displs[plan_f.group_rank[i]], out,
+				&(plan_f.send_block[6 * i]), &(plan_f.send_block[6 * i + 3]),
+				plan_f.old_grid, plan_f.element);
+#else
 	for (int i = 0; i < plan_f.g_size; i++) {
 		plan_b.pack_function(in, send_buf, &(plan_f.recv_block[6 * i]),
 				&(plan_f.recv_block[6 * i + 3]), plan_f.new_grid,
@@ -588,14 +775,18 @@ void Parallel3DFFT::backward_grid_comm(forward_plan plan_f,
             /* Self communication... */
             std::swap(send_buf, recv_buf);
         else {
-            MPI_Sendrecv(send_buf, plan_f.recv_size[i], P3M_MPI_FLOAT, plan_f.group[i],
-                    REQ_FFT_BACK, recv_buf, plan_f.send_size[i], P3M_MPI_FLOAT, plan_f.group[i],
-                    REQ_FFT_BACK, comm.mpicomm, MPI_STATUS_IGNORE);
+            MPI_Request requests[2];
+            MPI_Irecv(recv_buf, plan_f.send_size[i], P3M_MPI_FLOAT, plan_f.group[i],
+                    REQ_FFT_BACK, comm.mpicomm, &requests[0]);
+            MPI_Isend(send_buf, plan_f.recv_size[i], P3M_MPI_FLOAT, plan_f.group[i],
+                    REQ_FFT_BACK, comm.mpicomm, &requests[1]);
+            comm.waitall(2, requests);
         }
 
         unpack_block(recv_buf, out, &(plan_f.send_block[6 * i]),
                 &(plan_f.send_block[6 * i + 3]), plan_f.old_grid, plan_f.element);
 	}
+#endif
 }
 
 /** This ugly function does the bookkepping which nodes have to
@@ -953,6 +1144,76 @@ static void pack_block_permute2(p3m_float *in, p3m_float *out, p3m_int start[3],
 
 }
 
+/** Import the FFTW wisdom of the system and the wisdom file once.
+ *  Only the master node reads the file and broadcasts the wisdom to
+ *  all other nodes.
+ */
+static void import_wisdom(Communication &comm) {
+	/* all nodes have to take part if one of them has not imported it */
+	int missing = !wisdom_imported;
+	MPI_Allreduce(MPI_IN_PLACE, &missing, 1, MPI_INT, MPI_LOR, comm.mpicomm);
+	if (!missing)
+		return;
+
+	char *wisdom = NULL;
+	int length = 0;
+	if (comm.onMaster()) {
+		fftw_import_system_wisdom();
+		fftw_import_wisdom_from_filename(P3M_FFTW_WISDOM_FILENAME);
+		wisdom = fftw_export_wisdom_to_string();
+		if (wisdom != NULL)
+			length = strlen(wisdom) + 1;
+	}
+	MPI_Bcast(&length, 1, MPI_INT, 0, comm.mpicomm);
+	if (length > 0) {
+		if (!comm.onMaster())
+			wisdom = static_cast<char*>(malloc(length));
+		MPI_Bcast(wisdom, length, MPI_CHAR, 0, comm.mpicomm);
+		if (!comm.onMaster())
+			fftw_import_wisdom_from_string(wisdom);
+	}
+	sfree(wisdom);
+
+	wisdom_imported = true;
+}
+
+/** Collect the FFTW wisdom of all nodes on the master node, which
+ *  stores it in the wisdom file.
+ */
+static void export_wisdom(Communication &comm) {
+	char *wisdom = fftw_export_wisdom_to_string();
+	int length = (wisdom != NULL) ? strlen(wisdom) + 1 : 0;
+
+	int *lengths = NULL, *displs = NULL;
+	char *all_wisdom = NULL;
+	if (comm.onMaster()) {
+		lengths = new int[comm.size];
+		displs = new int[comm.size];
+	}
+	MPI_Gather(&length, 1, MPI_INT, lengths, 1, MPI_INT, 0, comm.mpicomm);
+	if (comm.onMaster()) {
+		int total = 0;
+		for (int i = 0; i < comm.size; i++) {
+			displs[i] = total;
+			total += lengths[i];
+		}
+		all_wisdom = new char[total];
+	}
+	MPI_Gatherv(wisdom, length, MPI_CHAR, all_wisdom, lengths, displs,
+			MPI_CHAR, 0, comm.mpicomm);
+
+	if (comm.onMaster()) {
+		for (int i = 1; i < comm.size; i++)
+			if (lengths[i] > 0)
+				fftw_import_wisdom_from_string(&all_wisdom[displs[i]]);
+		fftw_export_wisdom_to_filename(P3M_FFTW_WISDOM_FILENAME);
+		delete[] lengths;
+		delete[] displs;
+		delete[] all_wisdom;
+	}
+	sfree(wisdom);
+}
+
 //fixme: unpack_block and add_block are the same! Unify.
 void Parallel3DFFT::unpack_block(p3m_float *in, p3m_float *out,
 		p3m_int start[3], p3m_int size[3], p3m_int dim[3], p3m_int element) {
@@ -1011,6 +1272,12 @@ void Parallel3DFFT::getKSExtent(const p3m_int*& offset,
     size = plan[3].new_grid;
 }
 
+bool Parallel3DFFT::getKSHalfDim(p3m_int &dim, p3m_int &grid) const {
+    dim = ks_half_dim;
+    grid = ks_half_grid;
+    return ks_half_dim >= 0;
+}
+
 /** Debug function to print global fft grid.
  Print a globaly distributed grid contained in data. Element size is element.
  * \param plan     fft/communication plan (see \ref forward_plan).
@@ -29,9 +29,11 @@
  *  1D-FFT. After performing the FFT on theat direction the data is
  *  redistributed.
  *
- *  For simplicity at the moment I have implemented a full complex to
- *  complex FFT (even though a real to complex FFT would be
- *  sufficient)
+ *  A real charge grid is transformed with a real-to-complex FFT in
+ *  the first direction, so that only the non-negative frequencies of
+ *  that direction are stored in k-space (the others follow from the
+ *  Hermitian symmetry). An interlaced (complex) charge grid uses full
+ *  complex-to-complex FFTs.
  *
  */
 #ifndef _P3M_FFT_HPP
@@ -102,6 +104,18 @@ public:
 		/** size of send block elements. */
 		p3m_int element;
 
+		/** communicator of the group (the nodes of one communication
+		 *  group cell of the node grids). */
+		MPI_Comm group_comm;
+		/** rank of each node of the group in group_comm. */
+		int *group_rank;
+		/** all-to-all counts and displacements of the forward
+		 *  communication (indexed by the rank in group_comm). The
+		 *  backward communication uses them with send and recv
+		 *  exchanged. */
+		int *send_counts, *send_displs;
+		int *recv_counts, *recv_displs;
+
 		void print();
 	};
 
@@ -126,6 +140,13 @@ private:
 
   /** Whether FFT is initialized or not. */
   bool is_prepared;
+  /** Whether the real space grid is complex (interlacing). */
+  bool interlace;
+  /** Direction of the k-space grid that holds only the non-negative
+   *  frequencies (-1 if the complete grid is stored). */
+  p3m_int ks_half_dim;
+  /** Full size of the global grid in that direction. */
+  p3m_int ks_half_grid;
   
   /** Information about the three one dimensional FFTs and how the nodes
    *  have to communicate in between.
@@ -163,11 +184,15 @@ public:
    * \param global_grid_dim   Pointer to global CA grid dimensions.
    * \param global_grid_off   Pointer to global CA grid margins.
    * \param ks_pnum           Pointer to number of permutations in k-space.
+   * \param interlace         Whether the input is a complex grid that holds
+   *                          the shifted charges in its imaginary part.
+   * \param rigor             Minimal rigor of the FFTW plans (P3M_FFTW_*).
+   *                          Plans of the same size are reused.
    */
   void
   prepare(p3m_int *local_grid_dim, p3m_int *local_grid_margin,
           p3m_int* global_grid_dim, p3m_float *global_grid_off,
-          p3m_int *ks_pnum);
+          p3m_int *ks_pnum, bool interlace, p3m_int rigor);
 
     /** Perform the forward 3D FFT. buffer has to be of the same size as data
      * and will be used internally. */
@@ -181,6 +206,10 @@ public:
 
 	int getKSSize() const;
 	void getKSExtent(const p3m_int*& offset, const p3m_int*& size) const;
+	/** Whether the k-space grid holds only the non-negative frequencies
+	 *  in one direction (real-to-complex FFT). dim is that direction
+	 *  (in the order of getKSExtent()) and grid its full size. */
+	bool getKSHalfDim(p3m_int &dim, p3m_int &grid) const;
 
 	/** pack a block (size[3] starting at start[3]) of an input 3d-grid
 	 *  with dimension dim[3] into an output 3d-block with dimension size[3].
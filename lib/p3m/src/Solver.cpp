@@ -31,7 +31,8 @@ namespace P3M {
 Solver::Solver(MPI_Comm mpicomm) : comm(mpicomm), errorEstimate(NULL) {
     P3M_DEBUG(printf( "P3M::Solver() started...\n"));
 
-    errorEstimate = ErrorEstimate::create(comm);
+    variant = P3M_VARIANT_IK;
+    errorEstimate = ErrorEstimate::create(comm, variant);
     farSolver = NULL;
 
     /* SYSTEM PARAMETERS */
@@ -49,6 +50,24 @@ Solver::Solver(MPI_Comm mpicomm) : comm(mpicomm), errorEstimate(NULL) {
     
     shiftGaussians=false;
 
+    interpolation_order = -1;
+    fcs_erfc_table_init(&erfc_table);
+    overlap_near = false;
+    fftw_rigor = P3M_DEFAULT_FFTW_RIGOR;
+
+    max_particle_move = -1.0;
+    resort = false;
+    gridsort_resort = FCS_GRIDSORT_RESORT_NULL;
+    num_local_particles = 0;
+    gridsort_cache = FCS_GRIDSORT_CACHE_NULL;
+
+    buffer_size = 0;
+    fields_buffer = NULL;
+    potentials_buffer = NULL;
+    near_fields_buffer = NULL;
+    near_potentials_buffer = NULL;
+    positions_triclinic_buffer = NULL;
+
     /* P3M PARAMETERS */
     skin = 0.0;
     tolerance_field = P3M_DEFAULT_TOLERANCE_FIELD;
@@ -67,6 +86,8 @@ Solver::Solver(MPI_Comm mpicomm) : comm(mpicomm), errorEstimate(NULL) {
     tune_alpha = true;
     tune_grid = true;
     tune_cao = true;
+    tune_variant = false;
+    variant_set = false;
 
     /* Which components to compute? */
     require_total_energy = false;
@@ -86,17 +107,21 @@ Solver::Solver(MPI_Comm mpicomm) : comm(mpicomm), errorEstimate(NULL) {
 Solver::~Solver() {
     if (errorEstimate != NULL) delete errorEstimate;
     if (farSolver != NULL) delete farSolver;
+    fcs_erfc_table_destroy(&erfc_table);
+    fcs_gridsort_resort_destroy(&gridsort_resort);
+    fcs_gridsort_release_cache(&gridsort_cache);
+    freeBuffers();
 }
 
-void Solver::prepare() {
+void Solver::prepare(p3m_int rigor) {
     if (farSolver != NULL) delete farSolver;
     if(!this->isTriclinic){
         comm.prepare(box_l);
-        farSolver = new FarSolver(comm, box_l, r_cut, alpha, grid, cao, box_vectors, volume, isTriclinic);
+        farSolver = new FarSolver(comm, box_l, r_cut, alpha, grid, cao, box_vectors, volume, isTriclinic, variant, rigor);
     } else {
         p3m_float box_length[3]={1.0,1.0,1.0};
         comm.prepare(box_length);
-        farSolver = new FarSolver(comm, box_length, r_cut, alpha, grid, cao, box_vectors, volume, isTriclinic);
+        farSolver = new FarSolver(comm, box_length, r_cut, alpha, grid, cao, box_vectors, volume, isTriclinic, variant, rigor);
     }        
 }
 
@@ -146,9 +171,31 @@ compute_near(const void *param, p3m_float dist, p3m_float *field, p3m_float *pot
 /* callback function for performing a whole loop of near field computations (using compute_near) */
 FCS_NEAR_LOOP_FP(compute_near_loop, compute_near);
 
+/* callback function for near field computations of a batch of distances (using compute_near) */
+FCS_NEAR_BATCH_FP(compute_near_batch, compute_near);
+
+/* callback function for near field computations with interpolation tables */
+inline void
+compute_near_table(const void *param, p3m_float dist, p3m_float *field, p3m_float *potential)
+{
+    const near_params_t *params = static_cast<const near_params_t*>(param);
+
+    fcs_erfc_table_field_potential(params->table, dist, field, potential);
+
+    *potential -= params->potentialOffset;
+}
+
+/* callback function for near field computations of a batch of distances (using compute_near_table) */
+FCS_NEAR_BATCH_FP(compute_near_table_batch, compute_near_table);
+
+/* overlap function that computes the next near field boxes while the far field waits for messages */
+static bool compute_near_step(void *near) {
+    return fcs_near_compute_step(static_cast<fcs_near_t*>(near), P3M_OVERLAP_NEAR_STEP) > 0;
+}
+
 /* domain decomposition */
 void Solver::decompose(fcs_gridsort_t *gridsort,
-        p3m_int _num_particles,
+        p3m_int _num_particles, p3m_int _max_num_particles,
         p3m_float *_positions, p3m_float *_charges,
         p3m_int *num_real_particles,
         p3m_float **positions, p3m_float **charges,
@@ -163,8 +210,10 @@ void Solver::decompose(fcs_gridsort_t *gridsort,
     fcs_gridsort_create(gridsort);
 
     fcs_gridsort_set_system(gridsort, box_base, box_vectors[0], box_vectors[1], box_vectors[2], NULL);
-    fcs_gridsort_set_particles(gridsort, _num_particles, _num_particles,
+    fcs_gridsort_set_particles(gridsort, _num_particles, _max_num_particles,
             _positions, _charges);
+    fcs_gridsort_set_max_particle_move(gridsort, max_particle_move);
+    fcs_gridsort_set_cache(gridsort, &gridsort_cache);
 
     P3M_DEBUG(printf( "  calling fcs_gridsort_sort_forward()...\n"));
     /* @todo: Set skin to r_cut only, when near field is wanted! */
@@ -220,7 +269,8 @@ void Solver::decompose(fcs_gridsort_t *gridsort,
     }
  
 void Solver::run(
-        p3m_int _num_particles, p3m_float *_positions, p3m_float *_charges,
+        p3m_int _num_particles, p3m_int _max_num_particles,
+        p3m_float *_positions, p3m_float *_charges,
         p3m_float *_fields, p3m_float *_potentials) {
     P3M_INFO(printf( "P3M::Solver::run() started...\n"));
     if (farSolver == NULL)
@@ -250,71 +300,127 @@ void Solver::run(
     fcs_gridsort_index_t *indices, *ghost_indices;
     fcs_gridsort_t gridsort;
     this->decompose(&gridsort,
-            _num_particles, _positions, _charges,
+            _num_particles, _max_num_particles, _positions, _charges,
             &num_real_particles,
             &positions, &charges, &indices,
             &num_ghost_particles,
             &ghost_positions, &ghost_charges, &ghost_indices);
 
-    /* allocate local fields and potentials */
+    /* get local fields and potentials */
+    this->reserveBuffers(num_real_particles);
     p3m_float *fields = NULL;
     p3m_float *potentials = NULL;
     if (_fields != NULL)
-        fields = new p3m_float[3*num_real_particles];
+        fields = this->getBuffer(fields_buffer, 3);
     if (_potentials != NULL || require_total_energy)
-        potentials = new p3m_float[num_real_particles];
+        potentials = this->getBuffer(potentials_buffer, 1);
 
     stopTimer(DECOMP);
 
-    if (require_timings != NOTFAR) {
-#if defined(P3M_INTERLACE) && defined(P3M_AD)
-        if(!isTriclinic){ //orthorhombic
-            farSolver->runADI(num_real_particles, positions, charges, fields, potentials);
-        } else {//triclinic
-            p3m_float *positions_triclinic= new p3m_float[num_real_particles*3];
-            this->calculateTriclinicPositions(positions, positions_triclinic,num_real_particles);
-            farSolver->runADI(num_real_particles, positions_triclinic, charges, fields, potentials);
-            delete[] positions_triclinic;
-        }
-#else
-        if(!isTriclinic){ //orthorhombic
-            farSolver->runIK(num_real_particles, positions, charges, fields, potentials);
-        } else {//triclinic
-            p3m_float *positions_triclinic= new p3m_float[num_real_particles*3];
-            this->calculateTriclinicPositions(positions, positions_triclinic,num_real_particles);
-            farSolver->runIK(num_real_particles, positions_triclinic, charges, fields, potentials);
-            delete[] positions_triclinic;
-        }
-#endif
-    }
+    /* the near field is either computed after the far field or step by
+       step while the far field waits for messages */
+    bool overlap = near_field_flag && overlap_near;
+    fcs_near_t near;
+    near_params_t params;
+    p3m_float *near_fields = NULL;
+    p3m_float *near_potentials = NULL;
 
     if (near_field_flag) {
         /* start near timer */
         startTimer(NEAR);
 
-        /* compute near field */
-        fcs_near_t near;
+        params.alpha=alpha; params.potentialOffset=(shiftGaussians?(erfc(alpha*r_cut))/r_cut:0.0);
+
+        /* the interpolation tables are only recomputed if alpha or r_cut have changed */
+        params.table = NULL;
+        if (interpolation_order >= 0
+            && fcs_erfc_table_create(&erfc_table, interpolation_order, 0.1*tolerance_field, alpha, r_cut) > 0)
+            params.table = &erfc_table;
 
         fcs_near_create(&near);
         /*  fcs_near_set_field_potential(&near, compute_near);*/
-        fcs_near_set_loop(&near, compute_near_loop);
+        fcs_near_set_field_potential_batch(&near, (params.table != NULL) ? compute_near_table_batch : compute_near_batch);
 
         p3m_float box_base[3] = {0.0, 0.0, 0.0 };
         fcs_near_set_system(&near, box_base, box_vectors[0], box_vectors[1], box_vectors[2], NULL);
-        
-        fcs_near_set_particles(&near, num_real_particles, num_real_particles,
-                positions, charges, indices,
-                (_fields != NULL) ? fields : NULL,
-                        (_potentials != NULL) ? potentials : NULL);
+
+        if (overlap) {
+            /* the far field overwrites the fields and potentials, thus
+               the near field is accumulated separately */
+            if (_fields != NULL) {
+                near_fields = this->getBuffer(near_fields_buffer, 3);
+                for (p3m_int i = 0; i < 3*num_real_particles; i++)
+                    near_fields[i] = 0.0;
+            }
+            if (_potentials != NULL) {
+                near_potentials = this->getBuffer(near_potentials_buffer, 1);
+                for (p3m_int i = 0; i < num_real_particles; i++)
+                    near_potentials[i] = 0.0;
+            }
+            fcs_near_set_particles(&near, num_real_particles, num_real_particles,
+                    positions, charges, indices, near_fields, near_potentials);
+        } else
+            fcs_near_set_particles(&near, num_real_particles, num_real_particles,
+                    positions, charges, indices,
+                    (_fields != NULL) ? fields : NULL,
+                            (_potentials != NULL) ? potentials : NULL);
 
         fcs_near_set_ghosts(&near, num_ghost_particles,
                 ghost_positions, ghost_charges, ghost_indices);
-        
-        near_params_t params;
-        params.alpha=alpha; params.potentialOffset=(shiftGaussians?(erfc(alpha*r_cut))/r_cut:0.0);
-        P3M_DEBUG(printf( "  calling fcs_near_compute()...\n"));
-        fcs_near_compute(&near, r_cut, &params, comm.mpicomm);
-        P3M_DEBUG(printf( "  returning from fcs_near_compute().\n"));
+
+        if (overlap) {
+            /* sorts the particles into boxes, thus before the far field */
+            P3M_DEBUG(printf( "  calling fcs_near_compute_begin()...\n"));
+            fcs_near_compute_begin(&near, r_cut, &params, comm.mpicomm);
+            P3M_DEBUG(printf( "  returning from fcs_near_compute_begin().\n"));
+            comm.setOverlap(compute_near_step, &near);
+        }
+
+        stopTimer(NEAR);
+    }
+
+    if (require_timings != NOTFAR) {
+        if (variant == P3M_VARIANT_ADI) {
+            if(!isTriclinic){ //orthorhombic
+                farSolver->runADI(num_real_particles, positions, charges, fields, potentials);
+            } else {//triclinic
+                p3m_float *positions_triclinic = this->getBuffer(positions_triclinic_buffer, 3);
+                this->calculateTriclinicPositions(positions, positions_triclinic,num_real_particles);
+                farSolver->runADI(num_real_particles, positions_triclinic, charges, fields, potentials);
+            }
+        } else {
+            if(!isTriclinic){ //orthorhombic
+                farSolver->runIK(num_real_particles, positions, charges, fields, potentials);
+            } else {//triclinic
+                p3m_float *positions_triclinic = this->getBuffer(positions_triclinic_buffer, 3);
+                this->calculateTriclinicPositions(positions, positions_triclinic,num_real_particles);
+                farSolver->runIK(num_real_particles, positions_triclinic, charges, fields, potentials);
+            }
+        }
+    }
+
+    if (near_field_flag) {
+        startTimer(NEAR);
+
+        /* compute (the rest of) the near field */
+        if (overlap) {
+            comm.setOverlap(NULL, NULL);
+
+            P3M_DEBUG(printf( "  calling fcs_near_compute_end()...\n"));
+            fcs_near_compute_end(&near);
+            P3M_DEBUG(printf( "  returning from fcs_near_compute_end().\n"));
+
+            if (near_fields != NULL)
+                for (p3m_int i = 0; i < 3*num_real_particles; i++)
+                    fields[i] += near_fields[i];
+            if (near_potentials != NULL)
+                for (p3m_int i = 0; i < num_real_particles; i++)
+                    potentials[i] += near_potentials[i];
+        } else {
+            P3M_DEBUG(printf( "  calling fcs_near_compute()...\n"));
+            fcs_near_compute(&near, r_cut, &params, comm.mpicomm);
+            P3M_DEBUG(printf( "  returning from fcs_near_compute().\n"));
+        }
 
         fcs_near_destroy(&near);
 
@@ -322,12 +428,25 @@ void Solver::run(
     }
 
     startTimer(COMP);
-    /* sort particles back */
     fcs_gridsort_set_sorted_results(&gridsort, num_real_particles, fields, potentials);
-    fcs_gridsort_set_results(&gridsort, _num_particles, _fields, _potentials);
-    P3M_DEBUG(printf( "  calling fcs_gridsort_sort_backward()...\n"));
-    fcs_gridsort_sort_backward(&gridsort, comm.mpicomm);
-    P3M_DEBUG(printf( "  returning from fcs_gridsort_sort_backward().\n"));
+    fcs_gridsort_set_results(&gridsort, _max_num_particles, _fields, _potentials);
+
+    /* keep the particles in the order of the decomposition if possible,
+       otherwise sort them back */
+    bool resorted = resort
+        && fcs_gridsort_prepare_resort(&gridsort, comm.mpicomm);
+
+    if (!resorted) {
+        P3M_DEBUG(printf( "  calling fcs_gridsort_sort_backward()...\n"));
+        fcs_gridsort_sort_backward(&gridsort, comm.mpicomm);
+        P3M_DEBUG(printf( "  returning from fcs_gridsort_sort_backward().\n"));
+    }
+
+    fcs_gridsort_resort_destroy(&gridsort_resort);
+    if (resorted)
+        fcs_gridsort_resort_create(&gridsort_resort, &gridsort, comm.mpicomm);
+
+    num_local_particles = _num_particles;
 
     fcs_gridsort_free(&gridsort);
     fcs_gridsort_destroy(&gridsort);
@@ -381,9 +500,6 @@ void Solver::run(
 //            printf(" (empirical estimate)");
     }
 #endif
-    
-    sdelete(fields);
-    sdelete(potentials);
 
     P3M_INFO(printf( "P3M::Solver::run() finished.\n"));
 }
@@ -436,6 +552,8 @@ const p3m_int good_gridsize[] = {
 const p3m_int step_good_gridsize[] =
 { 0, 15, 26, 44, 58, 72, 78, 83, 90, 94, 98, 101, 103, 104 } ;
 const p3m_int num_steps_good_gridsize = 14;
+const p3m_int num_good_gridsize =
+        sizeof(good_gridsize)/sizeof(good_gridsize[0]);
 
 
 void
@@ -481,6 +599,7 @@ Solver::tune(p3m_int num_particles, p3m_float *positions, p3m_float *charges) {
             p.grid[0] = grid[0];
             p.grid[1] = grid[1];
             p.grid[2] = grid[2];
+            p.variant = variant;
             p.r_cut = r_cut;
             TuneParameterList params_to_try =
                     this->tuneBroadcastTuneFar(p);
@@ -495,6 +614,7 @@ Solver::tune(p3m_int num_particles, p3m_float *positions, p3m_float *charges) {
             p.grid[0] = grid[0];
             p.grid[1] = grid[1];
             p.grid[2] = grid[2];
+            p.variant = variant;
 
             /* compute the average distance between two charges  */
             p3m_float avg_dist =
@@ -563,6 +683,10 @@ void
 Solver::tuneFarSlave() {
     if (comm.onMaster())
         throw std::logic_error("tuneFarSlave cannot be called on master.");
+    /* receive the variant to tune */
+    p3m_int v;
+    MPI_Bcast(&v, 1, P3M_MPI_INT, 0, comm.mpicomm);
+    this->selectErrorEstimate(v);
     /* wait for calls to error estimate until finished */
     errorEstimate->loopSlave();
 }
@@ -600,7 +724,6 @@ Solver::tuneFar(Parameters p) {
     } catch (...) {
         P3M_INFO(printf("  Tuning failed.\n"));
         errorEstimate->endLoop();
-        this->tuneBroadcastFail();
         P3M_INFO(printf("P3M::Solver::tuneFar() finished.\n"));
         throw;
     }
@@ -634,11 +757,10 @@ Solver::tuneAlpha(TuneParameterList &params_to_try) {
 void
 Solver::tuneCAO(TuneParameterList &params_to_try) {
     if (tune_cao) {
-#ifdef P3M_AD
-        const p3m_int min_cao = 2;
-#else
-        const p3m_int min_cao = 1;
-#endif
+        /* the analytical differentiation requires a differentiable
+           charge assignment function */
+        const p3m_int min_cao =
+                (params_to_try.front().variant == P3M_VARIANT_ADI) ? 2 : 1;
         P3M_INFO(printf("    Testing cao={ "));
         for (TuneParameterList::iterator pit = params_to_try.begin();
                 pit != params_to_try.end(); ++pit) {
@@ -665,6 +787,10 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
         // store the minimal grid size seen so far
         p3m_int min_grid1d = good_gridsize[step_good_gridsize[num_steps_good_gridsize-1]];
 
+        // in non-cubic boxes, the grid size is tuned per dimension
+        const bool cubic = float_is_equal(box_l[0], box_l[1])
+                && float_is_equal(box_l[0], box_l[2]);
+
         for (TuneParameterList::iterator pit = params_to_try.begin();
                 pit != params_to_try.end(); ++pit) {
             // Find smallest possible grid for this set of parameters
@@ -683,8 +809,9 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
                 if (step_ix >= num_steps_good_gridsize) break;
                 upper_ix = step_good_gridsize[step_ix];
                 p3m_int grid1d = good_gridsize[upper_ix];
-                p.grid[0] = p.grid[1] = p.grid[2] = grid1d;
-                P3M_DEBUG(printf("      rough grid=" FINT "\n", grid1d));
+                this->setTuneGrid(p, grid1d);
+                P3M_DEBUG(printf("      rough grid=" F3INT "\n",      \
+                        p.grid[0], p.grid[1], p.grid[2]));
                 errorEstimate->computeMaster(p, sum_qpart, sum_q2, box_l, box_vectors, isTriclinic);
             } while (p.error > tolerance_field);
             // store the (working) rough grid param set
@@ -705,8 +832,9 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
             while (lower_ix+1 < upper_ix) {
                 p3m_int test_ix = (lower_ix+upper_ix)/2;
                 p3m_int grid1d = good_gridsize[test_ix];
-                p.grid[0] = p.grid[1] = p.grid[2] = grid1d;
-                P3M_DEBUG(printf("      fine grid=" FINT "\n", grid1d));
+                this->setTuneGrid(p, grid1d);
+                P3M_DEBUG(printf("      fine grid=" F3INT "\n",       \
+                        p.grid[0], p.grid[1], p.grid[2]));
                 errorEstimate->computeMaster(p, sum_qpart, sum_q2, box_l, box_vectors, isTriclinic);
                 if (p.error < tolerance_field) {
                     // parameters achieve error
@@ -719,6 +847,12 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
                 }
             }
 
+            // grid size in the longest dimension, before the single
+            // dimensions are shrunk
+            p3m_int grid1d = good_gridsize[upper_ix];
+            if (!cubic)
+                this->shrinkTuneGrid(*pit);
+
             P3M_INFO(printf( "      => "                          \
                     "r_cut=" FFLOAT ", "                          \
                     "alpha=" FFLOAT ", "                          \
@@ -736,9 +870,9 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
             // compare grid size to previous minimal grid size
             // if it is larger than any previous size + P3M_MAX_GRID_DIFF,
             // skip it
-            if (min_grid1d > pit->grid[0]) {
-                min_grid1d = pit->grid[0];
-            } else if (min_grid1d + P3M_MAX_GRID_DIFF < pit->grid[0]) {
+            if (min_grid1d > grid1d) {
+                min_grid1d = grid1d;
+            } else if (min_grid1d + P3M_MAX_GRID_DIFF < grid1d) {
                 P3M_INFO(printf("      grid too large => removing data set\n"));
                 // remove the rest of the params
                 TuneParameterList::iterator next = pit;
@@ -750,7 +884,8 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
             if (pit != params_to_try.begin()) {
                 TuneParameterList::iterator prev = pit;
                 prev--;
-                if (prev->grid[0] >= pit->grid[0]) {
+                if (prev->grid[0]*prev->grid[1]*prev->grid[2]
+                        >= pit->grid[0]*pit->grid[1]*pit->grid[2]) {
                     P3M_INFO(printf("      better than previous => removing previous data set.\n"));
                     params_to_try.erase(prev);
                 }
@@ -782,6 +917,54 @@ Solver::tuneGrid(TuneParameterList &params_to_try) {
     }
 }
 
+/** Set the grid of p such that the longest box dimension has grid1d
+    grid points. The other dimensions get the smallest good grid size
+    with at most the same grid constant. */
+void
+Solver::setTuneGrid(TuneParameters &p, p3m_int grid1d) {
+    const p3m_float max_box_l = fmax(box_l[0], fmax(box_l[1], box_l[2]));
+    for (int i = 0; i < 3; i++) {
+        const p3m_float min_grid =
+                grid1d * box_l[i] / max_box_l * (1.0 - ROUND_ERROR_PREC);
+        p3m_int ix = 1;
+        while (ix < num_good_gridsize-1 && good_gridsize[ix] < min_grid)
+            ix++;
+        p.grid[i] = good_gridsize[ix];
+    }
+}
+
+/** Reduce the grid size of p in the single dimensions as long as the
+    error estimate stays below the tolerance. The dimensions with the
+    smallest grid constant are shrunk first. */
+void
+Solver::shrinkTuneGrid(TuneParameters &p) {
+    p3m_int dims[3] = { 0, 1, 2 };
+    for (int i = 0; i < 3; i++)
+        for (int j = 2; j > i; j--)
+            if (box_l[dims[j]]/p.grid[dims[j]]
+                    < box_l[dims[j-1]]/p.grid[dims[j-1]]) {
+                p3m_int tmp = dims[j];
+                dims[j] = dims[j-1];
+                dims[j-1] = tmp;
+            }
+
+    for (int i = 0; i < 3; i++) {
+        const p3m_int dim = dims[i];
+        p3m_int ix = num_good_gridsize-1;
+        while (ix > 1 && good_gridsize[ix] > p.grid[dim]) ix--;
+
+        TuneParameters q = p;
+        while (--ix > 0) {
+            q.grid[dim] = good_gridsize[ix];
+            P3M_DEBUG(printf("      shrunk grid=" F3INT "\n",          \
+                    q.grid[0], q.grid[1], q.grid[2]));
+            errorEstimate->computeMaster(q, sum_qpart, sum_q2, box_l, box_vectors, isTriclinic);
+            if (q.error >= tolerance_field) break;
+            p = q;
+        }
+    }
+}
+
 TuneParameters
 Solver::timeParams(
         p3m_int num_particles, p3m_float *positions, p3m_float *charges,
@@ -802,10 +985,11 @@ Solver::timeParams(
         printf( "  r_cut=" FFLOAT ", "
                 "alpha=" FFLOAT ", "
                 "grid=" F3INT ", "
-                "cao=" FINT "\n",
+                "cao=" FINT ", "
+                "variant=%s\n",
                 pit->r_cut, pit->alpha,
                 pit->grid[0], pit->grid[1], pit->grid[2],
-                pit->cao);
+                pit->cao, P3M_VARIANT_NAME(pit->variant));
     }
 #endif
 
@@ -816,12 +1000,13 @@ Solver::timeParams(
         P3M_INFO(printf( "  Timing r_cut=" FFLOAT ", "         \
                 "alpha=" FFLOAT ", "                           \
                 "grid=" F3INT ", "                             \
-                "cao=" FINT "\n    "                           \
+                "cao=" FINT ", "                               \
+                "variant=%s\n    "                             \
                 "=> timing=" FFLOAT " "                        \
                 "(" FFLOAT " near, " FFLOAT " far)\n",         \
                 r_cut, alpha,                                  \
                 grid[0], grid[1], grid[2],                     \
-                cao, pit->timing,                              \
+                cao, P3M_VARIANT_NAME(variant), pit->timing,       \
                 pit->timing_near, pit->timing_far));
 
         if (pit->timing < best_timing) {
@@ -833,6 +1018,37 @@ Solver::timeParams(
     return best_params;
 }
 
+void Solver::reserveBuffers(p3m_int num_particles) {
+    if (num_particles <= buffer_size) return;
+
+    /* allocate some more to avoid reallocations when particles move */
+    this->freeBuffers();
+    buffer_size = num_particles + num_particles/10;
+}
+
+p3m_float *Solver::getBuffer(p3m_float *&buffer, p3m_int components) {
+    if (buffer == NULL)
+        buffer = new p3m_float[components*buffer_size];
+    return buffer;
+}
+
+void Solver::freeBuffers() {
+    sdelete(fields_buffer);
+    sdelete(potentials_buffer);
+    sdelete(near_fields_buffer);
+    sdelete(near_potentials_buffer);
+    sdelete(positions_triclinic_buffer);
+    fields_buffer = potentials_buffer = NULL;
+    near_fields_buffer = near_potentials_buffer = NULL;
+    positions_triclinic_buffer = NULL;
+    buffer_size = 0;
+}
+
+void P3M::Solver::selectErrorEstimate(p3m_int variant) {
+    if (errorEstimate != NULL) delete errorEstimate;
+    errorEstimate = ErrorEstimate::create(comm, variant);
+}
+
 void P3M::Solver::setRequireTimings(TimingType type) {
     require_timings = type;
     if (type == NONE || type == NOTFAR)
@@ -856,10 +1072,16 @@ const double* Solver::measureTimings(p3m_int num_particles,
     Solver::TimingType require_timings_before = this->getRequireTimings();
     this->setRequireTimings(FULL);
 
-    this->run(num_particles, positions, charges, fields, potentials);
+    /* the test run must not reorder the particles of the caller */
+    bool resort_before = resort;
+    resort = false;
+
+    this->run(num_particles, num_particles,
+            positions, charges, fields, potentials);
 
-    /* restore require_timings */
+    /* restore require_timings and resort */
     this->setRequireTimings(require_timings_before);
+    resort = resort_before;
 
     delete[] fields;
     delete[] potentials;
@@ -935,7 +1157,7 @@ static void tuneBroadcastCommand(Communication &comm, p3m_int command) {
 
 void Solver::tuneBroadcastSendParams(TuneParameters p) {
     // broadcast the parameters
-    p3m_int int_buffer[4];
+    p3m_int int_buffer[5];
     p3m_float float_buffer[2];
 
     // pack int data
@@ -943,7 +1165,8 @@ void Solver::tuneBroadcastSendParams(TuneParameters p) {
     int_buffer[1] = p.grid[1];
     int_buffer[2] = p.grid[2];
     int_buffer[3] = p.cao;
-    MPI_Bcast(int_buffer, 4, P3M_MPI_INT, 0, comm.mpicomm);
+    int_buffer[4] = p.variant;
+    MPI_Bcast(int_buffer, 5, P3M_MPI_INT, 0, comm.mpicomm);
 
     // pack float data
     float_buffer[0] = p.alpha;
@@ -956,18 +1179,20 @@ void Solver::tuneBroadcastSendParams(TuneParameters p) {
     grid[1] = p.grid[1];
     grid[2] = p.grid[2];
     cao = p.cao;
+    variant = p.variant;
 }
 
 void Solver::tuneBroadcastReceiveParams() {
     // receive parameters
-    p3m_int int_buffer[4];
+    p3m_int int_buffer[5];
     p3m_float float_buffer[2];
 
-    MPI_Bcast(int_buffer, 4, P3M_MPI_INT, 0, comm.mpicomm);
+    MPI_Bcast(int_buffer, 5, P3M_MPI_INT, 0, comm.mpicomm);
     grid[0] = int_buffer[0];
     grid[1] = int_buffer[1];
     grid[2] = int_buffer[2];
     cao = int_buffer[3];
+    variant = int_buffer[4];
 
     // unpack float data
     MPI_Bcast(float_buffer, 2, P3M_MPI_FLOAT, 0,  comm.mpicomm);
@@ -985,7 +1210,7 @@ void Solver::tuneBroadcastFinish(TuneParameters p) {
     tuneBroadcastCommand(comm, CMD_FINISHED);
     this->tuneBroadcastSendParams(p);
     needs_retune = false;
-    this->prepare();
+    this->prepare(fftw_rigor);
 }
 
 void Solver::tuneBroadcastNoTune() {
@@ -995,15 +1220,54 @@ void Solver::tuneBroadcastNoTune() {
 
 Solver::TuneParameterList
 Solver::tuneBroadcastTuneFar(TuneParameters p) {
-    tuneBroadcastCommand(comm, CMD_TUNE_FAR);
-    return this->tuneFar(p);
+    TuneParameterList params;
+    std::string error;
+
+    /* collect the parameter sets of all variants to try, the timings
+       decide which one is used */
+    for (p3m_int v = 0; v < P3M_NUM_VARIANTS; v++) {
+        if (tune_variant) {
+            /* triclinic boxes are only implemented with ad-i so far */
+            if (isTriclinic && v != P3M_VARIANT_ADI) continue;
+        } else if (v != variant) continue;
+
+        P3M_INFO(printf("  Tuning variant %s...\n", P3M_VARIANT_NAME(v)));
+
+        tuneBroadcastCommand(comm, CMD_TUNE_FAR);
+        MPI_Bcast(&v, 1, P3M_MPI_INT, 0, comm.mpicomm);
+        this->selectErrorEstimate(v);
+
+        p.variant = v;
+        try {
+            TuneParameterList variant_params = this->tuneFar(p);
+            params.splice(params.end(), variant_params);
+        } catch (std::exception &e) {
+            /* it suffices if one of the variants achieves the accuracy */
+            error = e.what();
+        }
+    }
+
+    if (params.empty()) {
+        this->tuneBroadcastFail();
+        if (error.empty()) {
+            char msg[255];
+            sprintf(msg,
+                    "Cannot achieve required accuracy (p3m_tolerance_field="
+                    FFLOATE ") for given parameters.",
+                    tolerance_field);
+            error = msg;
+        }
+        throw std::logic_error(error);
+    }
+
+    return params;
 }
 
 void Solver::tuneBroadcastTiming(TuneParameters &p, p3m_int num_particles,
         p3m_float *positions, p3m_float *charges) {
     tuneBroadcastCommand(comm, CMD_TIMING);
     this->tuneBroadcastSendParams(p);
-    this->prepare();
+    this->prepare(P3M_FFTW_ESTIMATE);
 
     const double *timings = this->measureTimings(num_particles, positions, charges);
     p.timing = timings[TOTAL];
@@ -1037,14 +1301,14 @@ void Solver::tuneLoopSlave(p3m_int num_particles, p3m_float* positions,
             break;
         case CMD_TIMING:
             this->tuneBroadcastReceiveParams();
-            this->prepare();
+            this->prepare(P3M_FFTW_ESTIMATE);
             this->measureTimings(num_particles, positions, charges);
             break;
         case CMD_FINISHED:
             this->tuneBroadcastReceiveParams();
             P3M_DEBUG_LOCAL(printf( "P3M::Solver::tuneLoopSlave() " \
                     "finished.\n"));
-            this->prepare();
+            this->prepare(fftw_rigor);
             needs_retune = false;
             break;
         case CMD_NO_TUNE:
@@ -28,6 +28,7 @@
 #include "FarSolver.hpp"
 #include "CAF.hpp"
 #include "common/gridsort/gridsort.h"
+#include "common/gridsort/gridsort_resort.h"
 #include <list>
 
 
@@ -51,11 +52,14 @@ namespace P3M {
     Solver(MPI_Comm mpicomm);
     ~Solver();
 
-    void prepare();
+    /** Create the far field solver for the current parameters, with
+        FFTW plans of the given rigor. */
+    void prepare(p3m_int rigor);
 
     void tune(p3m_int num_particles, p3m_float *positions, p3m_float *charges);
 
-    void run(p3m_int num_particles, p3m_float *positions, p3m_float *charges,
+    void run(p3m_int num_particles, p3m_int max_num_particles,
+             p3m_float *positions, p3m_float *charges,
              p3m_float *fields, p3m_float *potentials);
     
     void setRequireTotalEnergy(bool flag = true);
@@ -99,6 +103,22 @@ namespace P3M {
     bool near_field_flag;
     /** flag that determines if the Gaussian potentials are shifted */
     bool shiftGaussians;
+    /** order of the near field interpolation tables (-1: no interpolation) */
+    p3m_int interpolation_order;
+    /** near field interpolation tables */
+    fcs_erfc_table_t erfc_table;
+    /** whether to compute the near field while the far field waits for messages */
+    bool overlap_near;
+    /** rigor of the FFTW plans of the tuned parameters (P3M_FFTW_*) */
+    p3m_int fftw_rigor;
+    /** max. distance the particles have moved since the last run (<0: unknown) */
+    p3m_float max_particle_move;
+    /** whether the particles are to be kept in the order of the decomposition */
+    bool resort;
+    /** resort object of the last run (FCS_GRIDSORT_RESORT_NULL if not available) */
+    fcs_gridsort_resort_t gridsort_resort;
+    /** local number of particles of the last run */
+    p3m_int num_local_particles;
     
     /* TUNABLE PARAMETERS */
     /** cutoff radius */
@@ -109,6 +129,8 @@ namespace P3M {
     p3m_int grid[3];
     /** charge assignment order ([0,P3M_MAX_CAO]). */
     p3m_int cao;
+    /** variant of the algorithm (P3M_VARIANT_IK or P3M_VARIANT_ADI). */
+    p3m_int variant;
 
     /* Whether or not it is necessary to retune the method before running it. */
     bool needs_retune;
@@ -120,6 +142,10 @@ namespace P3M {
     bool tune_grid;
     /** Whether or not the charge assignment order is to be automatically tuned. */
     bool tune_cao;
+    /** Whether or not the variant is to be automatically tuned. */
+    bool tune_variant;
+    /** Whether or not the variant was chosen by the user. */
+    bool variant_set;
 
 private:
     /****************************************************
@@ -143,7 +169,7 @@ private:
     /* domain decomposition */
     void
     decompose(fcs_gridsort_t *gridsort,
-            p3m_int _num_particles,
+            p3m_int _num_particles, p3m_int _max_num_particles,
             p3m_float *_positions, p3m_float *_charges,
             p3m_int *num_real_particles,
             p3m_float **positions, p3m_float **charges,
@@ -161,10 +187,14 @@ private:
     TuneParameterList tuneFar(Parameters p);
     /** Slave variant of tune_far. */
     void tuneFarSlave();
+    /** Replace the error estimate by the one of the given variant. */
+    void selectErrorEstimate(p3m_int variant);
 
     void tuneAlpha(TuneParameterList &params_to_try);
     void tuneCAO(TuneParameterList &params_to_try);
     void tuneGrid(TuneParameterList &params_to_try);
+    void setTuneGrid(TuneParameters &p, p3m_int grid1d);
+    void shrinkTuneGrid(TuneParameters &p);
 
     TuneParameters timeParams(p3m_int num_particles, p3m_float *positions,
             p3m_float *charges, TuneParameterList &params_to_try);
@@ -212,6 +242,23 @@ private:
     }
 
     void gatherTimings();
+
+    /** gridsort data reused across runs */
+    fcs_gridsort_cache_t gridsort_cache;
+
+    /* Work buffers for the results of the local particles. They are
+       kept across runs and only reallocated when the local number of
+       particles exceeds buffer_size. */
+    p3m_int buffer_size;
+    p3m_float *fields_buffer, *potentials_buffer;
+    p3m_float *near_fields_buffer, *near_potentials_buffer;
+    p3m_float *positions_triclinic_buffer;
+
+    /** Make the work buffers large enough for num_particles particles. */
+    void reserveBuffers(p3m_int num_particles);
+    /** Get a work buffer with components values per particle. */
+    p3m_float *getBuffer(p3m_float *&buffer, p3m_int components);
+    void freeBuffers();
 };
 
 
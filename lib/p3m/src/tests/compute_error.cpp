@@ -16,12 +16,12 @@ int main(int argc, char *argv[]) {
   p3m_int grid = atoi(argv[1]);
 
   Communication comm(MPI_COMM_WORLD);
-  ErrorEstimate *error = ErrorEstimate::create(comm);
+  TuneParameters p;
+  ErrorEstimate *error = ErrorEstimate::create(comm, p.variant);
   p3m_float L[3] = { 10.0, 10.0, 10.0 };
   p3m_float num_charges = 300.0;
   p3m_float sum_q2 = 300.0;
 
-  TuneParameters p;
   p.cao = 4;
   p.grid[0] = grid;
   p.grid[1] = grid;
@@ -23,6 +23,7 @@
 #define _P3M_TYPES_HPP
 
 #include "p3mconfig.hpp"
+#include "common/fcs-common/FCSInterpolate.h"
 
 namespace P3M {
 /* DEFAULTS */
@@ -44,28 +45,33 @@ const p3m_float P3M_DEFAULT_TOLERANCE_FIELD = 1.0e-3;
 /* Define to print out timings at the end of run */
 //#define P3M_PRINT_TIMINGS
 
-/* COMPILE TIME SWITCHES */
-/* Differentiation method */
-/** ik-Differentiation */
-#define P3M_IK
-/** analytical differentiation */
-//#define P3M_AD
-/** Whether to use interlaced version of P3M algorithm. */
-//#define P3M_INTERLACE
-/* Sanity checks */
-#if defined(P3M_AD) && defined(P3M_IK)
-#error Cannot use P3M_AD and P3M_IK at the same time
-#endif
-
-#if defined(P3M_AD) && !defined(P3M_INTERLACE)
-#error Cannot use P3M_AD without P3M_INTERLACE
-#endif
+/* VARIANTS OF THE ALGORITHM (differentiation method and interlacing) */
+/** ik-differentiation */
+const p3m_int P3M_VARIANT_IK = 0;
+/** analytical differentiation with interlacing */
+const p3m_int P3M_VARIANT_ADI = 1;
+/** Number of variants. */
+const p3m_int P3M_NUM_VARIANTS = 2;
+/** Name of a variant in the output. */
+#define P3M_VARIANT_NAME(v) ((v) == P3M_VARIANT_ADI ? "ad-i" : "ik")
+
+/* RIGOR OF THE FFTW PLANNING (FFTW_ESTIMATE ... FFTW_EXHAUSTIVE) */
+const p3m_int P3M_FFTW_ESTIMATE = 0;
+const p3m_int P3M_FFTW_MEASURE = 1;
+const p3m_int P3M_FFTW_PATIENT = 2;
+const p3m_int P3M_FFTW_EXHAUSTIVE = 3;
+/** Default rigor of the FFTW plans of the final parameters (the
+ parameter sets timed during tuning are always estimated). */
+const p3m_int P3M_DEFAULT_FFTW_RIGOR = P3M_FFTW_PATIENT;
 
 /* CONSTANTS */
 /** Search horizon for maximal grid size. */
 const p3m_int P3M_MAX_GRID_DIFF = 10;
 /** This value for epsilon indicates metallic boundary conditions. */
 const p3m_float P3M_EPSILON_METALLIC = 0.0;
+/** Number of particles whose near field is computed in one step while
+ the far field waits for messages. */
+const p3m_int P3M_OVERLAP_NEAR_STEP = 64;
 /** precision limit for the r_cut zero */
 const p3m_float P3M_RCUT_PREC = 1.0e-3;
 /** Whether to use the approximation of Abramowitz/Stegun
@@ -77,11 +83,13 @@ static const char* P3M_FFTW_WISDOM_FILENAME = "fftw-wisdom.dat";
 
 /** Number of Brillouin zones taken into account in the calculation of
  the optimal influence function (aliasing sums). */
-#ifdef P3M_INTERLACE
-const p3m_int P3M_BRILLOUIN = 1;
-#else 
 const p3m_int P3M_BRILLOUIN = 0;
-#endif
+/** Same for the interlaced variants. */
+const p3m_int P3M_BRILLOUIN_INTERLACE = 1;
+/** Same for the error estimate of the interlaced variants. Interlacing
+ cancels the odd Brillouin zones, so the leading aliasing errors come
+ from the second zones. */
+const p3m_int P3M_BRILLOUIN_INTERLACE_ERROR = 2;
 
 /* Index helpers for direct and reciprocal space
  * After the FFT the data is in order YZX, which
@@ -103,8 +111,8 @@ const p3m_int P3M_BRILLOUIN = 0;
 /***************************************************/
 /* DATA TYPES */
 /***************************************************/
-    /** structure for near computation parameters: alpha and the potential shift. */
-    typedef struct {p3m_float alpha; p3m_float potentialOffset;} near_params_t;
+    /** structure for near computation parameters: alpha, the potential shift and the (optional) interpolation tables. */
+    typedef struct {p3m_float alpha; p3m_float potentialOffset; const fcs_erfc_table_t *table;} near_params_t;
     
 /** Structure for local grid parameters. */
 struct local_grid_t {
@@ -165,12 +173,15 @@ struct Parameters {
 	p3m_int grid[3];
 	/** charge assignment order ([0,P3M_MAX_CAO]). */
 	p3m_int cao;
+	/** variant of the algorithm (P3M_VARIANT_IK or P3M_VARIANT_ADI). */
+	p3m_int variant;
 };
 
 struct TuneParameters {
     TuneParameters() {
         r_cut = alpha = -1.0;
         cao = grid[0] = grid[1] = grid[2] = -1;
+        variant = P3M_VARIANT_IK;
         error = ks_error = rs_error = -1.0;
         timing = timing_near = timing_far = -1.0;
     }
@@ -182,6 +193,7 @@ struct TuneParameters {
         grid[0] = p.grid[0];
         grid[1] = p.grid[1];
         grid[2] = p.grid[2];
+        variant = p.variant;
         error = ks_error = rs_error = -1.0;
         timing = timing_near = timing_far = -1.0;
     }
@@ -194,6 +206,7 @@ struct TuneParameters {
         p.grid[0] = grid[0];
         p.grid[1] = grid[1];
         p.grid[2] = grid[2];
+        p.variant = variant;
         return p;
     }
 
@@ -205,6 +218,8 @@ struct TuneParameters {
     p3m_int grid[3];
     /** charge assignment order ([0,P3M_MAX_CAO]). */
     p3m_int cao;
+    /** variant of the algorithm (P3M_VARIANT_IK or P3M_VARIANT_ADI). */
+    p3m_int variant;
 
     /** Errors */
     p3m_float rs_error, ks_error, error;
@@ -10,6 +10,7 @@
 #endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "cuboid.h"
 
 double*** cuboid_alloc(int m, int n, int o)
@@ -45,6 +46,47 @@ double*** cuboid_alloc(int m, int n, int o)
 	return cuboid;
 }
 
+int cuboid_row_length(int o)
+{
+	int align = CUBOID_ALIGN/sizeof(double);
+
+	return ((o+align-1)/align)*align;
+}
+
+double*** cuboid_alloc_padded(int m, int n, int o)
+{
+	void *field;
+	double ***cuboid;
+	int o_p = cuboid_row_length(o);
+	int i,j;
+
+	if (posix_memalign(&field, CUBOID_ALIGN, sizeof(double)*m*n*o_p) != 0)
+	  {
+	    printf("Malloc failed!\n");
+	    exit(1);
+	  }
+	memset(field, 0, sizeof(double)*m*n*o_p);
+	cuboid = (double***) malloc(sizeof(double**)*m);
+	if (cuboid==NULL) 
+	  {
+	    printf("Malloc failed!\n");
+	    exit(1);
+	  }
+	for (i=0;i<m;i++) {
+		cuboid[i] = (double**) malloc(sizeof(double*)*n);
+		if (cuboid[i]==NULL) 
+		  {
+		    printf("Malloc failed!\n");
+		    exit(1);
+		  }
+		for (j=0;j<n;j++) {
+			cuboid[i][j] = (double*) field + (i*n+j)*o_p;
+		}
+	}
+	
+	return cuboid;
+}
+
 double*** cube_alloc(int n)
 {
 	return cuboid_alloc(n,n,n);
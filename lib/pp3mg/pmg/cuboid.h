@@ -8,9 +8,20 @@
 #ifndef _CUBOID__H_
 #define _CUBOID__H_
 
+/* alignment in bytes of the rows of padded cuboids */
+#define CUBOID_ALIGN 64
+
 double*** cuboid_alloc(int m, int n, int o);
 double*** cube_alloc(int n);
 
+/* Padded cuboids store their m*n rows contiguously, but each row holds
+   cuboid_row_length(o) >= o doubles and starts at a CUBOID_ALIGN boundary,
+   so cuboid[0][0] can be swept with the flat index (i*n+j)*o_p+k.
+   The padding is zeroed and never referenced by the solver. */
+int cuboid_row_length(int o);
+double*** cuboid_alloc_padded(int m, int n, int o);
+
+/* frees plain and padded cuboids */
 void cuboid_free(double ***cuboid, int m, int n, int o);
 void cube_free(double ***cuboid, int n);
 
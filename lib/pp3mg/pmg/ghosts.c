@@ -2,162 +2,166 @@
 #include <config.h>
 #endif
 #include <stdio.h>
+#include <string.h>
 
 #include <mpi.h>
 
 #include "ghosts.h"
 
-void update_ghosts( double ***v, mg_data* data, int level )
+/*
+ * The ghosts of a level are exchanged with all 26 neighbors (faces, edges
+ * and corners) at once, so that no exchange has to wait for the ghosts of
+ * another direction. The regions are described by subarray datatypes on
+ * the padded grids, which are shared by v, f, r, e and tmp.
+ */
+
+/* first index and extent in one dimension of the region sent to (recv = 0)
+   or received from (recv = 1) the neighbor in direction dir = -1, 0, 1 */
+static void halo_range( int size, int ghosts, int dir, int recv, int *start, int *extent )
 {
-  /* MPI variables */
-  int myid;
-  MPI_Status stats[2];
-  MPI_Request reqs[2];
+  if (dir == 0) {
+    *start = ghosts;
+    *extent = size - 2*ghosts;
+  } else {
+    *extent = ghosts;
+    if (dir < 0)
+      *start = recv ? 0 : ghosts;
+    else
+      *start = recv ? size - ghosts : size - 2*ghosts;
+  }
+}
 
-  /* Loop variables */
-  int i, j, k;
-  int m = data[level].m_l, n = data[level].n_l, o = data[level].o_l;
+void setup_ghosts( mg_data* data, int level )
+{
+  const int sizes[3] = { data[level].m_l, data[level].n_l, data[level].o_l };
+  int padded[3] = { data[level].m_l, data[level].n_l, data[level].o_p };
+  const int ghosts[3] = { data[level].x_ghosts, data[level].y_ghosts, data[level].z_ghosts };
+  const int lower[3] = { data[level].left, data[level].lower, data[level].back };
+  const int upper[3] = { data[level].right, data[level].upper, data[level].front };
+  int myid, dir[3], face[3], coords[3], fcoords[3];
+  int d, c, n, neighbor, self;
+  int sstart[3], rstart[3], extent[3];
 
-  /* Getting local rank */
   MPI_Comm_rank(data[level].cart_comm, &myid);
 
+  data[level].halo_count = 0;
+  data[level].halo_copies = 0;
+  data[level].halo_nreqs = 0;
+
+  for (d=0;d<27;d++) {
+    if (d == 13)
+      continue;
+    dir[0] = d/9 - 1;
+    dir[1] = (d/3)%3 - 1;
+    dir[2] = d%3 - 1;
+
+    neighbor = myid;
+    self = 1;
+    for (c=0;c<3;c++) {
+      face[c] = (dir[c] < 0) ? lower[c] : ((dir[c] > 0) ? upper[c] : myid);
+      if (face[c] == MPI_PROC_NULL)
+	neighbor = MPI_PROC_NULL;
+      if (face[c] != myid)
+	self = 0;
+    }
+    if (neighbor == MPI_PROC_NULL || (self && !data[level].periodic))
+      continue;
 
-  /* Sending data to left */
-  for (i=0;i<data[level].x_ghosts;i++)
-    for (j=0;j<n;j++)
-      for (k=0;k<o;k++)
-	data[level].sbufyz[i][j][k] = v[data[level].x_ghosts+i][j][k];
-
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].left)
-    MPI_Isend((void *) data[level].sbufyz[0][0],data[level].x_ghosts*n*o,MPI_DOUBLE,data[level].left,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].right)
-    MPI_Irecv((void *) data[level].rbufyz[0][0],data[level].x_ghosts*n*o,MPI_DOUBLE,data[level].right,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].right )
-    for (i=0;i<data[level].x_ghosts;i++)
-      for (j=0;j<n;j++)
-	for (k=0;k<o;k++)
-	  v[m-data[level].x_ghosts+i][j][k] = data[level].rbufyz[i][j][k];
-
-  /* Sending data to right */
-  for (i=0;i<data[level].x_ghosts;i++)
-    for (j=0;j<n;j++)
-      for (k=0;k<o;k++)
-	data[level].sbufyz[i][j][k] = v[m-2*data[level].x_ghosts+i][j][k];
-  
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].right)
-    MPI_Isend((void *) data[level].sbufyz[0][0],data[level].x_ghosts*n*o,MPI_DOUBLE,data[level].right,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].left)
-    MPI_Irecv((void *) data[level].rbufyz[0][0],data[level].x_ghosts*n*o,MPI_DOUBLE,data[level].left,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].left )
-    for (i=0;i<data[level].x_ghosts;i++)
-      for (j=0;j<n;j++)
-	for (k=0;k<o;k++)
-	  v[i][j][k] = data[level].rbufyz[i][j][k];
-
-  /* Sending data downwards */
-  for (i=0;i<m;i++)
-    for (j=0;j<data[level].y_ghosts;j++)
-      for (k=0;k<o;k++)
-	data[level].sbufxz[i][j][k] = v[i][data[level].y_ghosts+j][k];
-
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].lower)
-    MPI_Isend((void *) data[level].sbufxz[0][0],m*data[level].y_ghosts*o,MPI_DOUBLE,data[level].lower,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].upper)
-    MPI_Irecv((void *) data[level].rbufxz[0][0],m*data[level].y_ghosts*o,MPI_DOUBLE,data[level].upper,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].upper )
-    for (i=0;i<m;i++)
-      for (j=0;j<data[level].y_ghosts;j++)
-	for (k=0;k<o;k++)
-	  v[i][n-data[level].y_ghosts+j][k] = data[level].rbufxz[i][j][k];
-  
-  /* Sending data upwards */
-  for (i=0;i<m;i++)
-    for (j=0;j<data[level].y_ghosts;j++)
-      for (k=0;k<o;k++)
-	data[level].sbufxz[i][j][k] = v[i][n-2*data[level].y_ghosts+j][k];
-
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].upper)
-    MPI_Isend((void *) data[level].sbufxz[0][0],m*data[level].y_ghosts*o,MPI_DOUBLE,data[level].upper,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].lower)
-    MPI_Irecv((void *) data[level].rbufxz[0][0],m*data[level].y_ghosts*o,MPI_DOUBLE,data[level].lower,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].lower )
-    for (i=0;i<m;i++)
-      for (j=0;j<data[level].y_ghosts;j++)
-	for (k=0;k<o;k++)
-	  v[i][j][k] = data[level].rbufxz[i][j][k];
-
-  /* Sending data backwards */
-  for (i=0;i<m;i++)
-    for (j=0;j<n;j++)
-      for (k=0;k<data[level].z_ghosts;k++)
-	data[level].sbufxy[i][j][k] = v[i][j][data[level].z_ghosts+k];
-
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].back)
-    MPI_Isend((void *) data[level].sbufxy[0][0],m*n*data[level].z_ghosts,MPI_DOUBLE,data[level].back,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].front)
-    MPI_Irecv((void *) data[level].rbufxy[0][0],m*n*data[level].z_ghosts,MPI_DOUBLE,data[level].front,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].front )
-    for (i=0;i<m;i++)
-      for (j=0;j<n;j++)
-	for (k=0;k<data[level].z_ghosts;k++)
-	  v[i][j][o-data[level].z_ghosts+k] = data[level].rbufxy[i][j][k];
-  
-  /* Sending data to front */
-  for (i=0;i<m;i++)
-    for (j=0;j<n;j++)
-      for (k=0;k<data[level].z_ghosts;k++)
-	data[level].sbufxy[i][j][k] = v[i][j][o-2*data[level].z_ghosts+k];
-
-  reqs[0] = MPI_REQUEST_NULL; reqs[1] = MPI_REQUEST_NULL;
-  if (myid!=data[level].front)
-    MPI_Isend((void *) data[level].sbufxy[0][0],m*n*data[level].z_ghosts,MPI_DOUBLE,data[level].front,0,data[level].cart_comm,&reqs[0]);
-  if (myid!=data[level].back)
-    MPI_Irecv((void *) data[level].rbufxy[0][0],m*n*data[level].z_ghosts,MPI_DOUBLE,data[level].back,0,data[level].cart_comm,&reqs[1]);
-  MPI_Waitall(2,reqs,stats);
-  if( MPI_PROC_NULL != data[level].back )
-    for (i=0;i<m;i++)
-      for (j=0;j<n;j++)
-	for (k=0;k<data[level].z_ghosts;k++)
-	  v[i][j][k] = data[level].rbufxy[i][j][k];
-  
-  if (data[level].periodic) {
-    if (myid==data[level].back && myid==data[level].front) {
-      for (i=0;i<m;i++)
-	for (j=0;j<n;j++) 
-	  for (k=0;k<data[level].z_ghosts;k++) {
-	    v[i][j][k] = v[i][j][o-2*data[level].z_ghosts+k];
-	    v[i][j][o-data[level].z_ghosts+k] = v[i][j][data[level].z_ghosts+k];
-	  }
+    for (c=0;c<3;c++) {
+      halo_range(sizes[c], ghosts[c], dir[c], 0, &sstart[c], &extent[c]);
+      halo_range(sizes[c], ghosts[c], dir[c], 1, &rstart[c], &extent[c]);
     }
-    
-    if (myid==data[level].lower && myid==data[level].upper) {
-      for (i=0;i<m;i++)
-	for (j=0;j<data[level].y_ghosts;j++)
-	  for (k=0;k<o;k++) {
-	    v[i][j][k] = v[i][n-2*data[level].y_ghosts+j][k];
-	    v[i][n-data[level].y_ghosts+j][k] = v[i][data[level].y_ghosts+j][k];
-	  }
+    if (extent[0] <= 0 || extent[1] <= 0 || extent[2] <= 0)
+      continue;
+
+    if (self) {
+      /* periodic copy, the ghosts in direction d come from the opposite side */
+      n = data[level].halo_copies++;
+      for (c=0;c<3;c++) {
+	data[level].halo_copy[n][c][0] = rstart[c];
+	halo_range(sizes[c], ghosts[c], -dir[c], 0, &data[level].halo_copy[n][c][1], &extent[c]);
+	data[level].halo_copy[n][c][2] = extent[c];
+      }
+      continue;
     }
 
-    if (myid==data[level].left && myid==data[level].right) {
-      for (i=0;i<data[level].x_ghosts;i++)
-	for (j=0;j<n;j++)
-	  for (k=0;k<o;k++) {
-	    v[i][j][k] = v[m-2*data[level].x_ghosts+i][j][k];
-	    v[m-data[level].x_ghosts+i][j][k] = v[data[level].x_ghosts+i][j][k];
-	  }
+    /* the neighbor across an edge or corner combines the coordinates of
+       the face neighbors, which skip processes without points on this level */
+    for (c=0;c<3;c++) {
+      MPI_Cart_coords(data[level].cart_comm, face[c], 3, fcoords);
+      coords[c] = fcoords[c];
     }
+    MPI_Cart_rank(data[level].cart_comm, coords, &neighbor);
+
+    n = data[level].halo_count++;
+    data[level].halo_rank[n] = neighbor;
+    data[level].halo_sendtag[n] = d;
+    data[level].halo_recvtag[n] = 26 - d;
+    MPI_Type_create_subarray(3, padded, extent, sstart, MPI_ORDER_C, MPI_DOUBLE,
+			     &data[level].halo_send[n]);
+    MPI_Type_commit(&data[level].halo_send[n]);
+    MPI_Type_create_subarray(3, padded, extent, rstart, MPI_ORDER_C, MPI_DOUBLE,
+			     &data[level].halo_recv[n]);
+    MPI_Type_commit(&data[level].halo_recv[n]);
+  }
+
+  return;
+}
+
+void free_ghosts( mg_data* data, int level )
+{
+  int n;
+
+  for (n=0;n<data[level].halo_count;n++) {
+    MPI_Type_free(&data[level].halo_send[n]);
+    MPI_Type_free(&data[level].halo_recv[n]);
   }
-    
+  data[level].halo_count = 0;
+  data[level].halo_copies = 0;
+
+  return;
+}
+
+void update_ghosts_begin( double ***v, mg_data* data, int level )
+{
+  double *v0 = v[0][0];
+  const int n_l = data[level].n_l, o_p = data[level].o_p;
+  int n, i, j;
+
+  data[level].halo_nreqs = 0;
+  for (n=0;n<data[level].halo_count;n++)
+    MPI_Irecv((void *) v0,1,data[level].halo_recv[n],data[level].halo_rank[n],
+	      data[level].halo_recvtag[n],data[level].cart_comm,
+	      &data[level].halo_reqs[data[level].halo_nreqs++]);
+  for (n=0;n<data[level].halo_count;n++)
+    MPI_Isend((void *) v0,1,data[level].halo_send[n],data[level].halo_rank[n],
+	      data[level].halo_sendtag[n],data[level].cart_comm,
+	      &data[level].halo_reqs[data[level].halo_nreqs++]);
+
+  for (n=0;n<data[level].halo_copies;n++) {
+    int (*copy)[3] = data[level].halo_copy[n];
+    for (i=0;i<copy[0][2];i++)
+      for (j=0;j<copy[1][2];j++)
+	memcpy(v0 + ((copy[0][0]+i)*n_l + copy[1][0]+j)*o_p + copy[2][0],
+	       v0 + ((copy[0][1]+i)*n_l + copy[1][1]+j)*o_p + copy[2][1],
+	       copy[2][2]*sizeof(double));
+  }
+
+  return;
+}
+
+void update_ghosts_end( double ***v, mg_data* data, int level )
+{
+  MPI_Waitall(data[level].halo_nreqs,data[level].halo_reqs,MPI_STATUSES_IGNORE);
+  data[level].halo_nreqs = 0;
+
+  return;
+}
+
+void update_ghosts( double ***v, mg_data* data, int level )
+{
+  update_ghosts_begin( v, data, level );
+  update_ghosts_end( v, data, level );
+
   return;
 }
@@ -3,6 +3,14 @@
 
 #include "mg.h"
 
+void setup_ghosts( mg_data* data, int level );
+void free_ghosts( mg_data* data, int level );
+
 void update_ghosts(double ***v, mg_data* data, int level );
 
+/* update_ghosts split in two, the ghosts of v must not be read and the
+   points sent to the neighbors must not be written in between */
+void update_ghosts_begin( double ***v, mg_data* data, int level );
+void update_ghosts_end( double ***v, mg_data* data, int level );
+
 #endif /* ifndef _GHOSTS__H_ */
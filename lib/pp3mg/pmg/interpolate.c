@@ -7,12 +7,22 @@
 
 void interpolate_prepare( double ***fine, double ***coarse, mg_data* data, int level )
 {
+  const int n_f = data[level].n_l, o_pf = data[level].o_p;
+  const int n_c = data[level+1].n_l, o_pc = data[level+1].o_p;
+  const int m = data[level].m_l, o = data[level].o_l;
+  const double *c0 = coarse[0][0];
+  double *f0 = fine[0][0];
   int i, j, k;
 
-  for (i = data[level].x_ghosts-data[level].x_off; i < data[level].m_l-data[level].x_ghosts; i+=2) {
-    for (j = data[level].y_ghosts-data[level].y_off; j < data[level].n_l-data[level].y_ghosts; j+=2) {
-      for (k = data[level].z_ghosts-data[level].z_off; k < data[level].o_l-data[level].z_ghosts; k+=2) {
-        fine[i+1][j+1][k+1] = 0.125 * coarse[i/2+1][j/2+1][k/2+1];
+#ifdef _OPENMP
+#pragma omp parallel for private(j,k) if (m*n_f*o_pf > MG_OMP_MIN_POINTS)
+#endif
+  for (i = data[level].x_ghosts-data[level].x_off; i < m-data[level].x_ghosts; i+=2) {
+    for (j = data[level].y_ghosts-data[level].y_off; j < n_f-data[level].y_ghosts; j+=2) {
+      double *f = f0 + ((i+1)*n_f+j+1)*o_pf + 1;
+      const double *c = c0 + ((i/2+1)*n_c+j/2+1)*o_pc + 1;
+      for (k = data[level].z_ghosts-data[level].z_off; k < o-data[level].z_ghosts; k+=2) {
+        f[k] = 0.125 * c[k/2];
       }
     }
   }
@@ -20,127 +30,81 @@ void interpolate_prepare( double ***fine, double ***coarse, mg_data* data, int l
   return;
 }
 
+/*
+ * The points of the fine grid that do not coincide with a coarse grid point
+ * are interpolated in seven passes, one for each position in the coarse
+ * cell. A pass reads only points set by interpolate_prepare, so the passes
+ * are independent of each other.
+ */
+static const struct {
+  /* loop starts at ghosts + start*off */
+  int start[3];
+  /* written point relative to the loop index */
+  int dst[3];
+  /* points averaged, relative to the loop index */
+  int nsrc;
+  int src[8][3];
+  /* weights for zeros at (0.0,0.0,0.0) and (\pi,\pi,\pi) */
+  double weight;
+  double weight_pi3;
+} interpolate_passes[7] = {
+  { {  1,  1,  1 }, { 0, 0, 0 }, 8,
+    { {-1,-1,-1}, {-1,-1, 1}, {-1, 1,-1}, {-1, 1, 1}, { 1,-1,-1}, { 1,-1, 1}, { 1, 1,-1}, { 1, 1, 1} },
+    0.125, -0.125 },
+  { {  1,  1, -1 }, { 0, 0, 1 }, 4, { {-1,-1, 1}, {-1, 1, 1}, { 1,-1, 1}, { 1, 1, 1} }, 0.25, 0.25 },
+  { {  1, -1,  1 }, { 0, 1, 0 }, 4, { {-1, 1,-1}, {-1, 1, 1}, { 1, 1,-1}, { 1, 1, 1} }, 0.25, 0.25 },
+  { {  1, -1, -1 }, { 0, 1, 1 }, 2, { {-1, 1, 1}, { 1, 1, 1} }, 0.5, -0.5 },
+  { { -1,  1,  1 }, { 1, 0, 0 }, 4, { { 1,-1,-1}, { 1,-1, 1}, { 1, 1,-1}, { 1, 1, 1} }, 0.25, 0.25 },
+  { { -1,  1, -1 }, { 1, 0, 1 }, 2, { { 1,-1, 1}, { 1, 1, 1} }, 0.5, -0.5 },
+  { { -1, -1,  1 }, { 1, 1, 0 }, 2, { { 1, 1,-1}, { 1, 1, 1} }, 0.5, -0.5 },
+};
+
 void interpolate_finish(double ***fine, mg_data* data, int level )
 {
-  int i, j, k;
-  int xoff = data[level].x_off, yoff = data[level].y_off, zoff = data[level].z_off;
-  int m = data[level].m_l, n = data[level].n_l, o = data[level].o_l;
+  const int m = data[level].m_l, n = data[level].n_l, o = data[level].o_l;
+  const int o_p = data[level].o_p;
+  const int off[3] = { data[level].x_off, data[level].y_off, data[level].z_off };
+  const int ghosts[3] = { data[level].x_ghosts, data[level].y_ghosts, data[level].z_ghosts };
+  double *f0 = fine[0][0];
 
-  /* WARNING: currently only zeros at (0.0,0.0,0.0) or (M_PI,M_PI,M_PI) are supported! */
-  if (data[level].zero_at_pi3==false) {
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j][k] = 0.125 * (fine[i-1][j-1][k-1] + fine[i-1][j-1][k+1] + fine[i-1][j+1][k-1] + fine[i-1][j+1][k+1] + fine[i+1][j-1][k-1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j][k+1] = 0.25 * (fine[i-1][j-1][k+1] + fine[i-1][j+1][k+1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j+1][k] = 0.25 * (fine[i-1][j+1][k-1] + fine[i-1][j+1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j+1][k+1] = 0.5 * (fine[i-1][j+1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i+1][j][k] = 0.25 * (fine[i+1][j-1][k-1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-        fine[i+1][j][k+1] = 0.5 * (fine[i+1][j-1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i+1][j+1][k] = 0.5 * (fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-  } else {
-    /* zero at (\pi,\pi,\pi) */
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j][k] = -0.125 * (fine[i-1][j-1][k-1] + fine[i-1][j-1][k+1] + fine[i-1][j+1][k-1] + fine[i-1][j+1][k+1] + fine[i+1][j-1][k-1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j][k+1] = 0.25 * (fine[i-1][j-1][k+1] + fine[i-1][j+1][k+1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j+1][k] = 0.25 * (fine[i-1][j+1][k-1] + fine[i-1][j+1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts+xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i][j+1][k+1] = -0.5 * (fine[i-1][j+1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i+1][j][k] = 0.25 * (fine[i+1][j-1][k-1] + fine[i+1][j-1][k+1] + fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts+yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts-zoff; k<o-data[level].x_ghosts; k+=2) {
-        fine[i+1][j][k+1] = -0.5 * (fine[i+1][j-1][k+1] + fine[i+1][j+1][k+1]);
-	}
-      }
-    }
-    
-    for (i = data[level].x_ghosts-xoff; i<m-data[level].x_ghosts; i+=2) {
-      for (j = data[level].y_ghosts-yoff; j<n-data[level].x_ghosts; j+=2) {
-	for (k = data[level].z_ghosts+zoff; k<o-data[level].x_ghosts; k+=2) {
-	  fine[i+1][j+1][k] = -0.5 * (fine[i+1][j+1][k-1] + fine[i+1][j+1][k+1]);
+#ifdef _OPENMP
+#pragma omp parallel if (m*n*o_p > MG_OMP_MIN_POINTS)
+#endif
+  {
+    int pass, s, i, j, k;
+
+    for (pass=0;pass<7;pass++) {
+      const int nsrc = interpolate_passes[pass].nsrc;
+      /* WARNING: currently only zeros at (0.0,0.0,0.0) or (M_PI,M_PI,M_PI) are supported! */
+      const double w = (data[level].zero_at_pi3==false) ?
+	interpolate_passes[pass].weight : interpolate_passes[pass].weight_pi3;
+      const int i0 = ghosts[0] + interpolate_passes[pass].start[0]*off[0];
+      const int j0 = ghosts[1] + interpolate_passes[pass].start[1]*off[1];
+      const int k0 = ghosts[2] + interpolate_passes[pass].start[2]*off[2];
+      const int dst = (interpolate_passes[pass].dst[0]*n + interpolate_passes[pass].dst[1])*o_p
+	+ interpolate_passes[pass].dst[2];
+      int src[8];
+
+      for (s=0;s<nsrc;s++)
+	src[s] = (interpolate_passes[pass].src[s][0]*n + interpolate_passes[pass].src[s][1])*o_p
+	  + interpolate_passes[pass].src[s][2];
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+      for (i = i0; i<m-ghosts[0]; i+=2) {
+	for (j = j0; j<n-ghosts[1]; j+=2) {
+	  double *f = f0 + (i*n+j)*o_p;
+	  for (k = k0; k<o-ghosts[2]; k+=2) {
+	    double sum = f[k+src[0]];
+	    for (s=1;s<nsrc;s++)
+	      sum = sum + f[k+src[s]];
+	    f[k+dst] = w * sum;
+	  }
 	}
       }
     }
   }
+
   return;
 }
-
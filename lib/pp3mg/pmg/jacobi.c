@@ -9,38 +9,152 @@
 #include <config.h>
 #endif
 #include <mpi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "jacobi.h"
 #include "lueqf.h"
 #include "ghosts.h"
 
-double jacobi( double*** v, double*** f, double*** r, mg_data* data, int level, 
-	       int maxiter )
+/* r = D^(-1)*(f - A*v) on the points of plane i that belong to part */
+static void jacobi_res_plane( const double *v, const double *f, double *r, double alpha,
+			      mg_data* data, int level, int i, int part )
 {
+  const int n = data[level].n_l, o_p = data[level].o_p;
+  int j, k, s, segments, k0[2], k1[2];
 
-  double res;
+  for (j=data[level].y_ghosts;j<n-data[level].y_ghosts;j++) {
+    segments = lueqf_row_segments( data, level, part, i, j, k0, k1 );
+    for (s=0;s<segments;s++) {
+      const int row = (i*n+j)*o_p + k0[s], len = k1[s]-k0[s];
+      lueqf_res_row( v+row, f+row, r+row, len, data[level].size,
+		     data[level].values, data[level].offsets );
+      for (k=row;k<row+len;k++)
+	r[k] = alpha * r[k];
+    }
+  }
+}
+
+/* v = v + omega * r on the interior of plane i */
+static void jacobi_update_plane( double *v, const double *r, mg_data* data, int level, int i )
+{
+  const int n = data[level].n_l, o_p = data[level].o_p;
+  const int z_ghosts = data[level].z_ghosts;
+  const int len = data[level].o_l - 2*z_ghosts;
+  const double omega = data[level].omega;
+  int j, k;
+
+  for (j=data[level].y_ghosts;j<n-data[level].y_ghosts;j++) {
+    const int row = (i*n+j)*o_p + z_ghosts;
+    for (k=row;k<row+len;k++)
+      v[k] = v[k] + omega * r[k];
+  }
+}
+
+/*
+ * Finishes a damped Jacobi step on the interior of level, the residual of
+ * the inner part is already in r. The rest of the residual and the update
+ * are fused into a single pass over the grid: plane i-x_ghosts of v is
+ * updated as soon as the residual of plane i is computed, since no later
+ * residual reads it. With OpenMP, each thread streams a slab of planes and
+ * the planes shared with the neighboring slabs are updated after a barrier.
+ */
+static void jacobi_sweep( double *v, const double *f, double *r, double alpha,
+			  mg_data* data, int level )
+{
+  const int m = data[level].m_l, x_ghosts = data[level].x_ghosts;
+
+#ifdef _OPENMP
+#pragma omp parallel if (m*data[level].n_l*data[level].o_p > MG_OMP_MIN_POINTS)
+#endif
+  {
+    int t = 0, nt = 1;
+    int planes, i0, i1, lo, i;
+
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+    nt = omp_get_num_threads();
+#endif
+
+    planes = m - 2*x_ghosts;
+    i0 = x_ghosts + (t*planes)/nt;
+    i1 = x_ghosts + ((t+1)*planes)/nt;
+    /* the first planes of a slab are read by the previous one */
+    lo = (t == 0) ? i0 : ((i0+x_ghosts < i1) ? i0+x_ghosts : i1);
+
+    for (i=i0;i<i1;i++) {
+      jacobi_res_plane( v, f, r, alpha, data, level, i, LUEQF_OUTER );
+      if (i-x_ghosts >= lo)
+	jacobi_update_plane( v, r, data, level, i-x_ghosts );
+    }
+    /* the last planes of a slab are read by the next one */
+    if (t == nt-1)
+      for (i=(lo > i1-x_ghosts ? lo : i1-x_ghosts);i<i1;i++)
+	jacobi_update_plane( v, r, data, level, i );
+
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+
+    for (i=i0;i<lo;i++)
+      jacobi_update_plane( v, r, data, level, i );
+    if (t != nt-1)
+      for (i=(lo > i1-x_ghosts ? lo : i1-x_ghosts);i<i1;i++)
+	jacobi_update_plane( v, r, data, level, i );
+  }
+}
+
+/* r = D^(-1)*(f - A*v) on the inner part, which needs no ghosts */
+static void jacobi_res_inner( const double *v, const double *f, double *r, double alpha,
+			      mg_data* data, int level )
+{
+  const int m = data[level].m_l, x_ghosts = data[level].x_ghosts;
+  int i;
+
+#ifdef _OPENMP
+#pragma omp parallel for if (m*data[level].n_l*data[level].o_p > MG_OMP_MIN_POINTS)
+#endif
+  for (i=2*x_ghosts;i<m-2*x_ghosts;i++)
+    jacobi_res_plane( v, f, r, alpha, data, level, i, LUEQF_INNER );
+}
+
+/* maxiter Jacobi steps, each overlapping the ghost exchange with the
+   residual of the inner part; the ghosts of v are not updated afterwards */
+static void jacobi_iterate( double*** v, double*** f, double*** r, mg_data* data, int level,
+			    int maxiter )
+{
+  const double alpha = lueqf_invdiag( data, level );
   int iter;
-  int i, j, k;
 
   for (iter=0;iter<maxiter;iter++) {
-    /* r = f - A*v */
-    update_ghosts( v, data, level );
-    lueqf_res( v, f, r, data, level );
-    /* r = D^(-1)*r */
-    lueqf_invd( r, data, level );
-    /* v = v + omega * r */
-    for (i=0;i<data[level].m_l;i++) {
-      for (j=0;j<data[level].n_l;j++) {
-	for (k=0;k<data[level].o_l;k++) {
-	  v[i][j][k] = v[i][j][k] + data[level].omega * r[i][j][k];
-	}
-      }
-    }
+    /* v = v + omega * D^(-1) * (f - A*v) */
+    update_ghosts_begin( v, data, level );
+    jacobi_res_inner( v[0][0], f[0][0], r[0][0], alpha, data, level );
+    update_ghosts_end( v, data, level );
+    jacobi_sweep( v[0][0], f[0][0], r[0][0], alpha, data, level );
   }
+}
 
-  update_ghosts( v, data, level );
-  res = lueqf_res( v, f, r, data, level );
-  update_ghosts( v, data, level );
+double jacobi( double*** v, double*** f, double*** r, mg_data* data, int level, 
+	       int maxiter )
+{
+
+  double res;
+
+  jacobi_iterate( v, f, r, data, level, maxiter );
+
+  update_ghosts_begin( v, data, level );
+  res = lueqf_res_part( v, f, r, data, level, LUEQF_INNER );
+  update_ghosts_end( v, data, level );
+  res = res + lueqf_res_part( v, f, r, data, level, LUEQF_OUTER );
 
   return(res);
 }
+
+void jacobi_smooth( double*** v, double*** f, double*** r, mg_data* data, int level,
+		    int maxiter )
+{
+  jacobi_iterate( v, f, r, data, level, maxiter );
+  update_ghosts( v, data, level );
+}
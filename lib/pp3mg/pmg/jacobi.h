@@ -10,8 +10,15 @@
 
 #include "mg.h"
 
+/* Performs maxiter damped Jacobi steps on level. On return, the interior
+   of r holds the residual f - A*v and its squared norm is returned.
+   The ghosts of v are up to date on return. */
 double jacobi( double*** v, double*** f, double*** r, mg_data* data, int level, 
 	       int maxiter );
 
+/* Same as jacobi, without computing the residual; r is used as scratch. */
+void jacobi_smooth( double*** v, double*** f, double*** r, mg_data* data, int level,
+		    int maxiter );
+
 
 #endif /* ifndef _JACOBI__H_ */
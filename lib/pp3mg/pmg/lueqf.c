@@ -6,21 +6,36 @@
 
 double lueqf_res( double*** v, double*** f, double*** r, mg_data* data, int level )
 {
-  int i, j, k, count;
+  return lueqf_res_part( v, f, r, data, level, LUEQF_ALL );
+}
+
+double lueqf_res_part( double*** v, double*** f, double*** r, mg_data* data, int level, int part )
+{
+  const int m = data[level].m_l, n = data[level].n_l, o_p = data[level].o_p;
+  const int x_ghosts = data[level].x_ghosts, y_ghosts = data[level].y_ghosts;
+  double *v0, *f0, *r0;
+  int i, j, k, s, segments, k0[2], k1[2];
   double res = 0.0;
-  double stencilsum;
-
-  for (i=data[level].x_ghosts;i<data[level].m_l-data[level].x_ghosts;i++) {
-    for (j=data[level].y_ghosts;j<data[level].n_l-data[level].y_ghosts;j++) {
-      for (k=data[level].z_ghosts;k<data[level].o_l-data[level].z_ghosts;k++) {
-	stencilsum = 0.0;
-        for( count = 0; count < data[level].size; count++ )
-	  stencilsum += ( data[level].values[count] *
-			  v[i+data[level].x_offsets[count]]
-			   [j+data[level].y_offsets[count]]
-			   [k+data[level].z_offsets[count]] );
-	r[i][j][k] = f[i][j][k] - stencilsum;
-	res = res + r[i][j][k] * r[i][j][k];
+
+  if (m<=0 || n<=0 || data[level].o_l<=0)
+    return(res);
+
+  v0 = v[0][0];
+  f0 = f[0][0];
+  r0 = r[0][0];
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j,k,s,segments,k0,k1) reduction(+:res) if (m*n*o_p > MG_OMP_MIN_POINTS)
+#endif
+  for (i=x_ghosts;i<m-x_ghosts;i++) {
+    for (j=y_ghosts;j<n-y_ghosts;j++) {
+      segments = lueqf_row_segments( data, level, part, i, j, k0, k1 );
+      for (s=0;s<segments;s++) {
+	const int row = (i*n+j)*o_p;
+	lueqf_res_row( v0+row+k0[s], f0+row+k0[s], r0+row+k0[s], k1[s]-k0[s],
+		       data[level].size, data[level].values, data[level].offsets );
+	for (k=row+k0[s];k<row+k1[s];k++)
+	  res = res + r0[k] * r0[k];
       }
     }
   }
@@ -28,20 +43,40 @@ double lueqf_res( double*** v, double*** f, double*** r, mg_data* data, int leve
   return(res);
 }
 
-void lueqf_invd( double ***r, mg_data* data, int level )
+double lueqf_invdiag( mg_data* data, int level )
 {
-  int i, j, k;
-  double alpha;
+  int i;
+  double alpha = 0.0;
 
   for (i=0;i<data[level].size;i++)
     if (data[level].x_offsets[i] == 0 && data[level].y_offsets[i] == 0 && data[level].z_offsets[i] == 0)
       alpha = 1.0 / data[level].values[i];
 
-  for (i=data[level].x_ghosts;i<data[level].m_l-data[level].x_ghosts;i++) {
-    for (j=data[level].y_ghosts;j<data[level].n_l-data[level].y_ghosts;j++) {
-      for (k=data[level].z_ghosts;k<data[level].o_l-data[level].z_ghosts;k++) {
-	r[i][j][k] = alpha * r[i][j][k];
-      }
+  return(alpha);
+}
+
+void lueqf_invd( double ***r, mg_data* data, int level )
+{
+  const int m = data[level].m_l, n = data[level].n_l, o_p = data[level].o_p;
+  const int z_ghosts = data[level].z_ghosts;
+  const int len = data[level].o_l - 2*z_ghosts;
+  const double alpha = lueqf_invdiag( data, level );
+  double *r0;
+  int i, j, k;
+
+  if (m<=0 || n<=0 || data[level].o_l<=0)
+    return;
+
+  r0 = r[0][0];
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j,k) if (m*n*o_p > MG_OMP_MIN_POINTS)
+#endif
+  for (i=data[level].x_ghosts;i<m-data[level].x_ghosts;i++) {
+    for (j=data[level].y_ghosts;j<n-data[level].y_ghosts;j++) {
+      double *rr = r0 + (i*n+j)*o_p + z_ghosts;
+      for (k=0;k<len;k++)
+	rr[k] = alpha * rr[k];
     }
   }
 
@@ -9,4 +9,64 @@ double lueqf_res( double*** v, double*** f, double*** r, mg_data* data, int leve
 // 		 MPI_Comm cart_comm);
 void lueqf_invd( double ***r, mg_data* data, int level );
 
+/* parts of the interior, for overlapping the residual with update_ghosts */
+#define LUEQF_ALL   0
+#define LUEQF_INNER 1 /* points whose stencil does not reach the ghosts */
+#define LUEQF_OUTER 2 /* the remaining points */
+
+double lueqf_res_part( double*** v, double*** f, double*** r, mg_data* data, int level, int part );
+
+/* inverse of the diagonal entry of the stencil on level */
+double lueqf_invdiag( mg_data* data, int level );
+
+/* r = f - A*v for len consecutive points of a row of the padded grids,
+   with the stencil given by values and the flat offsets */
+static inline void lueqf_res_row( const double *restrict v, const double *restrict f,
+				  double *restrict r, int len, int size,
+				  const double *values, const int *offsets )
+{
+  int count, k;
+
+  for (k=0;k<len;k++)
+    r[k] = 0.0;
+  for( count = 0; count < size; count++ ) {
+    const double a = values[count];
+    const double *vc = v + offsets[count];
+    for (k=0;k<len;k++)
+      r[k] += a * vc[k];
+  }
+  for (k=0;k<len;k++)
+    r[k] = f[k] - r[k];
+}
+
+/* the segments [k0[s],k1[s]) of the interior of row (i,j) that belong to
+   part, returns their number */
+static inline int lueqf_row_segments( mg_data* data, int level, int part, int i, int j,
+				      int *k0, int *k1 )
+{
+  const int m = data[level].m_l, n = data[level].n_l, o = data[level].o_l;
+  const int x_ghosts = data[level].x_ghosts, y_ghosts = data[level].y_ghosts;
+  const int z_ghosts = data[level].z_ghosts;
+  const int inner = m > 4*x_ghosts && n > 4*y_ghosts && o > 4*z_ghosts
+    && i >= 2*x_ghosts && i < m-2*x_ghosts && j >= 2*y_ghosts && j < n-2*y_ghosts;
+
+  if (part == LUEQF_ALL || (part == LUEQF_OUTER && !inner)) {
+    k0[0] = z_ghosts;
+    k1[0] = o-z_ghosts;
+    return 1;
+  }
+  if (!inner)
+    return 0;
+  if (part == LUEQF_INNER) {
+    k0[0] = 2*z_ghosts;
+    k1[0] = o-2*z_ghosts;
+    return 1;
+  }
+  k0[0] = z_ghosts;
+  k1[0] = 2*z_ghosts;
+  k0[1] = o-2*z_ghosts;
+  k1[1] = o-z_ghosts;
+  return 2;
+}
+
 #endif /* ifndef _LUEQF__H_ */
@@ -4,6 +4,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 #include <sys/time.h>
 
@@ -36,14 +37,13 @@ void mg_setup( mg_data **outdata, int maxlevel, int m, int n, int o,
     - periodic
     - cartesian communicator cart_comm
    allocates space for each level:
-    - sbufxy, sbufxz, sbufyz
-    - rbufxy, rbufxz, rbufyz
+    - datatypes for the ghost exchange
    allocates space for stencil data on level 0
    inits for each level:
     - v, f, r, e
 */
   int level;
-  int i, j, k;
+  int i;
   double sum;
   mg_data *data;
 
@@ -325,42 +325,29 @@ void mg_setup( mg_data **outdata, int maxlevel, int m, int n, int o,
       }
     }
 
+    /* flatten stencil offsets for the padded grids */
+    data[level].o_p = cuboid_row_length(data[level].o_l);
+    data[level].offsets = (int*) malloc( data[level].size*sizeof(int) );
+    for ( i=0; i<data[level].size; i++ )
+      data[level].offsets[i] = 
+	(data[level].x_offsets[i]*data[level].n_l + data[level].y_offsets[i])*data[level].o_p
+	+ data[level].z_offsets[i];
+
     if (data[level].m_l>0 && data[level].n_l>0 && data[level].o_l>0) {
-      data[level].v = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].o_l);
-      data[level].f = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].o_l);
-      data[level].r = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].o_l);
-      data[level].e = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].o_l);
-      data[level].tmp = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].o_l);
-      data[level].sbufxy = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].z_ghosts);
-      data[level].sbufxz = cuboid_alloc(data[level].m_l,data[level].y_ghosts,data[level].o_l);
-      data[level].sbufyz = cuboid_alloc(data[level].x_ghosts,data[level].n_l,data[level].o_l);
-      data[level].rbufxy = cuboid_alloc(data[level].m_l,data[level].n_l,data[level].z_ghosts);
-      data[level].rbufxz = cuboid_alloc(data[level].m_l,data[level].y_ghosts,data[level].o_l);
-      data[level].rbufyz = cuboid_alloc(data[level].x_ghosts,data[level].n_l,data[level].o_l);
-
-      for (i=0;i<data[level].m_l;i++) {
-	for (j=0;j<data[level].n_l;j++) {
-	  for (k=0;k<data[level].o_l;k++) {
-	    data[level].v[i][j][k] = 0.0;
-	    data[level].f[i][j][k] = 0.0;
-	    data[level].r[i][j][k] = 0.0;
-	    data[level].e[i][j][k] = 0.0;
-	    data[level].tmp[i][j][k] = 0.0;
-	  }
-	}
-      }
+      data[level].v = cuboid_alloc_padded(data[level].m_l,data[level].n_l,data[level].o_l);
+      data[level].f = cuboid_alloc_padded(data[level].m_l,data[level].n_l,data[level].o_l);
+      data[level].r = cuboid_alloc_padded(data[level].m_l,data[level].n_l,data[level].o_l);
+      data[level].e = cuboid_alloc_padded(data[level].m_l,data[level].n_l,data[level].o_l);
+      data[level].tmp = cuboid_alloc_padded(data[level].m_l,data[level].n_l,data[level].o_l);
+      setup_ghosts( data, level );
     } else {
       data[level].v = NULL;
       data[level].f = NULL;
       data[level].r = NULL;
       data[level].e = NULL;
       data[level].tmp = NULL;
-      data[level].sbufxy = NULL;
-      data[level].sbufxz = NULL;
-      data[level].sbufyz = NULL;
-      data[level].rbufxy = NULL;
-      data[level].rbufxz = NULL;
-      data[level].rbufyz = NULL;
+      data[level].halo_count = 0;
+      data[level].halo_copies = 0;
     }
 
 #ifdef DEBUG
@@ -427,8 +414,8 @@ void mg_init(double ***v, double ***f, mg_data *data )
     }
   }
   
+  /* the ghosts of f are never read */
   update_ghosts( data[0].v, data, 0 );
-  update_ghosts( data[0].f, data, 0 );
 
 /*       /\* Debugging output *\/ */
 /* #ifdef DEBUG */
@@ -486,6 +473,7 @@ void mg_free(mg_data *data, int maxlevel)
   int level;
 
   for (level=0;level<maxlevel;level++) {
+    free_ghosts( data, level );
     if (data[level].v != NULL)
       cuboid_free(data[level].v,data[level].m_l,data[level].n_l,data[level].o_l);
     if (data[level].f != NULL)
@@ -496,18 +484,6 @@ void mg_free(mg_data *data, int maxlevel)
       cuboid_free(data[level].e,data[level].m_l,data[level].n_l,data[level].o_l);
     if (data[level].tmp != NULL)
       cuboid_free(data[level].tmp,data[level].m_l,data[level].n_l,data[level].o_l);
-    if (data[level].sbufxy != NULL)
-      cuboid_free(data[level].sbufxy,data[level].m_l,data[level].n_l,data[level].z_ghosts);
-    if (data[level].sbufxz != NULL)
-      cuboid_free(data[level].sbufxz,data[level].m_l,data[level].y_ghosts,data[level].o_l);
-    if (data[level].sbufyz != NULL)
-      cuboid_free(data[level].sbufyz,data[level].x_ghosts,data[level].n_l,data[level].o_l);
-    if (data[level].rbufxy != NULL)
-      cuboid_free(data[level].rbufxy,data[level].m_l,data[level].n_l,data[level].z_ghosts);
-    if (data[level].rbufxz != NULL)
-      cuboid_free(data[level].rbufxz,data[level].m_l,data[level].y_ghosts,data[level].o_l);
-    if (data[level].rbufyz != NULL)
-      cuboid_free(data[level].rbufyz,data[level].x_ghosts,data[level].n_l,data[level].o_l);
     if( data[level].values != NULL )
       free( data[level].values );
     if( data[level].x_offsets != NULL )
@@ -516,6 +492,8 @@ void mg_free(mg_data *data, int maxlevel)
       free( data[level].y_offsets );
     if( data[level].z_offsets != NULL )
       free( data[level].z_offsets );
+    if( data[level].offsets != NULL )
+      free( data[level].offsets );
   }
 
   free(data);
@@ -525,30 +503,24 @@ void mg_free(mg_data *data, int maxlevel)
 
 double mg_vcycle( mg_data *data, int level, int maxlevel )
 {
-  int i, j, k;
+  int i, points;
   double res = 0.0;
+  double *v, *e;
 
   /* Clear old v_2h */
-  for (i=0;i<data[level+1].m_l;i++) {
-    for (j=0;j<data[level+1].n_l;j++) {
-      for (k=0;k<data[level+1].o_l;k++) {
-	data[level+1].v[i][j][k] = 0.0;
-      }
-    }
-  }
+  if (data[level+1].m_l>0 && data[level+1].n_l>0 && data[level+1].o_l>0)
+    memset( data[level+1].v[0][0], 0,
+	    data[level+1].m_l*data[level+1].n_l*data[level+1].o_p*sizeof(double) );
 
-  /* v_h <- smooth(v_h,f_h,nu1) */
-  jacobi( data[level].v, data[level].f, data[level].tmp, data, level, data[level].nu1 );
-
-  /* r_h <- f_h - L * v_h */
-  lueqf_res( data[level].v, data[level].f, data[level].r, data, level );
+  /* v_h <- smooth(v_h,f_h,nu1), r_h <- f_h - L * v_h */
+  jacobi( data[level].v, data[level].f, data[level].r, data, level, data[level].nu1 );
   update_ghosts( data[level].r, data, level );
 
   /* f_2h <- I_h^2h(r_h) */
   if (data[level+1].m_l>0 && data[level+1].n_l>0 && data[level+1].o_l>0) {
     /*restrict_inj(data[level].r,data[level+1].f, data, level );*/
     restrict_fw(data[level].r,data[level+1].f,data, level); 
-    update_ghosts( data[level+1].f, data, level+1 );
+    /* the ghosts of f are never read */
   }
 
   if (level<(maxlevel-1)) {
@@ -557,7 +529,7 @@ double mg_vcycle( mg_data *data, int level, int maxlevel )
 	/* v_2h <- L^(-1) * f_2h */
 	mg_vcycle( data, level + 1, maxlevel );
       } else {
-	jacobi( data[level+1].v, data[level+1].f, data[level+1].tmp, data, level+1, data[level].nu1+data[level].nu2 );
+	jacobi_smooth( data[level+1].v, data[level+1].f, data[level+1].tmp, data, level+1, data[level].nu1+data[level].nu2 );
       }
     }
   }
@@ -569,19 +541,22 @@ double mg_vcycle( mg_data *data, int level, int maxlevel )
 
   update_ghosts( data[level].e, data, level );
   interpolate_finish( data[level].e, data, level );
-  update_ghosts( data[level].e, data, level );
 
-  /* v_h <- v_h + e_h */
-  for (i=0;i<data[level].m_l;i++) {
-    for (j=0;j<data[level].n_l;j++) {
-      for (k=0;k<data[level].o_l;k++) {
-	data[level].v[i][j][k] = data[level].v[i][j][k] + data[level].e[i][j][k];
-      }
-    }
-  }
-
-  /* v_h <- smooth(v_h,f_h,nu2) */
-  res = jacobi( data[level].v, data[level].f, data[level].tmp, data, level, data[level].nu2 );
+  /* v_h <- v_h + e_h, the ghosts of v are updated by the smoother */
+  v = data[level].v[0][0];
+  e = data[level].e[0][0];
+  points = data[level].m_l*data[level].n_l*data[level].o_p;
+#ifdef _OPENMP
+#pragma omp parallel for if (points > MG_OMP_MIN_POINTS)
+#endif
+  for (i=0;i<points;i++)
+    v[i] = v[i] + e[i];
+
+  /* v_h <- smooth(v_h,f_h,nu2), only the residual of the finest level is used */
+  if (level == 0)
+    res = jacobi( data[level].v, data[level].f, data[level].tmp, data, level, data[level].nu2 );
+  else
+    jacobi_smooth( data[level].v, data[level].f, data[level].tmp, data, level, data[level].nu2 );
 
   return(res);
 }
@@ -3,6 +3,9 @@
 
 #include "mpi.h"
 
+/* minimum number of grid points of a level to thread its sweeps */
+#define MG_OMP_MIN_POINTS 32768
+
 typedef struct {
   double ***v;
   double ***f;
@@ -10,16 +13,6 @@ typedef struct {
   double ***e;
   double ***tmp;
 
-  /* buffers for send */
-  double ***sbufxy;
-  double ***sbufxz;
-  double ***sbufyz;
-
-  /* buffers for receive */
-  double ***rbufxy;
-  double ***rbufxz;
-  double ***rbufyz;
-
   /* global dimensions */
   int m;
   int n;
@@ -30,6 +23,9 @@ typedef struct {
   int n_l;
   int o_l;
 
+  /* padded row length of v, f, r, e and tmp */
+  int o_p;
+
   /* periodic? */
   int periodic;
 
@@ -53,6 +49,20 @@ typedef struct {
   int y_ghosts;
   int z_ghosts;
 
+  /* halo exchange with the (up to) 26 neighbors, see ghosts.c */
+  int halo_count;
+  int halo_rank[26];
+  int halo_sendtag[26];
+  int halo_recvtag[26];
+  MPI_Datatype halo_send[26];
+  MPI_Datatype halo_recv[26];
+  /* periodic copies within the process */
+  int halo_copies;
+  int halo_copy[26][3][3];
+  /* pending requests of update_ghosts_begin */
+  int halo_nreqs;
+  MPI_Request halo_reqs[52];
+
   /* number of pre and post smoothing steps */
   int nu1;
   int nu2;
@@ -69,6 +79,9 @@ typedef struct {
   int* x_offsets;
   int* y_offsets;
   int* z_offsets;
+
+  /* stencil offsets into the padded grids of this level */
+  int* offsets;
 } mg_data;
 
 void mg_setup( mg_data **outdata, int maxlevel, int m, int n, int o,
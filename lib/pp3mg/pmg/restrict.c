@@ -24,102 +24,45 @@ void restrict_inj(double ***fine, double ***coarse, mg_data* data, int level )
 
 void restrict_fw(double ***fine, double ***coarse, mg_data* data, int level )
 {
-  int i, j, k;
-  int xoff , yoff, zoff;
-  xoff = data[level].x_off;
-  yoff = data[level].y_off;
-  zoff = data[level].z_off;
+  const int xoff = data[level].x_off, yoff = data[level].y_off, zoff = data[level].z_off;
+  const int n_f = data[level].n_l, o_pf = data[level].o_p;
+  const int m_c = data[level+1].m_l, n_c = data[level+1].n_l, o_c = data[level+1].o_l;
+  const int o_pc = data[level+1].o_p;
+  const int x_ghosts = data[level+1].x_ghosts, y_ghosts = data[level+1].y_ghosts;
+  const int z_ghosts = data[level+1].z_ghosts;
+  const double *f0 = fine[0][0];
+  double *c0 = coarse[0][0];
+  double w[9][3];
+  int i, j, k, row;
 
+  /* full weighting stencil, rows ordered by their x and y offsets */
   /* WARNING: currently only zeros at (0.0,0.0,0.0) or at (\pi,\pi,\pi) are supported! */
-  if (data[level].zero_at_pi3==false) {
-    for ( i = data[level+1].x_ghosts; i < data[level+1].m_l-data[level+1].x_ghosts; i++ ) {
-      for ( j = data[level+1].y_ghosts; j < data[level+1].n_l-data[level+1].y_ghosts; j++ ) {
-	for ( k = data[level+1].z_ghosts; k < data[level+1].o_l-data[level+1].z_ghosts; k++ ) {
-	  coarse[i][j][k] = 
-	    0.015625 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff  ] + 
-	    0.015625 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff-1] +
-	    0.062500 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    0.015625 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff  ] +
-	    0.015625 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff+1] +
-	    
-	    
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff-1] +
-	    0.062500 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff  ] + 
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    0.062500 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff-1] +
-	    0.125000 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff  ] +
-	    0.062500 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff-1] +
-	    0.062500 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff+1] +
-	    
-	    
-	    0.015625 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff  ] + 
-	    0.015625 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff-1] +
-	    0.062500 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    0.015625 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff  ] +
-	    0.015625 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff+1];
-	}
-      }
+  for (row=0;row<9;row++) {
+    for (k=0;k<3;k++) {
+      const int d = (row/3 != 1) + (row%3 != 1) + (k != 1);
+      w[row][k] = 0.125 / (1 << d);
+      if (data[level].zero_at_pi3==true && d%2==1)
+	w[row][k] = -w[row][k];
     }
-  } else {
-    /* zero at (\pi,\pi,\pi) */
-    for ( i = data[level+1].x_ghosts; i < data[level+1].m_l-data[level+1].x_ghosts; i++ ) {
-      for ( j = data[level+1].y_ghosts; j < data[level+1].n_l-data[level+1].y_ghosts; j++ ) {
-	for ( k = data[level+1].z_ghosts; k < data[level+1].o_l-data[level+1].z_ghosts; k++ ) {
-	  coarse[i][j][k] = 
-	    -0.015625 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff  ] + 
-	    -0.015625 * fine[2*i-xoff-1][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff-1] +
-	    -0.062500 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    -0.015625 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff  ] +
-	    -0.015625 * fine[2*i-xoff-1][2*j-yoff+1][2*k-zoff+1] +
-	    
-	    
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff-1] +
-	    -0.062500 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff  ] + 
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    -0.062500 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff-1] +
-	    0.125000 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff  ] +
-	    -0.062500 * fine[2*i-xoff  ][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff-1] +
-	    -0.062500 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff  ][2*j-yoff+1][2*k-zoff+1] +
-	    
-	    
-	    -0.015625 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff  ] + 
-	    -0.015625 * fine[2*i-xoff+1][2*j-yoff-1][2*k-zoff+1] +
-	    
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff-1] +
-	    -0.062500 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff  ] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff  ][2*k-zoff+1] +
-	    
-	    -0.015625 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff-1] +
-	    0.031250 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff  ] +
-	    -0.015625 * fine[2*i-xoff+1][2*j-yoff+1][2*k-zoff+1];
-	}
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j,k,row) if (8*m_c*n_c*o_pc > MG_OMP_MIN_POINTS)
+#endif
+  for ( i = x_ghosts; i < m_c-x_ghosts; i++ ) {
+    for ( j = y_ghosts; j < n_c-y_ghosts; j++ ) {
+      const double *p[9];
+      double *c = c0 + (i*n_c+j)*o_pc;
+      double sum;
+
+      for (row=0;row<9;row++)
+	p[row] = f0 + ((2*i-xoff+row/3-1)*n_f + 2*j-yoff+row%3-1)*o_pf - zoff;
+
+      for ( k = z_ghosts; k < o_c-z_ghosts; k++ ) {
+	sum = 0.0;
+	for (row=0;row<9;row++)
+	  sum = sum + w[row][0] * p[row][2*k-1] + w[row][1] * p[row][2*k] + w[row][2] * p[row][2*k+1];
+	c[k] = sum;
       }
     }
   }
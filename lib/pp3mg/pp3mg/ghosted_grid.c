@@ -1,7 +1,7 @@
 /* 
  * ghosted_grid.c
  *
- * This file contains the function "update_ghosts" to update
+ * This file contains the function "pp3mg_update_ghosts" to update
  * "boundary data" with neighboring processors.
  *
  * Based on Fortran code by Matthias Bolten.
@@ -17,12 +17,36 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
-#include <stdlib.h>
+#include <string.h>
 #include <mpi.h>
 #include <stdio.h>
 
 #include "ghosted_grid.h"
 
+/* first index and extent in one dimension of the region sent to (recv = 0)
+   or received from (recv = 1) the neighbor in direction dir = -1, 0, 1,
+   the interior is [ghosts,size+ghosts) */
+static void ghosted_range( int size, int ghosts, int dir, int recv, int *start, int *extent )
+{
+  if( dir == 0 ){
+    *start = ghosts;
+    *extent = size;
+  }
+  else{
+    *extent = ghosts;
+    if( dir < 0 )
+      *start = recv ? 0 : ghosts;
+    else
+      *start = recv ? size+ghosts : size;
+  }
+}
+
+/*
+ * The ghosts are exchanged with all 26 neighbors (faces, edges and corners)
+ * at once and completed by a single MPI_Waitall, instead of one blocking
+ * exchange per face. The regions are described by subarray datatypes, so
+ * no pack buffers are needed.
+ */
 void pp3mg_update_ghosts( double*** u, int m, int n, int o, int ghosts, MPI_Comm mpi_comm_cart )
 {
   /* MPI variables */
@@ -30,243 +54,95 @@ void pp3mg_update_ghosts( double*** u, int m, int n, int o, int ghosts, MPI_Comm
   int mpi_periods[3];
   int mpi_coords[3];
   int mpi_self;
-  int mpi_left, mpi_right, mpi_lower, mpi_upper, mpi_back, mpi_front;
-  MPI_Request mpi_req[2];
-  MPI_Status mpi_stat[2];
+  int mpi_lower[3], mpi_upper[3];
+  int mpi_face[3], mpi_neighbor, mpi_ncoords[3], mpi_fcoords[3];
+  MPI_Datatype mpi_send[26], mpi_recv[26];
+  MPI_Request mpi_req[52];
+  int mpi_nreqs = 0;
 
   /* Other variables */
-  double* buf_left, *buf_right;
-  double* buf_lower, *buf_upper;
-  double* buf_back, *buf_front;
-  int i, j, k;
-  int count;
+  const int size[3] = { m, n, o };
+  const int ghosted[3] = { m+2*ghosts, n+2*ghosts, o+2*ghosts };
+  int sstart[3], rstart[3], extent[3], cstart[3];
+  int dir[3];
+  int d, c, i, j, self, periodic, ntypes = 0;
+  double* u0 = u[0][0];
 
   /* Initializing MPI variables */
   MPI_Comm_rank( mpi_comm_cart, &mpi_self );
   MPI_Cart_get( mpi_comm_cart, 3, mpi_dims, mpi_periods, mpi_coords );
-  MPI_Cart_shift( mpi_comm_cart, 0, 1, &mpi_left, &mpi_right );
-  MPI_Cart_shift( mpi_comm_cart, 1, 1, &mpi_lower, &mpi_upper );
-  MPI_Cart_shift( mpi_comm_cart, 2, 1, &mpi_back, &mpi_front );
-  mpi_req[0] = MPI_REQUEST_NULL; 
-  mpi_req[1] = MPI_REQUEST_NULL;
-	
-  /* ----------------------------------------------------------------------------
-   *
-   * x-direction
-   *
-   * ---------------------------------------------------------------------------- */
-
-  /* Memory for transfer to left and right neighbors */
-  buf_left  = (double*) malloc( ghosts * (n + 2*ghosts) * (o + 2*ghosts) * sizeof( double ) );
-  buf_right = (double*) malloc( ghosts * (n + 2*ghosts) * (o + 2*ghosts) * sizeof( double ) );
-
-  /* Sending ghosts to left neighbor */
-  if( mpi_left == mpi_self ){
-    if( mpi_periods[0] ){	
-      for( i = ghosts; i < 2*ghosts; i++ )
-	for( j = 0; j < n+2*ghosts; j++ )
-	  for( k = 0; k < o+2*ghosts; k++ )
-	    u[i+m][j][k] = u[i][j][k];
-    }
-  }
-  else{
-    count = 0;
-    for( i = ghosts; i < 2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  buf_left[count] = u[i][j][k];
-	  count++;					
-	}
-    MPI_Isend( (void*) buf_left, count, MPI_DOUBLE, mpi_left, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_right, count, MPI_DOUBLE, mpi_right, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall(2, mpi_req, mpi_stat );
-	       
-    count = 0;
-    for( i = ghosts; i < 2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  u[i+m][j][k] = buf_right[count];
-	  count++;					
-	}		
-  }				
-				
-  /* Sending ghosts to right neighbor */
-  if( mpi_right == mpi_self ){
-    if( mpi_periods[0] ){
-      for( i = m; i < m+ghosts; i++ )
-	for( j = 0; j < n+2*ghosts; j++ )
-	  for( k = 0; k < o+2*ghosts; k++ )
-	    u[i-m][j][k] = u[i][j][k];
+  for( c = 0; c < 3; c++ )
+    MPI_Cart_shift( mpi_comm_cart, c, 1, &mpi_lower[c], &mpi_upper[c] );
+
+  if( ghosts <= 0 )
+    return;
+
+  for( d = 0; d < 27; d++ ){
+    if( d == 13 )
+      continue;
+    dir[0] = d/9 - 1;
+    dir[1] = (d/3)%3 - 1;
+    dir[2] = d%3 - 1;
+
+    mpi_neighbor = mpi_self;
+    self = 1;
+    periodic = 1;
+    for( c = 0; c < 3; c++ ){
+      mpi_face[c] = ( dir[c] < 0 ) ? mpi_lower[c] : ( ( dir[c] > 0 ) ? mpi_upper[c] : mpi_self );
+      if( mpi_face[c] == MPI_PROC_NULL )
+	mpi_neighbor = MPI_PROC_NULL;
+      if( mpi_face[c] != mpi_self )
+	self = 0;
+      if( dir[c] != 0 && !mpi_periods[c] )
+	periodic = 0;
     }
-  }
-  else{
-    count = 0;
-    for( i = m; i < m+ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  buf_right[count] = u[i][j][k];
-	  count++;					
-	}
-    MPI_Isend( (void*) buf_right, count, MPI_DOUBLE, mpi_right, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_left, count, MPI_DOUBLE, mpi_left, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall(2, mpi_req, mpi_stat );
-	       
-    count = 0;
-    for( i = m; i < m+ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  u[i-m][j][k] = buf_left[count];
-	  count++;					
-	}
-  }
-
-  /* Freeing memory */
-  free( buf_left );
-  free( buf_right );
-	
-  /* ----------------------------------------------------------------------------
-   *
-   * y-direction
-   *
-   * ---------------------------------------------------------------------------- */
+    if( mpi_neighbor == MPI_PROC_NULL || ( self && !periodic ) )
+      continue;
 
-  /* Memory for transfer to lower and upper neighbors */
-  buf_lower = (double*) malloc( (m + 2*ghosts) * ghosts * (o + 2*ghosts) * sizeof( double ) );
-  buf_upper = (double*) malloc( (m + 2*ghosts) * ghosts * (o + 2*ghosts) * sizeof( double ) );
-
-  /* Sending ghosts to lower neighbor */
-  if( mpi_lower == mpi_self ){
-    if( mpi_periods[1] ){
-      for( i = 0; i < m+2*ghosts; i++ )
-	for( j = ghosts; j < 2*ghosts; j++ )
-	  for( k = 0; k < o+2*ghosts; k++ )
-	    u[i][j+n][k] = u[i][j][k];
+    for( c = 0; c < 3; c++ ){
+      ghosted_range( size[c], ghosts, dir[c], 0, &sstart[c], &extent[c] );
+      ghosted_range( size[c], ghosts, dir[c], 1, &rstart[c], &extent[c] );
     }
-  }
-  else{
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = ghosts; j < 2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  buf_lower[count] = u[i][j][k];
-	  count++;					
-	}
-    MPI_Isend( (void*) buf_lower, count, MPI_DOUBLE, mpi_lower, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_upper, count, MPI_DOUBLE, mpi_upper, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall( 2, mpi_req, mpi_stat );
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = ghosts; j < 2*ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  u[i][j+n][k] = buf_upper[count];
-	  count++;					
-	}			
-  }
 
-
-  /* Sending ghosts to upper neighbor */
-  if( mpi_upper == mpi_self ){
-    if( mpi_periods[1] ){
-      for( i = 0; i < m+2*ghosts; i++ )
-	for( j = n; j < n+ghosts; j++ )
-	  for( k = 0; k < o+2*ghosts; k++ )
-	    u[i][j-n][k] = u[i][j][k];			
+    if( self ){
+      /* periodic copy, the ghosts in direction d come from the opposite side */
+      for( c = 0; c < 3; c++ )
+	ghosted_range( size[c], ghosts, -dir[c], 0, &cstart[c], &extent[c] );
+      for( i = 0; i < extent[0]; i++ )
+	for( j = 0; j < extent[1]; j++ )
+	  memcpy( &u[rstart[0]+i][rstart[1]+j][rstart[2]],
+		  &u[cstart[0]+i][cstart[1]+j][cstart[2]],
+		  extent[2] * sizeof( double ) );
+      continue;
     }
-  }
-  else{
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = n; j < n+ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  buf_upper[count] = u[i][j][k];
-	  count++;					
-	}		
-    MPI_Isend( (void*) buf_upper, count, MPI_DOUBLE, mpi_upper, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_lower, count, MPI_DOUBLE, mpi_lower, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall( 2, mpi_req, mpi_stat );
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = n; j < n+ghosts; j++ )
-	for( k = 0; k < o+2*ghosts; k++ ){
-	  u[i][j-n][k] = buf_lower[count];
-	  count++;					
-	}	
-  }
 
-  /* Freeing memory */
-  free( buf_lower );
-  free( buf_upper );
-	
-  /* ----------------------------------------------------------------------------
-   *
-   * z-direction
-   *
-   * ---------------------------------------------------------------------------- */
-
-  /* Memory for transfer to back and front neighbors */
-  buf_front = (double*) malloc( (m + 2*ghosts) * (n + 2*ghosts) * ghosts * sizeof( double ) );
-  buf_back  = (double*) malloc( (m + 2*ghosts) * (n + 2*ghosts) * ghosts * sizeof( double ) );
-	
-  /* Sending ghosts to back neighbor */
-  if( mpi_back == mpi_self ){
-    if( mpi_periods[2] ){
-      for( i = 0; i < m+2*ghosts; i++ )
-	for( j = 0; j < n+2*ghosts; j++ )
-	  for( k = ghosts; k < 2*ghosts; k++ )
-	    u[i][j][k+o] = u[i][j][k];
+    /* the neighbor across an edge or corner combines the coordinates of
+       the face neighbors */
+    for( c = 0; c < 3; c++ ){
+      MPI_Cart_coords( mpi_comm_cart, mpi_face[c], 3, mpi_fcoords );
+      mpi_ncoords[c] = mpi_fcoords[c];
     }
-  }
-  else{
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = ghosts; k < 2*ghosts; k++ ){
-	  buf_back[count] = u[i][j][k];
-	  count++;					
-	}	
-    MPI_Isend( (void*) buf_back, count, MPI_DOUBLE, mpi_back, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_front, count, MPI_DOUBLE, mpi_front, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall( 2, mpi_req, mpi_stat );
-		
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = ghosts; k < 2*ghosts; k++ ){
-	  u[i][j][k+o] = buf_front[count];
-	  count++;
-	}	
+    MPI_Cart_rank( mpi_comm_cart, mpi_ncoords, &mpi_neighbor );
+
+    MPI_Type_create_subarray( 3, (int*) ghosted, extent, sstart, MPI_ORDER_C, MPI_DOUBLE,
+			      &mpi_send[ntypes] );
+    MPI_Type_commit( &mpi_send[ntypes] );
+    MPI_Type_create_subarray( 3, (int*) ghosted, extent, rstart, MPI_ORDER_C, MPI_DOUBLE,
+			      &mpi_recv[ntypes] );
+    MPI_Type_commit( &mpi_recv[ntypes] );
+
+    MPI_Irecv( (void*) u0, 1, mpi_recv[ntypes], mpi_neighbor, 26-d, mpi_comm_cart,
+	       &mpi_req[mpi_nreqs++] );
+    MPI_Isend( (void*) u0, 1, mpi_send[ntypes], mpi_neighbor, d, mpi_comm_cart,
+	       &mpi_req[mpi_nreqs++] );
+    ntypes++;
   }
 
-  /* Sending ghosts to front neighbor */
-  if( mpi_front == mpi_self ){
-    if( mpi_periods[2] ){
-      for( i = 0; i < m+2*ghosts; i++ )
-	for( j = 0; j < n+2*ghosts; j++ )
-	  for( k = o; k < o+ghosts; k++ )
-	    u[i][j][k-o] = u[i][j][k];
-    }
-  }
-  else{
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = o; k < o+ghosts; k++ ){
-	  buf_front[count] = u[i][j][k];
-	  count++;					
-	}
-    MPI_Isend( (void*) buf_front, count, MPI_DOUBLE, mpi_front, 1, mpi_comm_cart, &mpi_req[0] );
-    MPI_Irecv( (void*) buf_back, count, MPI_DOUBLE, mpi_back, 1, mpi_comm_cart, &mpi_req[1] );
-    MPI_Waitall( 2, mpi_req, mpi_stat );		
-    count = 0;
-    for( i = 0; i < m+2*ghosts; i++ )
-      for( j = 0; j < n+2*ghosts; j++ )
-	for( k = o; k < o+ghosts; k++ ){
-	  u[i][j][k-o] = buf_back[count];
-	  count++;
-	}
-  }
+  MPI_Waitall( mpi_nreqs, mpi_req, MPI_STATUSES_IGNORE );
 
-  /* Freeing memory */
-  free( buf_back );
-  free( buf_front );
+  /* Freeing datatypes */
+  for( i = 0; i < ntypes; i++ ){
+    MPI_Type_free( &mpi_send[i] );
+    MPI_Type_free( &mpi_recv[i] );
+  }
 }
@@ -34,6 +34,8 @@
 namespace fs = boost::filesystem;
 #endif
 
+#include <vector>
+
 #include "base/discretization.hpp"
 #include "base/helper.hpp"
 #include "base/stencil.hpp"
@@ -52,7 +54,6 @@ vmg_float Comm::ComputeResidualNorm(Multigrid& sol_mg, Multigrid& rhs_mg)
   rhs().IsConsistent();
 #endif
 
-  Stencil::iterator stencil_iter;
   vmg_float norm = 0.0;
 
   const vmg_float prefactor = MG::GetDiscretization()->OperatorPrefactor(sol_mg());
@@ -65,17 +66,43 @@ vmg_float Comm::ComputeResidualNorm(Multigrid& sol_mg, Multigrid& rhs_mg)
 
   const Grid& sol = sol_mg();
   const Grid& rhs = rhs_mg();
+  const LocalIndices& l = rhs.Local();
+
+  // Linear offsets of the stencil entries
+  const int num_disp = A.size();
+  std::vector<int> disp(num_disp);
+  std::vector<vmg_float> val(num_disp);
+  for (int n=0; n<num_disp; ++n) {
+    disp[n] = A[n].Disp().Z() + sol.Local().SizeTotal().Z() * (A[n].Disp().Y() + sol.Local().SizeTotal().Y() * A[n].Disp().X());
+    val[n] = prefactor * A[n].Val();
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel if (l.Size().Product() > 32768)
+#endif
+  {
+    std::vector<vmg_float> res(l.Size().Z());
+
+#ifdef _OPENMP
+#pragma omp for reduction(+:norm)
+#endif
+    for (int i=l.Begin().X(); i<l.End().X(); ++i)
+      for (int j=l.Begin().Y(); j<l.End().Y(); ++j) {
+
+	const vmg_float* r = &rhs.GetVal(i,j,l.Begin().Z());
+	const vmg_float* x = &sol.GetVal(i,j,l.Begin().Z());
+
+	for (int k=0; k<l.Size().Z(); ++k)
+	  res[k] = r[k] - prefactor * A.GetDiag() * x[k];
 
-  for (int i=rhs.Local().Begin().X(); i<rhs.Local().End().X(); ++i)
-    for (int j=rhs.Local().Begin().Y(); j<rhs.Local().End().Y(); ++j)
-      for (int k=rhs.Local().Begin().Z(); k<rhs.Local().End().Z(); ++k) {
-	vmg_float val = rhs.GetVal(i,j,k) - prefactor * A.GetDiag() * sol.GetVal(i,j,k);
-	for (stencil_iter=A.begin(); stencil_iter!=A.end(); ++stencil_iter)
-	  val -= prefactor * stencil_iter->Val() * sol.GetVal(i + stencil_iter->Disp().X(),
-							      j + stencil_iter->Disp().Y(),
-							      k + stencil_iter->Disp().Z());
-	norm += val*val;
+	for (int n=0; n<num_disp; ++n)
+	  for (int k=0; k<l.Size().Z(); ++k)
+	    res[k] -= val[n] * x[k+disp[n]];
+
+	for (int k=0; k<l.Size().Z(); ++k)
+	  norm += res[k]*res[k];
       }
+  }
 
   norm = GlobalSum(norm);
   norm = std::sqrt(sol.Extent().MeshWidth().Product() * norm);
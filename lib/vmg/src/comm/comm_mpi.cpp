@@ -944,10 +944,6 @@ void CommMPI::InitCommMPI(const MPI_Comm& comm)
 CommMPI::~CommMPI()
 {
   MPI_Comm_free(&comm_global);
-#ifdef VMG_ONE_SIDED
-  if (win_created)
-    MPI_Win_free(&win);
-#endif
   MPI_Info_free(&info);
 }
 
@@ -55,18 +55,12 @@ class CommMPI : public Comm, public HasTempGrids, public HasRequestVec
 public:
   CommMPI(const Boundary& boundary, DomainDecomposition* domain_dec, const MPI_Comm& mpi_comm, bool register_ = true) :
     Comm(boundary, domain_dec, register_)
-#ifdef VMG_ONE_SIDED
-    ,win_created(false)
-#endif
   {
     InitCommMPI(mpi_comm);
   }
 
   CommMPI(const Boundary& boundary, DomainDecomposition* domain_dec, bool register_ = true) :
     Comm(boundary, domain_dec, register_)
-#ifdef VMG_ONE_SIDED
-    ,win_created(false)
-#endif
   {
     InitCommMPI(MPI_COMM_WORLD);
   }
@@ -182,12 +176,6 @@ protected:
 
   MPI_Comm comm_global;
   MPI_Info info;
-
-#ifdef VMG_ONE_SIDED
-  bool win_created;
-  MPI_Win win;
-#endif
-
 };
 
 }
@@ -60,7 +60,7 @@ void DomainDecompositionMPI::Compute(Comm* comm, const Interface* interface, std
     global_l.GlobalSize() = interface->Global()[i].GlobalSize();
     global_l.BoundaryType() = interface->Global()[i].BoundaryType();
 
-    if (IsActive(comm, global_l.GlobalSize(), procs)) {
+    if (IsActive(comm, global_l.GlobalSize(), procs, i > 0)) {
 
       if (i == 0) {
 
@@ -143,18 +143,30 @@ void DomainDecompositionMPI::Compute(Comm* comm, const Interface* interface, std
   }
 }
 
-bool DomainDecompositionMPI::IsActive(Comm* comm, const Index& size_global, Index& procs)
+bool DomainDecompositionMPI::IsActive(Comm* comm, const Index& size_global, Index& procs, bool agglomerate)
 {
   bool is_active = true;
   const int points_min = 5;
 
   procs = size_global / points_min + 1;
 
-  for (int i=0; i<3; ++i) {
+  for (int i=0; i<3; ++i)
     procs[i] = std::min(procs[i], comm->GlobalProcs()[i]);
-    is_active &= comm->GlobalPos()[i] < procs[i];
+
+  /*
+   * Agglomerate coarse levels onto fewer processes until each of them
+   * holds enough points. Halving the largest process dimension first
+   * keeps the active processes of a coarser level a subset of the
+   * active processes of the finer level.
+   */
+  while (agglomerate && procs.Product() > 1 && size_global.Product() < coarse_points * procs.Product()) {
+    const int dim = (procs[0] >= procs[1] && procs[0] >= procs[2]) ? 0 : (procs[1] >= procs[2] ? 1 : 2);
+    procs[dim] = (procs[dim] + 1) / 2;
   }
 
+  for (int i=0; i<3; ++i)
+    is_active &= comm->GlobalPos()[i] < procs[i];
+
   return is_active;
 }
 
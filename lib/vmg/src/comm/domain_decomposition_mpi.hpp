@@ -39,11 +39,17 @@ class Index;
 class DomainDecompositionMPI : public DomainDecomposition
 {
 public:
+  DomainDecompositionMPI(int coarse_points_ = 0) :
+    coarse_points(coarse_points_)
+  {}
+
   void Compute(Comm* comm, const Interface* interface, std::vector<GlobalIndices>& global);
 
 private:
-  bool IsActive(Comm* comm, const Index& size_global, Index& procs);
+  bool IsActive(Comm* comm, const Index& size_global, Index& procs, bool agglomerate);
   void FineToCoarse(Comm* comm, int& begin, int& end, int levels);
+
+  int coarse_points; ///< Minimum number of grid points per process on the coarse levels
 };
 
 }
@@ -94,10 +94,14 @@ void VMG::MPI::Settings::ComputeSettings(Multigrid& sol, Multigrid& rhs, MPI_Com
     TempGrid* temp_grid = new TempGrid();
     temp_grid->SetPropertiesToCoarser(sol(i), comm.BoundaryConditions());
 
-    if (temp_grid->Global().LocalBegin().IsComponentwiseGreaterOrEqual(sol(i-1).Global().LocalBegin()) &&
-	temp_grid->Global().LocalBegin().IsComponentwiseLessOrEqual(sol(i-1).Global().LocalEnd()) &&
-	temp_grid->Global().LocalEnd().IsComponentwiseGreaterOrEqual(sol(i-1).Global().LocalBegin()) &&
-	temp_grid->Global().LocalEnd().IsComponentwiseLessOrEqual(sol(i-1).Global().LocalEnd())) {
+    /*
+     * Only reuse the coarse grid if it matches exactly. If the coarse level
+     * is agglomerated onto fewer processes, the coarse grid merely contains
+     * the coarsened part and aliasing it would make the transfer datatypes
+     * of restriction and prolongation indistinguishable.
+     */
+    if (temp_grid->Global().LocalBegin() == sol(i-1).Global().LocalBegin() &&
+	temp_grid->Global().LocalEnd() == sol(i-1).Global().LocalEnd()) {
       delete temp_grid;
       coarser_grids.insert(std::make_pair(&sol(i), &sol(i-1)));
     }else {
@@ -111,10 +115,14 @@ void VMG::MPI::Settings::ComputeSettings(Multigrid& sol, Multigrid& rhs, MPI_Com
     TempGrid* temp_grid = new TempGrid();
     temp_grid->SetPropertiesToCoarser(rhs(i), comm.BoundaryConditions());
 
-    if (temp_grid->Global().LocalBegin().IsComponentwiseGreaterOrEqual(sol(i-1).Global().LocalBegin()) &&
-	temp_grid->Global().LocalBegin().IsComponentwiseLessOrEqual(sol(i-1).Global().LocalEnd()) &&
-	temp_grid->Global().LocalEnd().IsComponentwiseGreaterOrEqual(sol(i-1).Global().LocalBegin()) &&
-	temp_grid->Global().LocalEnd().IsComponentwiseLessOrEqual(sol(i-1).Global().LocalEnd())) {
+    /*
+     * Only reuse the coarse grid if it matches exactly. If the coarse level
+     * is agglomerated onto fewer processes, the coarse grid merely contains
+     * the coarsened part and aliasing it would make the transfer datatypes
+     * of restriction and prolongation indistinguishable.
+     */
+    if (temp_grid->Global().LocalBegin() == rhs(i-1).Global().LocalBegin() &&
+	temp_grid->Global().LocalEnd() == rhs(i-1).Global().LocalEnd()) {
       delete temp_grid;
       coarser_grids.insert(std::make_pair(&rhs(i), &rhs(i-1)));
     }else {
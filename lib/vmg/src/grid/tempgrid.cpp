@@ -29,6 +29,8 @@
 #include <config.h>
 #endif
 
+#include <vector>
+
 #include "base/discretization.hpp"
 #include "base/interface.hpp"
 #include "base/stencil.hpp"
@@ -314,17 +316,44 @@ void TempGrid::SetPropertiesToCoarser(const Grid& grid, const Boundary& boundary
 
 void TempGrid::ImportFromResidual(Grid& sol, Grid& rhs)
 {
-  Grid::iterator iter;
-
   const vmg_float prefactor = MG::GetDiscretization()->OperatorPrefactor(sol);
   const Stencil& A = MG::GetDiscretization()->GetStencil();
+  const LocalIndices& l = Local();
 
   this->Clear();
 
   MG::GetComm()->CommToGhosts(sol);
 
-  for (iter=Iterators().Local().Begin(); iter!=Iterators().Local().End(); ++iter)
-    (*this)(*iter) = rhs.GetVal(*iter) - prefactor * A.Apply(sol, *iter);
+  // Linear offsets of the stencil entries
+  const int num_disp = A.size();
+  std::vector<int> disp(num_disp);
+  std::vector<vmg_float> val(num_disp);
+  for (int n=0; n<num_disp; ++n) {
+    disp[n] = A[n].Disp().Z() + sol.Local().SizeTotal().Z() * (A[n].Disp().Y() + sol.Local().SizeTotal().Y() * A[n].Disp().X());
+    val[n] = A[n].Val();
+  }
+
+  // The rows are accumulated one stencil entry at a time, so that the inner loops are contiguous
+#ifdef _OPENMP
+#pragma omp parallel for if (l.Size().Product() > 32768)
+#endif
+  for (int i=l.Begin().X(); i<l.End().X(); ++i)
+    for (int j=l.Begin().Y(); j<l.End().Y(); ++j) {
+
+      vmg_float* res = &(*this)(i,j,0);
+      const vmg_float* r = &rhs.GetVal(i,j,0);
+      const vmg_float* x = &sol.GetVal(i,j,0);
+
+      for (int k=l.Begin().Z(); k<l.End().Z(); ++k)
+	res[k] = A.GetDiag() * x[k];
+
+      for (int n=0; n<num_disp; ++n)
+	for (int k=l.Begin().Z(); k<l.End().Z(); ++k)
+	  res[k] += val[n] * x[k+disp[n]];
+
+      for (int k=l.Begin().Z(); k<l.End().Z(); ++k)
+	res[k] = r[k] - prefactor * res[k];
+    }
 }
 
 void TempGrid::Allocate()
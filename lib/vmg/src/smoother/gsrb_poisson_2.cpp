@@ -36,132 +36,40 @@
 #endif
 
 #include "base/helper.hpp"
-#include "comm/comm.hpp"
 #include "grid/grid.hpp"
 #include "smoother/gsrb_poisson_2.hpp"
-#include "mg.hpp"
+#include "smoother/gsrb_sweep.hpp"
 
 using namespace VMG;
 
-static inline void ComputePartial(Grid& sol, Grid& rhs,
-				  const Index& begin, const Index& end,
-				  const vmg_float& prefactor, const int& off)
+static void ComputePartial(Grid& sol, Grid& rhs,
+			   const Index& begin, const Index& end,
+			   const vmg_float& prefactor, const int& off)
 {
   const vmg_float fac = 1.0 / 6.0;
 
+  // Offsets of the neighbors in x- and y-direction
+  const int dy = sol.Local().SizeTotal().Z();
+  const int dx = sol.Local().SizeTotal().Y() * dy;
+
   for (int i=begin.X(); i<end.X(); ++i)
-    for (int j=begin.Y(); j<end.Y(); ++j)
+    for (int j=begin.Y(); j<end.Y(); ++j) {
+      vmg_float* s = &sol(i,j,0);
+      const vmg_float* r = &rhs.GetVal(i,j,0);
       for (int k=begin.Z() + (i + j + begin.Z() + off) % 2; k<end.Z(); k+=2)
-	sol(i,j,k) = prefactor * rhs.GetVal(i,j,k) + fac * (sol.GetVal(i-1,j  ,k  ) +
-							    sol.GetVal(i+1,j  ,k  ) +
-							    sol.GetVal(i  ,j-1,k  ) +
-							    sol.GetVal(i  ,j+1,k  ) +
-							    sol.GetVal(i  ,j  ,k-1) +
-							    sol.GetVal(i  ,j  ,k+1));
+	s[k] = prefactor * r[k] + fac * (s[k-dx] +
+					 s[k+dx] +
+					 s[k-dy] +
+					 s[k+dy] +
+					 s[k-1] +
+					 s[k+1]);
+    }
 }
 
 void GaussSeidelRBPoisson2::Compute(Grid& sol, Grid& rhs)
 {
   const vmg_float prefactor_inv = Helper::pow_2(sol.Extent().MeshWidth().Max()) / 6.0;
   const int off = rhs.Global().LocalBegin().Sum() - rhs.Local().HaloSize1().Sum();
-  const LocalIndices& local = rhs.Local();
-  Comm& comm = *MG::GetComm();
-
-  /*
-   * Compute first halfstep
-   */
-
-  // Start asynchronous communication
-  comm.CommToGhostsAsyncStart(sol);
-
-  // Smooth part not depending on ghost cells
-  ComputePartial(sol, rhs,
-		 local.Begin()+1, local.End()-1,
-		 prefactor_inv, off+1);
-
-  // Finish asynchronous communication
-  comm.CommToGhostsAsyncFinish(sol);
-
-  /*
-   * Smooth near boundary cells
-   */
-
-  ComputePartial(sol, rhs,
-		 local.Begin(),
-		 Index(local.Begin().X()+1, local.End().Y(), local.End().Z()),
-		 prefactor_inv, off+1);
-
-  ComputePartial(sol, rhs,
-		 Index(local.End().X()-1, local.Begin().Y(), local.Begin().Z()),
-		 local.End(),
-		 prefactor_inv, off+1);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y(), local.Begin().Z()),
-		 Index(local.End().X()-1, local.Begin().Y()+1, local.End().Z()),
-		 prefactor_inv, off+1);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.End().Y()-1, local.Begin().Z()),
-		 Index(local.End().X()-1, local.End().Y(), local.End().Z()),
-		 prefactor_inv, off+1);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y()+1, local.Begin().Z()),
-		 Index(local.End().X()-1, local.End().Y()-1, local.Begin().Z()+1),
-		 prefactor_inv, off+1);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y()+1, local.End().Z()-1),
-		 Index(local.End().X()-1, local.End().Y()-1, local.End().Z()),
-		 prefactor_inv, off+1);
-
-  /*
-   * Compute second halfstep
-   */
-
-  // Start asynchronous communication
-  comm.CommToGhostsAsyncStart(sol);
-
-  // Smooth part not depending on ghost cells
-  ComputePartial(sol, rhs,
-		 local.Begin()+1, local.End()-1,
-		 prefactor_inv, off);
-
-  // Finish asynchronous communication
-  comm.CommToGhostsAsyncFinish(sol);
-
-  /*
-   * Smooth near boundary cells
-   */
-
-  ComputePartial(sol, rhs,
-		 local.Begin(),
-		 Index(local.Begin().X()+1, local.End().Y(), local.End().Z()),
-		 prefactor_inv, off);
-
-  ComputePartial(sol, rhs,
-		 Index(local.End().X()-1, local.Begin().Y(), local.Begin().Z()),
-		 local.End(),
-		 prefactor_inv, off);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y(), local.Begin().Z()),
-		 Index(local.End().X()-1, local.Begin().Y()+1, local.End().Z()),
-		 prefactor_inv, off);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.End().Y()-1, local.Begin().Z()),
-		 Index(local.End().X()-1, local.End().Y(), local.End().Z()),
-		 prefactor_inv, off);
-
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y()+1, local.Begin().Z()),
-		 Index(local.End().X()-1, local.End().Y()-1, local.Begin().Z()+1),
-		 prefactor_inv, off);
 
-  ComputePartial(sol, rhs,
-		 Index(local.Begin().X()+1, local.Begin().Y()+1, local.End().Z()-1),
-		 Index(local.End().X()-1, local.End().Y()-1, local.End().Z()),
-		 prefactor_inv, off);
+  GaussSeidelRBSweep(sol, rhs, ComputePartial, prefactor_inv, off);
 }
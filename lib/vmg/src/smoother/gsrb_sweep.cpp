@@ -0,0 +1,230 @@
+/*
+ *    vmg - a versatile multigrid solver
+ *    Copyright (C) 2012 Institute for Numerical Simulation, University of Bonn
+ *
+ *  vmg is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  vmg is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   gsrb_sweep.cpp
+ * @date   Sat Oct 17 09:12:41 2026
+ *
+ * @brief  Schedule of a red-black Gauss-Seidel step shared by the
+ *         specialized Poisson smoothers.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
+#include "comm/comm.hpp"
+#include "grid/grid.hpp"
+#include "smoother/gsrb_sweep.hpp"
+#include "mg.hpp"
+
+using namespace VMG;
+
+/* Minimal number of grid points per thread */
+#define GSRB_POINTS_PER_THREAD 16384
+
+/*
+ * Updates the points of one color on the boundary layer of the box
+ * [begin, end), i.e., on all points of the box not contained in
+ * [begin+1, end-1).
+ */
+static void ComputeShell(Grid& sol, Grid& rhs, GSRBKernel kernel,
+			 const Index& begin, const Index& end,
+			 const vmg_float& prefactor, const int& off)
+{
+  kernel(sol, rhs,
+	 begin,
+	 Index(begin.X()+1, end.Y(), end.Z()),
+	 prefactor, off);
+
+  kernel(sol, rhs,
+	 Index(end.X()-1, begin.Y(), begin.Z()),
+	 end,
+	 prefactor, off);
+
+  kernel(sol, rhs,
+	 Index(begin.X()+1, begin.Y(), begin.Z()),
+	 Index(end.X()-1, begin.Y()+1, end.Z()),
+	 prefactor, off);
+
+  kernel(sol, rhs,
+	 Index(begin.X()+1, end.Y()-1, begin.Z()),
+	 Index(end.X()-1, end.Y(), end.Z()),
+	 prefactor, off);
+
+  kernel(sol, rhs,
+	 Index(begin.X()+1, begin.Y()+1, begin.Z()),
+	 Index(end.X()-1, end.Y()-1, begin.Z()+1),
+	 prefactor, off);
+
+  kernel(sol, rhs,
+	 Index(begin.X()+1, begin.Y()+1, end.Z()-1),
+	 Index(end.X()-1, end.Y()-1, end.Z()),
+	 prefactor, off);
+}
+
+/*
+ * Updates the red points of plane red if it belongs to the interior.
+ * Afterwards, the black points of plane black are updated if it belongs
+ * to the deep interior.
+ */
+static inline void ComputeWavefront(Grid& sol, Grid& rhs, GSRBKernel kernel,
+				    const Index& begin, const Index& end,
+				    const int& red, const int& black,
+				    const vmg_float& prefactor, const int& off)
+{
+  if (red >= begin.X()+1 && red < end.X()-1)
+    kernel(sol, rhs,
+	   Index(red, begin.Y()+1, begin.Z()+1),
+	   Index(red+1, end.Y()-1, end.Z()-1),
+	   prefactor, off+1);
+
+  if (black >= begin.X()+2 && black < end.X()-2)
+    kernel(sol, rhs,
+	   Index(black, begin.Y()+2, begin.Z()+2),
+	   Index(black+1, end.Y()-2, end.Z()-2),
+	   prefactor, off);
+}
+
+/*
+ * Red half step on the interior [begin+1, end-1) fused with the black
+ * half step on the deep interior [begin+2, end-2). The black points of
+ * a plane are updated as soon as the red points of both neighboring
+ * planes are done.
+ */
+static void ComputeInterior(Grid& sol, Grid& rhs, GSRBKernel kernel,
+			    const Index& begin, const Index& end,
+			    const vmg_float& prefactor, const int& off)
+{
+  const int planes_begin = begin.X()+1;
+  const int planes_end = end.X()-1;
+
+#ifdef _OPENMP
+  const int points = (end - begin).Product();
+  const int max_threads = std::min(omp_get_max_threads(), (planes_end - planes_begin) / 2);
+
+#pragma omp parallel if (max_threads > 1 && points > 2 * GSRB_POINTS_PER_THREAD) num_threads(std::max(max_threads, 1))
+  {
+    const int num_chunks = 2 * omp_get_num_threads();
+    const int thread = omp_get_thread_num();
+    int chunk_begin[2], chunk_end[2];
+
+    /* Thread t handles chunk 2t in the first and chunk 2t+1 in the second phase */
+    for (int p=0; p<2; ++p) {
+      chunk_begin[p] = planes_begin + static_cast<long>(planes_end - planes_begin) * (2*thread+p) / num_chunks;
+      chunk_end[p] = planes_begin + static_cast<long>(planes_end - planes_begin) * (2*thread+p+1) / num_chunks;
+    }
+
+    /* First phase: the black points of the outer planes need red points of the neighboring chunks */
+    for (int i=chunk_begin[0]; i<chunk_end[0]; ++i)
+      ComputeWavefront(sol, rhs, kernel, begin, end, i, (i-1 > chunk_begin[0] ? i-1 : planes_begin-1), prefactor, off);
+
+#pragma omp barrier
+
+    /* Second phase: the red points of both neighboring chunks are done */
+    for (int i=chunk_begin[1]; i<chunk_end[1]; ++i)
+      ComputeWavefront(sol, rhs, kernel, begin, end, i, (i-1 >= chunk_begin[1] ? i-1 : planes_begin-1), prefactor, off);
+    if (chunk_end[1] > chunk_begin[1])
+      ComputeWavefront(sol, rhs, kernel, begin, end, planes_begin-1, chunk_end[1]-1, prefactor, off);
+
+#pragma omp barrier
+
+    if (chunk_end[0] > chunk_begin[0]) {
+      ComputeWavefront(sol, rhs, kernel, begin, end, planes_begin-1, chunk_begin[0], prefactor, off);
+      if (chunk_end[0]-1 > chunk_begin[0])
+	ComputeWavefront(sol, rhs, kernel, begin, end, planes_begin-1, chunk_end[0]-1, prefactor, off);
+    }
+  }
+#else
+  for (int i=planes_begin; i<planes_end; ++i)
+    ComputeWavefront(sol, rhs, kernel, begin, end, i, i-1, prefactor, off);
+#endif
+}
+
+void VMG::GaussSeidelRBSweep(Grid& sol, Grid& rhs, GSRBKernel kernel,
+			     const vmg_float& prefactor, const int& off)
+{
+  const LocalIndices& local = rhs.Local();
+  Comm& comm = *MG::GetComm();
+
+  if (local.Size().Min() < 5) {
+
+    /*
+     * Small grids: both half steps one after the other
+     */
+    for (int step=1; step>=0; --step) {
+
+      // Start asynchronous communication
+      comm.CommToGhostsAsyncStart(sol);
+
+      // Smooth part not depending on ghost cells
+      kernel(sol, rhs,
+	     local.Begin()+1, local.End()-1,
+	     prefactor, off+step);
+
+      // Finish asynchronous communication
+      comm.CommToGhostsAsyncFinish(sol);
+
+      // Smooth near boundary cells
+      ComputeShell(sol, rhs, kernel, local.Begin(), local.End(), prefactor, off+step);
+    }
+
+    return;
+  }
+
+  /*
+   * Red half step on the interior and black half step on the deep
+   * interior, overlapped with the exchange of the black ghost cells
+   */
+  comm.CommToGhostsAsyncStart(sol);
+
+  ComputeInterior(sol, rhs, kernel, local.Begin(), local.End(), prefactor, off);
+
+  comm.CommToGhostsAsyncFinish(sol);
+
+  /*
+   * Finish the red half step near the boundary
+   */
+  ComputeShell(sol, rhs, kernel, local.Begin(), local.End(), prefactor, off+1);
+
+  /*
+   * Black half step on the remaining interior, overlapped with the
+   * exchange of the red ghost cells
+   */
+  comm.CommToGhostsAsyncStart(sol);
+
+  ComputeShell(sol, rhs, kernel, local.Begin()+1, local.End()-1, prefactor, off);
+
+  comm.CommToGhostsAsyncFinish(sol);
+
+  /*
+   * Finish the black half step near the boundary
+   */
+  ComputeShell(sol, rhs, kernel, local.Begin(), local.End(), prefactor, off);
+}
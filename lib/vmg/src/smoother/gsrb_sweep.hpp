@@ -0,0 +1,61 @@
+/*
+ *    vmg - a versatile multigrid solver
+ *    Copyright (C) 2012 Institute for Numerical Simulation, University of Bonn
+ *
+ *  vmg is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  vmg is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   gsrb_sweep.hpp
+ * @date   Sat Oct 17 09:12:41 2026
+ *
+ * @brief  Schedule of a red-black Gauss-Seidel step shared by the
+ *         specialized Poisson smoothers.
+ *
+ */
+
+#ifndef GSRB_SWEEP_HPP_
+#define GSRB_SWEEP_HPP_
+
+#include "base/defs.hpp"
+
+namespace VMG
+{
+
+class Grid;
+class Index;
+
+/**
+ * Updates all points of one color within the box [begin, end). The
+ * color is selected by off as in (i+j+k+off) % 2 == 0.
+ */
+typedef void (*GSRBKernel)(Grid& sol, Grid& rhs,
+			   const Index& begin, const Index& end,
+			   const vmg_float& prefactor, const int& off);
+
+/**
+ * Performs one red and one black half step with the given kernel.
+ *
+ * On grids large enough, both half steps are done in a single pass
+ * over the interior: the black points of plane i-1 are updated right
+ * after the red points of plane i, while the ghost cells are exchanged.
+ * With OpenMP the planes are split into chunks, alternately handled in
+ * two phases, so that neighboring chunks are never updated concurrently.
+ */
+void GaussSeidelRBSweep(Grid& sol, Grid& rhs, GSRBKernel kernel,
+			const vmg_float& prefactor, const int& off);
+
+}
+
+#endif /* GSRB_SWEEP_HPP_ */
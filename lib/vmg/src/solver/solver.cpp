@@ -45,6 +45,7 @@ void Solver::Run(Grid& sol, Grid& rhs)
 #endif
 
   if (rhs.Global().LocalSize().Product() > 0) {
+    this->GatherRhs(rhs);
     this->Realloc(rhs);
     this->AssembleMatrix(rhs);
     this->Compute();
@@ -52,6 +53,33 @@ void Solver::Run(Grid& sol, Grid& rhs)
   }
 }
 
+void Solver::GatherRhs(const Grid& rhs)
+{
+  Index i, offset;
+  int index;
+
+  const int n = rhs.Global().GlobalSize().Product();
+
+  // Values are stored in the first half, boundary flags in the second half
+  rhs_global.assign(2*n, 0.0);
+
+  // Local index of the first grid point owned by this process
+  for (int j=0; j<3; ++j)
+    offset[j] = (rhs.Local().HaloSize1()[j] > 0 ? rhs.Local().Begin()[j] : 0);
+
+  for (i.X()=0; i.X()<rhs.Global().LocalSize().X(); ++i.X())
+    for (i.Y()=0; i.Y()<rhs.Global().LocalSize().Y(); ++i.Y())
+      for (i.Z()=0; i.Z()<rhs.Global().LocalSize().Z(); ++i.Z()) {
+	index = rhs.GlobalLinearIndex(rhs.Global().LocalBegin() + i);
+	rhs_global[index] = rhs.GetVal(offset + i);
+	if (!(offset + i).IsInBounds(rhs.Local().Begin(), rhs.Local().End()))
+	  rhs_global[n+index] = 1.0;
+      }
+
+  // The coarse levels live on few processes only, so a dense reduction is cheap here
+  MG::GetComm()->LevelSumArray(rhs, &rhs_global.front(), 2*n);
+}
+
 void Solver::Realloc(int n)
 {
   //Reallocate memory if necessary
@@ -82,11 +82,21 @@ public:
 protected:
   virtual void Compute() = 0; ///< Solves the system of equations
 
+  /**
+   * Right hand side and boundary flag of the whole level, gathered
+   * from all processes holding a part of it.
+   */
+  const vmg_float& RhsGlobal(int i) const {return rhs_global[i];}
+  bool IsBoundaryGlobal(int i) const {return rhs_global[rhs_global.size()/2+i] != 0.0;}
+
 private:
   virtual void AssembleMatrix(const Grid& rhs) = 0; ///< Assembles all matrices and vectors.
   virtual void ExportSol(Grid& sol, Grid& rhs) = 0; ///< Exports the solution back to a given mesh.
 
+  void GatherRhs(const Grid& rhs); ///< Agglomerates the right hand side on all processes of the level.
+
   std::vector<vmg_float> A, b, x;
+  std::vector<vmg_float> rhs_global;
   int size;
 };
 
@@ -39,13 +39,11 @@
 
 using namespace VMG;
 
-// TODO: Implement global communication here
 // TODO: Implement this more efficiently
-// TODO: This has to be reviewed for parallelization
 
 void SolverRegular::AssembleMatrix(const Grid& rhs)
 {
-  Grid::iterator grid_iter;
+  Index i;
   Stencil::iterator stencil_iter;
   int mat_index, mat_index2;
   vmg_float prefactor_inv = 1.0 / MG::GetDiscretization()->OperatorPrefactor(rhs);
@@ -57,65 +55,41 @@ void SolverRegular::AssembleMatrix(const Grid& rhs)
 
   this->Realloc(rhs.Global().GlobalSize().Product());
 
-  for (grid_iter = rhs.Iterators().Local().Begin(); grid_iter != rhs.Iterators().Local().End(); ++grid_iter) {
+  for (i.X()=0; i.X()<rhs.Global().GlobalSize().X(); ++i.X())
+    for (i.Y()=0; i.Y()<rhs.Global().GlobalSize().Y(); ++i.Y())
+      for (i.Z()=0; i.Z()<rhs.Global().GlobalSize().Z(); ++i.Z()) {
 
-    mat_index = rhs.GlobalLinearIndex(*grid_iter + rhs.Global().LocalBegin());
+	mat_index = rhs.GlobalLinearIndex(i);
 
-    assert(mat_index >= 0 && mat_index<this->Size());
+	assert(mat_index >= 0 && mat_index<this->Size());
 
-    this->Sol(mat_index) = 0.0;
-    this->Rhs(mat_index) = prefactor_inv * rhs.GetVal(*grid_iter);
+	for (int l=0; l<this->Size(); l++)
+	  this->Mat(mat_index, l) = 0.0;
 
-    for (int l=0; l<this->Size(); l++)
-      this->Mat(mat_index, l) = 0.0;
+	if (this->IsBoundaryGlobal(mat_index)) {
 
-    this->Mat(mat_index, mat_index) = A.GetDiag();
+	  this->Sol(mat_index) = this->Rhs(mat_index) = this->RhsGlobal(mat_index);
 
-    for (stencil_iter = A.begin(); stencil_iter != A.end(); ++stencil_iter) {
+	  this->Mat(mat_index, mat_index) = 1.0;
 
-      mat_index2 = rhs.GlobalLinearIndex(*grid_iter + rhs.Global().LocalBegin() + stencil_iter->Disp());
+	}else {
 
-      assert(mat_index2 >= 0 && mat_index2<this->Size());
+	  this->Sol(mat_index) = 0.0;
+	  this->Rhs(mat_index) = prefactor_inv * this->RhsGlobal(mat_index);
 
-      this->Mat(mat_index, mat_index2) += stencil_iter->Val();
+	  this->Mat(mat_index, mat_index) = A.GetDiag();
 
-    }
-  }
-
-  for (int i=0; i<3; ++i) {
-
-    for (grid_iter = rhs.Iterators().Boundary1()[i].Begin(); grid_iter != rhs.Iterators().Boundary1()[i].End(); ++grid_iter) {
-
-      mat_index = rhs.GlobalLinearIndex(*grid_iter + rhs.Global().LocalBegin());
-
-      assert(mat_index >= 0 && mat_index<this->Size());
-
-      this->Sol(mat_index) = this->Rhs(mat_index) = rhs.GetVal(*grid_iter);
-
-      for (int l=0; l<this->Size(); l++)
-	this->Mat(mat_index, l) = 0.0;
-
-      this->Mat(mat_index, mat_index) = 1.0;
+	  for (stencil_iter = A.begin(); stencil_iter != A.end(); ++stencil_iter) {
 
-    }
+	    mat_index2 = rhs.GlobalLinearIndex(i + stencil_iter->Disp());
 
-    for (grid_iter = rhs.Iterators().Boundary2()[i].Begin(); grid_iter != rhs.Iterators().Boundary2()[i].End(); ++grid_iter) {
+	    assert(mat_index2 >= 0 && mat_index2<this->Size());
 
-      mat_index = rhs.GlobalLinearIndex(*grid_iter + rhs.Global().LocalBegin());
-
-      assert(mat_index >= 0 && mat_index<this->Size());
-
-      this->Sol(mat_index) = this->Rhs(mat_index) = rhs.GetVal(*grid_iter);
-
-      for (int l=0; l<this->Size(); l++)
-	this->Mat(mat_index, l) = 0.0;
-
-      this->Mat(mat_index, mat_index) = 1.0;
-
-    }
-
-  }
+	    this->Mat(mat_index, mat_index2) += stencil_iter->Val();
 
+	  }
+	}
+      }
 }
 
 void SolverRegular::ExportSol(Grid& sol, Grid& rhs)
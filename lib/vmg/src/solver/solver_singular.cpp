@@ -43,13 +43,10 @@
 
 using namespace VMG;
 
-//TODO: Implement global MPI communication here
-
 void SolverSingular::AssembleMatrix(const Grid& rhs)
 {
-  Grid::iterator grid_iter;
   Stencil::iterator stencil_iter;
-  Index i;
+  Index g, i;
   int index, index2;
   vmg_float row_sum;
 
@@ -61,43 +58,45 @@ void SolverSingular::AssembleMatrix(const Grid& rhs)
   // Make sure that arrays are big enough to hold expanded system of equations
   this->Realloc(rhs.Global().GlobalSize().Product() + 1);
 
-  for (grid_iter = rhs.Iterators().Local().Begin(); grid_iter != rhs.Iterators().Local().End(); ++grid_iter) {
+  for (g.X()=0; g.X()<rhs.Global().GlobalSize().X(); ++g.X())
+    for (g.Y()=0; g.Y()<rhs.Global().GlobalSize().Y(); ++g.Y())
+      for (g.Z()=0; g.Z()<rhs.Global().GlobalSize().Z(); ++g.Z()) {
 
-    // Compute 1-dimensional index from 3-dimensional grid
-    index = rhs.GlobalLinearIndex(*grid_iter - rhs.Local().Begin() + rhs.Global().LocalBegin());
+	// Compute 1-dimensional index from 3-dimensional grid
+	index = rhs.GlobalLinearIndex(g);
 
-    // Check if we computed the index correctly
-    assert(index >= 0 && index < this->Size()-1);
+	// Check if we computed the index correctly
+	assert(index >= 0 && index < this->Size()-1);
 
-    // Set solution and right hand side vectors
-    this->Sol(index) = 0.0;
-    this->Rhs(index) = rhs.GetVal(*grid_iter);
+	// Set solution and right hand side vectors
+	this->Sol(index) = 0.0;
+	this->Rhs(index) = this->RhsGlobal(index);
 
-    // Initialize matrix with zeros and then set entries according to the stencil
-    for (int l=0; l<this->Size(); l++)
-      this->Mat(index,l) = 0.0;
+	// Initialize matrix with zeros and then set entries according to the stencil
+	for (int l=0; l<this->Size(); l++)
+	  this->Mat(index,l) = 0.0;
 
-    this->Mat(index,index) = prefactor * A.GetDiag();
+	this->Mat(index,index) = prefactor * A.GetDiag();
 
-    for (stencil_iter = A.begin(); stencil_iter != A.end(); ++stencil_iter) {
+	for (stencil_iter = A.begin(); stencil_iter != A.end(); ++stencil_iter) {
 
-      i = *grid_iter - rhs.Local().Begin() + rhs.Global().LocalBegin() + stencil_iter->Disp();
+	  i = g + stencil_iter->Disp();
 
-      for (int j=0; j<3; ++j)
-	if (comm->BoundaryConditions()[j] == Periodic) {
-	  if (i[j] < 0)
-	    i[j] += rhs.Global().GlobalSize()[j];
-	  else if (i[j] >= rhs.Global().GlobalSize()[j])
-	    i[j] -= rhs.Global().GlobalSize()[j];
-	}
+	  for (int j=0; j<3; ++j)
+	    if (comm->BoundaryConditions()[j] == Periodic) {
+	      if (i[j] < 0)
+		i[j] += rhs.Global().GlobalSize()[j];
+	      else if (i[j] >= rhs.Global().GlobalSize()[j])
+		i[j] -= rhs.Global().GlobalSize()[j];
+	    }
 
-      // Compute global 1-dimensional index
-      index2 = rhs.GlobalLinearIndex(i);
+	  // Compute global 1-dimensional index
+	  index2 = rhs.GlobalLinearIndex(i);
 
-      // Set matrix entry
-      this->Mat(index,index2) += prefactor * stencil_iter->Val();
-    }
-  }
+	  // Set matrix entry
+	  this->Mat(index,index2) += prefactor * stencil_iter->Val();
+	}
+      }
 
   // Check if matrix has zero row sum (i.e. (1,1,...,1) is an Eigenvector to the Eigenvalue 0)
   row_sum = A.GetDiag();
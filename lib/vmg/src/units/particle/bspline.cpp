@@ -54,7 +54,8 @@ Particle::BSpline::BSpline(const int& near_field_cells, const vmg_float& h) :
   field_denom((BSPLINE_DEGREE+1)/2),
   intervals((BSPLINE_DEGREE+1)/2),
   R(near_field_cells*h),
-  near_field_cells(near_field_cells)
+  near_field_cells(near_field_cells),
+  spline_vals(Helper::intpow(2*near_field_cells+1,3))
 {
   for (unsigned int i=0; i<intervals.size(); ++i)
     intervals[i] = R * ( -1.0 + 2.0 / static_cast<vmg_float>(BSPLINE_DEGREE) * (i + BSPLINE_DEGREE/2 + 1));
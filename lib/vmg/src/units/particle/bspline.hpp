@@ -56,19 +56,24 @@ public:
 
   void SetSpline(Grid& grid, const Particle& p) const
   {
-    assert(p.Pos().X() >= grid.Extent().Begin().X() && p.Pos().X() < grid.Extent().End().X());
-    assert(p.Pos().Y() >= grid.Extent().Begin().Y() && p.Pos().Y() < grid.Extent().End().Y());
-    assert(p.Pos().Z() >= grid.Extent().Begin().Z() && p.Pos().Z() < grid.Extent().End().Z());
+    SetSpline(grid, p.Pos().X(), p.Pos().Y(), p.Pos().Z(), p.Charge());
+  }
+
+  void SetSpline(Grid& grid, const vmg_float& x, const vmg_float& y, const vmg_float& z, const vmg_float& q) const
+  {
+    assert(x >= grid.Extent().Begin().X() && x < grid.Extent().End().X());
+    assert(y >= grid.Extent().Begin().Y() && y < grid.Extent().End().Y());
+    assert(z >= grid.Extent().Begin().Z() && z < grid.Extent().End().Z());
 
-    vmg_float* vals = new vmg_float[Helper::intpow(2*near_field_cells+1,3)];
+    vmg_float* vals = &spline_vals.front();
 
     vmg_float temp_val;
     vmg_float int_val = 0.0;
     int c = 0;
 
-    const int index_global_x = (p.Pos().X() - grid.Extent().Begin().X()) / grid.Extent().MeshWidth().X();
-    const int index_global_y = (p.Pos().Y() - grid.Extent().Begin().Y()) / grid.Extent().MeshWidth().Y();
-    const int index_global_z = (p.Pos().Z() - grid.Extent().Begin().Z()) / grid.Extent().MeshWidth().Z();
+    const int index_global_x = (x - grid.Extent().Begin().X()) / grid.Extent().MeshWidth().X();
+    const int index_global_y = (y - grid.Extent().Begin().Y()) / grid.Extent().MeshWidth().Y();
+    const int index_global_z = (z - grid.Extent().Begin().Z()) / grid.Extent().MeshWidth().Z();
 
     assert(index_global_x >= grid.Global().LocalBegin().X() && index_global_x < grid.Global().LocalEnd().X());
     assert(index_global_y >= grid.Global().LocalBegin().Y() && index_global_y < grid.Global().LocalEnd().Y());
@@ -82,9 +87,9 @@ public:
     assert(index_local_y >= grid.Local().Begin().Y() && index_local_y < grid.Local().End().Y());
     assert(index_local_z >= grid.Local().Begin().Z() && index_local_z < grid.Local().End().Z());
 
-    const vmg_float pos_beg_x = p.Pos().X() - grid.Extent().Begin().X() - grid.Extent().MeshWidth().X() * (index_global_x - near_field_cells);
-    const vmg_float pos_beg_y = p.Pos().Y() - grid.Extent().Begin().Y() - grid.Extent().MeshWidth().Y() * (index_global_y - near_field_cells);
-    const vmg_float pos_beg_z = p.Pos().Z() - grid.Extent().Begin().Z() - grid.Extent().MeshWidth().Z() * (index_global_z - near_field_cells);
+    const vmg_float pos_beg_x = x - grid.Extent().Begin().X() - grid.Extent().MeshWidth().X() * (index_global_x - near_field_cells);
+    const vmg_float pos_beg_y = y - grid.Extent().Begin().Y() - grid.Extent().MeshWidth().Y() * (index_global_y - near_field_cells);
+    const vmg_float pos_beg_z = z - grid.Extent().Begin().Z() - grid.Extent().MeshWidth().Z() * (index_global_z - near_field_cells);
 
     const vmg_float& h_x = grid.Extent().MeshWidth().X();
     const vmg_float& h_y = grid.Extent().MeshWidth().Y();
@@ -100,7 +105,7 @@ public:
 
 	  // Compute distance from grid point to particle
 	  temp_val = EvaluateSpline(std::sqrt(dir_x*dir_x+dir_y*dir_y+dir_z*dir_z));
-	  vals[c++] = temp_val * p.Charge();
+	  vals[c++] = temp_val * q;
 	  int_val += temp_val;
 
 	  dir_z -= h_z;
@@ -120,8 +125,6 @@ public:
 	  grid(index_local_x + i,
 	       index_local_y + j,
 	       index_local_z + k) += vals[c++] * int_val;
-
-    delete [] vals;
   }
 
   vmg_float EvaluatePotential(const vmg_float& val) const
@@ -140,6 +143,22 @@ public:
     return 0.0;
   }
 
+  /**
+   * Evaluates potential and field correction with a single interval lookup.
+   * Equivalent to calling EvaluatePotential and EvaluateField.
+   */
+  void EvaluatePotentialAndField(const vmg_float& val, vmg_float& pot, vmg_float& field) const
+  {
+    for (unsigned int i=0; i<intervals.size(); ++i)
+      if (val < intervals[i]) {
+	pot = potential_nom[i](val) / potential_denom[i](val);
+	field = field_nom[i](val) / field_denom[i](val);
+	return;
+      }
+    pot = potential_nom.back()(val) / potential_denom.back()(val);
+    field = 0.0;
+  }
+
   const vmg_float& GetAntiDerivativeAtZero() const
   {
     return antid;
@@ -154,6 +173,8 @@ private:
 
   const vmg_float R;
   const int near_field_cells;
+
+  mutable std::vector<vmg_float> spline_vals;
 };
 
 }
@@ -37,190 +37,288 @@
 #include <sourceinfompicalls.h>
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "units/particle/comm_mpi_particle.hpp"
 #include "units/particle/linked_cell_list.hpp"
 #include "units/particle/particle.hpp"
 
 using namespace VMG;
 
-void Particle::CommMPI::CommParticles(const Grid& grid, std::list<Particle>& particles)
+/*
+ * Sets up the lookup of the process owning a grid point. The extents of
+ * all processes are gathered only if the decomposition changed on any
+ * process. If the extents form a tensor product decomposition matching
+ * the Cartesian communicator, the owner is found by a binary search in
+ * each dimension.
+ */
+void Particle::CommMPI::SetupParticlePlan(const Grid& grid)
 {
-  Factory& factory = MG::GetFactory();
+  int changed, rank, size;
+  Index dims, periods, coords;
 
-  const vmg_int& num_particles_local = factory.GetObjectStorageVal<vmg_int>("PARTICLE_NUM_LOCAL");
-  vmg_float* x = factory.GetObjectStorageArray<vmg_float>("PARTICLE_POS_ARRAY");
-  vmg_float* q = factory.GetObjectStorageArray<vmg_float>("PARTICLE_CHARGE_ARRAY");
+  changed = (!plan_valid ||
+	     plan_begin != grid.Global().LocalBegin() ||
+	     plan_end != grid.Global().LocalEnd() ||
+	     plan_global_size != grid.Global().GlobalSize()) ? 1 : 0;
+
+  MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, comm_global);
+
+  if (!changed)
+    return;
 
-  int rank, size;
   MPI_Comm_rank(comm_global, &rank);
   MPI_Comm_size(comm_global, &size);
+  MPI_Cart_get(comm_global, 3, dims.vec(), periods.vec(), coords.vec());
 
-#ifndef VMG_ONE_SIDED
-  vmg_int* receiver;
-  if (!factory.TestObject("PARTICLE_RECEIVER_ARRAY"))
-    new ObjectStorageArray<vmg_int>("PARTICLE_RECEIVER_ARRAY", size);
-  receiver = factory.GetObjectStorageArray<vmg_int>("PARTICLE_RECEIVER_ARRAY");
-#endif
+  plan_begin = grid.Global().LocalBegin();
+  plan_end = grid.Global().LocalEnd();
+  plan_global_size = grid.Global().GlobalSize();
 
-  Index index;
   std::vector<int> global_extent(6*size);
-  std::vector<int> send_sizes(size);
-  std::vector<int> recv_sizes(size);
-  std::vector<Index> begin_remote(size);
-  std::vector<Index> end_remote(size);
-  std::vector< std::vector<vmg_float> > send_buffer_x(size);
-  std::vector< std::vector<vmg_float> > send_buffer_q(size);
-  std::vector< std::vector<vmg_int> > send_buffer_ind(size);
-  std::vector< std::vector<vmg_float> > recv_buffer_x(size);
-  std::vector< std::vector<vmg_float> > recv_buffer_q(size);
-  std::vector< std::vector<vmg_int> > recv_buffer_ind(size);
-
-  std::memcpy(&global_extent[6*rank], grid.Global().LocalBegin().vec(), 3*sizeof(int));
-  std::memcpy(&global_extent[6*rank+3], grid.Global().LocalEnd().vec(), 3*sizeof(int));
+
+  std::memcpy(&global_extent[6*rank], plan_begin.vec(), 3*sizeof(int));
+  std::memcpy(&global_extent[6*rank+3], plan_end.vec(), 3*sizeof(int));
 
   MPI_Allgather(MPI_IN_PLACE, 6, MPI_INT, &global_extent.front(), 6, MPI_INT, comm_global);
 
+  plan_begin_remote.resize(size);
+  plan_end_remote.resize(size);
   for (int i=0; i<size; ++i) {
-    begin_remote[i] = static_cast<Index>(&global_extent[6*i]);
-    end_remote[i] = static_cast<Index>(&global_extent[6*i+3]);
+    plan_begin_remote[i] = static_cast<Index>(&global_extent[6*i]);
+    plan_end_remote[i] = static_cast<Index>(&global_extent[6*i+3]);
   }
 
-  for (int i=0; i<num_particles_local; ++i) {
-    index = static_cast<Index>((Vector(&x[3*i]) - grid.Extent().Begin()) / grid.Extent().MeshWidth());
-    for (int j=0; j<size; ++j)
-      if (index.IsInBounds(begin_remote[j], end_remote[j])) {
-	send_buffer_x[j].push_back(x[3*i+0]);
-	send_buffer_x[j].push_back(x[3*i+1]);
-	send_buffer_x[j].push_back(x[3*i+2]);
-	send_buffer_q[j].push_back(q[i]);
-	send_buffer_ind[j].push_back(i);
-	break;
-      }
+  for (int j=0; j<3; ++j)
+    plan_cuts[j].assign(dims[j], 0);
+  plan_ranks.resize(size);
+
+  for (int i=0; i<size; ++i) {
+    MPI_Cart_coords(comm_global, i, 3, coords.vec());
+    for (int j=0; j<3; ++j)
+      plan_cuts[j][coords[j]] = plan_begin_remote[i][j];
+    plan_ranks[coords.Z() + dims.Z() * (coords.Y() + dims.Y() * coords.X())] = i;
+  }
+
+  plan_cartesian = true;
+  for (int i=0; i<size && plan_cartesian; ++i) {
+    MPI_Cart_coords(comm_global, i, 3, coords.vec());
+    for (int j=0; j<3; ++j) {
+      const int end = (coords[j]+1 < dims[j] ? plan_cuts[j][coords[j]+1] : plan_global_size[j]);
+      if (plan_begin_remote[i][j] != plan_cuts[j][coords[j]] || plan_end_remote[i][j] != end)
+	plan_cartesian = false;
+    }
+  }
+
+  plan_valid = true;
+}
+
+int Particle::CommMPI::ParticleDestination(const Index& index) const
+{
+  if (plan_cartesian) {
+
+    Index coords;
+
+    for (int j=0; j<3; ++j) {
+      if (index[j] < 0 || index[j] >= plan_global_size[j])
+	return -1;
+      // Empty processes share their begin with their successor, so take the last match
+      coords[j] = std::upper_bound(plan_cuts[j].begin(), plan_cuts[j].end(), index[j]) - plan_cuts[j].begin() - 1;
+    }
+
+    return plan_ranks[coords.Z() + static_cast<int>(plan_cuts[2].size()) *
+		      (coords.Y() + static_cast<int>(plan_cuts[1].size()) * coords.X())];
   }
 
+  for (unsigned int i=0; i<plan_begin_remote.size(); ++i)
+    if (index.IsInBounds(plan_begin_remote[i], plan_end_remote[i]))
+      return i;
+
+  return -1;
+}
+
+void Particle::CommMPI::CommParticles(const Grid& grid, LinkedCellList& lc)
+{
+  Factory& factory = MG::GetFactory();
+
+  const vmg_int& num_particles_local = factory.GetObjectStorageVal<vmg_int>("PARTICLE_NUM_LOCAL");
+  vmg_float* x = factory.GetObjectStorageArray<vmg_float>("PARTICLE_POS_ARRAY");
+  vmg_float* q = factory.GetObjectStorageArray<vmg_float>("PARTICLE_CHARGE_ARRAY");
+
+  const int tag = 8191;
+
+  SetupParticlePlan(grid);
+
   /*
-   * Communicate which process gets how many particles
+   * Find the destination process of each particle
    */
-  for (int i=0; i<size; ++i)
-    send_sizes[i] = send_buffer_q[i].size();
+  std::vector<int> dest(num_particles_local);
 
-  MPI_Alltoall(&send_sizes.front(), 1, MPI_INT, &recv_sizes.front(), 1, MPI_INT, comm_global);
+  for (int i=0; i<num_particles_local; ++i)
+    dest[i] = ParticleDestination(static_cast<Index>((Vector(&x[3*i]) - grid.Extent().Begin()) / grid.Extent().MeshWidth()));
 
-  assert(RequestsPending() == 0);
+  send_ranks = dest;
+  std::sort(send_ranks.begin(), send_ranks.end());
+  send_ranks.erase(std::unique(send_ranks.begin(), send_ranks.end()), send_ranks.end());
+  if (!send_ranks.empty() && send_ranks.front() < 0)
+    send_ranks.erase(send_ranks.begin());
 
   /*
-   * Send particles
+   * Sort the particles by destination and pack x and q
    */
-  for (int i=0; i<size; ++i) {
+  send_displs.assign(send_ranks.size()+1, 0);
+  for (int i=0; i<num_particles_local; ++i)
+    if (dest[i] >= 0) {
+      dest[i] = std::lower_bound(send_ranks.begin(), send_ranks.end(), dest[i]) - send_ranks.begin();
+      ++send_displs[dest[i]+1];
+    }
+
+  for (unsigned int i=0; i<send_ranks.size(); ++i)
+    send_displs[i+1] += send_displs[i];
+
+  std::vector<int> fill(send_displs.begin(), send_displs.end()-1);
+  send_index.resize(send_displs.back());
+  send_buffer.resize(4*send_displs.back());
 
-    if (!send_buffer_q[i].empty()) {
-      MPI_Isend(&send_buffer_x[i].front(), send_buffer_x[i].size(), MPI_DOUBLE, i, 0, comm_global, &Request());
-      MPI_Isend(&send_buffer_q[i].front(), send_buffer_q[i].size(), MPI_DOUBLE, i, 1, comm_global, &Request());
-      MPI_Isend(&send_buffer_ind[i].front(), send_buffer_ind[i].size(), MPI_INT, i, 2, comm_global, &Request());
+  for (int i=0; i<num_particles_local; ++i)
+    if (dest[i] >= 0) {
+      const int j = fill[dest[i]]++;
+      send_index[j] = i;
+      std::memcpy(&send_buffer[4*j], &x[3*i], 3*sizeof(vmg_float));
+      send_buffer[4*j+3] = q[i];
     }
 
-#ifndef VMG_ONE_SIDED
-    receiver[i] = send_buffer_q[i].size();
-#endif
-  }
+  assert(RequestsPending() == 0);
+
+  for (unsigned int i=0; i<send_ranks.size(); ++i)
+    MPI_Issend(&send_buffer[4*send_displs[i]], 4*(send_displs[i+1]-send_displs[i]), MPI_DOUBLE,
+	       send_ranks[i], tag, comm_global, &Request());
 
   /*
-   * Receive particles
+   * Receive particles. With MPI-3 the sources are discovered with a
+   * non-blocking consensus, so only processes exchanging particles
+   * communicate. Otherwise the message sizes are exchanged with an
+   * all-to-all.
    */
-  for (int i=0; i<size; ++i) {
+  std::vector< std::pair< int, std::vector<vmg_float> > > messages;
 
-    if (recv_sizes[i] > 0) {
+#if MPI_VERSION >= 3
+  MPI_Request barrier;
+  MPI_Status status;
+  bool barrier_active = false;
+  int done = 0, flag, count;
 
-      recv_buffer_x[i].resize(3*recv_sizes[i]);
-      recv_buffer_q[i].resize(recv_sizes[i]);
-      recv_buffer_ind[i].resize(recv_sizes[i]);
+  while (!done) {
 
-      MPI_Irecv(&recv_buffer_x[i].front(), 3*recv_sizes[i], MPI_DOUBLE, i, 0, comm_global, &Request());
-      MPI_Irecv(&recv_buffer_q[i].front(), recv_sizes[i], MPI_DOUBLE, i, 1, comm_global, &Request());
-      MPI_Irecv(&recv_buffer_ind[i].front(), recv_sizes[i], MPI_INT, i, 2, comm_global, &Request());
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, comm_global, &flag, &status);
 
+    if (flag) {
+      MPI_Get_count(&status, MPI_DOUBLE, &count);
+      messages.push_back(std::make_pair(status.MPI_SOURCE, std::vector<vmg_float>(count)));
+      MPI_Recv(&messages.back().second.front(), count, MPI_DOUBLE, status.MPI_SOURCE, tag, comm_global, MPI_STATUS_IGNORE);
     }
 
+    if (barrier_active) {
+      MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+    }else if (TestAll()) {
+      MPI_Ibarrier(comm_global, &barrier);
+      barrier_active = true;
+    }
   }
 
   WaitAll();
 
-  particles.clear();
+  std::sort(messages.begin(), messages.end());
+#else
+  int size;
+  MPI_Comm_size(comm_global, &size);
+
+  std::vector<int> send_sizes(size, 0);
+  std::vector<int> recv_sizes(size);
+
+  for (unsigned int i=0; i<send_ranks.size(); ++i)
+    send_sizes[send_ranks[i]] = 4*(send_displs[i+1]-send_displs[i]);
+
+  MPI_Alltoall(&send_sizes.front(), 1, MPI_INT, &recv_sizes.front(), 1, MPI_INT, comm_global);
 
   for (int i=0; i<size; ++i)
-    for (int j=0; j<recv_sizes[i]; ++j)
-      particles.push_back(Particle(&recv_buffer_x[i][3*j], recv_buffer_q[i][j], 0.0, 0.0, i, recv_buffer_ind[i][j]));
-}
+    if (recv_sizes[i] > 0)
+      messages.push_back(std::make_pair(i, std::vector<vmg_float>(recv_sizes[i])));
 
-void Particle::CommMPI::CommParticlesBack(std::list<Particle>& particles)
-{
-  std::list<Particle>::iterator iter;
-
-#ifdef VMG_ONE_SIDED
-  if (!win_created) {
-    vmg_float* p = MG::GetFactory().GetObjectStorageArray<vmg_float>("PARTICLE_POTENTIAL_ARRAY");
-    const vmg_int& num_particles_local = MG::GetFactory().GetObjectStorageVal<vmg_int>("PARTICLE_NUM_LOCAL");
-    MPI_Win_create(p, num_particles_local*sizeof(vmg_float), sizeof(vmg_float), info, comm_global, &win);
-    win_created = true;
+  for (unsigned int i=0; i<messages.size(); ++i)
+    MPI_Irecv(&messages[i].second.front(), messages[i].second.size(), MPI_DOUBLE,
+	      messages[i].first, tag, comm_global, &Request());
+
+  WaitAll();
+#endif
+
+  /*
+   * Store the reverse plan and hand the particles to the cell list. The
+   * index of a particle is its position in the receive buffer.
+   */
+  recv_ranks.resize(messages.size());
+  recv_displs.assign(messages.size()+1, 0);
+  for (unsigned int i=0; i<messages.size(); ++i) {
+    recv_ranks[i] = messages[i].first;
+    recv_displs[i+1] = recv_displs[i] + messages[i].second.size() / 4;
   }
 
-  MPI_Win_fence(MPI_MODE_NOPRECEDE, win);
+  recv_buffer.resize(4*recv_displs.back());
+  for (unsigned int i=0; i<messages.size(); ++i)
+    if (!messages[i].second.empty())
+      std::memcpy(&recv_buffer[4*recv_displs[i]], &messages[i].second.front(), messages[i].second.size()*sizeof(vmg_float));
 
-  for (iter=particles.begin(); iter!=particles.end(); ++iter)
-    MPI_Put(&iter->Pot(), 1, MPI_DOUBLE, iter->Rank(), iter->Index(), 1, MPI_DOUBLE, win);
+  lc.Clear();
 
-  MPI_Win_fence(MPI_MODE_NOSTORE | MPI_MODE_NOSUCCEED, win);
-#else
-  int rank, size;
-  MPI_Comm_rank(comm_global, &rank);
-  MPI_Comm_size(comm_global, &size);
+  for (unsigned int i=0; i<recv_ranks.size(); ++i)
+    for (int j=recv_displs[i]; j<recv_displs[i+1]; ++j)
+      lc.AddParticle(&recv_buffer[4*j], recv_buffer[4*j+3], recv_ranks[i], j);
+
+  lc.Sort();
+}
 
-  std::vector< std::vector<vmg_float> > send_buffer_float(size);
-  std::vector< std::vector<vmg_float> > recv_buffer_float(size);
-  std::vector< std::vector<vmg_int> > send_buffer_index(size);
-  std::vector< std::vector<vmg_int> > recv_buffer_index(size);
+void Particle::CommMPI::CommParticlesBack(const LinkedCellList& lc)
+{
+  const vmg_float* lc_p = lc.Pot();
+  const vmg_float* lc_fx = lc.FieldX();
+  const vmg_float* lc_fy = lc.FieldY();
+  const vmg_float* lc_fz = lc.FieldZ();
+  const int* lc_rank = lc.Rank();
+  const vmg_int* lc_index = lc.Index();
 
-  vmg_int* size_receive = MG::GetFactory().GetObjectStorageArray<vmg_int>("PARTICLE_RECEIVER_ARRAY");
   vmg_float* p = MG::GetFactory().GetObjectStorageArray<vmg_float>("PARTICLE_POTENTIAL_ARRAY");
   vmg_float* f = MG::GetFactory().GetObjectStorageArray<vmg_float>("PARTICLE_FIELD_ARRAY");
 
-  // Build send buffer
-  for (iter=particles.begin(); iter!=particles.end(); ++iter) {
-    send_buffer_float[iter->Rank()].push_back(iter->Pot());
-    send_buffer_float[iter->Rank()].push_back(iter->Field()[0]);
-    send_buffer_float[iter->Rank()].push_back(iter->Field()[1]);
-    send_buffer_float[iter->Rank()].push_back(iter->Field()[2]);
-    send_buffer_index[iter->Rank()].push_back(iter->Index());
-  }
+  const int tag = 8192;
 
-  // Send potentials
-  for (int i=0; i<size; ++i) {
-    if (!send_buffer_float[i].empty()) {
-      MPI_Isend(&send_buffer_float[i].front(), send_buffer_float[i].size(), MPI_DOUBLE, i, 699+rank, comm_global, &Request());
-      MPI_Isend(&send_buffer_index[i].front(), send_buffer_index[i].size(), MPI_INT, i, 32111+rank, comm_global, &Request());
+  // Results are stored at the position the particle had in the receive buffer
+  for (vmg_int i=0; i<lc.Size(); ++i)
+    if (lc_rank[i] >= 0) {
+      recv_buffer[4*lc_index[i]+0] = lc_p[i];
+      recv_buffer[4*lc_index[i]+1] = lc_fx[i];
+      recv_buffer[4*lc_index[i]+2] = lc_fy[i];
+      recv_buffer[4*lc_index[i]+3] = lc_fz[i];
     }
-  }
 
-  //Receive potentials
-  for (int i=0; i<size; ++i) {
-    if (size_receive[i] > 0) {
-      recv_buffer_float[i].resize(4*size_receive[i]);
-      recv_buffer_index[i].resize(size_receive[i]);
-      MPI_Irecv(&recv_buffer_float[i].front(), 4*size_receive[i], MPI_DOUBLE, i, 699+i, comm_global, &Request());
-      MPI_Irecv(&recv_buffer_index[i].front(), size_receive[i], MPI_INT, i, 32111+i, comm_global, &Request());
-    }
-  }
+  assert(RequestsPending() == 0);
 
-  WaitAll();
+  for (unsigned int i=0; i<send_ranks.size(); ++i)
+    MPI_Irecv(&send_buffer[4*send_displs[i]], 4*(send_displs[i+1]-send_displs[i]), MPI_DOUBLE,
+	      send_ranks[i], tag, comm_global, &Request());
 
-  // Add potential values
-  for (int i=0; i<size; ++i)
-    for (vmg_int j=0; j<size_receive[i]; ++j) {
-      p[recv_buffer_index[i][j]] = recv_buffer_float[i][4*j];
-      std::memcpy(&f[3*recv_buffer_index[i][j]], &recv_buffer_float[i][4*j+1], 3*sizeof(vmg_float));
-    }
-#endif
+  for (unsigned int i=0; i<recv_ranks.size(); ++i)
+    MPI_Isend(&recv_buffer[4*recv_displs[i]], 4*(recv_displs[i+1]-recv_displs[i]), MPI_DOUBLE,
+	      recv_ranks[i], tag, comm_global, &Request());
 
+  WaitAll();
+
+  for (int j=0; j<send_displs.back(); ++j) {
+    p[send_index[j]] = send_buffer[4*j];
+    std::memcpy(&f[3*send_index[j]], &send_buffer[4*j+1], 3*sizeof(vmg_float));
+  }
 }
 
 void Particle::CommMPI::CommLCListToGhosts(LinkedCellList& lc)
@@ -228,7 +326,6 @@ void Particle::CommMPI::CommLCListToGhosts(LinkedCellList& lc)
   VMG::MPI::DatatypesLocal types(lc, comm_global, false);
   std::vector<int> send_size(types.NB().size());
   vmg_int recv_size;
-  std::list<Particle*>::iterator iter;
   Index ind;
   Vector offset;
 
@@ -236,6 +333,11 @@ void Particle::CommMPI::CommLCListToGhosts(LinkedCellList& lc)
 
   lc.ClearHalo();
 
+  const vmg_float* lc_x = lc.X();
+  const vmg_float* lc_y = lc.Y();
+  const vmg_float* lc_z = lc.Z();
+  const vmg_float* lc_q = lc.Charge();
+
   for (unsigned int i=0; i<types.NB().size(); ++i)
     if (types.NB()[i].Feasible()) {
 
@@ -246,20 +348,29 @@ void Particle::CommMPI::CommLCListToGhosts(LinkedCellList& lc)
         else
           offset[j] = 0.0;
 
-      for (ind.X() = types.NB()[i].Starts().X(); ind.X() < types.NB()[i].Starts().X()+types.NB()[i].Subsizes().X(); ++ind.X())
-	for (ind.Y() = types.NB()[i].Starts().Y(); ind.Y() < types.NB()[i].Starts().Y()+types.NB()[i].Subsizes().Y(); ++ind.Y())
-	  for (ind.Z() = types.NB()[i].Starts().Z(); ind.Z() < types.NB()[i].Starts().Z()+types.NB()[i].Subsizes().Z(); ++ind.Z())
-	    for (iter=lc(ind).begin(); iter!=lc(ind).end(); ++iter) {
+      // Cells adjacent in z-direction hold a contiguous range of particles
+      const Index& starts = types.NB()[i].Starts();
+      const Index& subsizes = types.NB()[i].Subsizes();
+
+      for (ind.X() = starts.X(); ind.X() < starts.X()+subsizes.X(); ++ind.X())
+	for (ind.Y() = starts.Y(); ind.Y() < starts.Y()+subsizes.Y(); ++ind.Y()) {
+
+	  const vmg_int p_begin = lc.CellBegin(lc.CellIndex(ind.X(), ind.Y(), starts.Z()));
+	  const vmg_int p_end = lc.CellEnd(lc.CellIndex(ind.X(), ind.Y(), starts.Z()+subsizes.Z()-1));
 
-              for (int j=0; j<3; ++j)
-                types.NB()[i].Buffer().push_back((*iter)->Pos()[j] + offset[j]);
-              types.NB()[i].Buffer().push_back((*iter)->Charge());
+	  for (vmg_int p=p_begin; p<p_end; ++p) {
 
-              assert(lc.Extent().Begin().IsComponentwiseLessOrEqual((*iter)->Pos()));
-              assert(lc.Extent().End().IsComponentwiseGreaterOrEqual((*iter)->Pos()));
-              assert(lc.Extent().Begin().IsComponentwiseLessOrEqual((*iter)->Pos() + offset + halo_length));
-              assert(lc.Extent().End().IsComponentwiseGreaterOrEqual((*iter)->Pos() + offset - halo_length));
-	    }
+	    types.NB()[i].Buffer().push_back(lc_x[p] + offset[0]);
+	    types.NB()[i].Buffer().push_back(lc_y[p] + offset[1]);
+	    types.NB()[i].Buffer().push_back(lc_z[p] + offset[2]);
+	    types.NB()[i].Buffer().push_back(lc_q[p]);
+
+	    assert(lc.Extent().Begin().IsComponentwiseLessOrEqual(Vector(lc_x[p], lc_y[p], lc_z[p])));
+	    assert(lc.Extent().End().IsComponentwiseGreaterOrEqual(Vector(lc_x[p], lc_y[p], lc_z[p])));
+	    assert(lc.Extent().Begin().IsComponentwiseLessOrEqual(Vector(lc_x[p], lc_y[p], lc_z[p]) + offset + halo_length));
+	    assert(lc.Extent().End().IsComponentwiseGreaterOrEqual(Vector(lc_x[p], lc_y[p], lc_z[p]) + offset - halo_length));
+	  }
+	}
 
       send_size[i] = types.NB()[i].Buffer().size();
       MPI_Isend(&send_size[i], 1, MPI_INT, types.NB()[i].Rank(), 2048+types.NB()[i].TagSend(), comm_global, &Request());
@@ -286,6 +397,8 @@ void Particle::CommMPI::CommLCListToGhosts(LinkedCellList& lc)
   for (unsigned int i=0; i<types.Halo().size(); ++i)
     for (unsigned int j=0; j<types.Halo()[i].Buffer().size(); j+=4)
       lc.AddParticleToHalo(&types.Halo()[i].Buffer()[j], types.Halo()[i].Buffer()[j+3]);
+
+  lc.Sort();
 }
 
 #endif /* HAVE_MPI */
@@ -19,7 +19,7 @@
 #ifndef COMM_MPI_PARTICLE_HPP_
 #define COMM_MPI_PARTICLE_HPP_
 
-#include <list>
+#include <vector>
 
 #include "comm/comm_mpi.hpp"
 #include "units/particle/particle.hpp"
@@ -36,18 +36,44 @@ class CommMPI : public VMG::CommMPI
 {
 public:
   CommMPI(const Boundary& boundary, DomainDecomposition* domain_dec, const MPI_Comm& mpi_comm) :
-    VMG::CommMPI(boundary, domain_dec, mpi_comm)
+    VMG::CommMPI(boundary, domain_dec, mpi_comm),
+    plan_valid(false)
   {}
 
   CommMPI(const Boundary& boundary, DomainDecomposition* domain_dec) :
-    VMG::CommMPI(boundary, domain_dec)
+    VMG::CommMPI(boundary, domain_dec),
+    plan_valid(false)
   {}
 
   virtual ~CommMPI() {}
 
-  void CommParticles(const Grid& grid, std::list<Particle>& particles);
-  void CommParticlesBack(std::list<Particle>& particles);
+  void CommParticles(const Grid& grid, LinkedCellList& lc);
+  void CommParticlesBack(const LinkedCellList& lc);
   void CommLCListToGhosts(LinkedCellList& lc);
+
+private:
+  void SetupParticlePlan(const Grid& grid);
+  int ParticleDestination(const Index& index) const;
+
+  /*
+   * Lookup of the process owning a grid point. It is set up once and
+   * kept as long as the decomposition of the grid does not change.
+   */
+  bool plan_valid;
+  bool plan_cartesian;
+  Index plan_begin, plan_end, plan_global_size;
+  std::vector<int> plan_cuts[3];
+  std::vector<int> plan_ranks;
+  std::vector<Index> plan_begin_remote, plan_end_remote;
+
+  /*
+   * Particle exchange of the current step. Particles are sent as one
+   * packed message per destination. The results travel back along the
+   * reverse plan, so neither sizes nor indices have to be sent back.
+   */
+  std::vector<int> send_ranks, send_displs, send_index;
+  std::vector<int> recv_ranks, recv_displs;
+  std::vector<vmg_float> send_buffer, recv_buffer;
 };
 
 }
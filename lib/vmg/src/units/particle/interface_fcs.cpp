@@ -77,6 +77,7 @@ namespace VMGBackupSettings
   static vmg_int near_field_cells = -1;
   static vmg_int interpolation_degree = -1;
   static vmg_int discretization_order = -1;
+  static vmg_int coarse_points = -1;
   static MPI_Comm mpi_comm;
 }
 
@@ -84,7 +85,8 @@ static void VMG_fcs_init(vmg_int level, const vmg_int* periodic,vmg_int max_iter
 			 vmg_int smoothing_steps, vmg_int cycle_type, vmg_float precision,
 			 const vmg_float* box_offset, vmg_float box_size,
 			 vmg_int near_field_cells, vmg_int interpolation_degree,
-                         vmg_int discretization_order, MPI_Comm mpi_comm)
+                         vmg_int discretization_order, vmg_int coarse_points,
+			 MPI_Comm mpi_comm)
 {
   VMGBackupSettings::level = level;
   std::memcpy(VMGBackupSettings::periodic, periodic, 3*sizeof(vmg_int));
@@ -97,6 +99,7 @@ static void VMG_fcs_init(vmg_int level, const vmg_int* periodic,vmg_int max_iter
   VMGBackupSettings::near_field_cells = near_field_cells;
   VMGBackupSettings::interpolation_degree = interpolation_degree;
   VMGBackupSettings::discretization_order = discretization_order;
+  VMGBackupSettings::coarse_points = coarse_points;
   VMGBackupSettings::mpi_comm = mpi_comm;
 
 #ifdef DEBUG
@@ -116,7 +119,7 @@ static void VMG_fcs_init(vmg_int level, const vmg_int* periodic,vmg_int max_iter
    */
   if (singular) {
 
-    new Particle::CommMPI(boundary, new DomainDecompositionMPI(), mpi_comm);
+    new Particle::CommMPI(boundary, new DomainDecompositionMPI(coarse_points), mpi_comm);
     new DiscretizationPoissonFD(discretization_order);
     new InterfaceParticles(boundary, 2, level, Vector(box_offset), box_size, near_field_cells, 0, 1.0);
     new LevelOperatorCS(Stencils::RestrictionFullWeight, Stencils::InterpolationTrilinear);
@@ -125,7 +128,7 @@ static void VMG_fcs_init(vmg_int level, const vmg_int* periodic,vmg_int max_iter
 
   }else {
 
-    new Particle::CommMPI(boundary, new DomainDecompositionMPI(), mpi_comm);
+    new Particle::CommMPI(boundary, new DomainDecompositionMPI(coarse_points), mpi_comm);
     new DiscretizationPoissonFV(discretization_order);
     new InterfaceParticles(boundary, 2, level, Vector(box_offset), box_size, near_field_cells, 2, 1.6);
     new LevelOperatorFAS(Stencils::RestrictionFullWeight, Stencils::Injection, Stencils::InterpolationTrilinear);
@@ -167,7 +170,8 @@ void VMG_fcs_setup(vmg_int level, const vmg_int* periodic, vmg_int max_iter,
 		   vmg_int smoothing_steps, vmg_int cycle_type, vmg_float precision,
 		   const vmg_float* box_offset, vmg_float box_size,
 		   vmg_int near_field_cells, vmg_int interpolation_degree,
-                   vmg_int discretization_order, MPI_Comm mpi_comm)
+                   vmg_int discretization_order, vmg_int coarse_points,
+		   MPI_Comm mpi_comm)
 {
   if (VMGBackupSettings::level != level ||
       VMGBackupSettings::periodic[0] != periodic[0] ||
@@ -184,6 +188,7 @@ void VMG_fcs_setup(vmg_int level, const vmg_int* periodic, vmg_int max_iter,
       VMGBackupSettings::near_field_cells != near_field_cells ||
       VMGBackupSettings::interpolation_degree != interpolation_degree ||
       VMGBackupSettings::discretization_order != discretization_order ||
+      VMGBackupSettings::coarse_points != coarse_points ||
       VMGBackupSettings::mpi_comm != mpi_comm) {
 
     VMG_fcs_destroy();
@@ -191,7 +196,7 @@ void VMG_fcs_setup(vmg_int level, const vmg_int* periodic, vmg_int max_iter,
 		 smoothing_steps, cycle_type, precision,
 		 box_offset, box_size, near_field_cells,
                  interpolation_degree, discretization_order,
-		 mpi_comm);
+		 coarse_points, mpi_comm);
 
   }
 }
@@ -40,6 +40,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <vector>
 
 #include "base/helper.hpp"
 #include "base/index.hpp"
@@ -75,27 +76,32 @@ void InterfaceParticles::ImportRightHandSide(Multigrid& multigrid)
   assert(particle_grid.Global().LocalSize().IsComponentwiseGreater(near_field_cells));
 
   /*
-   * Distribute particles to their processes
+   * Distribute particles to their processes. The particles are
+   * stored sorted by cell, so the charge assignment below sweeps
+   * through the grid in memory order.
    */
-  particles.clear();
+  particles.SetGridSize(near_field_cells, grid);
   comm.CommParticles(grid, particles);
 
-  /*
-   * Charge assignment on the grid
-   */
-  std::list<Particle::Particle>::iterator iter;
+  const vmg_float* x = particles.X();
+  const vmg_float* y = particles.Y();
+  const vmg_float* z = particles.Z();
+  const vmg_float* q = particles.Charge();
 
 #ifdef OUTPUT_DEBUG
   vmg_float particle_charges = 0.0;
-  for (iter=particles.begin(); iter!=particles.end(); ++iter)
-    particle_charges += iter->Charge();
+  for (vmg_int i=0; i<particles.Size(); ++i)
+    particle_charges += q[i];
   particle_charges = MG::GetComm()->GlobalSumRoot(particle_charges);
   comm.PrintOnce(Debug, "Particle list charge sum: %e", particle_charges);
-  comm.Print(Debug, "Local number of particles: %d", particles.size());
+  comm.Print(Debug, "Local number of particles: %d", particles.Size());
 #endif
 
-  for (iter=particles.begin(); iter!=particles.end(); ++iter)
-    spl.SetSpline(particle_grid, *iter);
+  /*
+   * Charge assignment on the grid
+   */
+  for (vmg_int i=0; i<particles.Size(); ++i)
+    spl.SetSpline(particle_grid, x[i], y[i], z[i], q[i]);
 
   // Communicate charges over halo
   comm.CommFromGhosts(particle_grid);
@@ -163,76 +169,110 @@ void InterfaceParticles::ExportSolution(Grid& grid)
   /*
    * Compute potentials
    */
-  Particle::LinkedCellList lc(particles, near_field_cells, grid);
-  Particle::LinkedCellList::iterator p1, p2;
-  Grid::iterator iter;
+  comm.CommLCListToGhosts(particles);
+
+  const vmg_float* x = particles.X();
+  const vmg_float* y = particles.Y();
+  const vmg_float* z = particles.Z();
+  const vmg_float* q = particles.Charge();
+  const int* rank = particles.Rank();
+  vmg_float* p = particles.Pot();
+  vmg_float* fx = particles.FieldX();
+  vmg_float* fy = particles.FieldY();
+  vmg_float* fz = particles.FieldZ();
 
-  comm.CommLCListToGhosts(lc);
+  std::vector<vmg_float> length;
+  vmg_float pot_spline, field_spline;
+  Vector field;
 
-  for (int i=lc.Local().Begin().X(); i<lc.Local().End().X(); ++i)
-    for (int j=lc.Local().Begin().Y(); j<lc.Local().End().Y(); ++j)
-      for (int k=lc.Local().Begin().Z(); k<lc.Local().End().Z(); ++k) {
+  for (int i=particles.Local().Begin().X(); i<particles.Local().End().X(); ++i)
+    for (int j=particles.Local().Begin().Y(); j<particles.Local().End().Y(); ++j)
+      for (int k=particles.Local().Begin().Z(); k<particles.Local().End().Z(); ++k) {
 
-	if (lc(i,j,k).size() > 0)
-	  ip.ComputeCoefficients(particle_grid, Index(i,j,k) - lc.Local().Begin() + particle_grid.Local().Begin());
+	const int c = particles.CellIndex(i,j,k);
 
-	for (p1=lc(i,j,k).begin(); p1!=lc(i,j,k).end(); ++p1) {
+	if (particles.CellBegin(c) == particles.CellEnd(c))
+	  continue;
+
+	ip.ComputeCoefficients(particle_grid, Index(i,j,k) - particles.Local().Begin() + particle_grid.Local().Begin());
+
+	for (vmg_int p1=particles.CellBegin(c); p1<particles.CellEnd(c); ++p1) {
+
+	  const Vector pos(x[p1], y[p1], z[p1]);
 
 	  // Interpolate long-range part of potential and electric field
-	  ip.Evaluate(**p1);
+	  ip.Evaluate(pos, p[p1], field);
 
 	  // Subtract self-induced potential
-	  (*p1)->Pot() -= (*p1)->Charge() * spl.GetAntiDerivativeAtZero();
+	  p[p1] -= q[p1] * spl.GetAntiDerivativeAtZero();
 
 #ifdef OUTPUT_DEBUG
-	  e_long += 0.5 * (*p1)->Charge() * ip.EvaluatePotentialLR(**p1);
-	  e_self += 0.5 * (*p1)->Charge() * (*p1)->Charge() * spl.GetAntiDerivativeAtZero();
+	  e_long += 0.5 * q[p1] * ip.EvaluatePotentialLR(pos);
+	  e_self += 0.5 * q[p1] * q[p1] * spl.GetAntiDerivativeAtZero();
 #endif
 
 	  for (int dx=-1*near_field_cells; dx<=near_field_cells; ++dx)
-	    for (int dy=-1*near_field_cells; dy<=near_field_cells; ++dy)
-	      for (int dz=-1*near_field_cells; dz<=near_field_cells; ++dz) {
+	    for (int dy=-1*near_field_cells; dy<=near_field_cells; ++dy) {
 
-		for (p2=lc(i+dx,j+dy,k+dz).begin(); p2!=lc(i+dx,j+dy,k+dz).end(); ++p2)
+	      // The cells k-near_field_cells,...,k+near_field_cells are stored contiguously
+	      const vmg_int p2_begin = particles.CellBegin(particles.CellIndex(i+dx, j+dy, k-near_field_cells));
+	      const vmg_int p2_end = particles.CellEnd(particles.CellIndex(i+dx, j+dy, k+near_field_cells));
 
-		  if (*p1 != *p2) {
+	      if (length.size() < static_cast<size_t>(p2_end - p2_begin))
+		length.resize(p2_end - p2_begin);
 
-		    const Vector dir = (*p1)->Pos() - (*p2)->Pos();
-		    const vmg_float length = dir.Length();
+	      for (vmg_int p2=p2_begin; p2<p2_end; ++p2)
+		length[p2-p2_begin] = std::sqrt((x[p1]-x[p2])*(x[p1]-x[p2]) +
+						(y[p1]-y[p2])*(y[p1]-y[p2]) +
+						(z[p1]-z[p2])*(z[p1]-z[p2]));
 
-		    if (length < r_cut) {
+	      for (vmg_int p2=p2_begin; p2<p2_end; ++p2)
+		if (p2 != p1 && length[p2-p2_begin] < r_cut) {
 
-		      (*p1)->Pot() += (*p2)->Charge() / length * (1.0 + spl.EvaluatePotential(length));
-		      (*p1)->Field() += (*p2)->Charge() * dir * spl.EvaluateField(length);
+		  const vmg_float& l = length[p2-p2_begin];
+
+		  spl.EvaluatePotentialAndField(l, pot_spline, field_spline);
+
+		  p[p1] += q[p2] / l * (1.0 + pot_spline);
+		  field[0] += q[p2] * (x[p1]-x[p2]) * field_spline;
+		  field[1] += q[p2] * (y[p1]-y[p2]) * field_spline;
+		  field[2] += q[p2] * (z[p1]-z[p2]) * field_spline;
 
 #ifdef OUTPUT_DEBUG
-		      e_short_peak += 0.5 * (*p1)->Charge() * (*p2)->Charge() / length;
-		      e_short_spline += 0.5 * (*p1)->Charge() * (*p2)->Charge() / length * spl.EvaluatePotential(length);
+		  e_short_peak += 0.5 * q[p1] * q[p2] / l;
+		  e_short_spline += 0.5 * q[p1] * q[p2] / l * pot_spline;
 #endif
-		    }
-		  }
-	      }
+		}
+	    }
+
+	  fx[p1] = field[0];
+	  fy[p1] = field[1];
+	  fz[p1] = field[2];
 	}
       }
 
   /* Remove average force term */
   Vector average_force = 0.0;
-  for (std::list<Particle::Particle>::const_iterator iter=particles.begin(); iter!=particles.end(); ++iter)
-    average_force += iter->Charge() * iter->Field();
+  for (vmg_int i=0; i<particles.Size(); ++i)
+    if (rank[i] >= 0)
+      average_force += q[i] * Vector(fx[i], fy[i], fz[i]);
   const vmg_int& npl = MG::GetFactory().GetObjectStorageVal<vmg_int>("PARTICLE_NUM_LOCAL");
   const vmg_int num_particles_global = comm.GlobalSum(npl);
   average_force /= num_particles_global;
   comm.GlobalSumArray(average_force.vec(), 3);
-  for (std::list<Particle::Particle>::iterator iter=particles.begin(); iter!=particles.end(); ++iter)
-    iter->Field() -= average_force / iter->Charge();
+  for (vmg_int i=0; i<particles.Size(); ++i)
+    if (rank[i] >= 0) {
+      fx[i] -= average_force[0] / q[i];
+      fy[i] -= average_force[1] / q[i];
+      fz[i] -= average_force[2] / q[i];
+    }
 
   comm.CommParticlesBack(particles);
 
 #ifdef OUTPUT_DEBUG
-  vmg_float* q = factory.GetObjectStorageArray<vmg_float>("PARTICLE_CHARGE_ARRAY");
+  const vmg_float* q_local = factory.GetObjectStorageArray<vmg_float>("PARTICLE_CHARGE_ARRAY");
   const vmg_int& num_particles_local = factory.GetObjectStorageVal<vmg_int>("PARTICLE_NUM_LOCAL");
-  const vmg_float* p = factory.GetObjectStorageArray<vmg_float>("PARTICLE_POTENTIAL_ARRAY");
-  const vmg_float* f = factory.GetObjectStorageArray<vmg_float>("PARTICLE_FIELD_ARRAY");
+  const vmg_float* p_local = factory.GetObjectStorageArray<vmg_float>("PARTICLE_POTENTIAL_ARRAY");
 
 
   e_long = comm.GlobalSumRoot(e_long);
@@ -241,7 +281,7 @@ void InterfaceParticles::ExportSolution(Grid& grid)
   e_self = comm.GlobalSumRoot(e_self);
 
   for (int j=0; j<num_particles_local; ++j)
-    e += 0.5 * p[j] * q[j];
+    e += 0.5 * p_local[j] * q_local[j];
   e = comm.GlobalSumRoot(e);
 
   comm.PrintOnce(Debug, "E_long:         %e", e_long);
@@ -107,10 +107,11 @@ void Particle::Interpolation::_compute_coefficients_1d(const Index& index, const
 
 void Particle::Interpolation::Evaluate(Particle& p)
 {
-  const Vector& pos = p.Pos();
-  vmg_float& pot = p.Pot();
-  Vector& field = p.Field();
+  Evaluate(p.Pos(), p.Pot(), p.Field());
+}
 
+void Particle::Interpolation::Evaluate(const Vector& pos, vmg_float& pot, Vector& field)
+{
   pot = 0.0;
   field = 0.0;
 
@@ -143,13 +144,16 @@ void Particle::Interpolation::Evaluate(Particle& p)
 }
 
 vmg_float Particle::Interpolation::EvaluatePotentialLR(const Particle& p)
+{
+  return EvaluatePotentialLR(p.Pos());
+}
+
+vmg_float Particle::Interpolation::EvaluatePotentialLR(const Vector& pos)
 {
   vmg_float result = 0.0;
   Vector prod, offset;
   Index i;
 
-  const Vector& pos = p.Pos();
-
   prod[0] = 1.0;
   offset[0] = pos[0] - pos_begin[0];
   for (i[0]=0; i[0]<deg_1; ++i[0]) {
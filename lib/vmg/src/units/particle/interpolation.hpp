@@ -42,8 +42,10 @@ public:
 
   void ComputeCoefficients(const Grid& grid, const Index& index);
   void Evaluate(Particle& p);
+  void Evaluate(const Vector& pos, vmg_float& pot, Vector& field);
 
   vmg_float EvaluatePotentialLR(const Particle& p);
+  vmg_float EvaluatePotentialLR(const Vector& pos);
 
 private:
   vmg_float& _access_coeff(const Index& index)
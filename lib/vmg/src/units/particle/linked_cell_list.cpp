@@ -21,7 +21,7 @@
  * @author Julian Iseringhausen <isering@ins.uni-bonn.de>
  * @date   Mon Nov 21 13:27:22 2011
  *
- * @brief  A linked cell list implementation.
+ * @brief  A cell list storing the particles sorted by cell.
  *
  */
 
@@ -29,17 +29,13 @@
 #include <config.h>
 #endif
 
-#include "comm/comm.hpp"
+#include "grid/grid.hpp"
 #include "units/particle/linked_cell_list.hpp"
-#include "mg.hpp"
 
 using namespace VMG;
 
-Particle::LinkedCellList::LinkedCellList(std::list<Particle>& particles,
-					 const int& near_field_cells, const Grid& grid)
+void Particle::LinkedCellList::SetGridSize(const int& near_field_cells, const Grid& grid)
 {
-  std::list<Particle>::iterator iter;
-  Index index_global, index_local;
   LocalIndices local = grid.Local();
 
   local.BoundaryBegin1() = 0;
@@ -80,30 +76,45 @@ Particle::LinkedCellList::LinkedCellList(std::list<Particle>& particles,
     }
   }
 
-  SetGridSize(grid.Global(), local, grid.Extent());
+  global_ = grid.Global();
+  local_ = local;
+  extent_ = grid.Extent();
+  near_field_cells_ = near_field_cells;
+  num_cells_ = local_.SizeTotal().Product();
 
-  for (iter=particles.begin(); iter!=particles.end(); ++iter)
-    AddParticle(&(*iter));
+  Clear();
 }
 
-Particle::LinkedCellList::~LinkedCellList()
+void Particle::LinkedCellList::Clear()
 {
-  ClearHalo();
+  x_.clear(); y_.clear(); z_.clear();
+  q_.clear(); p_.clear();
+  fx_.clear(); fy_.clear(); fz_.clear();
+  rank_.clear();
+  index_.clear();
+  cell_.clear();
+  offset_.assign(num_cells_+1, 0);
 }
 
-void Particle::LinkedCellList::AddParticle(Particle* p)
+void Particle::LinkedCellList::AddParticle(const vmg_float* x, const vmg_float& q, const int& rank, const vmg_int& index)
 {
-  const Index global_index = (p->Pos() - Extent().Begin()) / Extent().MeshWidth();
-  const Index local_index = global_index - Global().LocalBegin() + Local().Begin();
+  const VMG::Index global_index = (Vector(x) - Extent().Begin()) / Extent().MeshWidth();
+  const VMG::Index local_index = global_index - Global().LocalBegin() + Local().Begin();
 
   assert(local_index.IsInBounds(Local().Begin(), Local().End()));
-  (*this)(local_index).push_back(p);
+
+  x_.push_back(x[0]); y_.push_back(x[1]); z_.push_back(x[2]);
+  q_.push_back(q); p_.push_back(0.0);
+  fx_.push_back(0.0); fy_.push_back(0.0); fz_.push_back(0.0);
+  rank_.push_back(rank);
+  index_.push_back(index);
+  cell_.push_back(CellIndex(local_index.X(), local_index.Y(), local_index.Z()));
 }
 
 void Particle::LinkedCellList::AddParticleToHalo(const vmg_float* x, const vmg_float& q)
 {
-  const Index global_index = ((Vector(x) - Extent().Begin()) / Extent().MeshWidth()).Floor();
-  const Index local_index = global_index - Global().LocalBegin() + Local().Begin();
+  const VMG::Index global_index = ((Vector(x) - Extent().Begin()) / Extent().MeshWidth()).Floor();
+  const VMG::Index local_index = global_index - Global().LocalBegin() + Local().Begin();
 
   assert(local_index.IsInBounds(0, Local().SizeTotal()));
   assert((local_index[0] >= Local().HaloBegin1()[0] && local_index[0] < Local().HaloEnd1()[0]) ||
@@ -113,23 +124,66 @@ void Particle::LinkedCellList::AddParticleToHalo(const vmg_float* x, const vmg_f
 	 (local_index[1] >= Local().HaloBegin2()[1] && local_index[1] < Local().HaloEnd2()[1]) ||
 	 (local_index[2] >= Local().HaloBegin2()[2] && local_index[2] < Local().HaloEnd2()[2]));
 
-  (*this)(local_index).push_back(new Particle(x, q));
+  x_.push_back(x[0]); y_.push_back(x[1]); z_.push_back(x[2]);
+  q_.push_back(q); p_.push_back(0.0);
+  fx_.push_back(0.0); fy_.push_back(0.0); fz_.push_back(0.0);
+  rank_.push_back(-1);
+  index_.push_back(-1);
+  cell_.push_back(CellIndex(local_index.X(), local_index.Y(), local_index.Z()));
 }
 
-void Particle::LinkedCellList::ClearHalo()
+/*
+ * Counting sort of all particles by cell. The sort is stable, so
+ * particles that were already sorted keep their relative order.
+ */
+void Particle::LinkedCellList::Sort()
 {
-  Grid::iterator g_iter;
-  std::list<Particle*>::iterator p_iter;
+  std::vector<vmg_int> target(cell_.size());
 
-  for (int i=0; i<3; ++i) {
+  offset_.assign(num_cells_+1, 0);
 
-    for (g_iter = Iterators().Halo1()[i].Begin(); g_iter != Iterators().Halo1()[i].End(); ++g_iter)
-      for (p_iter = (*this)(*g_iter).begin(); p_iter!=(*this)(*g_iter).end(); ++p_iter)
-	delete *p_iter;
+  for (unsigned int i=0; i<cell_.size(); ++i)
+    ++offset_[cell_[i]+1];
 
-    for (g_iter = Iterators().Halo2()[i].Begin(); g_iter != Iterators().Halo2()[i].End(); ++g_iter)
-      for (p_iter = (*this)(*g_iter).begin(); p_iter!=(*this)(*g_iter).end(); ++p_iter)
-	delete *p_iter;
+  for (int c=0; c<num_cells_; ++c)
+    offset_[c+1] += offset_[c];
 
-  }
+  std::vector<vmg_int> fill(offset_.begin(), offset_.end()-1);
+  for (unsigned int i=0; i<cell_.size(); ++i)
+    target[i] = fill[cell_[i]]++;
+
+  Permute(x_, target); Permute(y_, target); Permute(z_, target);
+  Permute(q_, target); Permute(p_, target);
+  Permute(fx_, target); Permute(fy_, target); Permute(fz_, target);
+  Permute(rank_, target);
+  Permute(index_, target);
+  Permute(cell_, target);
+}
+
+/*
+ * Remove all halo particles while keeping the local ones sorted.
+ */
+void Particle::LinkedCellList::ClearHalo()
+{
+  vmg_int n = 0;
+
+  for (vmg_int i=0; i<Size(); ++i)
+    if (rank_[i] >= 0) {
+      x_[n] = x_[i]; y_[n] = y_[i]; z_[n] = z_[i];
+      q_[n] = q_[i]; p_[n] = p_[i];
+      fx_[n] = fx_[i]; fy_[n] = fy_[i]; fz_[n] = fz_[i];
+      rank_[n] = rank_[i];
+      index_[n] = index_[i];
+      cell_[n] = cell_[i];
+      ++n;
+    }
+
+  x_.resize(n); y_.resize(n); z_.resize(n);
+  q_.resize(n); p_.resize(n);
+  fx_.resize(n); fy_.resize(n); fz_.resize(n);
+  rank_.resize(n);
+  index_.resize(n);
+  cell_.resize(n);
+
+  Sort();
 }
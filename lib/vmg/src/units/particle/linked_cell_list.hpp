@@ -21,47 +21,127 @@
  * @author Julian Iseringhausen <isering@ins.uni-bonn.de>
  * @date   Mon Nov 21 13:27:22 2011
  *
- * @brief  A linked cell list implementation.
+ * @brief  A cell list storing the particles sorted by cell.
  *
  */
 
 #ifndef LINKED_CELL_LIST_HPP_
 #define LINKED_CELL_LIST_HPP_
 
-#include <list>
+#include <cstddef>
 #include <vector>
 
 #include "base/index.hpp"
-#include "grid/is_grid.hpp"
-#include "units/particle/particle.hpp"
+#include "base/vector.hpp"
+#include "grid/grid_properties.hpp"
 
 namespace VMG
 {
 
+class Grid;
+
 namespace Particle
 {
 
-class LinkedCellList : public IsGrid< std::list<Particle*> >
+/**
+ * Cell list holding the particles in contiguous arrays (structure of
+ * arrays), sorted by cell. The particles of cell c are stored in the
+ * range [CellBegin(c), CellEnd(c)). Since the cells are numbered with
+ * z running fastest, consecutive cells along z also form one
+ * contiguous range of particles.
+ *
+ * Particles are appended with AddParticle/AddParticleToHalo and become
+ * visible in the cells after the next call to Sort. Halo particles
+ * have a rank of -1.
+ */
+class LinkedCellList
 {
 public:
-  typedef std::list<Particle*>::iterator iterator;
-  typedef std::list<Particle*>::const_iterator const_iterator;
-  typedef std::list<Particle*>::reverse_iterator reverse_iterator;
-  typedef std::list<Particle*>::const_reverse_iterator const_reverse_iterator;
+  LinkedCellList() :
+    num_cells_(0)
+  {}
+
+  LinkedCellList(const int& near_field_cells, const Grid& grid)
+  {
+    SetGridSize(near_field_cells, grid);
+  }
 
-  LinkedCellList(std::list<Particle>& particles,
-		 const int& near_field_cells, const Grid& grid);
+  void SetGridSize(const int& near_field_cells, const Grid& grid);
 
-  ~LinkedCellList();
+  void Clear();
 
-  void AddParticle(Particle* particle);
+  void AddParticle(const vmg_float* x, const vmg_float& q, const int& rank, const vmg_int& index);
   void AddParticleToHalo(const vmg_float* x, const vmg_float& q);
 
+  void Sort();
   void ClearHalo();
 
-  const Index& NearFieldCells() const {return near_field_cells_;}
+  vmg_int Size() const {return static_cast<vmg_int>(q_.size());}
+
+  int CellIndex(const int& i, const int& j, const int& k) const
+  {
+    return k + local_.SizeTotal().Z() * (j + local_.SizeTotal().Y() * i);
+  }
+
+  vmg_int CellBegin(const int& c) const {return offset_[c];}
+  vmg_int CellEnd(const int& c) const {return offset_[c+1];}
+
+  vmg_float* X() {return Data(x_);}
+  vmg_float* Y() {return Data(y_);}
+  vmg_float* Z() {return Data(z_);}
+  vmg_float* Charge() {return Data(q_);}
+  vmg_float* Pot() {return Data(p_);}
+  vmg_float* FieldX() {return Data(fx_);}
+  vmg_float* FieldY() {return Data(fy_);}
+  vmg_float* FieldZ() {return Data(fz_);}
+  int* Rank() {return Data(rank_);}
+  vmg_int* Index() {return Data(index_);}
+
+  const vmg_float* X() const {return Data(x_);}
+  const vmg_float* Y() const {return Data(y_);}
+  const vmg_float* Z() const {return Data(z_);}
+  const vmg_float* Charge() const {return Data(q_);}
+  const vmg_float* Pot() const {return Data(p_);}
+  const vmg_float* FieldX() const {return Data(fx_);}
+  const vmg_float* FieldY() const {return Data(fy_);}
+  const vmg_float* FieldZ() const {return Data(fz_);}
+  const int* Rank() const {return Data(rank_);}
+  const vmg_int* Index() const {return Data(index_);}
+
+  const GlobalIndices& Global() const {return global_;}
+  const LocalIndices& Local() const {return local_;}
+  const SpatialExtent& Extent() const {return extent_;}
+
+  const VMG::Index& NearFieldCells() const {return near_field_cells_;}
+
 private:
-  Index near_field_cells_;
+  template <class T>
+  static T* Data(std::vector<T>& vec) {return vec.empty() ? NULL : &vec.front();}
+
+  template <class T>
+  static const T* Data(const std::vector<T>& vec) {return vec.empty() ? NULL : &vec.front();}
+
+  template <class T>
+  void Permute(std::vector<T>& vec, const std::vector<vmg_int>& target) const
+  {
+    std::vector<T> temp(vec.size());
+    for (unsigned int i=0; i<vec.size(); ++i)
+      temp[target[i]] = vec[i];
+    vec.swap(temp);
+  }
+
+  GlobalIndices global_;
+  LocalIndices local_;
+  SpatialExtent extent_;
+  VMG::Index near_field_cells_;
+  int num_cells_;
+
+  std::vector<vmg_float> x_, y_, z_, q_, p_, fx_, fy_, fz_;
+  std::vector<int> rank_;
+  std::vector<vmg_int> index_;
+
+  std::vector<int> cell_;
+  std::vector<vmg_int> offset_;
 };
 
 }
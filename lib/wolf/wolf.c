@@ -106,12 +106,28 @@ void ifcs_wolf_create(ifcs_wolf_t *wolf)
 
   wolf->resort = 0;
   wolf->near_resort = FCS_NEAR_RESORT_NULL;
+
+  wolf->verlet_skin = 0;
+  wolf->near_verlet = FCS_NEAR_VERLET_NULL;
+
+  wolf->balance = 0;
+  wolf->gridsort_cache = FCS_GRIDSORT_CACHE_NULL;
+
+  wolf->interpolation_order = -1;
+  wolf->interpolation_tolerance = WOLF_DEFAULT_INTERPOLATION_TOLERANCE;
+  fcs_erfc_table_init(&wolf->erfc_table);
 }
 
 
 void ifcs_wolf_destroy(ifcs_wolf_t *wolf)
 {
   fcs_near_resort_destroy(&wolf->near_resort);
+
+  fcs_near_verlet_destroy(&wolf->near_verlet);
+
+  fcs_gridsort_release_cache(&wolf->gridsort_cache);
+
+  fcs_erfc_table_destroy(&wolf->erfc_table);
 }
 
 
@@ -172,6 +188,56 @@ void ifcs_wolf_set_max_particle_move(ifcs_wolf_t *wolf, fcs_float max_particle_m
 }
 
 
+void ifcs_wolf_set_verlet_skin(ifcs_wolf_t *wolf, fcs_float verlet_skin)
+{
+  if (wolf->verlet_skin != verlet_skin) fcs_near_verlet_destroy(&wolf->near_verlet);
+
+  wolf->verlet_skin = verlet_skin;
+}
+
+
+void ifcs_wolf_get_verlet_skin(ifcs_wolf_t *wolf, fcs_float *verlet_skin)
+{
+  *verlet_skin = wolf->verlet_skin;
+}
+
+
+void ifcs_wolf_set_balance(ifcs_wolf_t *wolf, fcs_int balance)
+{
+  wolf->balance = balance;
+}
+
+
+void ifcs_wolf_get_balance(ifcs_wolf_t *wolf, fcs_int *balance)
+{
+  *balance = wolf->balance;
+}
+
+
+void ifcs_wolf_set_interpolation_order(ifcs_wolf_t *wolf, fcs_int interpolation_order)
+{
+  wolf->interpolation_order = interpolation_order;
+}
+
+
+void ifcs_wolf_get_interpolation_order(ifcs_wolf_t *wolf, fcs_int *interpolation_order)
+{
+  *interpolation_order = wolf->interpolation_order;
+}
+
+
+void ifcs_wolf_set_interpolation_tolerance(ifcs_wolf_t *wolf, fcs_float interpolation_tolerance)
+{
+  wolf->interpolation_tolerance = interpolation_tolerance;
+}
+
+
+void ifcs_wolf_get_interpolation_tolerance(ifcs_wolf_t *wolf, fcs_float *interpolation_tolerance)
+{
+  *interpolation_tolerance = wolf->interpolation_tolerance;
+}
+
+
 void ifcs_wolf_set_resort(ifcs_wolf_t *wolf, fcs_int resort)
 {
   wolf->resort = resort;
@@ -243,6 +309,7 @@ static void wolf_print_particles(fcs_int n, fcs_float *xyz, fcs_float *q, fcs_fl
 
 typedef struct {
   fcs_float alpha, p_shift, f_shift;
+  const fcs_erfc_table_t *table;
 
 } wolf_coulomb_field_potential_t;
 
@@ -264,7 +331,20 @@ static void wolf_coulomb_field_potential(const void *param, fcs_float dist, fcs_
   *f = -(erfc_part_ri + 2.0 * wcfp->alpha * 0.56418958354775627928034964498 * exp(-adist * adist)) / dist - wcfp->f_shift; /* FIXME: use fcs-type constant for 1/sqrt(pi) */
 }
 
-static FCS_NEAR_LOOP_FP(wolf_coulomb_loop_fp, wolf_coulomb_field_potential)
+static FCS_NEAR_BATCH_FP(wolf_coulomb_batch_fp, wolf_coulomb_field_potential)
+
+
+static void wolf_coulomb_field_potential_table(const void *param, fcs_float dist, fcs_float *f, fcs_float *p)
+{
+  wolf_coulomb_field_potential_t *wcfp = (wolf_coulomb_field_potential_t *) param;
+
+  fcs_erfc_table_field_potential(wcfp->table, dist, f, p);
+
+  *p -= wcfp->p_shift;
+  *f -= wcfp->f_shift;
+}
+
+static FCS_NEAR_BATCH_FP(wolf_coulomb_batch_fp_table, wolf_coulomb_field_potential_table)
 
 
 void ifcs_wolf_run(ifcs_wolf_t *wolf, MPI_Comm comm)
@@ -299,6 +379,9 @@ void ifcs_wolf_run(ifcs_wolf_t *wolf, MPI_Comm comm)
       printf(INFO_PRINT_PREFIX "box_c: [%" FCS_LMOD_FLOAT "f, %" FCS_LMOD_FLOAT "f, %" FCS_LMOD_FLOAT "f]\n", wolf->box_c[0], wolf->box_c[1], wolf->box_c[2]);
       printf(INFO_PRINT_PREFIX "cutoff: %" FCS_LMOD_FLOAT "f\n", wolf->cutoff);
       printf(INFO_PRINT_PREFIX "alpha: %" FCS_LMOD_FLOAT "f\n", wolf->alpha);
+      printf(INFO_PRINT_PREFIX "verlet skin: %" FCS_LMOD_FLOAT "f\n", wolf->verlet_skin);
+      printf(INFO_PRINT_PREFIX "balance: %" FCS_LMOD_INT "d\n", wolf->balance);
+      printf(INFO_PRINT_PREFIX "interpolation: %" FCS_LMOD_INT "d (tolerance: %" FCS_LMOD_FLOAT "e)\n", wolf->interpolation_order, wolf->interpolation_tolerance);
     }
   );
 
@@ -313,12 +396,28 @@ void ifcs_wolf_run(ifcs_wolf_t *wolf, MPI_Comm comm)
 
   fcs_near_create(&near);
 
-  fcs_near_set_loop(&near, wolf_coulomb_loop_fp);
+  /* interpolation tables are kept between the runs and only recomputed if the parameters change */
+  wcfp.table = NULL;
+  if (wolf->interpolation_order >= 0 && fcs_erfc_table_create(&wolf->erfc_table, wolf->interpolation_order, wolf->interpolation_tolerance, wolf->alpha, wolf->cutoff) > 0)
+    wcfp.table = &wolf->erfc_table;
+
+  fcs_near_set_field_potential_batch(&near, (wcfp.table) ? wolf_coulomb_batch_fp_table : wolf_coulomb_batch_fp);
   fcs_near_set_system(&near, wolf->box_base, wolf->box_a, wolf->box_b, wolf->box_c, wolf->periodicity);
   fcs_near_set_particles(&near, wolf->nparticles, wolf->max_nparticles, wolf->positions, wolf->charges, NULL, wolf->field, wolf->potentials);
   fcs_near_set_max_particle_move(&near, wolf->max_particle_move);
   fcs_near_set_resort(&near, wolf->resort);
 
+  /* balanced process domains are kept between the runs as long as they remain balanced */
+  fcs_near_set_balance(&near, wolf->balance, &wolf->gridsort_cache);
+
+  /* persistent neighbour lists are kept between the runs */
+  if (wolf->verlet_skin > 0)
+  {
+    if (wolf->near_verlet == FCS_NEAR_VERLET_NULL) fcs_near_verlet_create(&wolf->near_verlet, wolf->verlet_skin);
+
+    fcs_near_set_verlet(&near, wolf->near_verlet);
+  }
+
   fcs_float acutoff = wolf->alpha * wolf->cutoff;
   fcs_float erfc_part_ri = erfc(acutoff) / wolf->cutoff;
 
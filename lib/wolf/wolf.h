@@ -26,9 +26,14 @@ extern "C" {
 #endif
 
 
+#include "common/fcs-common/FCSInterpolate.h"
 #include "common/near/near.h"
 
 
+/* default accuracy of the (optional) interpolation tables of the near field kernel */
+#define WOLF_DEFAULT_INTERPOLATION_TOLERANCE  1e-6
+
+
 typedef struct _ifcs_wolf_t
 {
   fcs_float box_base[3], box_a[3], box_b[3], box_c[3];
@@ -46,6 +51,16 @@ typedef struct _ifcs_wolf_t
   fcs_int resort;
   fcs_near_resort_t near_resort;
 
+  fcs_float verlet_skin;
+  fcs_near_verlet_t near_verlet;
+
+  fcs_int balance;
+  fcs_gridsort_cache_t gridsort_cache;
+
+  fcs_int interpolation_order;
+  fcs_float interpolation_tolerance;
+  fcs_erfc_table_t erfc_table;
+
 } ifcs_wolf_t;
 
 
@@ -58,6 +73,14 @@ void ifcs_wolf_get_cutoff(ifcs_wolf_t *wolf, fcs_float *cutoff);
 void ifcs_wolf_set_alpha(ifcs_wolf_t *wolf, fcs_float alpha);
 void ifcs_wolf_get_alpha(ifcs_wolf_t *wolf, fcs_float *alpha);
 void ifcs_wolf_set_max_particle_move(ifcs_wolf_t *wolf, fcs_float max_particle_move);
+void ifcs_wolf_set_verlet_skin(ifcs_wolf_t *wolf, fcs_float verlet_skin);
+void ifcs_wolf_get_verlet_skin(ifcs_wolf_t *wolf, fcs_float *verlet_skin);
+void ifcs_wolf_set_balance(ifcs_wolf_t *wolf, fcs_int balance);
+void ifcs_wolf_get_balance(ifcs_wolf_t *wolf, fcs_int *balance);
+void ifcs_wolf_set_interpolation_order(ifcs_wolf_t *wolf, fcs_int interpolation_order);
+void ifcs_wolf_get_interpolation_order(ifcs_wolf_t *wolf, fcs_int *interpolation_order);
+void ifcs_wolf_set_interpolation_tolerance(ifcs_wolf_t *wolf, fcs_float interpolation_tolerance);
+void ifcs_wolf_get_interpolation_tolerance(ifcs_wolf_t *wolf, fcs_float *interpolation_tolerance);
 void ifcs_wolf_set_resort(ifcs_wolf_t *wolf, fcs_int resort);
 void ifcs_wolf_get_resort(ifcs_wolf_t *wolf, fcs_int *resort);
 void ifcs_wolf_get_resort_availability(ifcs_wolf_t *wolf, fcs_int *availability);
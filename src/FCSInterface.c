@@ -897,6 +897,11 @@ FCSResult fcs_run(FCS handle, fcs_int local_particles,
 
   if (handle->shift_positions)
   {
+    /* with resorting, the local number of particles may have changed */
+    fcs_int resort_availability = 0;
+    if (handle->get_resort_availability) handle->get_resort_availability(handle, &resort_availability);
+    if (resort_availability) handle->get_resort_particles(handle, &local_particles);
+
     fcs_unshift_positions(local_particles, positions, original_box_origin);
     handle->box_origin[0] = original_box_origin[0];
     handle->box_origin[1] = original_box_origin[1];
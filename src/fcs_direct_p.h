@@ -76,6 +76,24 @@ FCSResult fcs_direct_set_cutoff_with_near(FCS handle, fcs_bool cutoff_with_near)
 FCSResult fcs_direct_get_cutoff_with_near(FCS handle, fcs_bool *cutoff_with_near);
 
 
+/**
+ * @brief function to set whether the distributed computations should pass the particles only around half the ring and compute each pair of processes only once
+ * @param handle FCS-object
+ * @param half_ring fcs_bool if true, then the half ring is used
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_direct_set_half_ring(FCS handle, fcs_bool half_ring);
+
+
+/**
+ * @brief function to get whether the distributed computations pass the particles only around half the ring
+ * @param handle FCS-object
+ * @param half_ring fcs_bool whether the half ring is used
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_direct_get_half_ring(FCS handle, fcs_bool *half_ring);
+
+
 /**
  * @brief function to set whether the direct solver should use metallic boundary conditions for periodic systems
  * @param handle FCS-object
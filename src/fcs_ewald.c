@@ -99,6 +99,10 @@ FCSResult fcs_ewald_init(FCS handle)
   d->r_cut = 0.0;
   d->kmax = 0;
   d->maxkmax = MAXKMAX_DEFAULT;
+  d->interpolation_order = -1;
+  fcs_erfc_table_init(&d->erfc_table);
+  d->balance = 0;
+  d->gridsort_cache = FCS_GRIDSORT_CACHE_NULL;
   /* d->alpha = 1.0; */
   /* d->r_cut = 3.0; */
   /* d->kmax = 40; */
@@ -161,6 +165,63 @@ FCSResult fcs_ewald_get_maxkmax(FCS handle, fcs_int *maxkmax)
   return FCS_RESULT_SUCCESS;
 }
 
+FCSResult fcs_ewald_set_interpolation_order(FCS handle, fcs_int interpolation_order)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  EWALD_CHECK_RETURN_RESULT(handle, __func__);
+  
+  ewald_data_struct *d = (ewald_data_struct*)handle->method_context;
+  if (interpolation_order != d->interpolation_order) d->needs_retune = 1;
+  d->interpolation_order = interpolation_order;
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_ewald_get_interpolation_order(FCS handle, fcs_int *interpolation_order)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  EWALD_CHECK_RETURN_RESULT(handle, __func__);
+
+  ewald_data_struct *d = (ewald_data_struct*)handle->method_context;
+  *interpolation_order = d->interpolation_order;
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_ewald_set_balance(FCS handle, fcs_int balance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  EWALD_CHECK_RETURN_RESULT(handle, __func__);
+  
+  ewald_data_struct *d = (ewald_data_struct*)handle->method_context;
+  d->balance = balance;
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_ewald_get_balance(FCS handle, fcs_int *balance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  EWALD_CHECK_RETURN_RESULT(handle, __func__);
+
+  ewald_data_struct *d = (ewald_data_struct*)handle->method_context;
+  *balance = d->balance;
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
 FCSResult fcs_ewald_set_kmax(FCS handle, fcs_int kmax)
 {
   FCS_DEBUG_FUNC_INTRO(__func__);
@@ -601,6 +662,14 @@ FCSResult fcs_ewald_tune(FCS handle,
       d->G[linindex(nx, ny, nz, d->kmax)] = 1.0/V * 4.0*M_PI/ksqr * exp(-ksqr/(4*SQR(alpha)));
   }
 
+  /* Create near field interpolation tables (the interpolation error should be small compared to the required accuracy) */
+  if (d->interpolation_order >= 0)
+  {
+    fcs_int num_nodes = fcs_erfc_table_create(&d->erfc_table, d->interpolation_order, 0.1 * d->tolerance_field, d->alpha, d->r_cut);
+    FCS_INFO(fprintf(stderr, "    interpolation tables with %" FCS_LMOD_INT "d nodes\n", num_nodes));
+
+  } else fcs_erfc_table_destroy(&d->erfc_table);
+
   d->needs_retune = 0;
 
   FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
@@ -720,6 +789,8 @@ FCSResult fcs_ewald_set_parameter(FCS handle, fcs_bool continue_on_errors, char
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("ewald_kmax",    ewald_set_kmax,    FCS_PARSE_VAL(fcs_int));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("ewald_r_cut",   ewald_set_r_cut,   FCS_PARSE_VAL(fcs_float));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("ewald_alpha",   ewald_set_alpha,   FCS_PARSE_VAL(fcs_float));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("ewald_interpolation_order", ewald_set_interpolation_order, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("ewald_balance", ewald_set_balance, FCS_PARSE_VAL(fcs_int));
 
   return FCS_RESULT_SUCCESS;
 
@@ -766,6 +837,9 @@ FCSResult fcs_ewald_print_parameters(FCS handle)
   else
     printf("ewald alpha=%" FCS_LMOD_FLOAT "f\n", d->alpha);
 
+  printf("ewald interpolation_order=%" FCS_LMOD_INT "d\n", d->interpolation_order);
+  printf("ewald balance=%" FCS_LMOD_INT "d\n", d->balance);
+
   FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
 
   return FCS_RESULT_SUCCESS;
@@ -786,6 +860,8 @@ FCSResult fcs_ewald_destroy(FCS handle)
   if (handle->method_context != NULL) {
     ewald_data_struct *d = (ewald_data_struct*)handle->method_context;
     sfree(d->G);
+    fcs_erfc_table_destroy(&d->erfc_table);
+    fcs_gridsort_release_cache(&d->gridsort_cache);
     sfree(d->far_fields);
     sfree(d->near_fields);
     sfree(d->far_potentials);
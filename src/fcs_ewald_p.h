@@ -50,6 +50,14 @@ FCSResult fcs_ewald_set_tolerance_field(FCS handle, fcs_float tolerance_field_ab
 FCSResult fcs_ewald_set_tolerance_field_tune(FCS handle);
 FCSResult fcs_ewald_get_tolerance_field(FCS handle, fcs_float* tolerance_field_abs);
 
+/* order of the near field interpolation tables (-1: no interpolation (default), 0: constant, 1: linear, 2: quadratic, 3: cubic) */
+FCSResult fcs_ewald_set_interpolation_order(FCS handle, fcs_int interpolation_order);
+FCSResult fcs_ewald_get_interpolation_order(FCS handle, fcs_int *interpolation_order);
+
+/* load balancing of the process domains of the near field computations (0: regular process domains (default), 1: balanced process domains) */
+FCSResult fcs_ewald_set_balance(FCS handle, fcs_int balance);
+FCSResult fcs_ewald_get_balance(FCS handle, fcs_int *balance);
+
 #ifdef __cplusplus
 }
 #endif
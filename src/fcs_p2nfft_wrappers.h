@@ -77,6 +77,7 @@ FCS_P2NFFT_INTERFACE_WRAPPER_1(virial_is_active, virial_is_active, fcs_int*,   y
 FCS_P2NFFT_SET_GET_WRAPPER_1(ignore_tolerance, ignore_tolerance, fcs_int, set_ignore_tolerance)
 FCS_P2NFFT_SET_GET_WRAPPER_1(ignore_potential, ignore_potential, fcs_int, set_ignore_potential)
 FCS_P2NFFT_SET_GET_WRAPPER_1(ignore_field,     ignore_field,     fcs_int, set_ignore_field)
+FCS_P2NFFT_SET_GET_WRAPPER_1(tune_cache,       tune_cache,       fcs_int, set_tune_cache)
 
 /************************************************************
  *     Setter and Getter functions for pnfft parameters
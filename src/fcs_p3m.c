@@ -59,6 +59,14 @@ FCSResult fcs_p3m_init(FCS handle)
   handle->print_parameters = fcs_p3m_print_parameters;
   handle->tune = fcs_p3m_tune;
   handle->run = fcs_p3m_run;
+  handle->set_max_particle_move = fcs_p3m_set_max_particle_move;
+  handle->set_resort = fcs_p3m_set_resort;
+  handle->get_resort = fcs_p3m_get_resort;
+  handle->get_resort_availability = fcs_p3m_get_resort_availability;
+  handle->get_resort_particles = fcs_p3m_get_resort_particles;
+  handle->resort_ints = fcs_p3m_resort_ints;
+  handle->resort_floats = fcs_p3m_resort_floats;
+  handle->resort_bytes = fcs_p3m_resort_bytes;
 
   ifcs_p3m_init(&handle->method_context, handle->communicator);
 
@@ -327,6 +335,127 @@ FCSResult fcs_p3m_get_cao(FCS handle, fcs_int *cao) {
   return FCS_RESULT_SUCCESS;
 }
 
+FCSResult fcs_p3m_set_variant(FCS handle, fcs_int variant) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_variant(handle->method_context, variant);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_set_variant_tune(FCS handle) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_variant_tune(handle->method_context);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_variant(FCS handle, fcs_int *variant) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_variant(handle->method_context, variant);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_set_interpolation_order(FCS handle, fcs_int interpolation_order) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_interpolation_order(handle->method_context, interpolation_order);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_interpolation_order(FCS handle, fcs_int *interpolation_order) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_interpolation_order(handle->method_context, interpolation_order);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_set_overlap_near(FCS handle, fcs_int overlap_near) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_overlap_near(handle->method_context, overlap_near);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_overlap_near(FCS handle, fcs_int *overlap_near) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_overlap_near(handle->method_context, overlap_near);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_set_fftw_rigor(FCS handle, fcs_int fftw_rigor) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  if (fftw_rigor < 0 || fftw_rigor > 3)
+    return fcs_result_create(FCS_ERROR_WRONG_ARGUMENT, __func__,
+      "p3m_fftw_rigor has to be 0 (estimate), 1 (measure), 2 (patient) or 3 (exhaustive).");
+
+  ifcs_p3m_set_fftw_rigor(handle->method_context, fftw_rigor);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_fftw_rigor(FCS handle, fcs_int *fftw_rigor) {
+
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_fftw_rigor(handle->method_context, fftw_rigor);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
 FCSResult fcs_p3m_require_total_energy(FCS handle, fcs_int flag) {
 
   FCS_DEBUG_FUNC_INTRO(__func__);
@@ -460,7 +589,12 @@ FCSResult fcs_p3m_set_parameter(FCS handle, fcs_bool continue_on_errors, char **
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_alpha",                p3m_set_alpha,            FCS_PARSE_VAL(fcs_float));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_grid",                 p3m_set_grid,             FCS_PARSE_VAL(fcs_int));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_cao",                  p3m_set_cao,              FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_variant",              p3m_set_variant,          FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC0_GOTO_NEXT("p3m_variant_tune",         p3m_set_variant_tune);
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_require_total_energy", p3m_require_total_energy, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_interpolation_order",  p3m_set_interpolation_order, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_overlap_near",         p3m_set_overlap_near,     FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("p3m_fftw_rigor",           p3m_set_fftw_rigor,       FCS_PARSE_VAL(fcs_int));
 
   return FCS_RESULT_SUCCESS;
 
@@ -483,6 +617,22 @@ FCSResult fcs_p3m_print_parameters(FCS handle)
   fcs_p3m_get_tolerance_field(handle, &tolerance);
   printf("p3m absolute field tolerance: %" FCS_LMOD_FLOAT "e\n", tolerance);
 
+  fcs_int variant;
+  fcs_p3m_get_variant(handle, &variant);
+  printf("p3m variant: %" FCS_LMOD_INT "d\n", variant);
+
+  fcs_int interpolation_order;
+  fcs_p3m_get_interpolation_order(handle, &interpolation_order);
+  printf("p3m near field interpolation order: %" FCS_LMOD_INT "d\n", interpolation_order);
+
+  fcs_int overlap_near;
+  fcs_p3m_get_overlap_near(handle, &overlap_near);
+  printf("p3m overlap near field with far field communication: %" FCS_LMOD_INT "d\n", overlap_near);
+
+  fcs_int fftw_rigor;
+  fcs_p3m_get_fftw_rigor(handle, &fftw_rigor);
+  printf("p3m rigor of the FFTW plans: %" FCS_LMOD_INT "d\n", fftw_rigor);
+
   FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
 
   return FCS_RESULT_SUCCESS;
@@ -513,3 +663,111 @@ fcs_int fcs_p3m_get_potential_shift(FCS handle) {
 
   return r;
 }
+
+/************************************************************
+ *     Resort support
+ ************************************************************/
+
+FCSResult fcs_p3m_set_max_particle_move(FCS handle, fcs_float max_particle_move)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_max_particle_move(handle->method_context, max_particle_move);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_set_resort(FCS handle, fcs_int resort)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_set_resort(handle->method_context, resort);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_resort(FCS handle, fcs_int *resort)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_resort(handle->method_context, resort);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_resort_availability(FCS handle, fcs_int *availability)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_resort_availability(handle->method_context, availability);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_get_resort_particles(FCS handle, fcs_int *resort_particles)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_get_resort_particles(handle->method_context, resort_particles);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_resort_ints(FCS handle, fcs_int *src, fcs_int *dst, fcs_int n, MPI_Comm comm)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_resort_ints(handle->method_context, src, dst, n, comm);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_resort_floats(FCS handle, fcs_float *src, fcs_float *dst, fcs_int n, MPI_Comm comm)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_resort_floats(handle->method_context, src, dst, n, comm);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+FCSResult fcs_p3m_resort_bytes(FCS handle, void *src, void *dst, fcs_int n, MPI_Comm comm)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  P3M_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_p3m_resort_bytes(handle->method_context, src, dst, n, comm);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
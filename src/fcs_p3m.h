@@ -86,4 +86,13 @@ FCSResult fcs_p3m_set_potential_shift(FCS handle, fcs_int flag);
 
 fcs_int fcs_p3m_get_potential_shift(FCS handle);
 
+FCSResult fcs_p3m_set_max_particle_move(FCS handle, fcs_float max_particle_move);
+FCSResult fcs_p3m_set_resort(FCS handle, fcs_int resort);
+FCSResult fcs_p3m_get_resort(FCS handle, fcs_int *resort);
+FCSResult fcs_p3m_get_resort_availability(FCS handle, fcs_int *availability);
+FCSResult fcs_p3m_get_resort_particles(FCS handle, fcs_int *resort_particles);
+FCSResult fcs_p3m_resort_ints(FCS handle, fcs_int *src, fcs_int *dst, fcs_int n, MPI_Comm comm);
+FCSResult fcs_p3m_resort_floats(FCS handle, fcs_float *src, fcs_float *dst, fcs_int n, MPI_Comm comm);
+FCSResult fcs_p3m_resort_bytes(FCS handle, void *src, void *dst, fcs_int n, MPI_Comm comm);
+
 #endif
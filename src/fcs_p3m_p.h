@@ -233,6 +233,23 @@ FCSResult fcs_p3m_set_cao(FCS handle, fcs_int cao);
 FCSResult fcs_p3m_set_cao_tune(FCS handle);
 FCSResult fcs_p3m_get_cao(FCS handle, fcs_int *cao);
 
+/* variant of the algorithm (0: ik-differentiation, 1: analytical differentiation with interlacing, default: 0) */
+FCSResult fcs_p3m_set_variant(FCS handle, fcs_int variant);
+FCSResult fcs_p3m_set_variant_tune(FCS handle);
+FCSResult fcs_p3m_get_variant(FCS handle, fcs_int *variant);
+
+/* order of the near field interpolation tables (-1: no interpolation (default), 0: constant, 1: linear, 2: quadratic, 3: cubic) */
+FCSResult fcs_p3m_set_interpolation_order(FCS handle, fcs_int interpolation_order);
+FCSResult fcs_p3m_get_interpolation_order(FCS handle, fcs_int *interpolation_order);
+
+/* compute the near field while the far field waits for messages (0: no (default), 1: yes) */
+FCSResult fcs_p3m_set_overlap_near(FCS handle, fcs_int overlap_near);
+FCSResult fcs_p3m_get_overlap_near(FCS handle, fcs_int *overlap_near);
+
+/* rigor of the FFTW plans of the tuned parameters (0: estimate, 1: measure, 2: patient (default), 3: exhaustive) */
+FCSResult fcs_p3m_set_fftw_rigor(FCS handle, fcs_int fftw_rigor);
+FCSResult fcs_p3m_get_fftw_rigor(FCS handle, fcs_int *fftw_rigor);
+
 FCSResult fcs_p3m_require_total_energy(FCS handle, fcs_int total_energy);
 FCSResult fcs_p3m_get_total_energy(FCS handle, fcs_float *total_energy);
 
@@ -245,13 +262,6 @@ void fcs_p3m_set_tolerance_field_f(void *handle, fcs_float tolerance_field, fcs_
 FCSResult fcs_p3m_set_tolerance_field_tune(FCS handle);
 FCSResult fcs_p3m_get_tolerance_field(FCS handle, fcs_float *tolerance_field);
 
-
-
-  /*
-FCSResult fcs_p3m_set_variant(FCS handle, fcs_int variant);
-FCSResult fcs_p3m_get_variant(FCS handle, fcs_int *variant);
-  */
-
 #ifdef __cplusplus
 }
 #endif
@@ -64,6 +64,7 @@ FCSResult fcs_vmg_init(FCS handle)
   handle->vmg_param->near_field_cells = -1;
   handle->vmg_param->interpolation_order = -1;
   handle->vmg_param->discretization_order = -1;
+  handle->vmg_param->coarse_points = -1;
 
   return FCS_RESULT_SUCCESS;
 }
@@ -100,6 +101,7 @@ FCSResult fcs_vmg_tune(FCS handle, fcs_int local_particles,
   fcs_int near_field_cells;
   fcs_int interpolation_order;
   fcs_int discretization_order;
+  fcs_int coarse_points;
 
   result = fcs_vmg_get_max_level(handle, &level);
   if (result)
@@ -138,12 +140,16 @@ FCSResult fcs_vmg_tune(FCS handle, fcs_int local_particles,
   if (result)
     return result;
 
+  result  = fcs_vmg_get_coarse_points(handle, &coarse_points);
+  if (result)
+    return result;
+
   MPI_Comm comm = fcs_get_communicator(handle);
 
   VMG_fcs_setup(level, periodic, max_iter, smoothing_steps,
 		cycle_type, precision, offset, box_a[0],
 		near_field_cells, interpolation_order,
-		discretization_order, comm);
+		discretization_order, coarse_points, comm);
 
   result = fcs_vmg_library_check(handle);
   if (result)
@@ -329,6 +335,17 @@ FCSResult fcs_vmg_set_default(FCS handle)
     fcs_vmg_set_discretization_order(handle, discretization_order);
   }
 
+  fcs_int coarse_points;
+  fcs_vmg_get_coarse_points(handle, &coarse_points);
+  if (coarse_points < 0) {
+    coarse_points = 0;
+#ifdef FCS_ENABLE_DEBUG
+    if (rank == 0)
+      printf("%s: Parameter %s not set. Set default to %d.\n", __func__, "coarse_points", coarse_points);
+#endif
+    fcs_vmg_set_coarse_points(handle, coarse_points);
+  }
+
   return FCS_RESULT_SUCCESS;
 }
 
@@ -646,6 +663,47 @@ FCSResult fcs_vmg_get_discretization_order(FCS handle, fcs_int* discretization_o
   return FCS_RESULT_SUCCESS;
 }
 
+/**
+ * @brief Set the minimum number of grid points per process on the
+ *        coarse levels. Coarser levels are gathered onto fewer
+ *        processes until each of them holds at least this many
+ *        points. A value of 0 (default) disables the agglomeration.
+ *
+ * @param handle FCS-object that contains the parameter.
+ * @param coarse_points Minimum number of grid points per process.
+ *
+ * @return FCSResult-object containing the return value.
+ */
+FCSResult fcs_vmg_set_coarse_points(FCS handle, fcs_int coarse_points)
+{
+  VMG_CHECK_RETURN_RESULT(handle, __func__);
+
+  if (coarse_points < 0)
+    return fcs_result_create(FCS_ERROR_WRONG_ARGUMENT, __func__, "coarse_points must not be negative.");
+
+  handle->vmg_param->coarse_points = coarse_points;
+
+  return FCS_RESULT_SUCCESS;
+}
+
+/**
+ * @brief Get the minimum number of grid points per process on the
+ *        coarse levels.
+ *
+ * @param handle FCS-object that contains the parameter.
+ * @param coarse_points Minimum number of grid points per process.
+ *
+ * @return FCSResult-object containing the return value.
+ */
+FCSResult fcs_vmg_get_coarse_points(FCS handle, fcs_int* coarse_points)
+{
+  VMG_CHECK_RETURN_RESULT(handle, __func__);
+
+  *coarse_points = handle->vmg_param->coarse_points;
+
+  return FCS_RESULT_SUCCESS;
+}
+
 FCSResult fcs_vmg_check(FCS handle)
 {
   FCSResult result;
@@ -722,6 +780,15 @@ FCSResult fcs_vmg_check(FCS handle)
   if (discretization_order != 2 && discretization_order != 4)
     return fcs_result_create(FCS_ERROR_WRONG_ARGUMENT, __func__, "vmg discretization order must be 2 or 4.");
 
+  fcs_int coarse_points;
+  result = fcs_vmg_get_coarse_points(handle, &coarse_points);
+  CHECK_RESULT_RETURN(result);
+
+  if (coarse_points == -1)
+    return fcs_result_create(FCS_ERROR_MISSING_ELEMENT, __func__, "vmg number of coarse grid points per process not set.");
+  if (coarse_points < 0)
+    return fcs_result_create(FCS_ERROR_WRONG_ARGUMENT, __func__, "vmg number of coarse grid points per process must not be negative.");
+
   const fcs_float* box_a = fcs_get_box_a(handle);
   const fcs_float* box_b = fcs_get_box_b(handle);
   const fcs_float* box_c = fcs_get_box_c(handle);
@@ -768,6 +835,7 @@ FCSResult fcs_vmg_set_parameter(FCS handle, fcs_bool continue_on_errors, char **
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("vmg_near_field_cells",     vmg_set_near_field_cells,     FCS_PARSE_VAL(fcs_int));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("vmg_interpolation_order",  vmg_set_interpolation_order,  FCS_PARSE_VAL(fcs_int));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("vmg_discretization_order", vmg_set_discretization_order, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("vmg_coarse_points",        vmg_set_coarse_points,        FCS_PARSE_VAL(fcs_int));
 
   return FCS_RESULT_SUCCESS;
 
@@ -791,6 +859,7 @@ FCSResult fcs_vmg_print_parameters(FCS handle)
   fcs_int near_field_cells;
   fcs_int interpolation_order;
   fcs_int discretization_order;
+  fcs_int coarse_points;
 
   VMG_CHECK_RETURN_RESULT(handle, __func__);
 
@@ -802,6 +871,7 @@ FCSResult fcs_vmg_print_parameters(FCS handle)
   fcs_vmg_get_near_field_cells(handle, &near_field_cells);
   fcs_vmg_get_interpolation_order(handle, &interpolation_order);
   fcs_vmg_get_discretization_order(handle, &discretization_order);
+  fcs_vmg_get_coarse_points(handle, &coarse_points);
 
   printf("vmg max level:            %" FCS_LMOD_INT "d\n", level);
   printf("vmg max iterations:       %" FCS_LMOD_INT "d\n", max_iter);
@@ -811,6 +881,7 @@ FCSResult fcs_vmg_print_parameters(FCS handle)
   printf("vmg near field cells:     %" FCS_LMOD_INT "d\n", near_field_cells);
   printf("vmg interpolation degree: %" FCS_LMOD_INT "d\n", interpolation_order);
   printf("vmg discretization order: %" FCS_LMOD_INT "d\n", discretization_order);
+  printf("vmg coarse points:        %" FCS_LMOD_INT "d\n", coarse_points);
   
   return FCS_RESULT_SUCCESS;
 }
@@ -233,6 +233,30 @@ FCSResult fcs_vmg_set_discretization_order(FCS handle, fcs_int discretization_or
  */
 FCSResult fcs_vmg_get_discretization_order(FCS handle, fcs_int *discretization_order);
 
+/**
+ * @brief Set the minimum number of grid points per process on the
+ *        coarse levels. Coarser levels are gathered onto fewer
+ *        processes until each of them holds at least this many
+ *        points. A value of 0 (default) disables the agglomeration.
+ *
+ * @param handle FCS-object that contains the parameter.
+ * @param coarse_points Minimum number of grid points per process.
+ *
+ * @return FCSResult-object containing the return value.
+ */
+FCSResult fcs_vmg_set_coarse_points(FCS handle, fcs_int coarse_points);
+
+/**
+ * @brief Get the minimum number of grid points per process on the
+ *        coarse levels.
+ *
+ * @param handle FCS-object that contains the parameter.
+ * @param coarse_points Minimum number of grid points per process.
+ *
+ * @return FCSResult-object containing the return value.
+ */
+FCSResult fcs_vmg_get_coarse_points(FCS handle, fcs_int *coarse_points);
+
 /**
  * @brief Print runtimes of various vmg subsystems. vmg has to be configured
  *        with --enable-debug-measure-time in order to do so.
@@ -232,6 +232,10 @@ FCSResult fcs_wolf_set_parameter(FCS handle, fcs_bool continue_on_errors, char *
 
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_cutoff", wolf_set_cutoff, FCS_PARSE_VAL(fcs_float));
   FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_alpha", wolf_set_alpha, FCS_PARSE_VAL(fcs_float));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_verlet_skin", wolf_set_verlet_skin, FCS_PARSE_VAL(fcs_float));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_balance", wolf_set_balance, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_interpolation_order", wolf_set_interpolation_order, FCS_PARSE_VAL(fcs_int));
+  FCS_PARSE_IF_PARAM_THEN_FUNC1_GOTO_NEXT("wolf_interpolation_tolerance", wolf_set_interpolation_tolerance, FCS_PARSE_VAL(fcs_float));
 
   return FCS_RESULT_SUCCESS;
 
@@ -247,15 +251,24 @@ next_param:
 
 FCSResult fcs_wolf_print_parameters(FCS handle)
 {
-  fcs_float cutoff, alpha;
+  fcs_float cutoff, alpha, verlet_skin, interpolation_tolerance;
+  fcs_int balance, interpolation_order;
 
   FCS_DEBUG_FUNC_INTRO(__func__);
 
   fcs_wolf_get_cutoff(handle, &cutoff);
   fcs_wolf_get_alpha(handle, &alpha);
+  fcs_wolf_get_verlet_skin(handle, &verlet_skin);
+  fcs_wolf_get_balance(handle, &balance);
+  fcs_wolf_get_interpolation_order(handle, &interpolation_order);
+  fcs_wolf_get_interpolation_tolerance(handle, &interpolation_tolerance);
 
   printf("wolf cutoff: %" FCS_LMOD_FLOAT "f\n", cutoff);
   printf("wolf alpha: %" FCS_LMOD_FLOAT "f\n", alpha);
+  printf("wolf verlet skin: %" FCS_LMOD_FLOAT "f\n", verlet_skin);
+  printf("wolf balance: %" FCS_LMOD_INT "d\n", balance);
+  printf("wolf interpolation order: %" FCS_LMOD_INT "d\n", interpolation_order);
+  printf("wolf interpolation tolerance: %" FCS_LMOD_FLOAT "e\n", interpolation_tolerance);
 
   FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
   
@@ -319,6 +332,118 @@ FCSResult fcs_wolf_get_alpha(FCS handle, fcs_float *alpha)
 }
 
 
+FCSResult fcs_wolf_set_verlet_skin(FCS handle, fcs_float verlet_skin)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_set_verlet_skin(&handle->wolf_param->wolf, verlet_skin);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_get_verlet_skin(FCS handle, fcs_float *verlet_skin)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_get_verlet_skin(&handle->wolf_param->wolf, verlet_skin);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_set_balance(FCS handle, fcs_int balance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_set_balance(&handle->wolf_param->wolf, balance);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_get_balance(FCS handle, fcs_int *balance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_get_balance(&handle->wolf_param->wolf, balance);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_set_interpolation_order(FCS handle, fcs_int interpolation_order)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_set_interpolation_order(&handle->wolf_param->wolf, interpolation_order);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_get_interpolation_order(FCS handle, fcs_int *interpolation_order)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_get_interpolation_order(&handle->wolf_param->wolf, interpolation_order);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_set_interpolation_tolerance(FCS handle, fcs_float interpolation_tolerance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_set_interpolation_tolerance(&handle->wolf_param->wolf, interpolation_tolerance);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
+FCSResult fcs_wolf_get_interpolation_tolerance(FCS handle, fcs_float *interpolation_tolerance)
+{
+  FCS_DEBUG_FUNC_INTRO(__func__);
+
+  WOLF_CHECK_RETURN_RESULT(handle, __func__);
+
+  ifcs_wolf_get_interpolation_tolerance(&handle->wolf_param->wolf, interpolation_tolerance);
+
+  FCS_DEBUG_FUNC_OUTRO(__func__, FCS_RESULT_SUCCESS);
+
+  return FCS_RESULT_SUCCESS;
+}
+
+
 FCSResult fcs_wolf_set_max_particle_move(FCS handle, fcs_float max_particle_move)
 {
   FCS_DEBUG_FUNC_INTRO(__func__);
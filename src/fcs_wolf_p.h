@@ -78,6 +78,81 @@ FCSResult fcs_wolf_set_alpha(FCS handle, fcs_float alpha);
 FCSResult fcs_wolf_get_alpha(FCS handle, fcs_float *alpha);
 
 
+/**
+ * @brief function to set the skin of the persistent neighbour lists (a skin of zero disables the neighbour lists),
+ * the lists are reused between runs until particles have moved more than half of the skin
+ * @param handle FCS-object
+ * @param verlet_skin skin of the neighbour lists beyond the cutoff radius
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_set_verlet_skin(FCS handle, fcs_float verlet_skin);
+
+
+/**
+ * @brief function to get the current skin of the persistent neighbour lists
+ * @param handle FCS-object
+ * @param verlet_skin current skin of the neighbour lists
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_get_verlet_skin(FCS handle, fcs_float *verlet_skin);
+
+
+/**
+ * @brief function to set whether the process domains are balanced according to the particle distribution,
+ * the balanced domains are reused between runs as long as the load imbalance stays low
+ * @param handle FCS-object
+ * @param balance whether to balance the process domains (0: regular process domains (default), 1: balanced process domains)
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_set_balance(FCS handle, fcs_int balance);
+
+
+/**
+ * @brief function to get whether the process domains are balanced
+ * @param handle FCS-object
+ * @param balance whether the process domains are balanced
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_get_balance(FCS handle, fcs_int *balance);
+
+
+/**
+ * @brief function to set the order of the interpolation tables used for the near field kernel
+ * (-1: no interpolation (default), 0: constant, 1: linear, 2: quadratic, 3: cubic)
+ * @param handle FCS-object
+ * @param interpolation_order interpolation order
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_set_interpolation_order(FCS handle, fcs_int interpolation_order);
+
+
+/**
+ * @brief function to get the current order of the interpolation tables
+ * @param handle FCS-object
+ * @param interpolation_order current interpolation order
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_get_interpolation_order(FCS handle, fcs_int *interpolation_order);
+
+
+/**
+ * @brief function to set the accuracy of the interpolation tables, the number of table entries is chosen accordingly
+ * @param handle FCS-object
+ * @param interpolation_tolerance requested absolute accuracy of the interpolated kernel
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_set_interpolation_tolerance(FCS handle, fcs_float interpolation_tolerance);
+
+
+/**
+ * @brief function to get the current accuracy of the interpolation tables
+ * @param handle FCS-object
+ * @param interpolation_tolerance current accuracy of the interpolated kernel
+ * @return FCSResult-object containing the return state
+ */
+FCSResult fcs_wolf_get_interpolation_tolerance(FCS handle, fcs_float *interpolation_tolerance);
+
+
 /**
  * @brief function to set all solver parameters
  * @param handle FCS-object
@@ -0,0 +1,52 @@
+#! /bin/sh
+
+# Helper functions for the tests with scafacos_test,
+# to be sourced by the test scripts after ../defs.
+
+# run_scafacos_test NPROC [SCAFACOS_TEST-OPTIONS].. METHOD FILE
+# Run scafacos_test with NPROC processes and keep its output in $output,
+# fail if scafacos_test fails or reports an error.
+run_scafacos_test ()
+{
+  nproc=$1
+  shift
+  output=`start_mpi_job -np $nproc ./scafacos_test "$@" 2>&1`
+  ret=$?
+  echo "$output"
+  test $ret -eq 0 || return 1
+  case $output in
+    *ERROR:*) return 1 ;;
+  esac
+  return 0
+}
+
+# get_value NAME
+# Print the last value NAME of the output of the last run (e.g. abs_rms_field_error).
+get_value ()
+{
+  echo "$output" | sed -n "s/^ *$1 *= *//p" | tail -n 1
+}
+
+# check_less NAME VALUE BOUND
+# Fail if VALUE is not a number below BOUND.
+check_less ()
+{
+  if awk "BEGIN { exit !($2 + 0 == $2 && $2 < $3) }" </dev/null; then
+    echo "$1: $2 < $3"
+    return 0
+  fi
+  echo "FAIL: $1: $2 is not below $3"
+  return 1
+}
+
+# check_equal NAME VALUE0 VALUE1 RELTOL
+# Fail if VALUE0 and VALUE1 differ by more than RELTOL relative to VALUE0.
+check_equal ()
+{
+  if awk "BEGIN { d = $2 - $3; if (d < 0) d = -d; r = $2; if (r < 0) r = -r; exit !(d <= $4 * r) }" </dev/null; then
+    echo "$1: $2 = $3"
+    return 0
+  fi
+  echo "FAIL: $1: $2 differs from $3 by more than $4"
+  return 1
+}
@@ -933,7 +933,8 @@ static void run_integration(FCS fcs, particles_t *parts, Testcase *testcase)
     MASTER(cout << "    Update positions..." << endl);
     integ_update_positions(&integ, parts->nparticles, parts->positions, NULL, v_cur, f_cur, parts->charges, &max_particle_move);
 
-    if (resort_availability && integ.max_move)
+    /* without resort support, the particles stay on their processes only if there is a single process */
+    if ((resort_availability || comm_size == 1) && integ.max_move)
     {
       MASTER(cout << "    Set max particle move = " << max_particle_move);
 
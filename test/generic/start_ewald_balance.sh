@@ -0,0 +1,16 @@
+#! /bin/sh
+
+. ../defs || exit 1
+. "$srcdir/generic_defs.sh" || exit 1
+
+# Ewald with balanced process domains on an inhomogeneous system,
+# the results have to be the same as with the regular process domains.
+system=systems/3d-periodic/cloud_wall_300.xml.gz
+
+run_scafacos_test 2 -c tolerance_field,1e-3,ewald_balance,0 ewald $system || exit 1
+err0=`get_value abs_rms_field_error`
+
+run_scafacos_test 2 -c tolerance_field,1e-3,ewald_balance,1 ewald $system || exit 1
+err1=`get_value abs_rms_field_error`
+
+check_equal abs_rms_field_error "$err0" "$err1" 1e-5 || exit 1
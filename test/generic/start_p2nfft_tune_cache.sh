@@ -0,0 +1,33 @@
+#! /bin/sh
+
+. ../defs || exit 1
+. "$srcdir/generic_defs.sh" || exit 1
+
+# P2NFFT with the tuning cache on an inhomogeneous system, the first run tunes and stores the parameters (miss),
+# the second run restores them (hit) and has to give the same results, changed PNFFT flags must not hit the entry.
+system=systems/3d-periodic/cloud_wall_300.xml.gz
+conf=tolerance_field,1e-3,p2nfft_tune_cache,1
+
+rm -f p2nfft-tune-*.dat
+
+run_scafacos_test 2 -c $conf p2nfft $system || exit 1
+err0=`get_value abs_rms_field_error`
+check_less abs_rms_field_error "$err0" 2e-3 || exit 1
+
+nentries=`ls p2nfft-tune-*.dat 2>/dev/null | wc -l`
+test $nentries -eq 1 || { echo "FAIL: $nentries tuning cache entries after a miss"; exit 1; }
+
+run_scafacos_test 2 -c $conf p2nfft $system || exit 1
+err1=`get_value abs_rms_field_error`
+check_equal abs_rms_field_error "$err0" "$err1" 1e-6 || exit 1
+
+nentries=`ls p2nfft-tune-*.dat 2>/dev/null | wc -l`
+test $nentries -eq 1 || { echo "FAIL: $nentries tuning cache entries after a hit"; exit 1; }
+
+run_scafacos_test 2 -c $conf,pnfft_fft_in_place,1 p2nfft $system || exit 1
+check_less abs_rms_field_error "`get_value abs_rms_field_error`" 2e-3 || exit 1
+
+nentries=`ls p2nfft-tune-*.dat 2>/dev/null | wc -l`
+test $nentries -eq 2 || { echo "FAIL: $nentries tuning cache entries after changed PNFFT flags"; exit 1; }
+
+rm -f p2nfft-tune-*.dat
@@ -0,0 +1,32 @@
+#! /bin/sh
+
+. ../defs || exit 1
+. "$srcdir/generic_defs.sh" || exit 1
+
+# P3M with the ik and the ad-i variant on a system of random charges (as assumed by the error estimates).
+system=systems/3d-periodic/random_300.xml.gz
+
+# the tuned parameters of both variants have to achieve (about) the required accuracy
+for variant in p3m_variant,0 p3m_variant,1 p3m_variant_tune; do
+  run_scafacos_test 2 -c tolerance_field,1e-3,$variant p3m $system || exit 1
+  check_less abs_rms_field_error "`get_value abs_rms_field_error`" 3e-3 || exit 1
+done
+
+# with the same parameters, ad-i has to be more accurate than ik
+params=tolerance_field,1,p3m_r_cut,4.0,p3m_alpha,0.9,p3m_grid,16,p3m_cao,5
+
+run_scafacos_test 2 -c $params,p3m_variant,0 p3m $system || exit 1
+err_ik=`get_value abs_rms_field_error`
+check_less abs_rms_field_error "$err_ik" 5e-3 || exit 1
+
+run_scafacos_test 2 -c $params,p3m_variant,1 p3m $system || exit 1
+check_less abs_rms_field_error "`get_value abs_rms_field_error`" "$err_ik / 4" || exit 1
+
+# triclinic boxes are only implemented with ad-i, tuning the variant has to select it
+# (the same system of random charges in a triclinic box)
+system=systems/3d-periodic/triclinic/random_tricl_300.xml.gz
+
+run_scafacos_test 2 -c tolerance_field,1e-3,p3m_variant_tune p3m $system || exit 1
+variant=`echo "$output" | sed -n 's/^p3m variant: *//p' | tail -n 1`
+check_equal "p3m variant" "$variant" 1 0 || exit 1
+check_less abs_rms_field_error "`get_value abs_rms_field_error`" 3e-3 || exit 1
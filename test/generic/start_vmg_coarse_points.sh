@@ -0,0 +1,17 @@
+#! /bin/sh
+
+. ../defs || exit 1
+. "$srcdir/generic_defs.sh" || exit 1
+
+# VMG with the coarse levels gathered onto fewer processes on an inhomogeneous periodic system,
+# the results have to be the same as without the agglomeration.
+system=systems/3d-periodic/cloud_wall_300.xml.gz
+conf=vmg_max_level,5
+
+run_scafacos_test 2 -c $conf,vmg_coarse_points,0 vmg $system || exit 1
+err0=`get_value abs_rms_field_error`
+
+for coarse_points in 64 512; do
+  run_scafacos_test 2 -c $conf,vmg_coarse_points,$coarse_points vmg $system || exit 1
+  check_equal abs_rms_field_error "$err0" "`get_value abs_rms_field_error`" 1e-4 || exit 1
+done
@@ -0,0 +1,42 @@
+#! /bin/sh
+
+. ../defs || exit 1
+. "$srcdir/generic_defs.sh" || exit 1
+
+# Wolf with persistent neighbour lists (and balanced process domains) on an inhomogeneous system,
+# the results and the energies of an integration have to be the same as without the neighbour lists.
+system=systems/3d-periodic/cloud_wall_300.xml.gz
+conf=wolf_cutoff,3.0,wolf_alpha,0.8
+
+run_scafacos_test 2 -c $conf wolf $system || exit 1
+err0=`get_value abs_rms_field_error`
+
+run_scafacos_test 2 -c $conf,wolf_verlet_skin,0.5 wolf $system || exit 1
+err1=`get_value abs_rms_field_error`
+
+check_equal abs_rms_field_error "$err0" "$err1" 1e-6 || exit 1
+
+run_scafacos_test 2 -t 10 -c $conf wolf $system || exit 1
+energy0=`get_value total_energy`
+
+run_scafacos_test 2 -t 10 -c $conf,wolf_verlet_skin,0.5 wolf $system || exit 1
+energy1=`get_value total_energy`
+
+check_equal total_energy "$energy0" "$energy1" 1e-6 || exit 1
+
+run_scafacos_test 2 -t 10 -c $conf,wolf_verlet_skin,0.5,wolf_balance,1 wolf $system || exit 1
+energy1=`get_value total_energy`
+
+check_equal total_energy "$energy0" "$energy1" 1e-6 || exit 1
+
+# a pair of charges that crosses the periodic boundary has to remain in the neighbour lists
+# (with a single process, the maximum particle move of the integration is passed to the solver)
+system=systems/3d-periodic/boundary_crossing_4.xml.gz
+
+run_scafacos_test 1 -t 30 -c $conf wolf $system || exit 1
+energy0=`get_value total_energy`
+
+run_scafacos_test 1 -t 30 -c $conf,wolf_verlet_skin,0.5 wolf $system || exit 1
+energy1=`get_value total_energy`
+
+check_equal total_energy "$energy0" "$energy1" 1e-6 || exit 1